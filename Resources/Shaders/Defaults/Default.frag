@@ -1,6 +1,7 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
+#ifndef INSTANCED
 layout(set = 0, binding = 1) uniform UboObject
 {
 #ifdef ANIMATED
@@ -14,6 +15,7 @@ layout(set = 0, binding = 1) uniform UboObject
 	float ignoreFog;
 	float ignoreLighting;
 } object;
+#endif
 
 #ifdef COLOUR_MAPPING
 layout(set = 0, binding = 2) uniform sampler2D samplerDiffuse;
@@ -30,6 +32,10 @@ layout(location = 1) in vec3 fragmentNormal;
 #ifdef NORMAL_MAPPING
 layout(location = 2) in mat3 tangent;
 #endif
+#ifdef INSTANCED
+layout(location = 5) flat in vec4 fragmentBaseColor;
+layout(location = 6) flat in vec4 fragmentParameters;
+#endif
 
 layout(location = 0) out vec4 outColour;
 layout(location = 1) out vec2 outNormal;
@@ -39,9 +45,17 @@ layout(location = 2) out vec4 outMaterial;
 
 void main()
 {
-	vec4 textureColour = object.baseColor;
+#ifdef INSTANCED
+	vec4 baseColor = fragmentBaseColor;
+	vec4 parameters = fragmentParameters;
+#else
+	vec4 baseColor = object.baseColor;
+	vec4 parameters = vec4(object.metallic, object.roughness, object.ignoreFog, object.ignoreLighting);
+#endif
+
+	vec4 textureColour = baseColor;
 	vec3 unitNormal = normalize(fragmentNormal);
-	vec3 material = vec3(object.metallic, object.roughness, 0.0f);
+	vec3 material = vec3(parameters.x, parameters.y, 0.0f);
 	float glowing = 0.0f;
 
 #ifdef COLOUR_MAPPING
@@ -66,7 +80,7 @@ void main()
     unitNormal = normalize(tangent * unitNormal);
 #endif
 
-	material.z = (1.0f / 3.0f) * (object.ignoreFog + (2.0f * min(object.ignoreLighting + glowing, 1.0f)));
+	material.z = (1.0f / 3.0f) * (parameters.z + (2.0f * min(parameters.w + glowing, 1.0f)));
 
 	outColour = textureColour;
 	outNormal = encodeNormal(unitNormal);
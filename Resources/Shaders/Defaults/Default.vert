@@ -7,6 +7,7 @@ layout(set = 0, binding = 0) uniform UboScene
 	mat4 view;
 } scene;
 
+#ifndef INSTANCED
 layout(set = 0, binding = 1) uniform UboObject
 {
 #ifdef ANIMATED
@@ -20,6 +21,7 @@ layout(set = 0, binding = 1) uniform UboObject
 	float ignoreFog;
 	float ignoreLighting;
 } object;
+#endif
 
 layout(set = 0, location = 0) in vec3 vertexPosition;
 layout(set = 0, location = 1) in vec2 vertexUv;
@@ -31,12 +33,21 @@ layout(set = 0, location = 3) in vec3 vertexTangent;
 layout(set = 0, location = 4) in vec3 vertexJointIds;
 layout(set = 0, location = 5) in vec3 vertexWeights;
 #endif
+#ifdef INSTANCED
+layout(set = 0, location = 6) in mat4 instanceTransform;
+layout(set = 0, location = 10) in vec4 instanceBaseColor;
+layout(set = 0, location = 11) in vec4 instanceParameters;
+#endif
 
 layout(location = 0) out vec2 fragmentUv;
 layout(location = 1) out vec3 fragmentNormal;
 #ifdef NORMAL_MAPPING
 layout(location = 2) out mat3 tangent;
 #endif
+#ifdef INSTANCED
+layout(location = 5) flat out vec4 fragmentBaseColor;
+layout(location = 6) flat out vec4 fragmentParameters;
+#endif
 
 out gl_PerVertex
 {
@@ -45,6 +56,14 @@ out gl_PerVertex
 
 void main()
 {
+#ifdef INSTANCED
+	mat4 transform = instanceTransform;
+	fragmentBaseColor = instanceBaseColor;
+	fragmentParameters = instanceParameters;
+#else
+	mat4 transform = object.transform;
+#endif
+
 #ifdef ANIMATED
     vec4 totalLocalPos = vec4(0.0f);
     vec4 totalNormal = vec4(0.0f);
@@ -63,15 +82,15 @@ void main()
 	vec4 totalNormal = vec4(vertexNormal, 0.0f);
 #endif
 
-	vec4 worldPosition = object.transform * totalLocalPos;
+	vec4 worldPosition = transform * totalLocalPos;
 
     gl_Position = scene.projection * scene.view * worldPosition;
 
     fragmentUv = vertexUv;
-	fragmentNormal = normalize((object.transform * totalNormal).xyz);
+	fragmentNormal = normalize((transform * totalNormal).xyz);
 
 #ifdef NORMAL_MAPPING
-    mat3 normalMatrix = transpose(inverse(mat3(object.transform)));
+    mat3 normalMatrix = transpose(inverse(mat3(transform)));
     vec3 tangentT = normalize(normalMatrix * vertexTangent);
     vec3 tangentN = normalize(normalMatrix * vertexNormal);
     vec3 tangentB = normalize(cross(tangentT, tangentN));
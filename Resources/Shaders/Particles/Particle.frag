@@ -1,19 +1,38 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
-layout(set = 0, binding = 1) uniform sampler2D samplerDiffuse;
+layout(set = 0, binding = 1) uniform UboObject
+{
+	vec4 colourOffset;
+	float atlasRows;
+} object;
+
+layout(set = 0, binding = 2) uniform sampler2D samplerColour;
 
-layout(location = 0) in vec2 fragmentUv;
+layout(location = 0) in vec2 fragmentUv1;
+layout(location = 1) in vec2 fragmentUv2;
+layout(location = 2) flat in float fragmentBlendFactor;
+layout(location = 3) flat in float fragmentTransparency;
 
 layout(location = 0) out vec4 outColour;
 layout(location = 1) out vec2 outNormal;
 layout(location = 2) out vec4 outMaterial;
 
-void main() 
+void main()
 {
-	vec3 sampledColour = texture(samplerDiffuse, fragmentUv).rgb;
+	vec4 colour1 = texture(samplerColour, fragmentUv1);
+	vec4 colour2 = texture(samplerColour, fragmentUv2);
+	vec4 colour = mix(colour1, colour2, fragmentBlendFactor) * object.colourOffset;
+	colour.a *= 1.0f - fragmentTransparency;
+
+	// Only the colour attachment is blended, nearly clear fragments would overwrite the normal and material attachments.
+	if (colour.a < 0.05f)
+	{
+		discard;
+	}
 
-	outColour = vec4(sampledColour, 1.0f);
+	outColour = colour;
 	outNormal = vec2(0.0f);
-	outMaterial = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	// Particles ignore lighting, encoded the same way as the default material.
+	outMaterial = vec4(0.0f, 0.0f, 2.0f / 3.0f, 1.0f);
 }
@@ -0,0 +1,26 @@
+// The layout of a GPU particle, the first members match the instance attributes of 'Particle.vert'.
+struct Particle
+{
+	vec3 position;
+	float scale;
+	vec4 textureOffsets;
+	float rotation;
+	float blendFactor;
+	float transparency;
+	float lifeLength;
+	vec3 velocity;
+	float gravityEffect;
+	float elapsedTime;
+};
+
+// Finds the two texture atlas stages a particle blends between, as ParticlePool does on the CPU.
+void updateTextureStages(inout Particle particle, float atlasRows)
+{
+	float stageCount = atlasRows * atlasRows;
+	float atlasProgression = (particle.elapsedTime / particle.lifeLength) * stageCount;
+	float index1 = floor(atlasProgression);
+	float index2 = index1 < stageCount - 1.0f ? index1 + 1.0f : index1;
+
+	particle.blendFactor = fract(atlasProgression);
+	particle.textureOffsets = vec4(mod(index1, atlasRows), floor(index1 / atlasRows), mod(index2, atlasRows), floor(index2 / atlasRows)) / atlasRows;
+}
@@ -1,20 +1,55 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
+layout(set = 0, binding = 0) uniform UboScene
+{
+	mat4 projection;
+	mat4 view;
+} scene;
+
+layout(set = 0, binding = 1) uniform UboObject
+{
+	vec4 colourOffset;
+	float atlasRows;
+} object;
+
 layout(set = 0, location = 0) in vec3 vertexPosition;
 layout(set = 0, location = 1) in vec2 vertexUv;
-//layout(set = 0, location = 2) in mat4 vertexMvp;
+layout(set = 0, location = 4) in vec3 instancePosition;
+layout(set = 0, location = 5) in float instanceScale;
+layout(set = 0, location = 6) in vec4 instanceTextureOffsets;
+layout(set = 0, location = 7) in float instanceRotation;
+layout(set = 0, location = 8) in float instanceBlendFactor;
+layout(set = 0, location = 9) in float instanceTransparency;
 
-layout(location = 0) out vec2 fragmentUv;
+layout(location = 0) out vec2 fragmentUv1;
+layout(location = 1) out vec2 fragmentUv2;
+layout(location = 2) flat out float fragmentBlendFactor;
+layout(location = 3) flat out float fragmentTransparency;
 
-out gl_PerVertex 
+out gl_PerVertex
 {
-    vec4 gl_Position;
+	vec4 gl_Position;
 };
 
-void main() 
+void main()
 {
-   // gl_Position = vertexMvp * vec4(vertexPosition, 1.0f);
+	// The quad is spanned by the camera right and up axes, so it always faces the camera.
+	vec3 cameraRight = vec3(scene.view[0][0], scene.view[1][0], scene.view[2][0]);
+	vec3 cameraUp = vec3(scene.view[0][1], scene.view[1][1], scene.view[2][1]);
+
+	float rotationSin = sin(radians(instanceRotation));
+	float rotationCos = cos(radians(instanceRotation));
+	vec2 corner = vec2((rotationCos * vertexPosition.x) - (rotationSin * vertexPosition.y), (rotationSin * vertexPosition.x) + (rotationCos * vertexPosition.y));
+	corner *= instanceScale;
+
+	vec3 worldPosition = instancePosition + (cameraRight * corner.x) + (cameraUp * corner.y);
+
+	gl_Position = scene.projection * scene.view * vec4(worldPosition, 1.0f);
 
-    fragmentUv = vertexUv;
+	vec2 uv = vertexUv / object.atlasRows;
+	fragmentUv1 = uv + instanceTextureOffsets.xy;
+	fragmentUv2 = uv + instanceTextureOffsets.zw;
+	fragmentBlendFactor = instanceBlendFactor;
+	fragmentTransparency = instanceTransparency;
 }
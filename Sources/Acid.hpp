@@ -6,6 +6,7 @@
 
 #include "Animations/Animation/Animation.hpp"
 #include "Animations/Animation/AnimationLoader.hpp"
+#include "Animations/AnimationCache.hpp"
 #include "Animations/Animator.hpp"
 #include "Animations/Geometry/GeometryLoader.hpp"
 #include "Animations/Geometry/VertexAnimated.hpp"
@@ -17,6 +18,7 @@
 #include "Animations/Keyframe/Keyframe.hpp"
 #include "Animations/Keyframe/KeyframeData.hpp"
 #include "Animations/MeshAnimated.hpp"
+#include "Animations/Skeleton/Skeleton.hpp"
 #include "Animations/Skeleton/SkeletonLoader.hpp"
 #include "Animations/Skin/SkinLoader.hpp"
 #include "Animations/Skin/VertexSkinData.hpp"
@@ -54,8 +56,11 @@
 #include "Fonts/Text.hpp"
 #include "Guis/Gui.hpp"
 #include "Guis/RendererGuis.hpp"
+#include "Helpers/CacheFile.hpp"
 #include "Helpers/FileSystem.hpp"
 #include "Helpers/FormatString.hpp"
+#include "Helpers/MappedFile.hpp"
+#include "Helpers/RadixSort.hpp"
 #include "Helpers/SquareArray.hpp"
 #include "Inputs/AxisButton.hpp"
 #include "Inputs/AxisCompound.hpp"
@@ -73,6 +78,7 @@
 #include "Lights/Light.hpp"
 #include "Materials/IMaterial.hpp"
 #include "Materials/MaterialDefault.hpp"
+#include "Materials/MaterialInstance.hpp"
 #include "Materials/PipelineMaterial.hpp"
 #include "Maths/Colour.hpp"
 #include "Maths/Delta.hpp"
@@ -97,7 +103,7 @@
 #include "Meshes/Mesh.hpp"
 #include "Meshes/MeshRender.hpp"
 #include "Meshes/RendererMeshes.hpp"
-#include "Models/IVertex.hpp"
+#include "Models/MeshCache.hpp"
 #include "Models/Model.hpp"
 #include "Models/Obj/ModelObj.hpp"
 #include "Models/Shapes/MeshPattern.hpp"
@@ -108,14 +114,19 @@
 #include "Models/Shapes/ModelRectangle.hpp"
 #include "Models/Shapes/ModelSphere.hpp"
 #include "Models/VertexModel.hpp"
-#include "Models/VertexModelData.hpp"
+#include "Models/VertexStream.hpp"
 #include "Noise/Noise.hpp"
+#include "Objects/ComponentPools.hpp"
 #include "Objects/ComponentRegister.hpp"
 #include "Objects/GameObject.hpp"
 #include "Objects/IBehaviour.hpp"
 #include "Objects/IComponent.hpp"
 #include "Objects/Prefabs/PrefabObject.hpp"
 #include "Particles/Particle.hpp"
+#include "Particles/ParticleInstance.hpp"
+#include "Particles/ParticlePool.hpp"
+#include "Particles/ParticlePoolGpu.hpp"
+#include "Particles/ParticleSpawnRequest.hpp"
 #include "Particles/Particles.hpp"
 #include "Particles/ParticleSystem.hpp"
 #include "Particles/ParticleType.hpp"
@@ -125,6 +136,7 @@
 #include "Particles/Spawns/SpawnLine.hpp"
 #include "Particles/Spawns/SpawnPoint.hpp"
 #include "Particles/Spawns/SpawnSphere.hpp"
+#include "Physics/Aabb.hpp"
 #include "Physics/Collider.hpp"
 #include "Physics/ColliderBox.hpp"
 #include "Physics/ColliderCapsule.hpp"
@@ -135,6 +147,8 @@
 #include "Physics/ColliderSphere.hpp"
 #include "Physics/Force.hpp"
 #include "Physics/Frustum.hpp"
+#include "Physics/MotionState.hpp"
+#include "Physics/PhysicsScheduler.hpp"
 #include "Physics/Ray.hpp"
 #include "Physics/Rigidbody.hpp"
 #include "Post/Deferred/RendererDeferred.hpp"
@@ -159,20 +173,32 @@
 #include "Post/Pipelines/PipelineGaussian.hpp"
 #include "Renderer/Buffers/Buffer.hpp"
 #include "Renderer/Buffers/IndexBuffer.hpp"
+#include "Renderer/Buffers/InstanceBuffer.hpp"
+#include "Renderer/Buffers/StorageBuffer.hpp"
 #include "Renderer/Buffers/UniformBuffer.hpp"
+#include "Renderer/Buffers/UniformRing.hpp"
 #include "Renderer/Buffers/VertexBuffer.hpp"
 #include "Renderer/Commands/CommandBuffer.hpp"
+#include "Renderer/Commands/CommandPool.hpp"
 #include "Renderer/Descriptors/DescriptorSet.hpp"
 #include "Renderer/Descriptors/IDescriptor.hpp"
 #include "Renderer/Handlers/DescriptorsHandler.hpp"
 #include "Renderer/Handlers/UniformHandler.hpp"
 #include "Renderer/IManagerRender.hpp"
 #include "Renderer/IRenderer.hpp"
+#include "Renderer/Memory/BuddyAllocator.hpp"
+#include "Renderer/Memory/LinearAllocator.hpp"
+#include "Renderer/Memory/MemoryAllocator.hpp"
+#include "Renderer/Memory/RingAllocator.hpp"
+#include "Renderer/Memory/Uploader.hpp"
 #include "Renderer/Pipelines/Compute.hpp"
 #include "Renderer/Pipelines/IPipeline.hpp"
 #include "Renderer/Pipelines/Pipeline.hpp"
+#include "Renderer/Pipelines/PipelineCache.hpp"
 #include "Renderer/Pipelines/PipelineCreate.hpp"
+#include "Renderer/Pipelines/ShaderCache.hpp"
 #include "Renderer/Pipelines/ShaderProgram.hpp"
+#include "Renderer/RenderQueue.hpp"
 #include "Renderer/Renderer.hpp"
 #include "Renderer/Renderpass/Renderpass.hpp"
 #include "Renderer/Renderpass/RenderpassCreate.hpp"
@@ -181,7 +207,9 @@
 #include "Renderer/Swapchain/Framebuffers.hpp"
 #include "Renderer/Swapchain/Swapchain.hpp"
 #include "Resources/IResource.hpp"
+#include "Resources/ResourceFuture.hpp"
 #include "Resources/Resources.hpp"
+#include "Scenes/DynamicTree.hpp"
 #include "Scenes/ICamera.hpp"
 #include "Scenes/IScene.hpp"
 #include "Scenes/ISpatialStructure.hpp"
@@ -197,8 +225,9 @@
 #include "Textures/stb_image.h"
 #include "Textures/stb_image_write.h"
 #include "Textures/Texture.hpp"
-#include "Threads/Thread.hpp"
+#include "Threads/Job.hpp"
 #include "Threads/ThreadPool.hpp"
+#include "Threads/WorkStealingDeque.hpp"
 #include "Uis/UiBound.hpp"
 #include "Uis/UiInputButton.hpp"
 #include "Uis/UiInputDelay.hpp"
@@ -1,20 +1,46 @@
 #include "Animation.hpp"
 
+#include <set>
+
 namespace acid
 {
-	Animation::Animation(const float &length, const std::vector<Keyframe *> &keyframes) :
+	Animation::Animation(const std::string &filename, const float &length, const std::vector<Keyframe *> &keyframes) :
+		m_filename(GetResourceName(filename)),
 		m_length(length),
-		m_keyframes(keyframes)
+		m_keyframes(keyframes),
+		m_trackNames(std::vector<std::string>()),
+		m_times(std::vector<float>()),
+		m_positionsX(std::vector<float>()),
+		m_positionsY(std::vector<float>()),
+		m_positionsZ(std::vector<float>()),
+		m_rotationsX(std::vector<float>()),
+		m_rotationsY(std::vector<float>()),
+		m_rotationsZ(std::vector<float>()),
+		m_rotationsW(std::vector<float>())
 	{
+		BuildTracks();
 	}
 
-	Animation::Animation(const float &length, const std::vector<KeyframeData *> &keyframeData) :
-		m_length(length)
+	Animation::Animation(const std::string &filename, const float &length, const std::vector<KeyframeData *> &keyframeData) :
+		m_filename(GetResourceName(filename)),
+		m_length(length),
+		m_keyframes(std::vector<Keyframe *>()),
+		m_trackNames(std::vector<std::string>()),
+		m_times(std::vector<float>()),
+		m_positionsX(std::vector<float>()),
+		m_positionsY(std::vector<float>()),
+		m_positionsZ(std::vector<float>()),
+		m_rotationsX(std::vector<float>()),
+		m_rotationsY(std::vector<float>()),
+		m_rotationsZ(std::vector<float>()),
+		m_rotationsW(std::vector<float>())
 	{
 		for (auto &frameData : keyframeData)
 		{
 			m_keyframes.emplace_back(new Keyframe(*frameData));
 		}
+
+		BuildTracks();
 	}
 
 	Animation::~Animation()
@@ -24,4 +50,69 @@ namespace acid
 			delete keyFrame;
 		}
 	}
+
+	void Animation::BuildTracks()
+	{
+		auto trackNames = std::set<std::string>();
+
+		for (auto &keyframe : m_keyframes)
+		{
+			for (auto &[name, transform] : keyframe->GetPose())
+			{
+				trackNames.emplace(name);
+			}
+		}
+
+		m_trackNames = std::vector<std::string>(trackNames.begin(), trackNames.end());
+		auto trackCount = static_cast<uint32_t>(m_trackNames.size());
+		size_t size = m_keyframes.size() * trackCount;
+		m_times.resize(m_keyframes.size());
+		m_positionsX.resize(size);
+		m_positionsY.resize(size);
+		m_positionsZ.resize(size);
+		m_rotationsX.resize(size);
+		m_rotationsY.resize(size);
+		m_rotationsZ.resize(size);
+		m_rotationsW.resize(size, 1.0f);
+
+		for (uint32_t frame = 0; frame < m_keyframes.size(); frame++)
+		{
+			auto &pose = m_keyframes[frame]->GetPose();
+			m_times[frame] = m_keyframes[frame]->GetTimeStamp();
+
+			for (uint32_t track = 0; track < trackCount; track++)
+			{
+				size_t index = (frame * trackCount) + track;
+				auto it = pose.find(m_trackNames[track]);
+
+				// A joint missing from a keyframe holds the transform from the keyframe before.
+				if (it == pose.end())
+				{
+					if (frame != 0)
+					{
+						size_t previous = index - trackCount;
+						m_positionsX[index] = m_positionsX[previous];
+						m_positionsY[index] = m_positionsY[previous];
+						m_positionsZ[index] = m_positionsZ[previous];
+						m_rotationsX[index] = m_rotationsX[previous];
+						m_rotationsY[index] = m_rotationsY[previous];
+						m_rotationsZ[index] = m_rotationsZ[previous];
+						m_rotationsW[index] = m_rotationsW[previous];
+					}
+
+					continue;
+				}
+
+				Vector3 position = it->second->GetPosition();
+				Quaternion rotation = it->second->GetRotation();
+				m_positionsX[index] = position.m_x;
+				m_positionsY[index] = position.m_y;
+				m_positionsZ[index] = position.m_z;
+				m_rotationsX[index] = rotation.m_x;
+				m_rotationsY[index] = rotation.m_y;
+				m_rotationsZ[index] = rotation.m_z;
+				m_rotationsW[index] = rotation.m_w;
+			}
+		}
+	}
 }
@@ -1,32 +1,61 @@
 #pragma once
 
+#include <string>
 #include <vector>
 #include "Animations/Keyframe/Keyframe.hpp"
+#include "Resources/IResource.hpp"
 
 namespace acid
 {
 	/// <summary>
 	/// Represents an animation that can be carried out by an animated entity.
 	/// It contains the length of the animation in seconds, and a list of <seealso cref="KeyframeJoints"/>s.
+	/// Animations are shared between every mesh animated from the same file.
+	/// <para>
+	/// The keyframes are also stored as tracks, one per joint, with the position and rotation components of every track at a keyframe stored contiguously.
+	/// So a pose can be interpolated over all tracks at once, track t of keyframe f is at index f * track count + t.
+	/// </para>
 	/// </summary>
-	class ACID_EXPORT Animation
+	class ACID_EXPORT Animation :
+		public IResource
 	{
 	private:
+		std::string m_filename;
 		float m_length;
 
 		std::vector<Keyframe *> m_keyframes;
+
+		std::vector<std::string> m_trackNames;
+		std::vector<float> m_times;
+		std::vector<float> m_positionsX;
+		std::vector<float> m_positionsY;
+		std::vector<float> m_positionsZ;
+		std::vector<float> m_rotationsX;
+		std::vector<float> m_rotationsY;
+		std::vector<float> m_rotationsZ;
+		std::vector<float> m_rotationsW;
 	public:
+		/// <summary>
+		/// Gets the name an animation loaded from a file is registered in <see cref="Resources"/> as.
+		/// </summary>
+		/// <param name="filename"> The file the animation was loaded from. </param>
+		/// <returns> The resource name. </returns>
+		static std::string GetResourceName(const std::string &filename) { return filename + "#Animation"; }
+
 		/// <summary>
 		/// Creates a new animation.
 		/// </summary>
+		/// <param name="filename"> The file the animation was loaded from. </param>
 		/// <param name="lengthInSeconds"> The length of the animation in seconds. </param>
 		/// <param name="frames"> All the keyframes for the animation, ordered by time of appearance in the animation. </param>
-		Animation(const float &length, const std::vector<Keyframe *> &keyframes);
+		Animation(const std::string &filename, const float &length, const std::vector<Keyframe *> &keyframes);
 
-		Animation(const float &length, const std::vector<KeyframeData *> &keyframeData);
+		Animation(const std::string &filename, const float &length, const std::vector<KeyframeData *> &keyframeData);
 
 		~Animation();
 
+		std::string GetFilename() override { return m_filename; }
+
 		/// <summary>
 		/// Gets the length of the animation in seconds.
 		/// </summary>
@@ -38,6 +67,36 @@ namespace acid
 		/// keyframes in the animation (first keyframe of the animation in array position 0).
 		/// </summary>
 		/// <returns> The array of the animation's keyframes. </returns>
-		std::vector<Keyframe *> GetKeyframes() const { return m_keyframes; }
+		const std::vector<Keyframe *> &GetKeyframes() const { return m_keyframes; }
+
+		/// <summary>
+		/// Gets the name of the joint each track animates.
+		/// </summary>
+		/// <returns> The track joint names. </returns>
+		const std::vector<std::string> &GetTrackNames() const { return m_trackNames; }
+
+		uint32_t GetTrackCount() const { return static_cast<uint32_t>(m_trackNames.size()); }
+
+		/// <summary>
+		/// Gets the time in seconds of each keyframe, in increasing order.
+		/// </summary>
+		/// <returns> The keyframe times. </returns>
+		const std::vector<float> &GetTimes() const { return m_times; }
+
+		const std::vector<float> &GetPositionsX() const { return m_positionsX; }
+
+		const std::vector<float> &GetPositionsY() const { return m_positionsY; }
+
+		const std::vector<float> &GetPositionsZ() const { return m_positionsZ; }
+
+		const std::vector<float> &GetRotationsX() const { return m_rotationsX; }
+
+		const std::vector<float> &GetRotationsY() const { return m_rotationsY; }
+
+		const std::vector<float> &GetRotationsZ() const { return m_rotationsZ; }
+
+		const std::vector<float> &GetRotationsW() const { return m_rotationsW; }
+	private:
+		void BuildTracks();
 	};
 }
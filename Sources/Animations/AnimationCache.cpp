@@ -0,0 +1,253 @@
+#include "AnimationCache.hpp"
+
+#include <cstring>
+#include "Helpers/MappedFile.hpp"
+
+namespace acid
+{
+	const uint32_t AnimationCache::CACHE_MAGIC = 0x4E414141; // "AAAN"
+	const uint32_t AnimationCache::CACHE_VERSION = 2;
+
+	CacheFile AnimationCache::CACHE = CacheFile("Animations");
+
+	class CacheReader
+	{
+	public:
+		const char *m_data;
+		size_t m_size;
+		size_t m_offset;
+
+		CacheReader(const char *data, const size_t &size, const size_t &offset) :
+			m_data(data),
+			m_size(size),
+			m_offset(offset)
+		{
+		}
+
+		bool Has(const size_t &size) const
+		{
+			return m_offset + size <= m_size;
+		}
+
+		template<typename T>
+		bool Read(T &value)
+		{
+			if (!Has(sizeof(T)))
+			{
+				return false;
+			}
+
+			memcpy(&value, m_data + m_offset, sizeof(T));
+			m_offset += sizeof(T);
+			return true;
+		}
+
+		bool Read(std::string &value)
+		{
+			uint32_t size = 0;
+
+			if (!Read(size) || !Has(size))
+			{
+				return false;
+			}
+
+			value = std::string(m_data + m_offset, size);
+			m_offset += size;
+			return true;
+		}
+
+		bool Read(float *values, const size_t &count)
+		{
+			if (!Has(count * sizeof(float)))
+			{
+				return false;
+			}
+
+			memcpy(values, m_data + m_offset, count * sizeof(float));
+			m_offset += count * sizeof(float);
+			return true;
+		}
+	};
+
+	template<typename T>
+	static void WriteValue(std::vector<char> &data, const T &value)
+	{
+		const char *bytes = reinterpret_cast<const char *>(&value);
+		data.insert(data.end(), bytes, bytes + sizeof(T));
+	}
+
+	static void WriteString(std::vector<char> &data, const std::string &value)
+	{
+		WriteValue(data, static_cast<uint32_t>(value.size()));
+		data.insert(data.end(), value.begin(), value.end());
+	}
+
+	static void WriteFloats(std::vector<char> &data, const float *values, const size_t &count)
+	{
+		const char *bytes = reinterpret_cast<const char *>(values);
+		data.insert(data.end(), bytes, bytes + (count * sizeof(float)));
+	}
+
+	static void WriteJoint(std::vector<char> &data, const Joint &joint)
+	{
+		WriteValue(data, joint.GetIndex());
+		WriteString(data, joint.GetName());
+		WriteFloats(data, joint.GetLocalBindTransform().m_linear, 16);
+
+		auto children = joint.GetChildren();
+		WriteValue(data, static_cast<uint32_t>(children.size()));
+
+		for (auto &child : children)
+		{
+			WriteJoint(data, *child);
+		}
+	}
+
+	static Joint *ReadJoint(CacheReader &reader)
+	{
+		uint32_t index = 0;
+		std::string name = "";
+		Matrix4 localBindTransform = Matrix4();
+		uint32_t childCount = 0;
+
+		if (!reader.Read(index) || !reader.Read(name) || !reader.Read(localBindTransform.m_linear, 16) || !reader.Read(childCount))
+		{
+			return nullptr;
+		}
+
+		auto joint = std::make_unique<Joint>(index, name, localBindTransform);
+
+		for (uint32_t i = 0; i < childCount; i++)
+		{
+			Joint *child = ReadJoint(reader);
+
+			if (child == nullptr)
+			{
+				return nullptr;
+			}
+
+			joint->AddChild(child);
+		}
+
+		return joint.release();
+	}
+
+	std::string AnimationCache::GetDirectory()
+	{
+		return CACHE.GetDirectory();
+	}
+
+	void AnimationCache::SetDirectory(const std::string &directory)
+	{
+		CACHE.SetDirectory(directory);
+	}
+
+	bool AnimationCache::Load(const std::string &filename, VertexStream<VertexAnimated> &vertices, std::vector<uint32_t> &indices,
+		std::shared_ptr<Skeleton> &skeleton, std::shared_ptr<Animation> &animation)
+	{
+		MappedFile file(GetFilename(filename));
+		CacheFile::SourceHeader header = {};
+
+		if (!CacheFile::ReadSourceHeader(file, CACHE_MAGIC, CACHE_VERSION, filename, VertexStream<VertexAnimated>::GetStride(), header))
+		{
+			return false;
+		}
+
+		size_t vertexOffset = CacheFile::GetVertexOffset(header);
+		size_t vertexSize = static_cast<size_t>(header.vertexCount) * header.stride;
+		size_t indexSize = static_cast<size_t>(header.indexCount) * sizeof(uint32_t);
+
+		CacheReader reader = CacheReader(file.GetData(), file.GetSize(), vertexOffset + vertexSize + indexSize);
+		Joint *headJoint = ReadJoint(reader);
+
+		if (headJoint == nullptr)
+		{
+			return false;
+		}
+
+		auto loadedSkeleton = std::make_shared<Skeleton>(filename, headJoint);
+		float length = 0.0f;
+		uint32_t keyframeCount = 0;
+
+		if (!reader.Read(length) || !reader.Read(keyframeCount))
+		{
+			return false;
+		}
+
+		auto keyframes = std::vector<Keyframe *>();
+		bool valid = true;
+
+		for (uint32_t i = 0; i < keyframeCount && valid; i++)
+		{
+			float timeStamp = 0.0f;
+			uint32_t poseCount = 0;
+			auto pose = std::map<std::string, JointTransform *>();
+			valid = reader.Read(timeStamp) && reader.Read(poseCount);
+
+			for (uint32_t j = 0; j < poseCount && valid; j++)
+			{
+				std::string name = "";
+				float transform[7];
+				valid = reader.Read(name) && reader.Read(transform, 7);
+
+				if (valid)
+				{
+					pose.emplace(name, new JointTransform(Vector3(transform[0], transform[1], transform[2]), Quaternion(transform[3], transform[4], transform[5], transform[6])));
+				}
+			}
+
+			keyframes.emplace_back(new Keyframe(timeStamp, pose));
+		}
+
+		auto loadedAnimation = std::make_shared<Animation>(filename, length, keyframes);
+
+		if (!valid || keyframes.empty())
+		{
+			return false;
+		}
+
+		vertices.Assign(reinterpret_cast<const VertexAnimated *>(file.GetData() + vertexOffset), header.vertexCount);
+		indices.resize(header.indexCount);
+		memcpy(indices.data(), file.GetData() + vertexOffset + vertexSize, indexSize);
+		skeleton = loadedSkeleton;
+		animation = loadedAnimation;
+		return true;
+	}
+
+	bool AnimationCache::Save(const std::string &filename, const VertexStream<VertexAnimated> &vertices, const std::vector<uint32_t> &indices,
+		const Skeleton &skeleton, const Animation &animation)
+	{
+		auto data = CacheFile::CreateSourceEntry(CACHE_MAGIC, CACHE_VERSION, filename, VertexStream<VertexAnimated>::GetStride(), vertices.GetData(),
+			static_cast<uint32_t>(vertices.GetCount()), indices);
+
+		WriteJoint(data, *skeleton.GetHeadJoint());
+
+		// Keyframes keep the position and rotation of each joint, the local transforms are rebuilt from them.
+		auto keyframes = animation.GetKeyframes();
+		WriteValue(data, animation.GetLength());
+		WriteValue(data, static_cast<uint32_t>(keyframes.size()));
+
+		for (auto &keyframe : keyframes)
+		{
+			auto pose = keyframe->GetPose();
+			WriteValue(data, keyframe->GetTimeStamp());
+			WriteValue(data, static_cast<uint32_t>(pose.size()));
+
+			for (auto &[name, jointTransform] : pose)
+			{
+				Vector3 position = jointTransform->GetPosition();
+				Quaternion rotation = jointTransform->GetRotation();
+				float transform[7] = {position.m_x, position.m_y, position.m_z, rotation.m_x, rotation.m_y, rotation.m_z, rotation.m_w};
+				WriteString(data, name);
+				WriteFloats(data, transform, 7);
+			}
+		}
+
+		return CacheFile::Write(GetFilename(filename), data);
+	}
+
+	std::string AnimationCache::GetFilename(const std::string &filename)
+	{
+		return CACHE.GetFilename(filename, ".aanim");
+	}
+}
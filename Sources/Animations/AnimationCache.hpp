@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Animation/Animation.hpp"
+#include "Geometry/VertexAnimated.hpp"
+#include "Helpers/CacheFile.hpp"
+#include "Skeleton/Skeleton.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A cache of parsed COLLADA files stored as '.aanim' files, holding the skinned vertices, the skeleton and the animation so the XML is only parsed once.
+	/// Entries are found by the source filename, and are stale once the source file changes size or modification time.
+	/// </summary>
+	class ACID_EXPORT AnimationCache
+	{
+	private:
+		static const uint32_t CACHE_MAGIC;
+		static const uint32_t CACHE_VERSION;
+
+		static CacheFile CACHE;
+	public:
+		/// <summary>
+		/// Gets the directory cached animations are stored in, defaults to 'Cache/Animations' in the working directory.
+		/// </summary>
+		/// <returns> The cache directory. </returns>
+		static std::string GetDirectory();
+
+		/// <summary>
+		/// Sets the directory cached animations are stored in.
+		/// </summary>
+		/// <param name="directory"> The new cache directory. </param>
+		static void SetDirectory(const std::string &directory);
+
+		/// <summary>
+		/// Loads a cached animated model.
+		/// </summary>
+		/// <param name="filename"> The source file the model was parsed from. </param>
+		/// <param name="vertices"> The loaded skinned vertices. </param>
+		/// <param name="indices"> The loaded indices. </param>
+		/// <param name="skeleton"> The loaded skeleton. </param>
+		/// <param name="animation"> The loaded animation. </param>
+		/// <returns> If a valid cache entry was found. </returns>
+		static bool Load(const std::string &filename, VertexStream<VertexAnimated> &vertices, std::vector<uint32_t> &indices,
+			std::shared_ptr<Skeleton> &skeleton, std::shared_ptr<Animation> &animation);
+
+		/// <summary>
+		/// Saves a parsed animated model to the cache.
+		/// </summary>
+		/// <param name="filename"> The source file the model was parsed from. </param>
+		/// <param name="vertices"> The skinned vertices. </param>
+		/// <param name="indices"> The indices. </param>
+		/// <param name="skeleton"> The skeleton. </param>
+		/// <param name="animation"> The animation. </param>
+		/// <returns> If the entry was written. </returns>
+		static bool Save(const std::string &filename, const VertexStream<VertexAnimated> &vertices, const std::vector<uint32_t> &indices,
+			const Skeleton &skeleton, const Animation &animation);
+	private:
+		static std::string GetFilename(const std::string &filename);
+	};
+}
@@ -1,112 +1,396 @@
 #include "Animator.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include "Engine/Engine.hpp"
+#include "Threads/ThreadPool.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ACID_ANIMATIONS_SSE
+#endif
 
 namespace acid
 {
-	Animator::Animator(Joint *rootJoint) :
-		m_rootJoint(rootJoint),
-		m_currentAnimation(nullptr)
+	/// <summary>
+	/// The float lanes the track kernel is written against, one wide for the tail of the tracks.
+	/// </summary>
+	struct TrackScalar
+	{
+		using Type = float;
+		static const uint32_t WIDTH = 1;
+
+		static Type Load(const float *source) { return *source; }
+
+		static void Store(float *destination, const Type &value) { *destination = value; }
+
+		static Type Set(const float &value) { return value; }
+
+		static Type Add(const Type &a, const Type &b) { return a + b; }
+
+		static Type Sub(const Type &a, const Type &b) { return a - b; }
+
+		static Type Mul(const Type &a, const Type &b) { return a * b; }
+
+		static Type Div(const Type &a, const Type &b) { return a / b; }
+
+		static Type Min(const Type &a, const Type &b) { return a < b ? a : b; }
+
+		static Type Sqrt(const Type &a) { return std::sqrt(a); }
+
+		static Type Less(const Type &a, const Type &b) { return a < b ? 1.0f : 0.0f; }
+
+		static Type Select(const Type &mask, const Type &a, const Type &b) { return mask != 0.0f ? a : b; }
+	};
+
+#if defined(ACID_ANIMATIONS_SSE)
+	/// <summary>
+	/// The float lanes the track kernel is written against, four wide with SSE2.
+	/// </summary>
+	struct TrackLanes
+	{
+		using Type = __m128;
+		static const uint32_t WIDTH = 4;
+
+		static Type Load(const float *source) { return _mm_loadu_ps(source); }
+
+		static void Store(float *destination, const Type &value) { _mm_storeu_ps(destination, value); }
+
+		static Type Set(const float &value) { return _mm_set1_ps(value); }
+
+		static Type Add(const Type &a, const Type &b) { return _mm_add_ps(a, b); }
+
+		static Type Sub(const Type &a, const Type &b) { return _mm_sub_ps(a, b); }
+
+		static Type Mul(const Type &a, const Type &b) { return _mm_mul_ps(a, b); }
+
+		static Type Div(const Type &a, const Type &b) { return _mm_div_ps(a, b); }
+
+		static Type Min(const Type &a, const Type &b) { return _mm_min_ps(a, b); }
+
+		static Type Sqrt(const Type &a) { return _mm_sqrt_ps(a); }
+
+		static Type Less(const Type &a, const Type &b) { return _mm_cmplt_ps(a, b); }
+
+		static Type Select(const Type &mask, const Type &a, const Type &b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+	};
+#endif
+
+	/// <summary>
+	/// The pointers into the keyframe tracks and the interpolated tracks, offset together as the kernel walks over the tracks.
+	/// </summary>
+	struct TrackPointers
+	{
+		const float *previous[7];
+		const float *next[7];
+		float *result[7];
+	};
+
+	/// <summary>
+	/// Approximates the sine of an angle between zero and pi over two, with the Taylor series to the ninth degree.
+	/// </summary>
+	template<typename L>
+	static typename L::Type SinLanes(const typename L::Type &x)
 	{
+		auto x2 = L::Mul(x, x);
+		auto series = L::Add(L::Set(-1.0f / 5040.0f), L::Mul(x2, L::Set(1.0f / 362880.0f)));
+		series = L::Add(L::Set(1.0f / 120.0f), L::Mul(x2, series));
+		series = L::Add(L::Set(-1.0f / 6.0f), L::Mul(x2, series));
+		series = L::Add(L::Set(1.0f), L::Mul(x2, series));
+		return L::Mul(x, series);
 	}
 
-	Animator::~Animator()
+	/// <summary>
+	/// Approximates the arc cosine of a value between zero and one (Abramowitz and Stegun 4.4.45).
+	/// </summary>
+	template<typename L>
+	static typename L::Type AcosLanes(const typename L::Type &x)
+	{
+		auto series = L::Add(L::Set(0.0742610f), L::Mul(x, L::Set(-0.0187293f)));
+		series = L::Add(L::Set(-0.2121144f), L::Mul(x, series));
+		series = L::Add(L::Set(1.5707288f), L::Mul(x, series));
+		return L::Mul(L::Sqrt(L::Sub(L::Set(1.0f), x)), series);
+	}
+
+	/// <summary>
+	/// Interpolates the tracks the pointers are at, linearly for the positions and by the shortest spherical path for the rotations.
+	/// </summary>
+	template<typename L>
+	static void InterpolateLanes(const TrackPointers &tracks, const uint32_t &offset, const float &progression)
 	{
-		delete m_rootJoint;
+		auto zero = L::Set(0.0f);
+		auto one = L::Set(1.0f);
+		auto p = L::Set(progression);
+
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			auto previous = L::Load(tracks.previous[i] + offset);
+			auto next = L::Load(tracks.next[i] + offset);
+			L::Store(tracks.result[i] + offset, L::Add(previous, L::Mul(L::Sub(next, previous), p)));
+		}
+
+		typename L::Type a[4];
+		typename L::Type b[4];
 
-		delete m_currentAnimation;
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			a[i] = L::Load(tracks.previous[3 + i] + offset);
+			b[i] = L::Load(tracks.next[3 + i] + offset);
+		}
+
+		auto cosAngle = L::Add(L::Add(L::Mul(a[0], b[0]), L::Mul(a[1], b[1])), L::Add(L::Mul(a[2], b[2]), L::Mul(a[3], b[3])));
+
+		// Negates the next rotation when the rotations are more than half a turn apart, so the shortest path is taken.
+		auto flip = L::Less(cosAngle, zero);
+		cosAngle = L::Min(L::Select(flip, L::Sub(zero, cosAngle), cosAngle), one);
+
+		for (auto &component : b)
+		{
+			component = L::Select(flip, L::Sub(zero, component), component);
+		}
+
+		auto angle = AcosLanes<L>(cosAngle);
+		auto sinAngle = SinLanes<L>(angle);
+		auto nearlyParallel = L::Less(sinAngle, L::Set(0.001f));
+		auto t1 = L::Div(SinLanes<L>(L::Mul(L::Sub(one, p), angle)), sinAngle);
+		auto t2 = L::Div(SinLanes<L>(L::Mul(p, angle)), sinAngle);
+		t1 = L::Select(nearlyParallel, L::Sub(one, p), t1);
+		t2 = L::Select(nearlyParallel, p, t2);
+
+		typename L::Type result[4];
+		auto lengthSquared = zero;
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			result[i] = L::Add(L::Mul(a[i], t1), L::Mul(b[i], t2));
+			lengthSquared = L::Add(lengthSquared, L::Mul(result[i], result[i]));
+		}
+
+		auto inverseLength = L::Div(one, L::Sqrt(lengthSquared));
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			L::Store(tracks.result[3 + i] + offset, L::Mul(result[i], inverseLength));
+		}
 	}
 
-	void Animator::Update()
+	/// <summary>
+	/// Multiplies two row-major matrices the same way as <see cref="Matrix4::Multiply"/>, each row of the result is a combination of the rows of the left matrix.
+	/// </summary>
+	static void MultiplyRows(const Matrix4 &left, const Matrix4 &right, Matrix4 &destination)
 	{
-		if (m_currentAnimation == nullptr)
+#if defined(ACID_ANIMATIONS_SSE)
+		__m128 rows[4];
+
+		for (uint32_t i = 0; i < 4; i++)
 		{
-			return;
+			rows[i] = _mm_loadu_ps(left.m_linear + (i * 4));
+		}
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			const float *weights = right.m_linear + (i * 4);
+			__m128 row = _mm_add_ps(_mm_mul_ps(rows[0], _mm_set1_ps(weights[0])), _mm_mul_ps(rows[1], _mm_set1_ps(weights[1])));
+			row = _mm_add_ps(row, _mm_add_ps(_mm_mul_ps(rows[2], _mm_set1_ps(weights[2])), _mm_mul_ps(rows[3], _mm_set1_ps(weights[3]))));
+			_mm_storeu_ps(destination.m_linear + (i * 4), row);
 		}
+#else
+		destination = left * right;
+#endif
+	}
 
-		IncreaseAnimationTime();
-		auto currentPose = CalculateCurrentAnimationPose();
-		ApplyPoseToJoints(currentPose, m_rootJoint, Matrix4::IDENTITY);
+	Animator::Animator(const std::shared_ptr<Skeleton> &skeleton, const uint32_t &jointCount) :
+		m_skeleton(skeleton),
+		m_jointTransforms(std::vector<Matrix4>(jointCount)),
+		m_animationTime(0.0f),
+		m_frame(0),
+		m_currentAnimation(nullptr),
+		m_jointTracks(std::vector<int32_t>()),
+		m_positionsX(std::vector<float>()),
+		m_positionsY(std::vector<float>()),
+		m_positionsZ(std::vector<float>()),
+		m_rotationsX(std::vector<float>()),
+		m_rotationsY(std::vector<float>()),
+		m_rotationsZ(std::vector<float>()),
+		m_rotationsW(std::vector<float>()),
+		m_modelTransforms(std::vector<Matrix4>(skeleton->GetJointCount()))
+	{
 	}
 
-	void Animator::IncreaseAnimationTime()
+	Animator::~Animator()
 	{
-		m_animationTime += Engine::Get()->GetDelta();
+	}
+
+	void Animator::Update()
+	{
+		Update(Engine::Get()->GetDelta());
+	}
+
+	void Animator::Update(const float &delta)
+	{
+		if (m_currentAnimation == nullptr || m_currentAnimation->GetTimes().empty())
+		{
+			return;
+		}
+
+		m_animationTime += delta;
 
 		if (m_animationTime > m_currentAnimation->GetLength())
 		{
 			m_animationTime = std::fmod(m_animationTime, m_currentAnimation->GetLength());
 		}
+
+		auto &times = m_currentAnimation->GetTimes();
+		uint32_t previousFrame = FindPreviousFrame();
+		uint32_t nextFrame = previousFrame + 1 < times.size() ? previousFrame + 1 : previousFrame;
+		float totalTime = times[nextFrame] - times[previousFrame];
+		float progression = totalTime > 0.0f ? (m_animationTime - times[previousFrame]) / totalTime : 0.0f;
+
+		InterpolateTracks(previousFrame, nextFrame, progression);
+		ComposePose();
 	}
 
-	std::map<std::string, Matrix4> Animator::CalculateCurrentAnimationPose()
+	void Animator::Update(const std::vector<Animator *> &animators, const float &delta)
 	{
-		auto frames = GetPreviousAndNextFrames();
-		float progression = CalculateProgression(*frames[0], *frames[1]);
-		return InterpolatePoses(*frames[0], *frames[1], progression);
+		// Animators share no mutable data, so they are updated in batches of a few characters per job.
+		auto handle = ThreadPool::Get()->ParallelFor(0, static_cast<uint32_t>(animators.size()), [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				animators[i]->Update(delta);
+			}
+		}, 8);
+		ThreadPool::Get()->Wait(handle);
 	}
 
-	std::vector<Keyframe *> Animator::GetPreviousAndNextFrames()
+	void Animator::DoAnimation(const std::shared_ptr<Animation> &animation)
 	{
-		auto allFrames = m_currentAnimation->GetKeyframes();
-		Keyframe *previousFrame = allFrames[0];
-		Keyframe *nextFrame = allFrames[0];
+		m_animationTime = 0.0f;
+		m_frame = 0;
+		m_currentAnimation = animation;
+		m_jointTracks.clear();
 
-		for (uint32_t i = 1; i < allFrames.size(); i++)
+		if (m_currentAnimation == nullptr)
 		{
-			nextFrame = allFrames[i];
+			return;
+		}
 
-			if (nextFrame->GetTimeStamp() > m_animationTime)
-			{
-				break;
-			}
+		// Resolves the track of every joint once, so a pose never looks up joints by name.
+		auto &trackNames = m_currentAnimation->GetTrackNames();
 
-			previousFrame = allFrames[i];
+		for (auto &jointName : m_skeleton->GetJointNames())
+		{
+			auto it = std::lower_bound(trackNames.begin(), trackNames.end(), jointName);
+			m_jointTracks.emplace_back(it != trackNames.end() && *it == jointName ? static_cast<int32_t>(it - trackNames.begin()) : -1);
 		}
 
-		return {previousFrame, nextFrame};
+		uint32_t trackCount = m_currentAnimation->GetTrackCount();
+		m_positionsX.resize(trackCount);
+		m_positionsY.resize(trackCount);
+		m_positionsZ.resize(trackCount);
+		m_rotationsX.resize(trackCount);
+		m_rotationsY.resize(trackCount);
+		m_rotationsZ.resize(trackCount);
+		m_rotationsW.resize(trackCount);
 	}
 
-	float Animator::CalculateProgression(const Keyframe &previousFrame, const Keyframe &nextFrame)
+	uint32_t Animator::FindPreviousFrame()
 	{
-		float totalTime = nextFrame.GetTimeStamp() - previousFrame.GetTimeStamp();
-		float currentTime = m_animationTime - previousFrame.GetTimeStamp();
-		return currentTime / totalTime;
-	}
+		auto &times = m_currentAnimation->GetTimes();
 
-	std::map<std::string, Matrix4> Animator::InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, const float &progression)
-	{
-		auto currentPose = std::map<std::string, Matrix4>();
+		// The animation usually moves forward by less than a keyframe, so the search starts from the last frame and only restarts once the animation loops.
+		if (m_frame >= times.size() || times[m_frame] > m_animationTime)
+		{
+			m_frame = 0;
+		}
 
-		for (auto &joint : previousFrame.GetPose())
+		while (m_frame + 1 < times.size() && times[m_frame + 1] <= m_animationTime)
 		{
-			JointTransform *previousTransform = previousFrame.GetPose().find(joint.first)->second;
-			JointTransform *nextTransform = nextFrame.GetPose().find(joint.first)->second;
-			JointTransform currentTransform = JointTransform::Interpolate(*previousTransform, *nextTransform, progression);
-			currentPose.emplace(joint.first, currentTransform.GetLocalTransform());
+			m_frame++;
 		}
 
-		return currentPose;
+		return m_frame;
 	}
 
-	void Animator::ApplyPoseToJoints(const std::map<std::string, Matrix4> &currentPose, Joint *joint, const Matrix4 &parentTransform)
+	void Animator::InterpolateTracks(const uint32_t &previousFrame, const uint32_t &nextFrame, const float &progression)
 	{
-		Matrix4 currentLocalTransform = currentPose.find(joint->GetName())->second;
-		Matrix4 currentTransform = parentTransform * currentLocalTransform;
+		uint32_t trackCount = m_currentAnimation->GetTrackCount();
+		const std::vector<float> *keyframeTracks[7] = {
+			&m_currentAnimation->GetPositionsX(), &m_currentAnimation->GetPositionsY(), &m_currentAnimation->GetPositionsZ(),
+			&m_currentAnimation->GetRotationsX(), &m_currentAnimation->GetRotationsY(), &m_currentAnimation->GetRotationsZ(), &m_currentAnimation->GetRotationsW()
+		};
+		float *results[7] = {
+			m_positionsX.data(), m_positionsY.data(), m_positionsZ.data(),
+			m_rotationsX.data(), m_rotationsY.data(), m_rotationsZ.data(), m_rotationsW.data()
+		};
 
-		for (auto &childJoint : joint->GetChildren())
+		TrackPointers tracks = {};
+
+		for (uint32_t i = 0; i < 7; i++)
 		{
-			ApplyPoseToJoints(currentPose, childJoint, currentTransform);
+			tracks.previous[i] = keyframeTracks[i]->data() + (previousFrame * trackCount);
+			tracks.next[i] = keyframeTracks[i]->data() + (nextFrame * trackCount);
+			tracks.result[i] = results[i];
 		}
 
-		currentTransform = currentTransform * joint->GetInverseBindTransform();
-		joint->SetAnimatedTransform(currentTransform);
+		uint32_t i = 0;
+
+#if defined(ACID_ANIMATIONS_SSE)
+		for (; i + TrackLanes::WIDTH <= trackCount; i += TrackLanes::WIDTH)
+		{
+			InterpolateLanes<TrackLanes>(tracks, i, progression);
+		}
+#endif
+
+		for (; i < trackCount; i++)
+		{
+			InterpolateLanes<TrackScalar>(tracks, i, progression);
+		}
 	}
 
-	void Animator::DoAnimation(Animation *animation)
+	void Animator::ComposePose()
 	{
-		m_animationTime = 0.0f;
-		m_currentAnimation = animation;
+		auto &parents = m_skeleton->GetJointParents();
+		auto &indices = m_skeleton->GetJointIndices();
+		auto &localBindTransforms = m_skeleton->GetLocalBindTransforms();
+		auto &inverseBindTransforms = m_skeleton->GetInverseBindTransforms();
+		Matrix4 localTransform = Matrix4();
+
+		for (uint32_t j = 0; j < m_modelTransforms.size(); j++)
+		{
+			int32_t track = m_jointTracks[j];
+
+			if (track == -1)
+			{
+				localTransform = localBindTransforms[j];
+			}
+			else
+			{
+				// The same matrix as the translation of the joint multiplied by its rotation matrix.
+				float x = m_rotationsX[track];
+				float y = m_rotationsY[track];
+				float z = m_rotationsZ[track];
+				float w = m_rotationsW[track];
+				localTransform[0] = Vector4(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - z * w), 2.0f * (x * z + y * w), 0.0f);
+				localTransform[1] = Vector4(2.0f * (x * y + z * w), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - x * w), 0.0f);
+				localTransform[2] = Vector4(2.0f * (x * z - y * w), 2.0f * (y * z + x * w), 1.0f - 2.0f * (x * x + y * y), 0.0f);
+				localTransform[3] = Vector4(m_positionsX[track], m_positionsY[track], m_positionsZ[track], 1.0f);
+			}
+
+			// Parents always come before their children, so the model transform of the parent is already posed.
+			if (parents[j] == -1)
+			{
+				m_modelTransforms[j] = localTransform;
+			}
+			else
+			{
+				MultiplyRows(m_modelTransforms[parents[j]], localTransform, m_modelTransforms[j]);
+			}
+
+			if (indices[j] < m_jointTransforms.size())
+			{
+				MultiplyRows(m_modelTransforms[j], inverseBindTransforms[j], m_jointTransforms[indices[j]]);
+			}
+		}
 	}
 }
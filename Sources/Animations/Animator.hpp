@@ -1,13 +1,15 @@
 #pragma once
 
+#include <memory>
+#include <vector>
 #include "Animation/Animation.hpp"
-#include "Joint/Joint.hpp"
+#include "Skeleton/Skeleton.hpp"
 
 namespace acid
 {
 	/// <summary>
 	/// This class contains all the functionality to apply an animation to an animated entity.
-	/// An Animator instance is associated with just one animated entity.
+	/// An Animator instance is associated with just one animated entity, the skeleton and animation it plays can be shared with other animators.
 	/// It also keeps track of the running time (in seconds) of the current animation,
 	/// along with a reference to the currently playing animation for the corresponding entity.
 	/// <para>
@@ -16,120 +18,93 @@ namespace acid
 	/// The Animator will keep looping the current animation until a new animation is chosen.
 	/// </para>
 	/// <para>
-	/// The Animator calculates the desired current animation pose by interpolating between the previous and next keyframes of the animation
-	/// (based on the current animation time). The Animator then updates the transforms all of the joints each frame to match the current desired animation pose.
+	/// The Animator calculates the desired current animation pose by interpolating every track between the previous and next keyframes of the animation
+	/// (based on the current animation time). The local transforms are then composed into model-space over the flattened joints of the skeleton,
+	/// where every parent is posed before its children.
 	/// </para>
 	/// </summary>
 	class ACID_EXPORT Animator
 	{
 	private:
-		Joint *m_rootJoint;
+		std::shared_ptr<Skeleton> m_skeleton;
+		std::vector<Matrix4> m_jointTransforms;
 
 		float m_animationTime;
-		Animation *m_currentAnimation;
+		uint32_t m_frame;
+		std::shared_ptr<Animation> m_currentAnimation;
+		std::vector<int32_t> m_jointTracks;
+
+		std::vector<float> m_positionsX;
+		std::vector<float> m_positionsY;
+		std::vector<float> m_positionsZ;
+		std::vector<float> m_rotationsX;
+		std::vector<float> m_rotationsY;
+		std::vector<float> m_rotationsZ;
+		std::vector<float> m_rotationsW;
+		std::vector<Matrix4> m_modelTransforms;
 	public:
 		/// <summary>
 		/// Creates a new animator.
 		/// </summary>
-		/// <param name="rootJoint"> The root joint of the joint hierarchy which makes up the "skeleton" of the entity. </param>
-		Animator(Joint *rootJoint);
+		/// <param name="skeleton"> The joint hierarchy which makes up the "skeleton" of the entity. </param>
+		/// <param name="jointCount"> The number of joint transforms to keep, joints with a larger index are not posed. </param>
+		Animator(const std::shared_ptr<Skeleton> &skeleton, const uint32_t &jointCount);
 
 		~Animator();
 
 		/// <summary>
-		/// This method should be called each frame to update the animation currently being played. This increases the animation time (and loops it back to zero if necessary),
-		/// finds the pose that the entity should be in at that time of the animation, and then applied that pose to all the entity's joints.
+		/// This method should be called each frame to update the animation currently being played, it advances the animation by the engine delta.
 		/// </summary>
 		void Update();
 
 		/// <summary>
-		/// Increases the current animation time which allows the animation to progress. If the current animation has reached the end then the timer is reset, causing the animation to loop.
+		/// Advances the animation time (looping it back to zero if necessary), finds the pose that the entity should be in at that time of the animation,
+		/// and then applies that pose to all the entity's joints. Animators only read their shared skeleton and animation, so many can be updated at once.
 		/// </summary>
-		void IncreaseAnimationTime();
+		/// <param name="delta"> The time to advance the animation by. </param>
+		void Update(const float &delta);
 
 		/// <summary>
-		/// This method returns the current animation pose of the entity. It returns
-		/// the desired local-space transforms for all the joints in a map, indexed
-		/// by the name of the joint that they correspond to.
-		/// <para>
-		/// The pose is calculated based on the previous and next keyframes in the
-		/// current animation. Each keyframe provides the desired pose at a certain
-		/// time in the animation, so the animated pose for the current time can be
-		/// calculated by interpolating between the previous and next keyframe.
-		/// </para>
-		/// <para>
-		/// This method first finds the preious and next keyframe, calculates how far
-		/// between the two the current animation is, and then calculated the pose
-		/// for the current animation time by interpolating between the transforms at
-		/// those keyframes.
-		/// </para>
+		/// Updates many animators in parallel batches on the thread pool, and waits for them to finish.
 		/// </summary>
-		/// <returns> The current pose as a map of the desired local-space transforms for all the joints.
-		/// The transforms are indexed by the name ID of the joint that they should be applied to. </returns>
-		std::map<std::string, Matrix4> CalculateCurrentAnimationPose();
+		/// <param name="animators"> The animators to update. </param>
+		/// <param name="delta"> The time to advance the animations by. </param>
+		static void Update(const std::vector<Animator *> &animators, const float &delta);
+
+		std::shared_ptr<Skeleton> GetSkeleton() const { return m_skeleton; }
 
 		/// <summary>
-		/// Finds the previous keyframe in the animation and the next keyframe in the animation, and returns them in an array of length 2.
-		/// If there is no  previous frame (perhaps current animation time is 0.5 and the first keyframe is at time 1.5)
-		/// then the next keyframe is used as both the previous and next keyframe. The reverse happens if there is no next keyframe.
+		/// Gets the transforms that deform the vertices of the skin into the current pose, indexed by joint index.
+		/// Each transform moves its joint from the bind position (in model-space) to the desired animation pose (also in model-space).
 		/// </summary>
-		/// <returns> The previous and next keyframes, in an array which therefore will always have a length of 2. </returns>
-		std::vector<Keyframe *> GetPreviousAndNextFrames();
+		/// <returns> The joint transforms. </returns>
+		const std::vector<Matrix4> &GetJointTransforms() const { return m_jointTransforms; }
+
+		std::shared_ptr<Animation> GetCurrentAnimation() const { return m_currentAnimation; }
 
 		/// <summary>
-		/// Calculates how far between the previous and next keyframe the current animation time is, and returns it as a value between 0 and 1.
+		/// Indicates that the entity should carry out the given animation. Resets the animation time so that the new animation starts from the beginning.
 		/// </summary>
-		/// <param name="previousFrame"> The previous keyframe in the animation. </param>
-		/// <param name="nextFrame"> The next keyframe in the animation.
-		/// </param>
-		/// <returns> A number between 0 and 1 indicating how far between the two keyframes the current animation time is. </returns>
-		float CalculateProgression(const Keyframe &previousFrame, const Keyframe &nextFrame);
-
+		/// <param name="animation"> The new animation to carry out. </param>
+		void DoAnimation(const std::shared_ptr<Animation> &animation);
+	private:
 		/// <summary>
-		/// Calculates all the local-space joint transforms for the desired current pose by interpolating between
-		/// the transforms at the previous and next keyframes.
+		/// Finds the keyframe at or before the current animation time, starting from the last keyframe found as the time usually moves forward.
 		/// </summary>
-		/// <param name="previousFrame"> The previous keyframe in the animation. </param>
-		/// <param name="nextFrame"> The next keyframe in the animation. </param>
-		/// <param name="progression"> A number between 0 and 1 indicating how far between the previous and next keyframes the current animation time is.
-		/// </param>
-		/// <returns> The local-space transforms for all the joints for the desired current pose.
-		/// They are returned in a map, indexed by the name of the joint to which they should be applied. </returns>
-		std::map<std::string, Matrix4> InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, const float &progression);
+		/// <returns> The previous keyframe. </returns>
+		uint32_t FindPreviousFrame();
 
 		/// <summary>
-		/// This method applies the current pose to a given joint, and all of its descendants.
-		/// It does this by getting the desired local-transform for the
-		/// current joint, before applying it to the joint. Before applying the
-		/// transformations it needs to be converted from local-space to model-space
-		/// (so that they are relative to the model's origin, rather than relative to
-		/// the parent joint). This can be done by multiplying the local-transform of
-		/// the joint with the model-space transform of the parent joint.
-		/// <para>
-		/// The same thing is then done to all the child joints.
-		/// </para>
-		/// <para>
-		/// Finally the inverse of the joint's bind transform is multiplied with the
-		/// model-space transform of the joint. This basically "subtracts" the
-		/// joint's original bind (no animation applied) transform from the desired
-		/// pose transform. The result of this is then the transform required to move
-		/// the joint from its original model-space transform to it's desired
-		/// model-space posed transform. This is the transform that needs to be
-		/// loaded up to the vertex shader and used to transform the vertices into
-		/// the current pose.
-		/// </para>
+		/// Interpolates the position and rotation of every track between two keyframes.
 		/// </summary>
-		/// <param name="currentPose"> A map of the local-space transforms for all the joints for the desired pose. The map is indexed by the name of the joint which the transform corresponds to. </param>
-		/// <param name="joint"> The current joint which the pose should be applied to. </param>
-		/// <param name="parentTransform"> The desired model-space transform of the parent joint for the pose. </param>
-		void ApplyPoseToJoints(const std::map<std::string, Matrix4> &currentPose, Joint *joint, const Matrix4 &parentTransform);
-
-		Animation *GetCurrentAnimation() const { return m_currentAnimation; }
+		/// <param name="previousFrame"> The previous keyframe in the animation. </param>
+		/// <param name="nextFrame"> The next keyframe in the animation. </param>
+		/// <param name="progression"> A number between 0 and 1 indicating how far between the previous and next keyframes the current animation time is. </param>
+		void InterpolateTracks(const uint32_t &previousFrame, const uint32_t &nextFrame, const float &progression);
 
 		/// <summary>
-		/// Indicates that the entity should carry out the given animation. Resets the animation time so that the new animation starts from the beginning.
+		/// Composes the interpolated local transforms into model-space, then removes the bind transform of each joint.
 		/// </summary>
-		/// <param name="animation"> The new animation to carry out. </param>
-		void DoAnimation(Animation *animation);
+		void ComposePose();
 	};
 }
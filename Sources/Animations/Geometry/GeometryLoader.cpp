@@ -14,6 +14,8 @@ namespace acid
 		AssembleVertices();
 		RemoveUnusedVertices();
 
+		m_vertices.Reserve(m_positionsList.size());
+
 		for (auto &current : m_positionsList)
 		{
 			Vector3 position = current->GetPosition();
@@ -25,9 +27,7 @@ namespace acid
 			Vector3 jointIds = Vector3(skin->GetJointIds()[0], skin->GetJointIds()[1], skin->GetJointIds()[2]);
 			Vector3 weights = Vector3(skin->GetWeights()[0], skin->GetWeights()[1], skin->GetWeights()[2]);
 
-			VertexAnimated *vertex = new VertexAnimated(position, textures, normal, tangent, jointIds, weights);
-
-			m_vertices.emplace_back(vertex);
+			m_vertices.Add(position, textures, normal, tangent, jointIds, weights);
 
 			delete current;
 		}
@@ -19,14 +19,14 @@ namespace acid
 		std::vector<Vector2> m_uvsList;
 		std::vector<Vector3> m_normalsList;
 
-		std::vector<IVertex *> m_vertices;
+		VertexStream<VertexAnimated> m_vertices;
 		std::vector<uint32_t> m_indices;
 	public:
 		GeometryLoader(LoadedValue *libraryGeometries, const std::vector<VertexSkinData *> &vertexWeights);
 
 		~GeometryLoader();
 
-		std::vector<IVertex *> GetVertices() const { return m_vertices; }
+		const VertexStream<VertexAnimated> &GetVertices() const { return m_vertices; }
 
 		std::vector<uint32_t> GetIndices() const { return m_indices; }
 	private:
@@ -1,15 +1,13 @@
 #pragma once
 
-#include <vector>
 #include "Maths/Vector2.hpp"
 #include "Maths/Vector3.hpp"
-#include "Models/IVertex.hpp"
+#include "Models/VertexStream.hpp"
 #include "Renderer/Pipelines/PipelineCreate.hpp"
 
 namespace acid
 {
-	class ACID_EXPORT VertexAnimated :
-		public IVertex
+	class ACID_EXPORT VertexAnimated
 	{
 	public:
 		Vector3 m_position;
@@ -21,18 +19,10 @@ namespace acid
 
 		VertexAnimated(const Vector3 &position = Vector3::ZERO, const Vector2 &uv = Vector2::ZERO, const Vector3 &normal = Vector3::ZERO, const Vector3 &tangent = Vector3::ZERO, const Vector3 &jointId = Vector3::ZERO, const Vector3 &vertexWeight = Vector3::ZERO);
 
-		VertexAnimated(const VertexAnimated &source);
+		Vector3 GetPosition() const { return m_position; };
 
-		~VertexAnimated();
+		void SetPosition(const Vector3 &position) { m_position = position; };
 
-		Vector3 GetPosition() const override { return m_position; };
-
-		void SetPosition(const Vector3 &position) override { m_position = position; };
-
-		size_t GetSize() const override { return sizeof(VertexAnimated); }
-
-		void *GetData(std::vector<IVertex *> &vertices) override;
-
-		static VertexInput GetVertexInput();
+		static VertexInput GetVertexInput(const uint32_t &binding = 0);
 	};
 }
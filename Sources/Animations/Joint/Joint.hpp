@@ -10,14 +10,9 @@ namespace acid
 	/// It contains the index of the joint which determines where in the vertex shader uniform array the joint matrix for this joint is loaded up to.
 	/// It also contains the name of the bone, and a list of all the child joints.
 	/// <para>
-	/// The "animatedTransform" matrix is the joint transform.
-	/// This is the transform that gets loaded up to the vertex shader and is used to transform vertices.
-	/// It is a model-space transform that transforms the joint from it's bind (original position, no animation applied) position to it's current position in the current pose.
-	/// Changing this transform changes the position/rotation of the joint in the animated entity.
-	/// </para>
-	/// <para>
-	/// The two other matrices are transforms that are required to calculate the "animatedTransform" in the <seealso cref="Animator"/> class.
-	/// It also has the local bind transform which is the original (no pose/animation applied) transform of the joint relative to the parent joint (in bone-space).
+	/// Joints are shared by every animator using a <seealso cref="Skeleton"/>, so the posed transform of a joint is stored by the <seealso cref="Animator"/>.
+	/// The two matrices are transforms that are required to calculate the posed transform.
+	/// It has the local bind transform which is the original (no pose/animation applied) transform of the joint relative to the parent joint (in bone-space).
 	/// </para>
 	/// <para>
 	/// The "localBindTransform" is the original (bind) transform of the joint relative to its parent (in bone-space).
@@ -32,7 +27,6 @@ namespace acid
 		std::vector<Joint *> m_children;
 
 		Matrix4 m_localBindTransform;
-		Matrix4 m_animatedTransform;
 		Matrix4 m_inverseBindTransform;
 	public:
 		/// <summary>
@@ -88,16 +82,6 @@ namespace acid
 
 		void SetLocalBindTransform(const Matrix4 &localBindTransform) { m_localBindTransform = localBindTransform; }
 
-		/// <summary>
-		/// The animated transform is the transform that gets loaded up to the shader and is used to deform the vertices of the "skin". It represents the
-		/// transformation from the joint's bind position (in model-space) to the joint's desired animation pose (also in model-space).
-		/// This matrix is calculated by taking the desired model-space transform of the joint and multiplying it by the inverse of the starting model-space transform of the joint.
-		/// </summary>
-		/// <returns> The transformation matrix of the joint which is used to deform associated vertices of the skin in the shaders. </returns>
-		Matrix4 GetAnimatedTransform() const { return m_animatedTransform; }
-
-		void SetAnimatedTransform(const Matrix4 &animatedTransform) { m_animatedTransform = animatedTransform; }
-
 		/// <summary>
 		/// This returns the inverted model-space bind transform.
 		/// The bind transform is the original model-space transform of the joint (when no animation is applied).
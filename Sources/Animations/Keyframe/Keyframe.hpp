@@ -42,6 +42,6 @@ namespace acid
 		/// indexed by the name of the joint that they correspond to.
 		/// </summary>
 		/// <returns> The desired local-space transforms. </returns>
-		std::map<std::string, JointTransform *> GetPose() const { return m_pose; }
+		const std::map<std::string, JointTransform *> &GetPose() const { return m_pose; }
 	};
 }
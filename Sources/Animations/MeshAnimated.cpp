@@ -2,6 +2,11 @@
 
 #include "Files/Xml/FileXml.hpp"
 #include "Helpers/FileSystem.hpp"
+#include "Animation/AnimationLoader.hpp"
+#include "Geometry/GeometryLoader.hpp"
+#include "Skeleton/SkeletonLoader.hpp"
+#include "Skin/SkinLoader.hpp"
+#include "AnimationCache.hpp"
 
 namespace acid
 {
@@ -13,18 +18,15 @@ namespace acid
 		Mesh(),
 		m_filename(Files::SearchFile(filename)),
 		m_model(nullptr),
-		m_headJoint(nullptr),
-		m_animator(nullptr),
-		m_animation(nullptr)
+		m_skeleton(nullptr),
+		m_animation(nullptr),
+		m_animator(nullptr)
 	{
 		TrySetModel(m_filename);
 	}
 
 	MeshAnimated::~MeshAnimated()
 	{
-		delete m_headJoint;
-		delete m_animation;
-		delete m_animator;
 	}
 
 	void MeshAnimated::Update()
@@ -33,14 +35,6 @@ namespace acid
 		{
 			m_animator->Update();
 		}
-
-		if (m_headJoint != nullptr)
-		{
-			m_jointMatrices.clear();
-			m_jointMatrices.resize(MAX_JOINTS);
-			AddJointsToArray(*m_headJoint, m_jointMatrices);
-			//	m_jointMatrices.shrink_to_fit();
-		}
 	}
 
 	void MeshAnimated::Load(LoadedValue *value)
@@ -55,9 +49,7 @@ namespace acid
 
 	void MeshAnimated::TrySetModel(const std::string &filename)
 	{
-		delete m_animation;
-		delete m_headJoint;
-		delete m_animator;
+		m_animator = nullptr;
 
 		if (!FileSystem::FileExists(filename))
 		{
@@ -65,48 +57,72 @@ namespace acid
 			return;
 		}
 
-		FileXml file = FileXml(filename);
-		file.Load();
-
-		SkinLoader skinLoader = SkinLoader(file.GetParent()->GetChild("COLLADA")->GetChild("library_controllers"), MAX_WEIGHTS);
-		SkeletonLoader skeletonLoader = SkeletonLoader(file.GetParent()->GetChild("COLLADA")->GetChild("library_visual_scenes"), skinLoader.GetJointOrder());
-		GeometryLoader geometryLoader = GeometryLoader(file.GetParent()->GetChild("COLLADA")->GetChild("library_geometries"), skinLoader.GetVerticesSkinData());
+		m_model = std::dynamic_pointer_cast<Model>(Resources::Get()->Get(filename));
+		m_skeleton = std::dynamic_pointer_cast<Skeleton>(Resources::Get()->Get(Skeleton::GetResourceName(filename)));
+		m_animation = std::dynamic_pointer_cast<Animation>(Resources::Get()->Get(Animation::GetResourceName(filename)));
 
-		auto vertices = geometryLoader.GetVertices();
-		auto indices = geometryLoader.GetIndices();
-		m_model = std::make_shared<Model>(vertices, indices, filename);
-		m_headJoint = CreateJoints(skeletonLoader.GetHeadJoint());
-		m_headJoint->CalculateInverseBindTransform(Matrix4());
-		m_animator = new Animator(m_headJoint);
+		if (m_model == nullptr || m_skeleton == nullptr || m_animation == nullptr)
+		{
+			LoadResources(filename);
+		}
 
-		AnimationLoader animationLoader = AnimationLoader(file.GetParent()->GetChild("COLLADA")->GetChild("library_animations"),
-			file.GetParent()->GetChild("COLLADA")->GetChild("library_visual_scenes"));
-		m_animation = new Animation(animationLoader.GetLengthSeconds(), animationLoader.GetKeyframeData());
+		m_animator = std::make_unique<Animator>(m_skeleton, MAX_JOINTS);
 		m_animator->DoAnimation(m_animation);
 	}
 
-	Joint *MeshAnimated::CreateJoints(JointData *data)
+	std::vector<Matrix4> MeshAnimated::GetJointTransforms() const
 	{
-		Joint *j = new Joint(data->GetIndex(), data->GetNameId(), data->GetBindLocalTransform());
-
-		for (auto &child : data->GetChildren())
+		if (m_animator == nullptr)
 		{
-			j->AddChild(CreateJoints(child));
+			return std::vector<Matrix4>(MAX_JOINTS);
 		}
 
-		return j;
+		return m_animator->GetJointTransforms();
 	}
 
-	void MeshAnimated::AddJointsToArray(const Joint &headJoint, std::vector<Matrix4> &jointMatrices)
+	void MeshAnimated::LoadResources(const std::string &filename)
 	{
-		if (headJoint.GetIndex() < jointMatrices.size())
+		auto vertices = VertexStream<VertexAnimated>();
+		auto indices = std::vector<uint32_t>();
+		std::shared_ptr<Skeleton> skeleton = nullptr;
+		std::shared_ptr<Animation> animation = nullptr;
+
+		// The COLLADA XML is only parsed the first time a file is loaded, after that the binary cache is used.
+		if (!AnimationCache::Load(filename, vertices, indices, skeleton, animation))
+		{
+			FileXml file = FileXml(filename);
+			file.Load();
+
+			SkinLoader skinLoader = SkinLoader(file.GetParent()->GetChild("COLLADA")->GetChild("library_controllers"), MAX_WEIGHTS);
+			SkeletonLoader skeletonLoader = SkeletonLoader(file.GetParent()->GetChild("COLLADA")->GetChild("library_visual_scenes"), skinLoader.GetJointOrder());
+			GeometryLoader geometryLoader = GeometryLoader(file.GetParent()->GetChild("COLLADA")->GetChild("library_geometries"), skinLoader.GetVerticesSkinData());
+			AnimationLoader animationLoader = AnimationLoader(file.GetParent()->GetChild("COLLADA")->GetChild("library_animations"),
+				file.GetParent()->GetChild("COLLADA")->GetChild("library_visual_scenes"));
+
+			vertices = geometryLoader.GetVertices();
+			indices = geometryLoader.GetIndices();
+			skeleton = std::make_shared<Skeleton>(filename, *skeletonLoader.GetHeadJoint());
+			animation = std::make_shared<Animation>(filename, animationLoader.GetLengthSeconds(), animationLoader.GetKeyframeData());
+			AnimationCache::Save(filename, vertices, indices, *skeleton, *animation);
+		}
+
+		// Only the missing resources are registered, ones still loaded are kept so existing meshes keep sharing them.
+		if (m_model == nullptr)
+		{
+			m_model = std::make_shared<Model>(vertices, indices, filename);
+			Resources::Get()->Add(m_model);
+		}
+
+		if (m_skeleton == nullptr)
 		{
-			jointMatrices[headJoint.GetIndex()] = headJoint.GetAnimatedTransform();
+			m_skeleton = skeleton;
+			Resources::Get()->Add(m_skeleton);
 		}
 
-		for (auto &childJoint : headJoint.GetChildren())
+		if (m_animation == nullptr)
 		{
-			AddJointsToArray(*childJoint, jointMatrices);
+			m_animation = animation;
+			Resources::Get()->Add(m_animation);
 		}
 	}
 }
@@ -1,18 +1,21 @@
 #pragma once
 
+#include <memory>
 #include "Maths/Maths.hpp"
 #include "Maths/Matrix4.hpp"
 #include "Meshes/Mesh.hpp"
 #include "Objects/IComponent.hpp"
-#include "Animation/AnimationLoader.hpp"
-#include "Geometry/GeometryLoader.hpp"
+#include "Animation/Animation.hpp"
 #include "Geometry/VertexAnimated.hpp"
-#include "Skeleton/SkeletonLoader.hpp"
-#include "Skin/SkinLoader.hpp"
+#include "Skeleton/Skeleton.hpp"
 #include "Animator.hpp"
 
 namespace acid
 {
+	/// <summary>
+	/// A mesh skinned to a skeleton and posed by an animation, both loaded from a COLLADA file.
+	/// The model, skeleton and animation are shared resources, so each mesh only keeps its own pose.
+	/// </summary>
 	class ACID_EXPORT MeshAnimated :
 		public Mesh
 	{
@@ -20,11 +23,9 @@ namespace acid
 		std::string m_filename;
 
 		std::shared_ptr<Model> m_model;
-		Joint *m_headJoint;
-		Animator *m_animator;
-		Animation *m_animation;
-
-		std::vector<Matrix4> m_jointMatrices;
+		std::shared_ptr<Skeleton> m_skeleton;
+		std::shared_ptr<Animation> m_animation;
+		std::unique_ptr<Animator> m_animator;
 	public:
 		static const Matrix4 CORRECTION;
 		static const int MAX_JOINTS;
@@ -48,11 +49,16 @@ namespace acid
 
 		void TrySetModel(const std::string &filename) override;
 
-		std::vector<Matrix4> GetJointTransforms() const { return m_jointMatrices; }
+		std::shared_ptr<Skeleton> GetSkeleton() const { return m_skeleton; }
 
-	private:
-		Joint *CreateJoints(JointData *data);
+		std::shared_ptr<Animation> GetAnimation() const { return m_animation; }
 
-		void AddJointsToArray(const Joint &headJoint, std::vector<Matrix4> &jointMatrices);
+		/// <summary>
+		/// Gets the joint transforms of the current pose, indexed by joint index.
+		/// </summary>
+		/// <returns> The joint transforms, <see cref="MAX_JOINTS"/> long. </returns>
+		std::vector<Matrix4> GetJointTransforms() const;
+	private:
+		void LoadResources(const std::string &filename);
 	};
 }
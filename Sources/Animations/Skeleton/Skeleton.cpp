@@ -0,0 +1,69 @@
+#include "Skeleton.hpp"
+
+namespace acid
+{
+	Skeleton::Skeleton(const std::string &filename, Joint *headJoint) :
+		m_filename(GetResourceName(filename)),
+		m_headJoint(headJoint),
+		m_jointCount(0),
+		m_jointNames(std::vector<std::string>()),
+		m_jointParents(std::vector<int32_t>()),
+		m_jointIndices(std::vector<uint32_t>()),
+		m_localBindTransforms(std::vector<Matrix4>()),
+		m_inverseBindTransforms(std::vector<Matrix4>())
+	{
+		m_headJoint->CalculateInverseBindTransform(Matrix4());
+		Flatten(*m_headJoint, -1);
+		m_jointCount = static_cast<uint32_t>(m_jointNames.size());
+	}
+
+	Skeleton::Skeleton(const std::string &filename, const JointData &headJointData) :
+		Skeleton(filename, CreateJoints(headJointData))
+	{
+	}
+
+	Skeleton::~Skeleton()
+	{
+	}
+
+	int32_t Skeleton::FindJoint(const std::string &name) const
+	{
+		for (uint32_t i = 0; i < m_jointNames.size(); i++)
+		{
+			if (m_jointNames[i] == name)
+			{
+				return static_cast<int32_t>(i);
+			}
+		}
+
+		return -1;
+	}
+
+	Joint *Skeleton::CreateJoints(const JointData &data)
+	{
+		Joint *joint = new Joint(data.GetIndex(), data.GetNameId(), data.GetBindLocalTransform());
+
+		for (auto &child : data.GetChildren())
+		{
+			joint->AddChild(CreateJoints(*child));
+		}
+
+		return joint;
+	}
+
+	void Skeleton::Flatten(const Joint &joint, const int32_t &parent)
+	{
+		// Joints are added depth first, so every parent is added before its children.
+		auto index = static_cast<int32_t>(m_jointNames.size());
+		m_jointNames.emplace_back(joint.GetName());
+		m_jointParents.emplace_back(parent);
+		m_jointIndices.emplace_back(joint.GetIndex());
+		m_localBindTransforms.emplace_back(joint.GetLocalBindTransform());
+		m_inverseBindTransforms.emplace_back(joint.GetInverseBindTransform());
+
+		for (auto &child : joint.GetChildren())
+		{
+			Flatten(*child, index);
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Animations/Joint/Joint.hpp"
+#include "Animations/Joint/JointData.hpp"
+#include "Resources/IResource.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// The joint hierarchy and bind pose of an animated model, shared between every mesh animated from the same file.
+	/// The skeleton is never posed, each <see cref="Animator"/> keeps its own joint transforms.
+	/// The joints are also stored flattened in parent before child order, so a pose can be composed in a single loop.
+	/// </summary>
+	class ACID_EXPORT Skeleton :
+		public IResource
+	{
+	private:
+		std::string m_filename;
+		std::unique_ptr<Joint> m_headJoint;
+		uint32_t m_jointCount;
+
+		std::vector<std::string> m_jointNames;
+		std::vector<int32_t> m_jointParents;
+		std::vector<uint32_t> m_jointIndices;
+		std::vector<Matrix4> m_localBindTransforms;
+		std::vector<Matrix4> m_inverseBindTransforms;
+	public:
+		/// <summary>
+		/// Gets the name a skeleton loaded from a file is registered in <see cref="Resources"/> as.
+		/// </summary>
+		/// <param name="filename"> The file the skeleton was loaded from. </param>
+		/// <returns> The resource name. </returns>
+		static std::string GetResourceName(const std::string &filename) { return filename + "#Skeleton"; }
+
+		/// <summary>
+		/// Creates a new skeleton from a joint hierarchy, and calculates the inverse bind transforms of the joints.
+		/// </summary>
+		/// <param name="filename"> The file the skeleton was loaded from. </param>
+		/// <param name="headJoint"> The root joint, the skeleton takes ownership of the hierarchy. </param>
+		Skeleton(const std::string &filename, Joint *headJoint);
+
+		/// <summary>
+		/// Creates a new skeleton from loaded joint data.
+		/// </summary>
+		/// <param name="filename"> The file the skeleton was loaded from. </param>
+		/// <param name="headJointData"> The root joint data. </param>
+		Skeleton(const std::string &filename, const JointData &headJointData);
+
+		~Skeleton();
+
+		std::string GetFilename() override { return m_filename; }
+
+		const Joint *GetHeadJoint() const { return m_headJoint.get(); }
+
+		uint32_t GetJointCount() const { return m_jointCount; }
+
+		/// <summary>
+		/// Finds a joint in the flattened order by its name.
+		/// </summary>
+		/// <param name="name"> The joint name. </param>
+		/// <returns> The flattened joint, or -1 if there is no joint with the name. </returns>
+		int32_t FindJoint(const std::string &name) const;
+
+		const std::vector<std::string> &GetJointNames() const { return m_jointNames; }
+
+		/// <summary>
+		/// Gets the parent of each flattened joint, a parent always comes before its children.
+		/// </summary>
+		/// <returns> The flattened parent of each joint, -1 for the root. </returns>
+		const std::vector<int32_t> &GetJointParents() const { return m_jointParents; }
+
+		/// <summary>
+		/// Gets the index of each flattened joint, the index is where the joint transform is loaded in the vertex shader.
+		/// </summary>
+		/// <returns> The joint indices. </returns>
+		const std::vector<uint32_t> &GetJointIndices() const { return m_jointIndices; }
+
+		const std::vector<Matrix4> &GetLocalBindTransforms() const { return m_localBindTransforms; }
+
+		const std::vector<Matrix4> &GetInverseBindTransforms() const { return m_inverseBindTransforms; }
+	private:
+		static Joint *CreateJoints(const JointData &data);
+
+		void Flatten(const Joint &joint, const int32_t &parent);
+	};
+}
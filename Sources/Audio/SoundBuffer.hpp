@@ -34,6 +34,15 @@ namespace acid
 			return result;
 		}
 
+		static ResourceFuture<SoundBuffer> ResourceAsync(const std::string &filename)
+		{
+			std::string realFilename = Files::SearchFile(filename);
+			return Resources::Get()->LoadAsync<SoundBuffer>(realFilename, [realFilename]()
+			{
+				return std::make_shared<SoundBuffer>(realFilename);
+			});
+		}
+
 		SoundBuffer(const std::string &filename);
 
 		~SoundBuffer();
@@ -2,6 +2,7 @@ set(ACID_HEADERS_
         "Acid.hpp"
         "Animations/Animation/Animation.hpp"
         "Animations/Animation/AnimationLoader.hpp"
+        "Animations/AnimationCache.hpp"
         "Animations/Animator.hpp"
         "Animations/Geometry/GeometryLoader.hpp"
         "Animations/Geometry/VertexAnimated.hpp"
@@ -13,6 +14,7 @@ set(ACID_HEADERS_
         "Animations/Keyframe/Keyframe.hpp"
         "Animations/Keyframe/KeyframeData.hpp"
         "Animations/MeshAnimated.hpp"
+        "Animations/Skeleton/Skeleton.hpp"
         "Animations/Skeleton/SkeletonLoader.hpp"
         "Animations/Skin/SkinLoader.hpp"
         "Animations/Skin/VertexSkinData.hpp"
@@ -50,8 +52,11 @@ set(ACID_HEADERS_
         "Fonts/Text.hpp"
         "Guis/Gui.hpp"
         "Guis/RendererGuis.hpp"
+        "Helpers/CacheFile.hpp"
         "Helpers/FileSystem.hpp"
         "Helpers/FormatString.hpp"
+        "Helpers/MappedFile.hpp"
+        "Helpers/RadixSort.hpp"
         "Helpers/SquareArray.hpp"
         "Inputs/AxisButton.hpp"
         "Inputs/AxisCompound.hpp"
@@ -69,6 +74,7 @@ set(ACID_HEADERS_
         "Lights/Light.hpp"
         "Materials/IMaterial.hpp"
         "Materials/MaterialDefault.hpp"
+        "Materials/MaterialInstance.hpp"
         "Materials/PipelineMaterial.hpp"
         "Maths/Colour.hpp"
         "Maths/Delta.hpp"
@@ -93,7 +99,7 @@ set(ACID_HEADERS_
         "Meshes/Mesh.hpp"
         "Meshes/MeshRender.hpp"
         "Meshes/RendererMeshes.hpp"
-        "Models/IVertex.hpp"
+        "Models/MeshCache.hpp"
         "Models/Model.hpp"
         "Models/Obj/ModelObj.hpp"
         "Models/Shapes/MeshPattern.hpp"
@@ -104,14 +110,19 @@ set(ACID_HEADERS_
         "Models/Shapes/ModelRectangle.hpp"
         "Models/Shapes/ModelSphere.hpp"
         "Models/VertexModel.hpp"
-        "Models/VertexModelData.hpp"
+        "Models/VertexStream.hpp"
         "Noise/Noise.hpp"
+        "Objects/ComponentPools.hpp"
         "Objects/ComponentRegister.hpp"
         "Objects/GameObject.hpp"
         "Objects/IBehaviour.hpp"
         "Objects/IComponent.hpp"
         "Objects/Prefabs/PrefabObject.hpp"
         "Particles/Particle.hpp"
+        "Particles/ParticleInstance.hpp"
+        "Particles/ParticlePool.hpp"
+        "Particles/ParticlePoolGpu.hpp"
+        "Particles/ParticleSpawnRequest.hpp"
         "Particles/Particles.hpp"
         "Particles/ParticleSystem.hpp"
         "Particles/ParticleType.hpp"
@@ -121,6 +132,7 @@ set(ACID_HEADERS_
         "Particles/Spawns/SpawnLine.hpp"
         "Particles/Spawns/SpawnPoint.hpp"
         "Particles/Spawns/SpawnSphere.hpp"
+        "Physics/Aabb.hpp"
         "Physics/Collider.hpp"
         "Physics/ColliderBox.hpp"
         "Physics/ColliderCapsule.hpp"
@@ -131,6 +143,8 @@ set(ACID_HEADERS_
         "Physics/ColliderSphere.hpp"
         "Physics/Force.hpp"
         "Physics/Frustum.hpp"
+        "Physics/MotionState.hpp"
+        "Physics/PhysicsScheduler.hpp"
         "Physics/Ray.hpp"
         "Physics/Rigidbody.hpp"
         "Post/Deferred/RendererDeferred.hpp"
@@ -155,20 +169,32 @@ set(ACID_HEADERS_
         "Post/Pipelines/PipelineGaussian.hpp"
         "Renderer/Buffers/Buffer.hpp"
         "Renderer/Buffers/IndexBuffer.hpp"
+        "Renderer/Buffers/InstanceBuffer.hpp"
+        "Renderer/Buffers/StorageBuffer.hpp"
         "Renderer/Buffers/UniformBuffer.hpp"
+        "Renderer/Buffers/UniformRing.hpp"
         "Renderer/Buffers/VertexBuffer.hpp"
         "Renderer/Commands/CommandBuffer.hpp"
+        "Renderer/Commands/CommandPool.hpp"
         "Renderer/Descriptors/DescriptorSet.hpp"
         "Renderer/Descriptors/IDescriptor.hpp"
         "Renderer/Handlers/DescriptorsHandler.hpp"
         "Renderer/Handlers/UniformHandler.hpp"
         "Renderer/IManagerRender.hpp"
         "Renderer/IRenderer.hpp"
+        "Renderer/Memory/BuddyAllocator.hpp"
+        "Renderer/Memory/LinearAllocator.hpp"
+        "Renderer/Memory/MemoryAllocator.hpp"
+        "Renderer/Memory/RingAllocator.hpp"
+        "Renderer/Memory/Uploader.hpp"
         "Renderer/Pipelines/Compute.hpp"
         "Renderer/Pipelines/IPipeline.hpp"
         "Renderer/Pipelines/Pipeline.hpp"
+        "Renderer/Pipelines/PipelineCache.hpp"
         "Renderer/Pipelines/PipelineCreate.hpp"
+        "Renderer/Pipelines/ShaderCache.hpp"
         "Renderer/Pipelines/ShaderProgram.hpp"
+        "Renderer/RenderQueue.hpp"
         "Renderer/Renderer.hpp"
         "Renderer/Renderpass/Renderpass.hpp"
         "Renderer/Renderpass/RenderpassCreate.hpp"
@@ -177,7 +203,9 @@ set(ACID_HEADERS_
         "Renderer/Swapchain/Framebuffers.hpp"
         "Renderer/Swapchain/Swapchain.hpp"
         "Resources/IResource.hpp"
+        "Resources/ResourceFuture.hpp"
         "Resources/Resources.hpp"
+        "Scenes/DynamicTree.hpp"
         "Scenes/ICamera.hpp"
         "Scenes/IScene.hpp"
         "Scenes/ISpatialStructure.hpp"
@@ -193,8 +221,9 @@ set(ACID_HEADERS_
         "Textures/stb_image.h"
         "Textures/stb_image_write.h"
         "Textures/Texture.hpp"
-        "Threads/Thread.hpp"
+        "Threads/Job.hpp"
         "Threads/ThreadPool.hpp"
+        "Threads/WorkStealingDeque.hpp"
         "Uis/UiBound.hpp"
         "Uis/UiInputButton.hpp"
         "Uis/UiInputDelay.hpp"
@@ -210,6 +239,7 @@ set(ACID_HEADERS_
 set(ACID_SOURCES_
         "Animations/Animation/Animation.cpp"
         "Animations/Animation/AnimationLoader.cpp"
+        "Animations/AnimationCache.cpp"
         "Animations/Animator.cpp"
         "Animations/Geometry/GeometryLoader.cpp"
         "Animations/Geometry/VertexAnimated.cpp"
@@ -221,6 +251,7 @@ set(ACID_SOURCES_
         "Animations/Keyframe/Keyframe.cpp"
         "Animations/Keyframe/KeyframeData.cpp"
         "Animations/MeshAnimated.cpp"
+        "Animations/Skeleton/Skeleton.cpp"
         "Animations/Skeleton/SkeletonLoader.cpp"
         "Animations/Skin/SkinLoader.cpp"
         "Animations/Skin/VertexSkinData.cpp"
@@ -253,8 +284,11 @@ set(ACID_SOURCES_
         "Fonts/Text.cpp"
         "Guis/Gui.cpp"
         "Guis/RendererGuis.cpp"
+        "Helpers/CacheFile.cpp"
         "Helpers/FileSystem.cpp"
         "Helpers/FormatString.cpp"
+        "Helpers/MappedFile.cpp"
+        "Helpers/RadixSort.cpp"
         "Helpers/SquareArray.cpp"
         "Inputs/AxisButton.cpp"
         "Inputs/AxisCompound.cpp"
@@ -269,6 +303,7 @@ set(ACID_SOURCES_
         "Lights/Fog.cpp"
         "Lights/Light.cpp"
         "Materials/MaterialDefault.cpp"
+        "Materials/MaterialInstance.cpp"
         "Materials/PipelineMaterial.cpp"
         "Maths/Colour.cpp"
         "Maths/Delta.cpp"
@@ -292,6 +327,7 @@ set(ACID_SOURCES_
         "Meshes/Mesh.cpp"
         "Meshes/MeshRender.cpp"
         "Meshes/RendererMeshes.cpp"
+        "Models/MeshCache.cpp"
         "Models/Model.cpp"
         "Models/Obj/ModelObj.cpp"
         "Models/Shapes/MeshPattern.cpp"
@@ -302,12 +338,15 @@ set(ACID_SOURCES_
         "Models/Shapes/ModelRectangle.cpp"
         "Models/Shapes/ModelSphere.cpp"
         "Models/VertexModel.cpp"
-        "Models/VertexModelData.cpp"
         "Noise/Noise.cpp"
+        "Objects/ComponentPools.cpp"
         "Objects/ComponentRegister.cpp"
         "Objects/GameObject.cpp"
         "Objects/Prefabs/PrefabObject.cpp"
         "Particles/Particle.cpp"
+        "Particles/ParticleInstance.cpp"
+        "Particles/ParticlePool.cpp"
+        "Particles/ParticlePoolGpu.cpp"
         "Particles/Particles.cpp"
         "Particles/ParticleSystem.cpp"
         "Particles/ParticleType.cpp"
@@ -316,6 +355,7 @@ set(ACID_SOURCES_
         "Particles/Spawns/SpawnLine.cpp"
         "Particles/Spawns/SpawnPoint.cpp"
         "Particles/Spawns/SpawnSphere.cpp"
+        "Physics/Aabb.cpp"
         "Physics/Collider.cpp"
         "Physics/ColliderBox.cpp"
         "Physics/ColliderCapsule.cpp"
@@ -326,6 +366,8 @@ set(ACID_SOURCES_
         "Physics/ColliderSphere.cpp"
         "Physics/Force.cpp"
         "Physics/Frustum.cpp"
+        "Physics/MotionState.cpp"
+        "Physics/PhysicsScheduler.cpp"
         "Physics/Ray.cpp"
         "Physics/Rigidbody.cpp"
         "Post/Deferred/RendererDeferred.cpp"
@@ -350,16 +392,28 @@ set(ACID_SOURCES_
         "Post/Pipelines/PipelineGaussian.cpp"
         "Renderer/Buffers/Buffer.cpp"
         "Renderer/Buffers/IndexBuffer.cpp"
+        "Renderer/Buffers/InstanceBuffer.cpp"
+        "Renderer/Buffers/StorageBuffer.cpp"
         "Renderer/Buffers/UniformBuffer.cpp"
+        "Renderer/Buffers/UniformRing.cpp"
         "Renderer/Buffers/VertexBuffer.cpp"
         "Renderer/Commands/CommandBuffer.cpp"
+        "Renderer/Commands/CommandPool.cpp"
         "Renderer/Descriptors/DescriptorSet.cpp"
         "Renderer/Handlers/DescriptorsHandler.cpp"
         "Renderer/Handlers/UniformHandler.cpp"
         "Renderer/IManagerRender.cpp"
+        "Renderer/Memory/BuddyAllocator.cpp"
+        "Renderer/Memory/LinearAllocator.cpp"
+        "Renderer/Memory/MemoryAllocator.cpp"
+        "Renderer/Memory/RingAllocator.cpp"
+        "Renderer/Memory/Uploader.cpp"
         "Renderer/Pipelines/Compute.cpp"
         "Renderer/Pipelines/Pipeline.cpp"
+        "Renderer/Pipelines/PipelineCache.cpp"
+        "Renderer/Pipelines/ShaderCache.cpp"
         "Renderer/Pipelines/ShaderProgram.cpp"
+        "Renderer/RenderQueue.cpp"
         "Renderer/Renderer.cpp"
         "Renderer/Renderpass/Renderpass.cpp"
         "Renderer/RenderStage.cpp"
@@ -367,6 +421,7 @@ set(ACID_SOURCES_
         "Renderer/Swapchain/Framebuffers.cpp"
         "Renderer/Swapchain/Swapchain.cpp"
         "Resources/Resources.cpp"
+        "Scenes/DynamicTree.cpp"
         "Scenes/ScenePhysics.cpp"
         "Scenes/Scenes.cpp"
         "Scenes/SceneStructure.cpp"
@@ -377,7 +432,6 @@ set(ACID_SOURCES_
         "Skyboxes/MaterialSkybox.cpp"
         "Textures/Cubemap.cpp"
         "Textures/Texture.cpp"
-        "Threads/Thread.cpp"
         "Threads/ThreadPool.cpp"
         "Uis/UiBound.cpp"
         "Uis/UiInputButton.cpp"
@@ -96,6 +96,12 @@ namespace acid
 		template<typename T>
 		bool DeregisterModule() { return m_moduleRegister.DeregisterModule<T>(); }
 
+		/// <summary>
+		/// Gets the module register, used to declare module dependencies and how modules are updated.
+		/// </summary>
+		/// <returns> The module register. </returns>
+		ModuleRegister &GetModuleRegister() { return m_moduleRegister; }
+
 		/// <summary>
 		/// Gets the added/removed time for the engine (seconds).
 		/// </summary>
@@ -1,5 +1,6 @@
 #include "ModuleRegister.hpp"
 
+#include <algorithm>
 #include "Audio/Audio.hpp"
 #include "Display/Display.hpp"
 #include "Events/Events.hpp"
@@ -8,53 +9,106 @@
 #include "Inputs/Keyboard.hpp"
 #include "Inputs/Mouse.hpp"
 #include "Particles/Particles.hpp"
+#include "Renderer/Memory/MemoryAllocator.hpp"
+#include "Renderer/Memory/Uploader.hpp"
 #include "Renderer/Renderer.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Shadows/Shadows.hpp"
+#include "Threads/ThreadPool.hpp"
 #include "Uis/Uis.hpp"
 
 namespace acid
 {
+	std::map<std::type_index, uint32_t> ModuleRegister::TYPE_IDS = std::map<std::type_index, uint32_t>();
+	std::mutex ModuleRegister::TYPE_MUTEX = {};
+
+	uint32_t ModuleRegister::GetTypeId(const std::type_index &type)
+	{
+		std::lock_guard<std::mutex> lock(TYPE_MUTEX);
+		return TYPE_IDS.emplace(type, static_cast<uint32_t>(TYPE_IDS.size())).first->second;
+	}
+
 	ModuleRegister::ModuleRegister() :
-		m_modules(std::map<float, IModule *>())
+		m_modules(std::map<std::pair<ModuleUpdate, uint32_t>, uint32_t>()),
+		m_slots(std::vector<IModule *>()),
+		m_registrations(0),
+		m_dependencies(std::map<uint32_t, std::set<uint32_t>>()),
+		m_concurrent(std::set<uint32_t>()),
+		m_schedules(std::map<ModuleUpdate, std::vector<ModuleTask>>()),
+		m_parallel(true)
 	{
 	}
 
 	ModuleRegister::~ModuleRegister()
 	{
-		for (auto it = --m_modules.end(); it != m_modules.begin(); --it)
+		// Modules are deleted in the reverse order they were registered, the display and memory allocator outlive every module that owns GPU objects.
+		auto registrations = std::map<uint32_t, uint32_t>();
+
+		for (auto &[key, typeId] : m_modules)
 		{
-			delete (*it).second;
+			registrations.emplace(key.second, typeId);
+		}
+
+		// Slots are cleared as modules are deleted, so later modules see deleted modules as missing.
+		for (auto it = registrations.rbegin(); it != registrations.rend(); ++it)
+		{
+			delete m_slots[(*it).second];
+			m_slots[(*it).second] = nullptr;
 		}
 	}
 
 	void ModuleRegister::FillRegister()
 	{
+		RegisterModule<ThreadPool>(UPDATE_ALWAYS);
 		RegisterModule<Display>(UPDATE_POST);
+		RegisterModule<MemoryAllocator>(UPDATE_POST);
 		RegisterModule<Joysticks>(UPDATE_PRE);
 		RegisterModule<Keyboard>(UPDATE_PRE);
 		RegisterModule<Mouse>(UPDATE_PRE);
 		RegisterModule<Audio>(UPDATE_PRE);
 		RegisterModule<Files>(UPDATE_PRE);
-		RegisterModule<Scenes>(UPDATE_NORMAL);
-		RegisterModule<Renderer>(UPDATE_RENDER);
+		// Modules are deleted in reverse, scenes are deleted while the renderer can still defer destroying their objects,
+		// and resources once the renderer has destroyed the pipelines that use them.
 		RegisterModule<Resources>(UPDATE_PRE);
+		RegisterModule<Uploader>(UPDATE_RENDER);
+		RegisterModule<Renderer>(UPDATE_RENDER);
+		RegisterModule<Scenes>(UPDATE_NORMAL);
 		RegisterModule<Events>(UPDATE_ALWAYS);
 		RegisterModule<Uis>(UPDATE_PRE);
 		RegisterModule<Particles>(UPDATE_NORMAL);
 		RegisterModule<Shadows>(UPDATE_NORMAL);
+
+		// Modules that only touch their own data, or data behind locks, are updated as jobs.
+		// Resources stays on the main thread, its upload callbacks record on the renderers command pool.
+		SetConcurrent<Mouse>(true);
+		SetConcurrent<Audio>(true);
+		SetConcurrent<Particles>(true);
+		SetConcurrent<Shadows>(true);
+
+		AddDependency<Uis, Joysticks>();
+		AddDependency<Uis, Mouse>();
+		AddDependency<Particles, Scenes>();
+		AddDependency<Shadows, Scenes>();
+		AddDependency<Renderer, Uploader>();
 	}
 
-	IModule *ModuleRegister::RegisterModule(IModule *module, const ModuleUpdate &update)
+	IModule *ModuleRegister::RegisterModule(IModule *module, const ModuleUpdate &update, const uint32_t &typeId)
 	{
-		if (ContainsModule(module))
+		if (ContainsModule(module) || (typeId < m_slots.size() && m_slots[typeId] != nullptr))
 		{
 			fprintf(stderr, "Module '%i' is already registered!\n", update);
 			return nullptr;
 		}
 
-		float offset = update + (0.01f * static_cast<float>(m_modules.size()));
-		m_modules.emplace(offset, module);
+		if (typeId >= m_slots.size())
+		{
+			m_slots.resize(typeId + 1, nullptr);
+		}
+
+		// Modules of the same update type are updated in the order they were registered, unless a dependency says otherwise.
+		m_modules.emplace(std::make_pair(update, m_registrations++), typeId);
+		m_slots[typeId] = module;
+		BuildSchedules();
 		return module;
 	}
 
@@ -62,7 +116,7 @@ namespace acid
 	{
 		for (auto &module1 : m_modules)
 		{
-			if (module1.second == module)
+			if (m_slots[module1.second] == module)
 			{
 				return true;
 			}
@@ -73,15 +127,17 @@ namespace acid
 
 	bool ModuleRegister::DeregisterModule(IModule *module)
 	{
-		for (auto it = --m_modules.end(); it != m_modules.begin(); --it)
+		for (auto it = m_modules.begin(); it != m_modules.end(); ++it)
 		{
-			if ((*it).second != module)
+			if (m_slots[(*it).second] != module)
 			{
 				continue;
 			}
 
+			m_slots[(*it).second] = nullptr;
 			m_modules.erase(it);
-			delete (*it).second;
+			BuildSchedules();
+			delete module;
 			return true;
 		}
 
@@ -90,11 +146,158 @@ namespace acid
 
 	void ModuleRegister::RunUpdate(const ModuleUpdate &update) const
 	{
-		for (auto &module : m_modules)
+		auto schedule = m_schedules.find(update);
+
+		if (schedule == m_schedules.end())
+		{
+			return;
+		}
+
+		auto &tasks = (*schedule).second;
+		ThreadPool *threadPool = m_parallel ? GetModule<ThreadPool>() : nullptr;
+
+		if (threadPool == nullptr)
+		{
+			for (auto &task : tasks)
+			{
+				task.module->Update();
+			}
+
+			return;
+		}
+
+		std::vector<JobHandle> handles(tasks.size());
+		std::vector<JobHandle> running = {};
+
+		for (uint32_t i = 0; i < tasks.size(); i++)
+		{
+			auto &task = tasks[i];
+
+			// Modules that are not concurrent may touch anything, so they wait for every running job and are updated on this thread.
+			if (!task.concurrent)
+			{
+				for (auto &handle : running)
+				{
+					threadPool->Wait(handle);
+				}
+
+				running.clear();
+				task.module->Update();
+				continue;
+			}
+
+			std::vector<JobHandle> dependencies = {};
+
+			for (auto &dependency : task.dependencies)
+			{
+				dependencies.emplace_back(handles[dependency]);
+			}
+
+			IModule *module = task.module;
+			handles[i] = threadPool->Run([module]()
+			{
+				module->Update();
+			}, dependencies);
+			running.emplace_back(handles[i]);
+		}
+
+		for (auto &handle : running)
+		{
+			threadPool->Wait(handle);
+		}
+	}
+
+	void ModuleRegister::AddDependency(const uint32_t &typeId, const uint32_t &dependency)
+	{
+		m_dependencies[typeId].emplace(dependency);
+		BuildSchedules();
+	}
+
+	void ModuleRegister::SetConcurrent(const uint32_t &typeId, const bool &concurrent)
+	{
+		if (concurrent)
 		{
-			if (static_cast<int>(std::floor(module.first)) == update)
+			m_concurrent.emplace(typeId);
+		}
+		else
+		{
+			m_concurrent.erase(typeId);
+		}
+
+		BuildSchedules();
+	}
+
+	void ModuleRegister::BuildSchedules()
+	{
+		m_schedules.clear();
+		auto phases = std::map<ModuleUpdate, std::vector<uint32_t>>();
+
+		for (auto &[key, typeId] : m_modules)
+		{
+			phases[key.first].emplace_back(typeId);
+		}
+
+		for (auto &[update, typeIds] : phases)
+		{
+			auto &tasks = m_schedules[update];
+			auto taskIndices = std::map<uint32_t, uint32_t>();
+
+			while (tasks.size() < typeIds.size())
 			{
-				module.second->Update();
+				// Takes the first module in registration order whose dependencies in this update type are all scheduled.
+				uint32_t next = 0;
+				bool found = false;
+
+				for (uint32_t i = 0; i < typeIds.size() && !found; i++)
+				{
+					if (taskIndices.find(typeIds[i]) != taskIndices.end())
+					{
+						continue;
+					}
+
+					bool ready = true;
+
+					for (auto &dependency : m_dependencies[typeIds[i]])
+					{
+						if (taskIndices.find(dependency) == taskIndices.end() && std::find(typeIds.begin(), typeIds.end(), dependency) != typeIds.end())
+						{
+							ready = false;
+							break;
+						}
+					}
+
+					if (ready)
+					{
+						next = i;
+						found = true;
+					}
+				}
+
+				if (!found)
+				{
+					fprintf(stderr, "Module dependencies in update '%i' form a cycle!\n", update);
+
+					while (taskIndices.find(typeIds[next]) != taskIndices.end())
+					{
+						next++;
+					}
+				}
+
+				uint32_t typeId = typeIds[next];
+				ModuleTask task = {m_slots[typeId], m_concurrent.find(typeId) != m_concurrent.end(), {}};
+
+				for (auto &dependency : m_dependencies[typeId])
+				{
+					auto it = taskIndices.find(dependency);
+
+					if (it != taskIndices.end())
+					{
+						task.dependencies.emplace_back((*it).second);
+					}
+				}
+
+				taskIndices.emplace(typeId, static_cast<uint32_t>(tasks.size()));
+				tasks.emplace_back(task);
 			}
 		}
 	}
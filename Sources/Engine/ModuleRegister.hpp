@@ -1,18 +1,65 @@
 #pragma once
 
 #include <map>
+#include <mutex>
+#include <set>
+#include <typeindex>
+#include <utility>
+#include <vector>
 #include "IModule.hpp"
 
 namespace acid
 {
 	/// <summary>
 	/// The default updater for the engine.
+	/// Modules are found by a type id, each registered module fills the slot of its type so a lookup is a single index.
+	/// <para>
+	/// Each update type is scheduled as a task graph. Concurrent modules are updated as jobs once the modules they depend on are updated,
+	/// other modules are updated on the calling thread after every running job has finished.
+	/// </para>
 	/// </summary>
 	class ACID_EXPORT ModuleRegister
 	{
 	private:
-		std::map<float, IModule *> m_modules;
+		struct ModuleTask
+		{
+			IModule *module;
+			bool concurrent;
+			std::vector<uint32_t> dependencies;
+		};
+
+		static std::map<std::type_index, uint32_t> TYPE_IDS;
+		static std::mutex TYPE_MUTEX;
+
+		std::map<std::pair<ModuleUpdate, uint32_t>, uint32_t> m_modules;
+		std::vector<IModule *> m_slots;
+		uint32_t m_registrations;
+
+		std::map<uint32_t, std::set<uint32_t>> m_dependencies;
+		std::set<uint32_t> m_concurrent;
+		std::map<ModuleUpdate, std::vector<ModuleTask>> m_schedules;
+		bool m_parallel;
 	public:
+		/// <summary>
+		/// Gets the id of a module type, ids are assigned in the order types are first used.
+		/// </summary>
+		/// <param name="type"> The module type. </param>
+		/// <returns> The type id. </returns>
+		static uint32_t GetTypeId(const std::type_index &type);
+
+		/// <summary>
+		/// Gets the id of a module type, the id is only looked up the first time it is used.
+		/// </summary>
+		/// <param name="T"> The module type. </param>
+		/// <returns> The type id. </returns>
+		template<typename T>
+		static uint32_t GetTypeId()
+		{
+			// Ids are kept by the register so every binary agrees on them, each binary only caches its own copy.
+			static const uint32_t typeId = GetTypeId(std::type_index(typeid(T)));
+			return typeId;
+		}
+
 		/// <summary>
 		/// Creates a new module register.
 		/// </summary>
@@ -43,17 +90,14 @@ namespace acid
 		template<typename T>
 		T *GetModule() const
 		{
-			for (auto &module : m_modules)
-			{
-				auto casted = dynamic_cast<T *>(module.second);
+			uint32_t typeId = GetTypeId<T>();
 
-				if (casted != nullptr)
-				{
-					return casted;
-				}
+			if (typeId >= m_slots.size())
+			{
+				return nullptr;
 			}
 
-			return nullptr;
+			return static_cast<T *>(m_slots[typeId]);
 		}
 
 		/// <summary>
@@ -61,8 +105,9 @@ namespace acid
 		/// </summary>
 		/// <param name="module"> The modules object. </param>
 		/// <param name="update"> The modules update type. </param>
+		/// <param name="typeId"> The type id the module is found by. </param>
 		/// <returns> The registered module. </returns>
-		IModule *RegisterModule(IModule *module, const ModuleUpdate &update);
+		IModule *RegisterModule(IModule *module, const ModuleUpdate &update, const uint32_t &typeId);
 
 		/// <summary>
 		/// Registers a module with the register.
@@ -74,7 +119,13 @@ namespace acid
 		T *RegisterModule(const ModuleUpdate &update)
 		{
 			T *module = static_cast<T *>(malloc(sizeof(T)));
-			RegisterModule(module, update);
+
+			if (RegisterModule(module, update, GetTypeId<T>()) == nullptr)
+			{
+				free(module);
+				return nullptr;
+			}
+
 			return new(module) T();
 		}
 
@@ -93,26 +144,56 @@ namespace acid
 		template<typename T>
 		bool DeregisterModule()
 		{
-			for (auto &module : m_modules)
-			{
-				auto casted = dynamic_cast<T *>(module.second);
+			T *module = GetModule<T>();
 
-				if (casted != nullptr)
-				{
-					DeregisterModule(module.second);
-					return true;
-				}
+			if (module == nullptr)
+			{
+				return false;
 			}
 
-			return false;
+			return DeregisterModule(module);
 		}
 
+		/// <summary>
+		/// Declares that a module reads or writes data updated by another module, so it is updated after the other module when they share a update type.
+		/// </summary>
+		/// <param name="T"> The dependent module type. </param>
+		/// <param name="D"> The module type that is depended on. </param>
+		template<typename T, typename D>
+		void AddDependency() { AddDependency(GetTypeId<T>(), GetTypeId<D>()); }
+
+		/// <summary>
+		/// Sets if a module can be updated as a job, concurrently with every module of the same update type it does not depend on.
+		/// </summary>
+		/// <param name="concurrent"> If the module is concurrent. </param>
+		/// <param name="T"> The module type. </param>
+		template<typename T>
+		void SetConcurrent(const bool &concurrent) { SetConcurrent(GetTypeId<T>(), concurrent); }
+
 		/// <summary>
 		/// Runs updates for all module update types.
 		/// </summary>
 		/// <param name="update"> The modules update type. </param>
 		void RunUpdate(const ModuleUpdate &update) const;
 
-		uint32_t GetModuleCount() const { return m_modules.size(); }
+		uint32_t GetModuleCount() const { return static_cast<uint32_t>(m_modules.size()); }
+
+		/// <summary>
+		/// Gets if concurrent modules are updated as jobs, otherwise every module is updated on the calling thread in the scheduled order.
+		/// </summary>
+		/// <returns> If modules are updated in parallel. </returns>
+		bool IsParallel() const { return m_parallel; }
+
+		/// <summary>
+		/// Sets if concurrent modules are updated as jobs, disabling this gives a deterministic single threaded update for debugging.
+		/// </summary>
+		/// <param name="parallel"> If modules are updated in parallel. </param>
+		void SetParallel(const bool &parallel) { m_parallel = parallel; }
+	private:
+		void AddDependency(const uint32_t &typeId, const uint32_t &dependency);
+
+		void SetConcurrent(const uint32_t &typeId, const bool &concurrent);
+
+		void BuildSchedules();
 	};
 }
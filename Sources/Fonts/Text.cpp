@@ -251,9 +251,9 @@ namespace acid
 		lines.emplace_back(currentLine);
 	}
 
-	std::vector<IVertex *> Text::CreateQuad(const std::vector<FontLine> &lines)
+	VertexStream<VertexModel> Text::CreateQuad(const std::vector<FontLine> &lines)
 	{
-		auto vertices = std::vector<IVertex *>();
+		auto vertices = VertexStream<VertexModel>();
 		//m_numberLines = static_cast<int>(lines.size());
 
 		double cursorX = 0.0;
@@ -304,7 +304,7 @@ namespace acid
 		return vertices;
 	}
 
-	void Text::AddVerticesForCharacter(const double &cursorX, const double &cursorY, const FontCharacter &character, std::vector<IVertex *> &vertices)
+	void Text::AddVerticesForCharacter(const double &cursorX, const double &cursorY, const FontCharacter &character, VertexStream<VertexModel> &vertices)
 	{
 		double vertexX = cursorX + character.GetOffsetX();
 		double vertexY = cursorY + character.GetOffsetY();
@@ -324,13 +324,12 @@ namespace acid
 		AddVertex(vertexX, vertexY, textureX, textureY, vertices);
 	}
 
-	void Text::AddVertex(const double &vx, const double &vy, const double &tx, const double &ty, std::vector<IVertex *> &vertices)
+	void Text::AddVertex(const double &vx, const double &vy, const double &tx, const double &ty, VertexStream<VertexModel> &vertices)
 	{
-		IVertex *vertex = new VertexModel(Vector3(static_cast<float>(vx), static_cast<float>(vy), 0.0f), Vector2(static_cast<float>(tx), static_cast<float>(ty)));
-		vertices.emplace_back(vertex);
+		vertices.Add(Vector3(static_cast<float>(vx), static_cast<float>(vy), 0.0f), Vector2(static_cast<float>(tx), static_cast<float>(ty)));
 	}
 
-	void Text::NormalizeQuad(Vector2 *bounding, std::vector<IVertex *> &vertices)
+	void Text::NormalizeQuad(Vector2 *bounding, VertexStream<VertexModel> &vertices)
 	{
 		float minX = +INFINITY;
 		float minY = +INFINITY;
@@ -339,7 +338,7 @@ namespace acid
 
 		for (auto &vertex : vertices)
 		{
-			const Vector3 position = vertex->GetPosition();
+			const Vector3 position = vertex.GetPosition();
 
 			if (position.m_x < minX)
 			{
@@ -368,8 +367,8 @@ namespace acid
 
 		for (auto &vertex : vertices)
 		{
-			Vector3 position = Vector3((vertex->GetPosition().m_x - minX) / maxX, (vertex->GetPosition().m_y - minY) / maxY, 0.0f);
-			vertex->SetPosition(position);
+			Vector3 position = Vector3((vertex.GetPosition().m_x - minX) / maxX, (vertex.GetPosition().m_y - minY) / maxY, 0.0f);
+			vertex.SetPosition(position);
 		}
 	}
 }
@@ -5,6 +5,7 @@
 #include "Maths/Vector2.hpp"
 #include "Maths/Visual/IDriver.hpp"
 #include "Models/Model.hpp"
+#include "Models/VertexModel.hpp"
 #include "Renderer/Handlers/DescriptorsHandler.hpp"
 #include "Renderer/Handlers/UniformHandler.hpp"
 #include "Renderer/Pipelines/Pipeline.hpp"
@@ -252,12 +253,12 @@ namespace acid
 
 		void CompleteStructure(std::vector<FontLine> &lines, FontLine &currentLine, const FontWord &currentWord);
 
-		std::vector<IVertex *> CreateQuad(const std::vector<FontLine> &lines);
+		VertexStream<VertexModel> CreateQuad(const std::vector<FontLine> &lines);
 
-		void AddVerticesForCharacter(const double &cursorX, const double &cursorY, const FontCharacter &character, std::vector<IVertex *> &vertices);
+		void AddVerticesForCharacter(const double &cursorX, const double &cursorY, const FontCharacter &character, VertexStream<VertexModel> &vertices);
 
-		void AddVertex(const double &vx, const double &vy, const double &tx, const double &ty, std::vector<IVertex *> &vertices);
+		void AddVertex(const double &vx, const double &vy, const double &tx, const double &ty, VertexStream<VertexModel> &vertices);
 
-		void NormalizeQuad(Vector2 *bounding, std::vector<IVertex *> &vertices);
+		void NormalizeQuad(Vector2 *bounding, VertexStream<VertexModel> &vertices);
 	};
 }
@@ -0,0 +1,134 @@
+#include "CacheFile.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include "FileSystem.hpp"
+#include "MappedFile.hpp"
+
+namespace acid
+{
+	CacheFile::CacheFile(const std::string &name) :
+		m_name(name),
+		m_directory(""),
+		m_mutex()
+	{
+	}
+
+	std::string CacheFile::GetDirectory()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_directory.empty())
+		{
+			m_directory = FileSystem::GetWorkingDirectory() + "/Cache/" + m_name;
+		}
+
+		return m_directory;
+	}
+
+	void CacheFile::SetDirectory(const std::string &directory)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_directory = directory;
+	}
+
+	std::string CacheFile::GetFilename(const std::string &key, const std::string &extension)
+	{
+		char filename[32];
+		snprintf(filename, sizeof(filename), "/%016llx", static_cast<unsigned long long>(Hash(key.data(), key.size())));
+		return GetDirectory() + filename + extension;
+	}
+
+	bool CacheFile::Write(const std::string &filename, const std::vector<char> &data)
+	{
+		size_t separator = filename.find_last_of("\\/");
+
+		// The cache directory does not exist on a first run.
+		if (separator != std::string::npos && separator != 0 && !FileSystem::CreateFolder(filename.substr(0, separator)))
+		{
+			fprintf(stderr, "Cache directory could not be created: '%s'\n", filename.substr(0, separator).c_str());
+			return false;
+		}
+
+		std::string temporary = filename + ".tmp";
+
+		if (!FileSystem::WriteBinaryFile<char>(temporary, data))
+		{
+			return false;
+		}
+
+		FileSystem::DeleteFile(filename);
+
+		if (rename(temporary.c_str(), filename.c_str()) != 0)
+		{
+			fprintf(stderr, "Cache entry could not be written: '%s'\n", filename.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	uint64_t CacheFile::Hash(const char *data, const size_t &size, const uint64_t &seed)
+	{
+		uint64_t hash = seed;
+
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= static_cast<uint8_t>(data[i]);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	std::vector<char> CacheFile::CreateSourceEntry(const uint32_t &magic, const uint32_t &version, const std::string &filename, const uint32_t &stride,
+		const void *vertices, const uint32_t &vertexCount, const std::vector<uint32_t> &indices)
+	{
+		SourceHeader header = {};
+		header.magic = magic;
+		header.version = version;
+		header.stride = stride;
+		header.vertexCount = vertexCount;
+		header.indexCount = static_cast<uint32_t>(indices.size());
+		header.filenameSize = static_cast<uint32_t>(filename.size());
+		header.sourceSize = FileSystem::GetFileSize(filename);
+		header.sourceModified = FileSystem::GetModifiedTime(filename);
+
+		size_t vertexOffset = GetVertexOffset(header);
+		size_t vertexSize = static_cast<size_t>(vertexCount) * stride;
+		std::vector<char> data(vertexOffset + vertexSize + (indices.size() * sizeof(uint32_t)));
+		memcpy(data.data(), &header, sizeof(SourceHeader));
+		memcpy(data.data() + sizeof(SourceHeader), filename.data(), filename.size());
+		memcpy(data.data() + vertexOffset, vertices, vertexSize);
+		memcpy(data.data() + vertexOffset + vertexSize, indices.data(), indices.size() * sizeof(uint32_t));
+		return data;
+	}
+
+	bool CacheFile::ReadSourceHeader(const MappedFile &file, const uint32_t &magic, const uint32_t &version, const std::string &filename, const uint32_t &stride,
+		SourceHeader &header)
+	{
+		if (!file.IsOpen() || file.GetSize() < sizeof(SourceHeader))
+		{
+			return false;
+		}
+
+		memcpy(&header, file.GetData(), sizeof(SourceHeader));
+
+		if (header.magic != magic || header.version != version || header.stride != stride ||
+			header.sourceSize != FileSystem::GetFileSize(filename) || header.sourceModified != FileSystem::GetModifiedTime(filename))
+		{
+			return false;
+		}
+
+		// Filenames are hashes, the stored source filename guards against collisions.
+		size_t dataSize = (static_cast<size_t>(header.vertexCount) * stride) + (static_cast<size_t>(header.indexCount) * sizeof(uint32_t));
+
+		return filename.size() == header.filenameSize && file.GetSize() >= GetVertexOffset(header) + dataSize &&
+			memcmp(file.GetData() + sizeof(SourceHeader), filename.data(), filename.size()) == 0;
+	}
+
+	size_t CacheFile::GetVertexOffset(const SourceHeader &header)
+	{
+		return (sizeof(SourceHeader) + header.filenameSize + 7) & ~static_cast<size_t>(7);
+	}
+}
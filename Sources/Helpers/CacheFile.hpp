@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	class MappedFile;
+
+	/// <summary>
+	/// A directory of cache entries on disk, shared by the engines caches.
+	/// Entries are named by a hash of their key, and are written to a temporary file then renamed so a partial entry is never read.
+	/// </summary>
+	class ACID_EXPORT CacheFile
+	{
+	public:
+		/// <summary>
+		/// The header of a entry parsed from a source file, followed by the source filename and the vertices and indices.
+		/// </summary>
+		struct SourceHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t stride;
+			uint32_t vertexCount;
+			uint32_t indexCount;
+			uint32_t filenameSize;
+			uint64_t sourceSize;
+			int64_t sourceModified;
+		};
+	private:
+		std::string m_name;
+		std::string m_directory;
+		std::mutex m_mutex;
+	public:
+		/// <summary>
+		/// Creates a new cache directory.
+		/// </summary>
+		/// <param name="name"> The name of the directory inside 'Cache' in the working directory, used until another directory is set. </param>
+		explicit CacheFile(const std::string &name);
+
+		/// <summary>
+		/// Gets the directory the entries are stored in.
+		/// </summary>
+		/// <returns> The cache directory. </returns>
+		std::string GetDirectory();
+
+		/// <summary>
+		/// Sets the directory the entries are stored in.
+		/// </summary>
+		/// <param name="directory"> The new cache directory. </param>
+		void SetDirectory(const std::string &directory);
+
+		/// <summary>
+		/// Gets the filename of a entry.
+		/// </summary>
+		/// <param name="key"> The key the entry is found by. </param>
+		/// <param name="extension"> The entry extension, including the dot. </param>
+		/// <returns> The entry filename in the cache directory. </returns>
+		std::string GetFilename(const std::string &key, const std::string &extension);
+
+		/// <summary>
+		/// Writes a entry, creating the folders it is stored in. The previous entry is replaced only once the new one is complete.
+		/// </summary>
+		/// <param name="filename"> The entry filename. </param>
+		/// <param name="data"> The entry data. </param>
+		/// <returns> If the entry was written. </returns>
+		static bool Write(const std::string &filename, const std::vector<char> &data);
+
+		/// <summary>
+		/// Hashes data with FNV-1a.
+		/// </summary>
+		/// <param name="data"> The data to hash. </param>
+		/// <param name="size"> The size of the data. </param>
+		/// <param name="seed"> The hash to continue from. </param>
+		/// <returns> The hash. </returns>
+		static uint64_t Hash(const char *data, const size_t &size, const uint64_t &seed = 14695981039346656037ull);
+
+		/// <summary>
+		/// Builds a entry parsed from a source file, the vertices start aligned so they can be read in place.
+		/// </summary>
+		/// <param name="magic"> The magic of the cache. </param>
+		/// <param name="version"> The version of the cache. </param>
+		/// <param name="filename"> The source file, stale entries are found by its size and modification time. </param>
+		/// <param name="stride"> The size of a single vertex. </param>
+		/// <param name="vertices"> The vertex data. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		/// <param name="indices"> The indices. </param>
+		/// <returns> The entry data, more data may be appended after the indices. </returns>
+		static std::vector<char> CreateSourceEntry(const uint32_t &magic, const uint32_t &version, const std::string &filename, const uint32_t &stride,
+			const void *vertices, const uint32_t &vertexCount, const std::vector<uint32_t> &indices);
+
+		/// <summary>
+		/// Reads the header of a entry parsed from a source file.
+		/// </summary>
+		/// <param name="file"> The mapped entry. </param>
+		/// <param name="magic"> The magic of the cache. </param>
+		/// <param name="version"> The version of the cache. </param>
+		/// <param name="filename"> The source file. </param>
+		/// <param name="stride"> The size of a single vertex. </param>
+		/// <param name="header"> The read header. </param>
+		/// <returns> If the entry was built from this source file as it is now, and holds all of its vertices and indices. </returns>
+		static bool ReadSourceHeader(const MappedFile &file, const uint32_t &magic, const uint32_t &version, const std::string &filename, const uint32_t &stride,
+			SourceHeader &header);
+
+		/// <summary>
+		/// Gets the offset of the vertices in a entry parsed from a source file.
+		/// </summary>
+		/// <param name="header"> The entry header. </param>
+		/// <returns> The vertex offset. </returns>
+		static size_t GetVertexOffset(const SourceHeader &header);
+	};
+}
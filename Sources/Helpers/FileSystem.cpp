@@ -4,6 +4,8 @@
 #include <algorithm>
 #ifdef ACID_BUILD_WINDOWS
 #include <direct.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #define GetCurrentDir _getcwd
 #else
 #include <sys/stat.h>
@@ -24,6 +26,30 @@ namespace acid
 		return false;
 	}
 
+	uint64_t FileSystem::GetFileSize(const std::string &filepath)
+	{
+		struct stat status = {};
+
+		if (stat(filepath.c_str(), &status) != 0)
+		{
+			return 0;
+		}
+
+		return static_cast<uint64_t>(status.st_size);
+	}
+
+	int64_t FileSystem::GetModifiedTime(const std::string &filepath)
+	{
+		struct stat status = {};
+
+		if (stat(filepath.c_str(), &status) != 0)
+		{
+			return 0;
+		}
+
+		return static_cast<int64_t>(status.st_mtime);
+	}
+
 	bool FileSystem::DeleteFile(const std::string &filepath)
 	{
 		if (!FileExists(filepath))
@@ -44,7 +70,12 @@ namespace acid
 
 		if (createFolders)
 		{
-			CreateFolder(filepath.substr(0, filepath.find_last_of("\\/")));
+			size_t separator = filepath.find_last_of("\\/");
+
+			if (separator != std::string::npos && separator != 0)
+			{
+				CreateFolder(filepath.substr(0, separator));
+			}
 		}
 
 		FILE *file = fopen(filepath.c_str(), "rb+");
@@ -54,6 +85,12 @@ namespace acid
 			file = fopen(filepath.c_str(), "wb");
 		}
 
+		if (file == nullptr)
+		{
+			fprintf(stderr, "File could not be created: '%s'\n", filepath.c_str());
+			return false;
+		}
+
 		fclose(file);
 		return true;
 	}
@@ -67,17 +104,40 @@ namespace acid
 
 	bool FileSystem::CreateFolder(const std::string &path)
 	{
-		int nError = 0;
+		// Parents are created first, a single mkdir fails when any of them is missing.
+		for (size_t separator = path.find_first_of("\\/", 1); ; separator = path.find_first_of("\\/", separator + 1))
+		{
+			std::string folder = path.substr(0, separator);
 
+			if (!folder.empty() && folder.back() != ':' && !IsDirectory(folder))
+			{
 #ifdef ACID_BUILD_WINDOWS
-		nError = _mkdir(path.c_str());
+				_mkdir(folder.c_str());
 #else
-		mode_t nMode = 0733;
-		nError = mkdir(path.c_str(), nMode);
+				mode_t nMode = 0733;
+				mkdir(folder.c_str(), nMode);
 #endif
+			}
+
+			if (separator == std::string::npos)
+			{
+				break;
+			}
+		}
+
+		return IsDirectory(path);
+	}
+
+	bool FileSystem::IsDirectory(const std::string &path)
+	{
+		struct stat info;
+
+		if (stat(path.c_str(), &info) != 0)
+		{
+			return false;
+		}
 
-	//	assert(nError != 0 && "Could not create folder!");
-		return nError == 0;
+		return (info.st_mode & S_IFDIR) != 0;
 	}
 
 	std::optional<std::string> FileSystem::ReadTextFile(const std::string &filepath)
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <cstdint>
 #include <cstring>
 #include <optional>
 #include <string>
@@ -21,6 +22,20 @@ namespace acid
 		/// <returns> If the file exists. </returns>
 		static bool FileExists(const std::string &filepath);
 
+		/// <summary>
+		/// Gets the size of a file.
+		/// </summary>
+		/// <param name="filepath"> The filepath. </param>
+		/// <returns> The file size in bytes, 0 if the file does not exist. </returns>
+		static uint64_t GetFileSize(const std::string &filepath);
+
+		/// <summary>
+		/// Gets when a file was last modified.
+		/// </summary>
+		/// <param name="filepath"> The filepath. </param>
+		/// <returns> The modification time in seconds since the epoch, 0 if the file does not exist. </returns>
+		static int64_t GetModifiedTime(const std::string &filepath);
+
 		/// <summary>
 		/// Deletes a file.
 		/// </summary>
@@ -44,12 +59,19 @@ namespace acid
 		static bool ClearFile(const std::string &filepath);
 
 		/// <summary>
-		/// Creates a directory.
+		/// Creates a directory, and any missing parent directories.
 		/// </summary>
 		/// <param name="path"> The directory to create. </param>
-		/// <returns> If the folder was created. </returns>
+		/// <returns> If the folder exists afterwards. </returns>
 		static bool CreateFolder(const std::string &path);
 
+		/// <summary>
+		/// Gets if a path is a existing directory.
+		/// </summary>
+		/// <param name="path"> The path. </param>
+		/// <returns> If the path is a directory. </returns>
+		static bool IsDirectory(const std::string &path);
+
 		/// <summary>
 		/// Reads a text file into a string.
 		/// </summary>
@@ -0,0 +1,110 @@
+#include "MappedFile.hpp"
+
+#ifdef ACID_BUILD_WINDOWS
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace acid
+{
+#ifdef ACID_BUILD_WINDOWS
+	MappedFile::MappedFile(const std::string &filepath) :
+		m_data(nullptr),
+		m_size(0),
+		m_file(INVALID_HANDLE_VALUE),
+		m_mapping(nullptr)
+	{
+		m_file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+		if (m_file == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+
+		LARGE_INTEGER size = {};
+
+		if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+		{
+			return;
+		}
+
+		m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (m_mapping == nullptr)
+		{
+			return;
+		}
+
+		m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		m_size = m_data != nullptr ? static_cast<size_t>(size.QuadPart) : 0;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (m_data != nullptr)
+		{
+			UnmapViewOfFile(m_data);
+		}
+
+		if (m_mapping != nullptr)
+		{
+			CloseHandle(m_mapping);
+		}
+
+		if (m_file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_file);
+		}
+	}
+#else
+	MappedFile::MappedFile(const std::string &filepath) :
+		m_data(nullptr),
+		m_size(0),
+		m_file(-1)
+	{
+		m_file = open(filepath.c_str(), O_RDONLY);
+
+		if (m_file == -1)
+		{
+			return;
+		}
+
+		struct stat status = {};
+
+		if (fstat(m_file, &status) != 0 || status.st_size == 0)
+		{
+			return;
+		}
+
+		void *data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, m_file, 0);
+
+		if (data == MAP_FAILED)
+		{
+			return;
+		}
+
+		// Files are read front to back, so the OS can read ahead.
+		madvise(data, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+		m_data = static_cast<const char *>(data);
+		m_size = static_cast<size_t>(status.st_size);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (m_data != nullptr)
+		{
+			munmap(const_cast<char *>(m_data), m_size);
+		}
+
+		if (m_file != -1)
+		{
+			close(m_file);
+		}
+	}
+#endif
+}
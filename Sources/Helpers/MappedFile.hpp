@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A read only view of a file mapped into memory, pages are read by the OS as they are touched instead of copied into a buffer up front.
+	/// </summary>
+	class ACID_EXPORT MappedFile
+	{
+	private:
+		const char *m_data;
+		size_t m_size;
+#ifdef ACID_BUILD_WINDOWS
+		void *m_file;
+		void *m_mapping;
+#else
+		int m_file;
+#endif
+	public:
+		/// <summary>
+		/// Maps a file into memory, the file is not mapped if it can not be opened or is empty.
+		/// </summary>
+		/// <param name="filepath"> The filepath. </param>
+		explicit MappedFile(const std::string &filepath);
+
+		~MappedFile();
+
+		MappedFile(const MappedFile &) = delete;
+
+		MappedFile &operator=(const MappedFile &) = delete;
+
+		/// <summary>
+		/// Gets if the file was mapped.
+		/// </summary>
+		/// <returns> If the file data can be read. </returns>
+		bool IsOpen() const { return m_data != nullptr; }
+
+		const char *GetData() const { return m_data; }
+
+		size_t GetSize() const { return m_size; }
+	};
+}
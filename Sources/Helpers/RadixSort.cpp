@@ -0,0 +1,15 @@
+#include "RadixSort.hpp"
+
+#include <cstring>
+
+namespace acid
+{
+	uint32_t RadixSort::QuantizeFloat(const float &value, const uint32_t &bits)
+	{
+		// Positive floats keep their order when compared as integers.
+		uint32_t valueBits = 0;
+		float clampedValue = value > 0.0f ? value : 0.0f;
+		memcpy(&valueBits, &clampedValue, sizeof(float));
+		return (valueBits >> (31 - bits)) & ((1u << bits) - 1);
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A helper for sorting items by a integer key, shared by the render and particle sorts.
+	/// </summary>
+	class ACID_EXPORT RadixSort
+	{
+	public:
+		/// <summary>
+		/// Sorts items by their key member with a least significant digit radix sort, items with equal keys keep their order.
+		/// </summary>
+		/// <param name="items"> The items to sort. </param>
+		/// <param name="swap"> The storage used between passes, kept by the caller so it is not reallocated every sort. </param>
+		/// <param name="keyBits"> The number of low key bits that are used, only their bytes are sorted over. </param>
+		template<typename T>
+		static void Sort(std::vector<T> &items, std::vector<T> &swap, const uint32_t &keyBits = 8 * sizeof(T::key))
+		{
+			auto count = static_cast<uint32_t>(items.size());
+
+			if (count < 2)
+			{
+				return;
+			}
+
+			// All histograms are built in a single pass over the items.
+			uint32_t passes = (keyBits + 7) / 8;
+			std::array<std::array<uint32_t, 256>, sizeof(T::key)> histograms = {};
+
+			for (auto &item : items)
+			{
+				for (uint32_t i = 0; i < passes; i++)
+				{
+					histograms[i][(item.key >> (i * 8)) & 0xFF]++;
+				}
+			}
+
+			swap.resize(count);
+
+			for (uint32_t i = 0; i < passes; i++)
+			{
+				auto &histogram = histograms[i];
+				uint32_t shift = i * 8;
+
+				// Every key shares this byte, the pass would not change the order.
+				if (histogram[(items[0].key >> shift) & 0xFF] == count)
+				{
+					continue;
+				}
+
+				uint32_t offset = 0;
+
+				for (auto &bucket : histogram)
+				{
+					uint32_t bucketCount = bucket;
+					bucket = offset;
+					offset += bucketCount;
+				}
+
+				for (auto &item : items)
+				{
+					swap[histogram[(item.key >> shift) & 0xFF]++] = item;
+				}
+
+				items.swap(swap);
+			}
+		}
+
+		/// <summary>
+		/// Creates a key from a float that keeps the order of the floats, negative values are clamped to zero.
+		/// </summary>
+		/// <param name="value"> The value to quantize. </param>
+		/// <param name="bits"> The number of key bits, the lowest mantissa bits are dropped to fit. </param>
+		/// <returns> The key. </returns>
+		static uint32_t QuantizeFloat(const float &value, const uint32_t &bits);
+	};
+}
@@ -4,6 +4,7 @@
 #include "Renderer/Handlers/DescriptorsHandler.hpp"
 #include "Renderer/Handlers/UniformHandler.hpp"
 #include "Renderer/Pipelines/Pipeline.hpp"
+#include "MaterialInstance.hpp"
 #include "PipelineMaterial.hpp"
 
 namespace acid
@@ -37,5 +38,30 @@ namespace acid
 		virtual void PushDescriptors(DescriptorsHandler &descriptorSet) = 0;
 
 		virtual std::shared_ptr<PipelineMaterial> GetMaterial() const = 0;
+
+		/// <summary>
+		/// Gets if objects with this material are blended, they are drawn after opaque objects from back to front.
+		/// </summary>
+		/// <returns> If the material is transparent. </returns>
+		virtual bool IsTransparent() const { return false; }
+
+		/// <summary>
+		/// Gets the pipeline used to draw many objects with this material in a single instanced draw.
+		/// </summary>
+		/// <returns> The instanced pipeline, or nullptr if objects with this material are drawn one at a time. </returns>
+		virtual std::shared_ptr<PipelineMaterial> GetInstancedMaterial() const { return nullptr; }
+
+		/// <summary>
+		/// Writes the per instance attributes read by the instanced pipeline.
+		/// </summary>
+		/// <param name="instance"> The instance to write into. </param>
+		virtual void PushInstance(MaterialInstance &instance) {}
+
+		/// <summary>
+		/// Gets if another material pushes the same descriptors, so objects using either can share a instanced draw.
+		/// </summary>
+		/// <param name="other"> The other material. </param>
+		/// <returns> If the materials can be instanced together. </returns>
+		virtual bool IsInstanceCompatible(const IMaterial &other) const { return &other == this; }
 	};
 }
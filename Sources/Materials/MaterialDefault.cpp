@@ -20,7 +20,8 @@ namespace acid
 		m_castsShadows(castsShadows),
 		m_ignoreLighting(ignoreLighting),
 		m_ignoreFog(ignoreFog),
-		m_material(nullptr)
+		m_material(nullptr),
+		m_instancedMaterial(nullptr)
 	{
 	}
 
@@ -41,6 +42,15 @@ namespace acid
 		m_animated = dynamic_cast<MeshAnimated *>(mesh) != nullptr;
 		m_material = PipelineMaterial::Resource({1, 0}, PipelineCreate({"Shaders/Defaults/Default.vert", "Shaders/Defaults/Default.frag"},
 			mesh->GetVertexInput(), PIPELINE_MODE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, GetDefines()));
+
+		// Animated meshes upload their own joints, so they can not share a instanced draw.
+		if (!m_animated)
+		{
+			auto instancedDefines = GetDefines();
+			instancedDefines.emplace_back(PipelineDefine("INSTANCED", "TRUE"));
+			m_instancedMaterial = PipelineMaterial::Resource({1, 0}, PipelineCreate({"Shaders/Defaults/Default.vert", "Shaders/Defaults/Default.frag"},
+				MaterialInstance::GetVertexInput(mesh->GetVertexInput()), PIPELINE_MODE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, instancedDefines));
+		}
 	}
 
 	void MaterialDefault::Update()
@@ -86,7 +96,7 @@ namespace acid
 			uniformObject.Push("jointTransforms", *joints.data(), sizeof(Matrix4) * joints.size());
 		}
 
-		uniformObject.Push("transform", GetGameObject()->GetTransform().GetWorldMatrix());
+		uniformObject.Push("transform", GetGameObject()->GetRenderTransform().GetWorldMatrix());
 		uniformObject.Push("baseColor", m_baseColor);
 		uniformObject.Push("metallic", m_metallic);
 		uniformObject.Push("roughness", m_roughness);
@@ -101,6 +111,26 @@ namespace acid
 		descriptorSet.Push("samplerNormal", m_normalTexture);
 	}
 
+	void MaterialDefault::PushInstance(MaterialInstance &instance)
+	{
+		instance.m_transform = GetGameObject()->GetRenderTransform().GetWorldMatrix();
+		instance.m_baseColor = m_baseColor;
+		instance.m_parameters = Vector4(m_metallic, m_roughness, static_cast<float>(m_ignoreFog), static_cast<float>(m_ignoreLighting));
+	}
+
+	bool MaterialDefault::IsInstanceCompatible(const IMaterial &other) const
+	{
+		auto material = dynamic_cast<const MaterialDefault *>(&other);
+
+		if (material == nullptr)
+		{
+			return false;
+		}
+
+		return m_instancedMaterial == material->m_instancedMaterial && IsTransparent() == material->IsTransparent() && m_diffuseTexture == material->m_diffuseTexture &&
+			m_materialTexture == material->m_materialTexture && m_normalTexture == material->m_normalTexture;
+	}
+
 	std::vector<PipelineDefine> MaterialDefault::GetDefines()
 	{
 		std::vector<PipelineDefine> result = {};
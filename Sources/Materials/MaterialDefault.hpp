@@ -28,6 +28,7 @@ namespace acid
 		bool m_ignoreFog;
 
 		std::shared_ptr<PipelineMaterial> m_material;
+		std::shared_ptr<PipelineMaterial> m_instancedMaterial;
 	public:
 		MaterialDefault(const Colour &baseColor = Colour::WHITE, std::shared_ptr<Texture> diffuseTexture = nullptr,
 						const float &metallic = 0.0f, const float &roughness = 0.0f, std::shared_ptr<Texture> materialTexture = nullptr, std::shared_ptr<Texture> normalTexture = nullptr,
@@ -48,6 +49,12 @@ namespace acid
 
 		void PushDescriptors(DescriptorsHandler &descriptorSet) override;
 
+		void PushInstance(MaterialInstance &instance) override;
+
+		bool IsInstanceCompatible(const IMaterial &other) const override;
+
+		bool IsTransparent() const override { return m_baseColor.m_a < 1.0f; }
+
 		std::vector<PipelineDefine> GetDefines();
 
 		Colour GetBaseColor() const { return m_baseColor; }
@@ -111,5 +118,7 @@ namespace acid
 		void SetIgnoreFog(const bool &ignoreFog) { m_ignoreFog = ignoreFog; }
 
 		std::shared_ptr<PipelineMaterial> GetMaterial() const override { return m_material; }
+
+		std::shared_ptr<PipelineMaterial> GetInstancedMaterial() const override { return m_instancedMaterial; }
 	};
 }
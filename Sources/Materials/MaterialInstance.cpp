@@ -0,0 +1,60 @@
+#include "MaterialInstance.hpp"
+
+namespace acid
+{
+	const uint32_t MaterialInstance::BINDING = 1;
+	const uint32_t MaterialInstance::LOCATION = 6;
+
+	MaterialInstance::MaterialInstance() :
+		m_transform(Matrix4()),
+		m_baseColor(Colour()),
+		m_parameters(Vector4())
+	{
+	}
+
+	MaterialInstance::~MaterialInstance()
+	{
+	}
+
+	VertexInput MaterialInstance::GetVertexInput(const VertexInput &vertexInput)
+	{
+		auto bindingDescriptions = vertexInput.GetBindingDescriptions();
+		auto attributeDescriptions = vertexInput.GetAttributeDescriptions();
+
+		// The instance input description.
+		VkVertexInputBindingDescription bindingDescription = {};
+		bindingDescription.binding = BINDING;
+		bindingDescription.stride = sizeof(MaterialInstance);
+		bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+		bindingDescriptions.emplace_back(bindingDescription);
+
+		// Transform attribute, a matrix takes up one location per column.
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			VkVertexInputAttributeDescription attributeDescription = {};
+			attributeDescription.binding = BINDING;
+			attributeDescription.location = LOCATION + i;
+			attributeDescription.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+			attributeDescription.offset = static_cast<uint32_t>(offsetof(MaterialInstance, m_transform) + (i * sizeof(Vector4)));
+			attributeDescriptions.emplace_back(attributeDescription);
+		}
+
+		// Base colour attribute.
+		VkVertexInputAttributeDescription colourDescription = {};
+		colourDescription.binding = BINDING;
+		colourDescription.location = LOCATION + 4;
+		colourDescription.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+		colourDescription.offset = offsetof(MaterialInstance, m_baseColor);
+		attributeDescriptions.emplace_back(colourDescription);
+
+		// Parameters attribute.
+		VkVertexInputAttributeDescription parametersDescription = {};
+		parametersDescription.binding = BINDING;
+		parametersDescription.location = LOCATION + 5;
+		parametersDescription.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+		parametersDescription.offset = offsetof(MaterialInstance, m_parameters);
+		attributeDescriptions.emplace_back(parametersDescription);
+
+		return VertexInput(bindingDescriptions, attributeDescriptions);
+	}
+}
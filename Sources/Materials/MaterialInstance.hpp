@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Maths/Colour.hpp"
+#include "Maths/Matrix4.hpp"
+#include "Maths/Vector4.hpp"
+#include "Renderer/Pipelines/PipelineCreate.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Class that represents the per instance attributes read by instanced material pipelines.
+	/// </summary>
+	class ACID_EXPORT MaterialInstance
+	{
+	public:
+		static const uint32_t BINDING;
+		static const uint32_t LOCATION;
+
+		Matrix4 m_transform;
+		Colour m_baseColor;
+		Vector4 m_parameters;
+
+		MaterialInstance();
+
+		~MaterialInstance();
+
+		/// <summary>
+		/// Appends the instance binding and attributes to a models vertex input.
+		/// </summary>
+		/// <param name="vertexInput"> The vertex input of the instanced model. </param>
+		/// <returns> The combined vertex input. </returns>
+		static VertexInput GetVertexInput(const VertexInput &vertexInput);
+	};
+}
@@ -23,7 +23,8 @@ namespace acid
 	{
 		auto material = GetGameObject()->GetComponent<IMaterial>();
 
-		if (material == nullptr)
+		// Instanced materials are drawn from instance attributes, the object uniforms are left unused.
+		if (material == nullptr || material->GetInstancedMaterial() != nullptr)
 		{
 			return;
 		}
@@ -32,19 +33,8 @@ namespace acid
 		material->PushUniforms(m_uniformObject);
 	}
 
-	void MeshRender::CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene)
+	void MeshRender::CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene, RenderQueue &renderQueue)
 	{
-		// Checks if the mesh is in view.
-		/*auto shape = GetGameObject()->GetComponent<Collider>();
-
-		if (shape != nullptr)
-		{
-			if (!shape->InFrustum(Scenes::Get()->GetCamera()->GetViewFrustum()))
-			{
-				return;
-			}
-		}*/
-
 		// Gets required components.
 		auto material = GetGameObject()->GetComponent<IMaterial>();
 		auto mesh = GetGameObject()->GetComponent<Mesh>();
@@ -55,13 +45,18 @@ namespace acid
 		}
 
 		// Binds the material pipeline.
-		material->GetMaterial()->GetPipeline().BindPipeline(commandBuffer);
+		auto &pipeline = material->GetMaterial()->GetPipeline();
+
+		if (renderQueue.Bind(RENDER_BIND_PIPELINE, &pipeline))
+		{
+			pipeline.BindPipeline(commandBuffer);
+		}
 
 		// Updates descriptors.
 		m_descriptorSet.Push("UboScene", uniformScene);
 		m_descriptorSet.Push("UboObject", m_uniformObject);
 		material->PushDescriptors(m_descriptorSet);
-		bool updateSuccess = m_descriptorSet.Update(material->GetMaterial()->GetPipeline());
+		bool updateSuccess = m_descriptorSet.Update(pipeline);
 
 		if (!updateSuccess)
 		{
@@ -69,8 +64,17 @@ namespace acid
 		}
 
 		// Draws the object.
-		m_descriptorSet.BindDescriptor(commandBuffer);
-		mesh->GetModel()->CmdRender(commandBuffer);
+		if (renderQueue.Bind(RENDER_BIND_DESCRIPTOR, m_descriptorSet.GetDescriptorSet()))
+		{
+			m_descriptorSet.BindDescriptor(commandBuffer);
+		}
+
+		if (renderQueue.Bind(RENDER_BIND_VERTEX, mesh->GetModel().get()))
+		{
+			mesh->GetModel()->CmdBind(commandBuffer);
+		}
+
+		mesh->GetModel()->CmdDraw(commandBuffer);
 	}
 
 	void MeshRender::Load(LoadedValue *value)
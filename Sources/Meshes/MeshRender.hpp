@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Materials/IMaterial.hpp"
+#include "Renderer/RenderQueue.hpp"
 #include "Mesh.hpp"
 
 namespace acid
@@ -24,7 +25,15 @@ namespace acid
 
 		void Write(LoadedValue *destination) override;
 
-		void CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene);
+		/// <summary>
+		/// Draws this object, binds of state already bound by the previous draw in the queue are skipped.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="uniformScene"> The scene uniforms. </param>
+		/// <param name="renderQueue"> The queue tracking the bound state. </param>
+		void CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene, RenderQueue &renderQueue);
+
+		DescriptorsHandler &GetDescriptorSet() { return m_descriptorSet; }
 
 		UniformHandler GetUniformObject() const { return m_uniformObject; }
 	};
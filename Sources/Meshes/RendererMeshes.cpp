@@ -1,13 +1,23 @@
 ﻿#include "RendererMeshes.hpp"
 
+#include "Renderer/Renderer.hpp"
 #include "Scenes/Scenes.hpp"
 #include "MeshRender.hpp"
 
 namespace acid
 {
+	const uint32_t RendererMeshes::BATCH_FLAG = 1u << 31;
+
 	RendererMeshes::RendererMeshes(const GraphicsStage &graphicsStage) :
 		IRenderer(graphicsStage),
-		m_uniformScene(UniformHandler(true))
+		m_uniformScene(UniformHandler(true)),
+		m_instanceBuffers(std::vector<std::unique_ptr<InstanceBuffer>>(Renderer::MAX_FRAMES_IN_FLIGHT)),
+		m_batchDescriptors(std::map<PipelineMaterial *, std::vector<std::unique_ptr<DescriptorsHandler>>>()),
+		m_batches(std::vector<InstanceBatch>()),
+		m_batchCount(0),
+		m_instances(std::vector<MaterialInstance>()),
+		m_meshRenders(std::vector<MeshRender *>()),
+		m_renderQueue(RenderQueue())
 	{
 	}
 
@@ -20,11 +30,168 @@ namespace acid
 		m_uniformScene.Push("projection", camera.GetProjectionMatrix());
 		m_uniformScene.Push("view", camera.GetViewMatrix());
 
-		auto renderList = Scenes::Get()->GetStructure()->QueryComponents<MeshRender>();
+		// Only meshes with bounds inside the view frustum are drawn.
+		auto renderList = Scenes::Get()->GetStructure()->QueryComponents<MeshRender>(camera.GetViewFrustum());
+		auto cameraPosition = camera.GetPosition();
+
+		// Batches are reused between frames so their instance vectors keep their capacity.
+		std::map<std::pair<PipelineMaterial *, Model *>, std::vector<uint32_t>> batchIndices;
+		m_batchCount = 0;
+		m_meshRenders.clear();
+		m_renderQueue.Clear();
 
 		for (auto &meshRender : renderList)
 		{
-			meshRender->CmdRender(commandBuffer, m_uniformScene);
+			auto material = meshRender->GetGameObject()->GetComponent<IMaterial>();
+			auto mesh = meshRender->GetGameObject()->GetComponent<Mesh>();
+
+			if (material == nullptr || mesh == nullptr || mesh->GetModel() == nullptr || material->GetMaterial() == nullptr)
+			{
+				continue;
+			}
+
+			// Squared distances sort in the same order as distances.
+			float depth = cameraPosition.DistanceSquared(meshRender->GetGameObject()->GetRenderTransform().GetPosition());
+
+			// Transparent objects are drawn one at a time, so they can be sorted back to front.
+			if (material->GetInstancedMaterial() == nullptr || material->IsTransparent())
+			{
+				m_renderQueue.Push(material->GetMaterial().get(), mesh->GetModel().get(), &meshRender->GetDescriptorSet(), depth, material->IsTransparent(),
+					static_cast<uint32_t>(m_meshRenders.size()));
+				m_meshRenders.emplace_back(meshRender);
+				continue;
+			}
+
+			auto &indices = batchIndices[std::make_pair(material->GetInstancedMaterial().get(), mesh->GetModel().get())];
+			InstanceBatch *batch = nullptr;
+
+			for (auto &index : indices)
+			{
+				if (m_batches[index].material->IsInstanceCompatible(*material))
+				{
+					batch = &m_batches[index];
+					break;
+				}
+			}
+
+			if (batch == nullptr)
+			{
+				if (m_batchCount == m_batches.size())
+				{
+					m_batches.emplace_back(InstanceBatch{nullptr, nullptr, 0.0f, 0, nullptr, std::vector<MaterialInstance>()});
+				}
+
+				indices.emplace_back(m_batchCount);
+				batch = &m_batches[m_batchCount++];
+				batch->material = material;
+				batch->model = mesh->GetModel().get();
+				batch->depth = depth;
+				batch->instances.clear();
+			}
+
+			// A batch is sorted by its nearest instance.
+			batch->depth = std::min(batch->depth, depth);
+			batch->instances.emplace_back(MaterialInstance());
+			material->PushInstance(batch->instances.back());
+		}
+
+		for (uint32_t i = 0; i < m_batchCount; i++)
+		{
+			auto &batch = m_batches[i];
+			m_renderQueue.Push(batch.material->GetInstancedMaterial().get(), batch.model, batch.material, batch.depth, false, BATCH_FLAG | i);
 		}
+
+		UploadBatches();
+		m_renderQueue.Sort();
+
+		for (uint32_t i = 0; i < m_renderQueue.GetSize(); i++)
+		{
+			uint32_t value = m_renderQueue.GetValue(i);
+
+			if ((value & BATCH_FLAG) != 0)
+			{
+				CmdRenderBatch(commandBuffer, m_batches[value & ~BATCH_FLAG]);
+			}
+			else
+			{
+				m_meshRenders[value]->CmdRender(commandBuffer, m_uniformScene, m_renderQueue);
+			}
+		}
+	}
+
+	void RendererMeshes::UploadBatches()
+	{
+		// Every batch is packed into one buffer, each draw binds its own range of it.
+		m_instances.clear();
+
+		for (uint32_t i = 0; i < m_batchCount; i++)
+		{
+			m_batches[i].offset = static_cast<VkDeviceSize>(m_instances.size() * sizeof(MaterialInstance));
+			m_instances.insert(m_instances.end(), m_batches[i].instances.begin(), m_batches[i].instances.end());
+		}
+
+		if (m_instances.empty())
+		{
+			return;
+		}
+
+		auto size = static_cast<VkDeviceSize>(m_instances.size() * sizeof(MaterialInstance));
+		auto &instanceBuffer = m_instanceBuffers[Renderer::Get()->GetCurrentFrame()];
+		Buffer::Reserve(instanceBuffer, size, 64 * sizeof(MaterialInstance));
+		instanceBuffer->Update(m_instances.data(), size);
+
+		// Descriptor sets are handed out per pipeline, so a batch only rewrites its descriptors when the pushed textures change.
+		std::map<PipelineMaterial *, uint32_t> descriptorsUsed;
+
+		for (uint32_t i = 0; i < m_batchCount; i++)
+		{
+			auto instancedMaterial = m_batches[i].material->GetInstancedMaterial().get();
+			auto &descriptorSets = m_batchDescriptors[instancedMaterial];
+			uint32_t &used = descriptorsUsed[instancedMaterial];
+
+			if (used == descriptorSets.size())
+			{
+				descriptorSets.emplace_back(std::make_unique<DescriptorsHandler>());
+			}
+
+			m_batches[i].descriptorSet = descriptorSets[used++].get();
+		}
+	}
+
+	void RendererMeshes::CmdRenderBatch(const CommandBuffer &commandBuffer, InstanceBatch &batch)
+	{
+		auto &pipeline = batch.material->GetInstancedMaterial()->GetPipeline();
+		auto &descriptorSet = *batch.descriptorSet;
+		auto &instanceBuffer = m_instanceBuffers[Renderer::Get()->GetCurrentFrame()];
+
+		// Binds the material pipeline.
+		if (m_renderQueue.Bind(RENDER_BIND_PIPELINE, &pipeline))
+		{
+			pipeline.BindPipeline(commandBuffer);
+		}
+
+		// Updates descriptors.
+		descriptorSet.Push("UboScene", m_uniformScene);
+		batch.material->PushDescriptors(descriptorSet);
+		bool updateSuccess = descriptorSet.Update(pipeline);
+
+		if (!updateSuccess)
+		{
+			return;
+		}
+
+		// Draws every instance in the batch.
+		if (m_renderQueue.Bind(RENDER_BIND_DESCRIPTOR, descriptorSet.GetDescriptorSet()))
+		{
+			descriptorSet.BindDescriptor(commandBuffer);
+		}
+
+		if (m_renderQueue.Bind(RENDER_BIND_VERTEX, batch.model))
+		{
+			batch.model->CmdBind(commandBuffer);
+		}
+
+		instanceBuffer->CmdBind(commandBuffer, MaterialInstance::BINDING, batch.offset);
+		batch.model->CmdDraw(commandBuffer, static_cast<uint32_t>(batch.instances.size()));
 	}
 }
@@ -1,22 +1,63 @@
 ﻿#pragma once
 
+#include <map>
+#include "Materials/IMaterial.hpp"
+#include "Models/Model.hpp"
+#include "Renderer/Buffers/InstanceBuffer.hpp"
 #include "Renderer/Buffers/UniformBuffer.hpp"
 #include "Renderer/IRenderer.hpp"
+#include "Renderer/Handlers/DescriptorsHandler.hpp"
 #include "Renderer/Handlers/UniformHandler.hpp"
 #include "Renderer/Pipelines/Pipeline.hpp"
+#include "Renderer/RenderQueue.hpp"
 
 namespace acid
 {
+	class MeshRender;
+
+	/// <summary>
+	/// Renders the visible meshes, objects sharing a model and a instanced material are drawn together in one instanced draw.
+	/// Draws are sorted by state and depth through a render queue, so binds of state that is already bound are skipped.
+	/// </summary>
 	class ACID_EXPORT RendererMeshes :
 		public IRenderer
 	{
 	private:
+		struct InstanceBatch
+		{
+			IMaterial *material;
+			Model *model;
+			float depth;
+			VkDeviceSize offset;
+			DescriptorsHandler *descriptorSet;
+			std::vector<MaterialInstance> instances;
+		};
+
+		static const uint32_t BATCH_FLAG;
+
 		UniformHandler m_uniformScene;
+		std::vector<std::unique_ptr<InstanceBuffer>> m_instanceBuffers;
+		std::map<PipelineMaterial *, std::vector<std::unique_ptr<DescriptorsHandler>>> m_batchDescriptors;
+		std::vector<InstanceBatch> m_batches;
+		uint32_t m_batchCount;
+		std::vector<MaterialInstance> m_instances;
+		std::vector<MeshRender *> m_meshRenders;
+		RenderQueue m_renderQueue;
 	public:
 		RendererMeshes(const GraphicsStage &graphicsStage);
 
 		~RendererMeshes();
 
 		void Render(const CommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera) override;
+
+		/// <summary>
+		/// Gets the render queue of the last frame, its counters report how many binds were recorded and how many were skipped.
+		/// </summary>
+		/// <returns> The render queue. </returns>
+		const RenderQueue &GetRenderQueue() const { return m_renderQueue; }
+	private:
+		void UploadBatches();
+
+		void CmdRenderBatch(const CommandBuffer &commandBuffer, InstanceBatch &batch);
 	};
 }
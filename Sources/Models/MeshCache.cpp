@@ -0,0 +1,29 @@
+#include "MeshCache.hpp"
+
+namespace acid
+{
+	const uint32_t MeshCache::CACHE_MAGIC = 0x534D4D41; // "AMMS"
+	const uint32_t MeshCache::CACHE_VERSION = 1;
+
+	CacheFile MeshCache::CACHE = CacheFile("Meshes");
+
+	std::string MeshCache::GetDirectory()
+	{
+		return CACHE.GetDirectory();
+	}
+
+	void MeshCache::SetDirectory(const std::string &directory)
+	{
+		CACHE.SetDirectory(directory);
+	}
+
+	bool MeshCache::Save(const std::string &filename, const uint32_t &stride, const void *vertices, const uint32_t &vertexCount, const std::vector<uint32_t> &indices)
+	{
+		return CacheFile::Write(GetFilename(filename), CacheFile::CreateSourceEntry(CACHE_MAGIC, CACHE_VERSION, filename, stride, vertices, vertexCount, indices));
+	}
+
+	std::string MeshCache::GetFilename(const std::string &filename)
+	{
+		return CACHE.GetFilename(filename, ".amesh");
+	}
+}
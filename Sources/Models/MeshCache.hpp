@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Helpers/CacheFile.hpp"
+#include "Helpers/MappedFile.hpp"
+#include "VertexStream.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A cache of parsed meshes stored as '.amesh' files, the vertices and indices are written as they are uploaded so loading is a single copy out of a mapped file.
+	/// Entries are found by the source filename, and are stale once the source file changes size or modification time.
+	/// </summary>
+	class ACID_EXPORT MeshCache
+	{
+	private:
+		static const uint32_t CACHE_MAGIC;
+		static const uint32_t CACHE_VERSION;
+
+		static CacheFile CACHE;
+	public:
+		/// <summary>
+		/// Gets the directory cached meshes are stored in, defaults to 'Cache/Meshes' in the working directory.
+		/// </summary>
+		/// <returns> The cache directory. </returns>
+		static std::string GetDirectory();
+
+		/// <summary>
+		/// Sets the directory cached meshes are stored in.
+		/// </summary>
+		/// <param name="directory"> The new cache directory. </param>
+		static void SetDirectory(const std::string &directory);
+
+		/// <summary>
+		/// Loads a cached mesh.
+		/// </summary>
+		/// <param name="filename"> The source file the mesh was parsed from. </param>
+		/// <param name="vertices"> The loaded vertices. </param>
+		/// <param name="indices"> The loaded indices. </param>
+		/// <returns> If a valid cache entry was found. </returns>
+		template<typename T>
+		static bool Load(const std::string &filename, VertexStream<T> &vertices, std::vector<uint32_t> &indices)
+		{
+			MappedFile file(GetFilename(filename));
+			CacheFile::SourceHeader header = {};
+
+			if (!CacheFile::ReadSourceHeader(file, CACHE_MAGIC, CACHE_VERSION, filename, VertexStream<T>::GetStride(), header))
+			{
+				return false;
+			}
+
+			const char *vertexData = file.GetData() + CacheFile::GetVertexOffset(header);
+			vertices.Assign(reinterpret_cast<const T *>(vertexData), header.vertexCount);
+			indices.resize(header.indexCount);
+			memcpy(indices.data(), vertexData + (static_cast<size_t>(header.vertexCount) * VertexStream<T>::GetStride()), header.indexCount * sizeof(uint32_t));
+			return true;
+		}
+
+		/// <summary>
+		/// Saves a parsed mesh to the cache.
+		/// </summary>
+		/// <param name="filename"> The source file the mesh was parsed from. </param>
+		/// <param name="vertices"> The parsed vertices. </param>
+		/// <param name="indices"> The parsed indices. </param>
+		/// <returns> If the entry was written. </returns>
+		template<typename T>
+		static bool Save(const std::string &filename, const VertexStream<T> &vertices, const std::vector<uint32_t> &indices)
+		{
+			return Save(filename, VertexStream<T>::GetStride(), vertices.GetData(), static_cast<uint32_t>(vertices.GetCount()), indices);
+		}
+
+		/// <summary>
+		/// Saves a parsed mesh to the cache.
+		/// </summary>
+		/// <param name="filename"> The source file the mesh was parsed from. </param>
+		/// <param name="stride"> The size of a single vertex. </param>
+		/// <param name="vertices"> The vertex data. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		/// <param name="indices"> The parsed indices. </param>
+		/// <returns> If the entry was written. </returns>
+		static bool Save(const std::string &filename, const uint32_t &stride, const void *vertices, const uint32_t &vertexCount, const std::vector<uint32_t> &indices);
+	private:
+		static std::string GetFilename(const std::string &filename);
+	};
+}
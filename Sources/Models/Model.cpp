@@ -17,69 +17,39 @@ namespace acid
 	{
 	}
 
-	Model::Model(std::vector<IVertex *> &vertices, std::vector<uint32_t> &indices, const std::string &name) :
-		IResource(),
-		m_filename(name),
-		m_vertexBuffer(nullptr),
-		m_indexBuffer(nullptr),
-		m_pointCloud(std::vector<float>()),
-		m_minExtents(Vector3()),
-		m_maxExtents(Vector3())
+	Model::~Model()
 	{
-		void *verticesData = vertices[0]->GetData(vertices);
-		m_vertexBuffer = std::make_shared<VertexBuffer>(vertices[0]->GetSize(), vertices.size(), verticesData);
-		free(verticesData);
-
-		m_indexBuffer = std::make_shared<IndexBuffer>(VK_INDEX_TYPE_UINT32, sizeof(indices[0]), indices.size(), indices.data());
-
-		CalculateBounds(vertices);
-
-		for (auto &vertex : vertices)
-		{
-			delete vertex;
-		}
 	}
 
-	Model::Model(std::vector<IVertex *> &vertices, const std::string &name) :
-		IResource(),
-		m_filename(name),
-		m_vertexBuffer(nullptr),
-		m_indexBuffer(nullptr),
-		m_pointCloud(std::vector<float>()),
-		m_minExtents(Vector3()),
-		m_maxExtents(Vector3())
+	void Model::CmdRender(const CommandBuffer &commandBuffer, const uint32_t &instances)
 	{
-		void *verticesData = vertices[0]->GetData(vertices);
-		m_vertexBuffer = std::make_shared<VertexBuffer>(vertices[0]->GetSize(), vertices.size(), verticesData);
-		free(verticesData);
-
-		CalculateBounds(vertices);
+		CmdBind(commandBuffer);
+		CmdDraw(commandBuffer, instances);
+	}
 
-		for (auto &vertex : vertices)
+	void Model::CmdBind(const CommandBuffer &commandBuffer) const
+	{
+		if (m_vertexBuffer != nullptr)
 		{
-			delete vertex;
+			VkBuffer vertexBuffers[] = {m_vertexBuffer->GetBuffer()};
+			VkDeviceSize offsets[] = {0};
+			vkCmdBindVertexBuffers(commandBuffer.GetCommandBuffer(), 0, 1, vertexBuffers, offsets);
 		}
-	}
 
-	Model::~Model()
-	{
+		if (m_indexBuffer != nullptr)
+		{
+			vkCmdBindIndexBuffer(commandBuffer.GetCommandBuffer(), m_indexBuffer->GetBuffer(), 0, m_indexBuffer->GetIndexType());
+		}
 	}
 
-	void Model::CmdRender(const CommandBuffer &commandBuffer, const uint32_t &instances)
+	void Model::CmdDraw(const CommandBuffer &commandBuffer, const uint32_t &instances) const
 	{
 		if (m_vertexBuffer != nullptr && m_indexBuffer != nullptr)
 		{
-			VkBuffer vertexBuffers[] = {m_vertexBuffer->GetBuffer()};
-			VkDeviceSize offsets[] = {0};
-			vkCmdBindVertexBuffers(commandBuffer.GetCommandBuffer(), 0, 1, vertexBuffers, offsets);
-			vkCmdBindIndexBuffer(commandBuffer.GetCommandBuffer(), m_indexBuffer->GetBuffer(), 0, m_indexBuffer->GetIndexType());
 			vkCmdDrawIndexed(commandBuffer.GetCommandBuffer(), m_indexBuffer->GetIndexCount(), instances, 0, 0, 0);
 		}
 		else if (m_vertexBuffer != nullptr && m_indexBuffer == nullptr)
 		{
-			VkBuffer vertexBuffers[] = {m_vertexBuffer->GetBuffer()};
-			VkDeviceSize offsets[] = {0};
-			vkCmdBindVertexBuffers(commandBuffer.GetCommandBuffer(), 0, 1, vertexBuffers, offsets);
 			vkCmdDraw(commandBuffer.GetCommandBuffer(), m_vertexBuffer->GetVertexCount(), instances, 0, 0);
 		}
 		else
@@ -97,15 +67,16 @@ namespace acid
 		return std::max(min0, std::max(min1, std::max(max0, max1)));
 	}
 
-	void Model::Set(std::vector<IVertex *> &vertices, std::vector<uint32_t> &indices, const std::string &name)
+	void Model::Set(const void *vertices, const uint32_t &stride, const size_t &count, const size_t &positionOffset, const std::vector<uint32_t> &indices, const std::string &name)
 	{
 		m_filename = name;
+		m_vertexBuffer = nullptr;
+		m_indexBuffer = nullptr;
 
-		if (!vertices.empty())
+		// The vertices are already laid out as the GPU reads them, so they are copied straight into the staging ring.
+		if (count != 0)
 		{
-			void *verticesData = vertices[0]->GetData(vertices);
-			m_vertexBuffer = std::make_shared<VertexBuffer>(vertices[0]->GetSize(), vertices.size(), verticesData);
-			free(verticesData);
+			m_vertexBuffer = std::make_shared<VertexBuffer>(stride, count, vertices);
 		}
 
 		if (!indices.empty())
@@ -113,18 +84,13 @@ namespace acid
 			m_indexBuffer = std::make_shared<IndexBuffer>(VK_INDEX_TYPE_UINT32, sizeof(indices[0]), indices.size(), indices.data());
 		}
 
-		CalculateBounds(vertices);
-
-		for (auto &vertex : vertices)
-		{
-			delete vertex;
-		}
+		CalculateBounds(vertices, stride, count, positionOffset);
 	}
 
-	void Model::CalculateBounds(const std::vector<IVertex *> &vertices)
+	void Model::CalculateBounds(const void *vertices, const uint32_t &stride, const size_t &count, const size_t &positionOffset)
 	{
 		m_pointCloud.clear();
-		m_pointCloud.resize(vertices.size() * 3);
+		m_pointCloud.resize(count * 3);
 
 		m_minExtents.m_x = +std::numeric_limits<float>::infinity();
 		m_minExtents.m_y = +std::numeric_limits<float>::infinity();
@@ -133,16 +99,15 @@ namespace acid
 		m_maxExtents.m_y = -std::numeric_limits<float>::infinity();
 		m_maxExtents.m_z = -std::numeric_limits<float>::infinity();
 
-		int i = 0;
+		auto data = static_cast<const char *>(vertices);
 
-		for (auto &vertex : vertices)
+		for (size_t i = 0; i < count; i++)
 		{
-			Vector3 position = vertex->GetPosition();
+			const Vector3 &position = *reinterpret_cast<const Vector3 *>(data + (i * stride) + positionOffset);
 
-			m_pointCloud[i] = position.m_x;
-			m_pointCloud[i + 1] = position.m_y;
-			m_pointCloud[i + 2] = position.m_z;
-			i += 3;
+			m_pointCloud[i * 3] = position.m_x;
+			m_pointCloud[i * 3 + 1] = position.m_y;
+			m_pointCloud[i * 3 + 2] = position.m_z;
 
 			if (position.m_x < m_minExtents.m_x)
 			{
@@ -1,11 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include "Renderer/Buffers/IndexBuffer.hpp"
 #include "Renderer/Buffers/VertexBuffer.hpp"
 #include "Resources/Resources.hpp"
-#include "IVertex.hpp"
+#include "VertexStream.hpp"
 
 namespace acid
 {
@@ -35,16 +36,14 @@ namespace acid
 		/// Creates a new model.
 		/// </summary>
 		/// <param name="vertices"> The model vertices. </param>
-		/// <param name="indices"> The model indices. </param>
+		/// <param name="indices"> The model indices, if empty the vertices are drawn in order. </param>
 		/// <param name="name"> The model name. </param>
-		Model(std::vector<IVertex *> &vertices, std::vector<uint32_t> &indices, const std::string &name = "");
-
-		/// <summary>
-		/// Creates a new model without indices.
-		/// </summary>
-		/// <param name="vertices"> The model vertices. </param>
-		/// <param name="name"> The model name. </param>
-		Model(std::vector<IVertex *> &vertices, const std::string &name = "");
+		template<typename T>
+		explicit Model(const VertexStream<T> &vertices, const std::vector<uint32_t> &indices = {}, const std::string &name = "") :
+			Model()
+		{
+			Set(vertices, indices, name);
+		}
 
 		/// <summary>
 		/// Deconstructor for the model.
@@ -53,6 +52,19 @@ namespace acid
 
 		void CmdRender(const CommandBuffer &commandBuffer, const uint32_t &instances = 1);
 
+		/// <summary>
+		/// Binds the vertex and index buffers, so draws of this model can be recorded with <see cref="CmdDraw"/>.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		void CmdBind(const CommandBuffer &commandBuffer) const;
+
+		/// <summary>
+		/// Draws this model, the buffers must already be bound.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="instances"> The number of instances to draw. </param>
+		void CmdDraw(const CommandBuffer &commandBuffer, const uint32_t &instances = 1) const;
+
 		std::string GetFilename() override { return m_filename; }
 
 		Vector3 GetMinExtents() const { return m_minExtents; }
@@ -74,9 +86,21 @@ namespace acid
 		std::shared_ptr<IndexBuffer> GetIndexBuffer() const { return m_indexBuffer; }
 
 	protected:
-		void Set(std::vector<IVertex *> &vertices, std::vector<uint32_t> &indices, const std::string &name = "");
+		/// <summary>
+		/// Uploads the vertices and indices into the model buffers.
+		/// </summary>
+		/// <param name="vertices"> The model vertices, the vertex type must have a <c>m_position</c> member. </param>
+		/// <param name="indices"> The model indices, if empty the vertices are drawn in order. </param>
+		/// <param name="name"> The model name. </param>
+		template<typename T>
+		void Set(const VertexStream<T> &vertices, const std::vector<uint32_t> &indices, const std::string &name = "")
+		{
+			Set(vertices.GetData(), VertexStream<T>::GetStride(), vertices.GetCount(), offsetof(T, m_position), indices, name);
+		}
 
 	private:
-		void CalculateBounds(const std::vector<IVertex *> &vertices);
+		void Set(const void *vertices, const uint32_t &stride, const size_t &count, const size_t &positionOffset, const std::vector<uint32_t> &indices, const std::string &name);
+
+		void CalculateBounds(const void *vertices, const uint32_t &stride, const size_t &count, const size_t &positionOffset);
 	};
 }
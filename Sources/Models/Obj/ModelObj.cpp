@@ -1,117 +1,136 @@
 #include "ModelObj.hpp"
 
-#include "Helpers/FileSystem.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include "Helpers/MappedFile.hpp"
+#include "Models/MeshCache.hpp"
 
 namespace acid
 {
-	ModelObj::ModelObj(const std::string &filename) :
-		Model()
+	struct ObjCorner
 	{
-#if ACID_VERBOSE
-		float debugStart = Engine::Get()->GetTimeMs();
-#endif
+		int32_t position;
+		int32_t uv;
+		int32_t normal;
 
-		auto fileLoaded = FileSystem::ReadTextFile(filename);
+		bool operator==(const ObjCorner &other) const
+		{
+			return position == other.position && uv == other.uv && normal == other.normal;
+		}
+	};
 
-		if (!fileLoaded.has_value())
+	struct ObjCornerHash
+	{
+		size_t operator()(const ObjCorner &corner) const
 		{
-			return;
+			uint64_t hash = static_cast<uint32_t>(corner.position);
+			hash = (hash * 0x9E3779B97F4A7C15ull) ^ static_cast<uint32_t>(corner.uv);
+			hash = (hash * 0x9E3779B97F4A7C15ull) ^ static_cast<uint32_t>(corner.normal);
+			return static_cast<size_t>(hash ^ (hash >> 32));
 		}
+	};
+
+	static bool IsSpace(const char &c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
 
-		auto lines = FormatString::Split(fileLoaded.value(), "\n");
+	static const char *SkipSpaces(const char *first, const char *last)
+	{
+		while (first != last && IsSpace(*first))
+		{
+			first++;
+		}
 
-		auto indicesList = std::vector<uint32_t>();
-		auto verticesList = std::vector<VertexModelData *>();
-		auto uvsList = std::vector<Vector2>();
-		auto normalsList = std::vector<Vector3>();
+		return first;
+	}
 
-		for (auto &line : lines)
+	static const char *SkipToken(const char *first, const char *last)
+	{
+		while (first != last && !IsSpace(*first))
 		{
-			auto split = FormatString::Split(line, " ", true);
+			first++;
+		}
 
-			if (!split.empty())
-			{
-				std::string prefix = split[0];
+		return first;
+	}
 
-				if (prefix == "#")
-				{
-					continue;
-				}
-				else if (prefix == "v")
-				{
-					Vector3 vertex = Vector3(std::stof(split[1]), std::stof(split[2]), std::stof(split[3]));
-					VertexModelData *newVertex = new VertexModelData(static_cast<int>(verticesList.size()), vertex);
-					verticesList.emplace_back(newVertex);
-				}
-				else if (prefix == "vt")
-				{
-					Vector2 uv = Vector2(std::stof(split[1]), 1.0f - std::stof(split[2]));
-					uvsList.emplace_back(uv);
-				}
-				else if (prefix == "vn")
-				{
-					Vector3 normal = Vector3(std::stof(split[1]), std::stof(split[2]), std::stof(split[3]));
-					normalsList.emplace_back(normal);
-				}
-				else if (prefix == "f")
-				{
-					// The split length of 3 faced + 1 for the f prefix.
-					if (split.size() != 4 || FormatString::Contains(line, "//"))
-					{
-						fprintf(stderr, "Error reading the OBJ '%s', it does not appear to be UV mapped! The model will not be loaded.\n", filename.c_str());
-						throw std::runtime_error("Model loading error.");
-					}
+	static const char *ParseFloat(const char *first, const char *last, float &value)
+	{
+		first = SkipSpaces(first, last);
 
-					auto vertex1 = FormatString::Split(split[1], "/");
-					auto vertex2 = FormatString::Split(split[2], "/");
-					auto vertex3 = FormatString::Split(split[3], "/");
+		if (first != last && *first == '+')
+		{
+			first++;
+		}
 
-					VertexModelData *v0 = ProcessDataVertex(Vector3(std::stof(vertex1[0]), std::stof(vertex1[1]), std::stof(vertex1[2])), &verticesList, &indicesList);
-					VertexModelData *v1 = ProcessDataVertex(Vector3(std::stof(vertex2[0]), std::stof(vertex2[1]), std::stof(vertex2[2])), &verticesList, &indicesList);
-					VertexModelData *v2 = ProcessDataVertex(Vector3(std::stof(vertex3[0]), std::stof(vertex3[1]), std::stof(vertex3[2])), &verticesList, &indicesList);
-					CalculateTangents(v0, v1, v2, &uvsList);
-				}
-				else if (prefix == "o")
-				{
-				}
-				else if (prefix == "s")
-				{
-				}
-				else
-				{
-					fprintf(stderr, "OBJ '%s' unknown line: '%s'\n", filename.c_str(), line.c_str());
-				}
-			}
+#ifdef __cpp_lib_to_chars
+		auto result = std::from_chars(first, last, value);
+
+		if (result.ec != std::errc())
+		{
+			value = 0.0f;
+			return SkipToken(first, last);
 		}
 
-		// Averages out vertex tangents, and disabled non set vertices,
-		for (auto &current : verticesList)
+		return result.ptr;
+#else
+		// Without floating point from_chars the token is copied out, the mapped file is not null terminated.
+		char token[64];
+		const char *tokenEnd = SkipToken(first, last);
+		size_t size = std::min(static_cast<size_t>(tokenEnd - first), sizeof(token) - 1);
+		memcpy(token, first, size);
+		token[size] = '\0';
+		value = strtof(token, nullptr);
+		return tokenEnd;
+#endif
+	}
+
+	static const char *ParseIndex(const char *first, const char *last, const size_t &count, int32_t &index)
+	{
+		int32_t value = 0;
+		auto result = std::from_chars(first, last, value);
+
+		if (result.ec != std::errc() || value == 0)
 		{
-			current->AverageTangents();
+			index = -1;
+			return result.ptr;
+		}
 
-			if (!current->IsSet())
-			{
-				current->SetUvIndex(0);
-				current->SetNormalIndex(0);
-			}
+		if (value < 0 && static_cast<size_t>(-static_cast<int64_t>(value)) > count)
+		{
+			// A relative index before the first element is given the count, so it fails the range check instead of reading as missing or negative.
+			index = static_cast<int32_t>(count);
+			return result.ptr;
 		}
 
-		std::vector<IVertex *> vertices = std::vector<IVertex *>();
-		std::vector<uint32_t> indices = std::vector<uint32_t>();
+		// Negative indices count back from the last element read.
+		index = value < 0 ? static_cast<int32_t>(count) + value : value - 1;
+		return result.ptr;
+	}
 
-		indices.swap(indicesList);
+	ModelObj::ModelObj(const std::string &filename, const bool &upload) :
+		Model(),
+		m_loadFilename(filename),
+		m_loadVertices(VertexStream<VertexModel>()),
+		m_loadIndices(std::vector<uint32_t>())
+	{
+#if ACID_VERBOSE
+		float debugStart = Engine::Get()->GetTimeMs();
+#endif
 
-		// Turns the loaded data into a format that can be used by OpenGL.
-		for (auto &current : verticesList)
+		if (!MeshCache::Load(filename, m_loadVertices, m_loadIndices))
 		{
-			Vector3 position = current->GetPosition();
-			Vector2 textures = uvsList[current->GetUvIndex()];
-			Vector3 normal = normalsList[current->GetNormalIndex()];
-			Vector3 tangent = current->GetAverageTangent();
-
-			vertices.emplace_back(new VertexModel(position, textures, normal, tangent));
+			if (!Parse(filename))
+			{
+				return;
+			}
 
-			delete current;
+			MeshCache::Save(filename, m_loadVertices, m_loadIndices);
 		}
 
 #if ACID_VERBOSE
@@ -119,71 +138,216 @@ namespace acid
 		fprintf(stdout, "Obj '%s' loaded in %fms\n", filename.c_str(), debugEnd - debugStart);
 #endif
 
-		Model::Set(vertices, indices, filename);
+		if (upload)
+		{
+			Upload();
+		}
 	}
 
-
-	VertexModelData *ModelObj::ProcessDataVertex(const Vector3 &vertex, std::vector<VertexModelData *> *vertices, std::vector<uint32_t> *indices)
+	ModelObj::~ModelObj()
 	{
-		int index = static_cast<int>(vertex.m_x) - 1;
-		int textureIndex = static_cast<int>(vertex.m_y) - 1;
-		int normalIndex = static_cast<int>(vertex.m_z) - 1;
-		VertexModelData *currentVertex = (*vertices)[index];
+	}
 
-		if (!currentVertex->IsSet())
+	void ModelObj::Upload()
+	{
+		if (m_loadVertices.IsEmpty())
 		{
-			currentVertex->SetUvIndex(textureIndex);
-			currentVertex->SetNormalIndex(normalIndex);
-			indices->emplace_back(index);
-			return currentVertex;
+			return;
 		}
 
-		return DealWithAlreadyProcessedDataVertex(currentVertex, textureIndex, normalIndex, indices, vertices);
+		Model::Set(m_loadVertices, m_loadIndices, m_loadFilename);
+		m_loadVertices = VertexStream<VertexModel>();
+		m_loadIndices = std::vector<uint32_t>();
 	}
 
-	VertexModelData *ModelObj::DealWithAlreadyProcessedDataVertex(VertexModelData *previousVertex, const int &newTextureIndex, const int &newNormalIndex, std::vector<uint32_t> *indices, std::vector<VertexModelData *> *vertices)
+	bool ModelObj::Parse(const std::string &filename)
 	{
-		if (previousVertex->HasSameTextureAndNormal(newTextureIndex, newNormalIndex))
+		MappedFile file(filename);
+
+		if (!file.IsOpen())
 		{
-			indices->emplace_back(previousVertex->GetIndex());
-			return previousVertex;
+			fprintf(stderr, "Could not open OBJ: '%s'\n", filename.c_str());
+			return false;
 		}
 
-		VertexModelData *anotherVertex = previousVertex->GetDuplicateVertex();
+		auto positions = std::vector<Vector3>();
+		auto uvs = std::vector<Vector2>();
+		auto normals = std::vector<Vector3>();
+		auto generateNormals = std::vector<bool>();
+		auto vertexIndices = std::unordered_map<ObjCorner, uint32_t, ObjCornerHash>();
+		auto faceIndices = std::vector<uint32_t>();
 
-		if (anotherVertex != nullptr)
+		// Corners are deduplicated by the position, UV and normal they reference, so shared corners become one vertex.
+		auto findVertex = [&](const ObjCorner &corner) -> uint32_t
 		{
-			return DealWithAlreadyProcessedDataVertex(anotherVertex, newTextureIndex, newNormalIndex, indices, vertices);
-		}
+			auto it = vertexIndices.find(corner);
 
-		VertexModelData *duplicateVertex = new VertexModelData(static_cast<uint32_t>(vertices->size()), previousVertex->GetPosition());
-		duplicateVertex->SetUvIndex(newTextureIndex);
-		duplicateVertex->SetNormalIndex(newNormalIndex);
-		previousVertex->SetDuplicateVertex(duplicateVertex);
-		vertices->emplace_back(duplicateVertex);
-		indices->emplace_back(duplicateVertex->GetIndex());
-		return duplicateVertex;
-	}
+			if (it != vertexIndices.end())
+			{
+				return it->second;
+			}
 
-	void ModelObj::CalculateTangents(VertexModelData *v0, VertexModelData *v1, VertexModelData *v2, std::vector<Vector2> *uvs)
-	{
-		Vector2 uv0 = (*uvs)[v0->GetUvIndex()];
-		Vector2 uv1 = (*uvs)[v1->GetUvIndex()];
-		Vector2 uv2 = (*uvs)[v2->GetUvIndex()];
+			auto index = static_cast<uint32_t>(m_loadVertices.GetCount());
+			m_loadVertices.Add(positions[corner.position], corner.uv != -1 ? uvs[corner.uv] : Vector2::ZERO,
+				corner.normal != -1 ? normals[corner.normal] : Vector3::ZERO, Vector3::ZERO);
+			generateNormals.emplace_back(corner.normal == -1);
+			vertexIndices.emplace(corner, index);
+			return index;
+		};
+
+		const char *data = file.GetData();
+		const char *end = data + file.GetSize();
+
+		while (data < end)
+		{
+			auto lineEnd = static_cast<const char *>(memchr(data, '\n', static_cast<size_t>(end - data)));
+
+			if (lineEnd == nullptr)
+			{
+				lineEnd = end;
+			}
+
+			const char *token = SkipSpaces(data, lineEnd);
+			const char *tokenEnd = SkipToken(token, lineEnd);
+			std::string_view keyword = std::string_view(token, static_cast<size_t>(tokenEnd - token));
+
+			if (keyword == "v")
+			{
+				Vector3 position = Vector3();
+				tokenEnd = ParseFloat(tokenEnd, lineEnd, position.m_x);
+				tokenEnd = ParseFloat(tokenEnd, lineEnd, position.m_y);
+				ParseFloat(tokenEnd, lineEnd, position.m_z);
+				positions.emplace_back(position);
+			}
+			else if (keyword == "vt")
+			{
+				Vector2 uv = Vector2();
+				tokenEnd = ParseFloat(tokenEnd, lineEnd, uv.m_x);
+				ParseFloat(tokenEnd, lineEnd, uv.m_y);
+				uv.m_y = 1.0f - uv.m_y;
+				uvs.emplace_back(uv);
+			}
+			else if (keyword == "vn")
+			{
+				Vector3 normal = Vector3();
+				tokenEnd = ParseFloat(tokenEnd, lineEnd, normal.m_x);
+				tokenEnd = ParseFloat(tokenEnd, lineEnd, normal.m_y);
+				ParseFloat(tokenEnd, lineEnd, normal.m_z);
+				normals.emplace_back(normal);
+			}
+			else if (keyword == "f")
+			{
+				faceIndices.clear();
+
+				// Each corner is 'v', 'v/vt', 'v//vn' or 'v/vt/vn'.
+				while ((token = SkipSpaces(tokenEnd, lineEnd)) != lineEnd)
+				{
+					ObjCorner corner = {-1, -1, -1};
+					tokenEnd = ParseIndex(token, lineEnd, positions.size(), corner.position);
+
+					if (tokenEnd != lineEnd && *tokenEnd == '/')
+					{
+						tokenEnd++;
 
-		Vector2 deltaUv1 = uv1 - uv0;
-		Vector2 deltaUv2 = uv2 - uv0;
-		float r = 1.0f / (deltaUv1.m_x * deltaUv2.m_y - deltaUv1.m_y * deltaUv2.m_x);
+						if (tokenEnd != lineEnd && *tokenEnd != '/')
+						{
+							tokenEnd = ParseIndex(tokenEnd, lineEnd, uvs.size(), corner.uv);
+						}
 
-		Vector3 deltaPos1 = v1->GetPosition() - v0->GetPosition();
-		Vector3 deltaPos2 = v2->GetPosition() - v0->GetPosition();
-		deltaPos1 *= deltaUv2.m_y;
-		deltaPos2 *= deltaUv1.m_y;
+						if (tokenEnd != lineEnd && *tokenEnd == '/')
+						{
+							tokenEnd = ParseIndex(tokenEnd + 1, lineEnd, normals.size(), corner.normal);
+						}
+					}
+
+					tokenEnd = SkipToken(tokenEnd, lineEnd);
+
+					if (corner.position < 0 || corner.position >= static_cast<int32_t>(positions.size()) ||
+						corner.uv >= static_cast<int32_t>(uvs.size()) || corner.normal >= static_cast<int32_t>(normals.size()))
+					{
+						fprintf(stderr, "Error reading the OBJ '%s', a face references a element that does not exist! The model will not be loaded.\n", filename.c_str());
+						throw std::runtime_error("Model loading error.");
+					}
+
+					faceIndices.emplace_back(findVertex(corner));
+				}
+
+				// Quads and n-gons are split into a fan around the first corner.
+				for (size_t i = 2; i < faceIndices.size(); i++)
+				{
+					uint32_t i0 = faceIndices[0];
+					uint32_t i1 = faceIndices[i - 1];
+					uint32_t i2 = faceIndices[i];
+					m_loadIndices.emplace_back(i0);
+					m_loadIndices.emplace_back(i1);
+					m_loadIndices.emplace_back(i2);
+
+					VertexModel &v0 = m_loadVertices[i0];
+					VertexModel &v1 = m_loadVertices[i1];
+					VertexModel &v2 = m_loadVertices[i2];
+					Vector3 deltaPos1 = v1.m_position - v0.m_position;
+					Vector3 deltaPos2 = v2.m_position - v0.m_position;
+
+					// The face normal is weighted by the face area, and accumulated into corners that have no normal.
+					if (generateNormals[i0] || generateNormals[i1] || generateNormals[i2])
+					{
+						Vector3 faceNormal = deltaPos1.Cross(deltaPos2);
+
+						if (generateNormals[i0])
+						{
+							v0.m_normal += faceNormal;
+						}
+
+						if (generateNormals[i1])
+						{
+							v1.m_normal += faceNormal;
+						}
+
+						if (generateNormals[i2])
+						{
+							v2.m_normal += faceNormal;
+						}
+					}
+
+					Vector2 deltaUv1 = v1.m_uv - v0.m_uv;
+					Vector2 deltaUv2 = v2.m_uv - v0.m_uv;
+					float determinant = deltaUv1.m_x * deltaUv2.m_y - deltaUv1.m_y * deltaUv2.m_x;
+
+					// Faces without UVs have no tangent space.
+					if (determinant != 0.0f)
+					{
+						Vector3 tangent = (1.0f / determinant) * ((deltaPos1 * deltaUv2.m_y) - (deltaPos2 * deltaUv1.m_y));
+						v0.m_tangent += tangent;
+						v1.m_tangent += tangent;
+						v2.m_tangent += tangent;
+					}
+				}
+			}
+			else if (!keyword.empty() && keyword[0] != '#' && keyword != "o" && keyword != "g" && keyword != "s" && keyword != "mtllib" && keyword != "usemtl")
+			{
+				fprintf(stderr, "OBJ '%s' unknown line: '%s'\n", filename.c_str(), std::string(data, lineEnd).c_str());
+			}
+
+			// The last line may not end with a newline, then the line ends at the end of the file.
+			data = lineEnd == end ? end : lineEnd + 1;
+		}
 
-		Vector3 tangent = Vector3(r * (deltaPos1 - deltaPos2));
+		// Averages out vertex tangents and generated normals.
+		for (uint32_t i = 0; i < m_loadVertices.GetCount(); i++)
+		{
+			VertexModel &vertex = m_loadVertices[i];
+
+			if (generateNormals[i] && vertex.m_normal.Length() != 0.0f)
+			{
+				vertex.m_normal = vertex.m_normal.Normalize();
+			}
+
+			if (vertex.m_tangent.Length() != 0.0f)
+			{
+				vertex.m_tangent = vertex.m_tangent.Normalize();
+			}
+		}
 
-		v0->AddTangent(tangent);
-		v1->AddTangent(tangent);
-		v2->AddTangent(tangent);
+		return true;
 	}
 }
@@ -1,16 +1,17 @@
 #pragma once
 
-#include <functional>
-#include "Helpers/FormatString.hpp"
 #include "Models/Model.hpp"
 #include "Models/VertexModel.hpp"
-#include "Models/VertexModelData.hpp"
 
 namespace acid
 {
 	class ACID_EXPORT ModelObj :
 		public Model
 	{
+	private:
+		std::string m_loadFilename;
+		VertexStream<VertexModel> m_loadVertices;
+		std::vector<uint32_t> m_loadIndices;
 	public:
 		static std::shared_ptr<ModelObj> Resource(const std::string &filename)
 		{
@@ -27,13 +28,34 @@ namespace acid
 			return result;
 		}
 
-		ModelObj(const std::string &filename);
+		static ResourceFuture<ModelObj> ResourceAsync(const std::string &filename)
+		{
+			std::string realFilename = Files::SearchFile(filename);
+			return Resources::Get()->LoadAsync<ModelObj>(realFilename, [realFilename]()
+			{
+				return std::make_shared<ModelObj>(realFilename, false);
+			}, [](ModelObj &model)
+			{
+				model.Upload();
+			});
+		}
 
-	private:
-		VertexModelData *ProcessDataVertex(const Vector3 &vertex, std::vector<VertexModelData *> *vertices, std::vector<uint32_t> *indices);
+		/// <summary>
+		/// Creates a new model from a OBJ file, or from the mesh cache if the file has been parsed before.
+		/// Faces with more than three corners are triangulated as fans, and corners without UVs or normals are given zero UVs and generated normals.
+		/// </summary>
+		/// <param name="filename"> The file to load the model from. </param>
+		/// <param name="upload"> If the parsed vertices will be uploaded right away, otherwise <see cref="#Upload()"/> must be called from the main thread. </param>
+		ModelObj(const std::string &filename, const bool &upload = true);
 
-		VertexModelData *DealWithAlreadyProcessedDataVertex(VertexModelData *previousVertex, const int &newTextureIndex, const int &newNormalIndex, std::vector<uint32_t> *indices, std::vector<VertexModelData *> *vertices);
+		~ModelObj();
 
-		void CalculateTangents(VertexModelData *v0, VertexModelData *v1, VertexModelData *v2, std::vector<Vector2> *uvs);
+		/// <summary>
+		/// Uploads the parsed vertices into the model buffers, does nothing if the model has already been uploaded.
+		/// </summary>
+		void Upload();
+
+	private:
+		bool Parse(const std::string &filename);
 	};
 }
@@ -15,8 +15,9 @@ namespace acid
 
 	void MeshSimple::GenerateMesh()
 	{
-		auto vertices = std::vector<IVertex *>();
+		auto vertices = VertexStream<VertexModel>();
 		auto indices = std::vector<uint32_t>();
+		vertices.Reserve(m_vertexCount * m_vertexCount);
 
 		// Creates and stores vertices.
 		for (int col = 0; col < m_vertexCount; col++)
@@ -33,7 +34,7 @@ namespace acid
 				);
 				Vector3 normal = GetNormal(x, z, position);
 				Vector3 colour = GetColour(position, normal);
-				vertices.emplace_back(new VertexModel(position, uv, normal, colour));
+				vertices.Add(position, uv, normal, colour);
 			}
 		}
 
@@ -8,8 +8,9 @@ namespace acid
 	ModelCylinder::ModelCylinder(const float &radiusBase, const float &radiusTop, const float &height, const uint32_t &slices, const uint32_t &stacks) :
 		Model()
 	{
-		auto vertices = std::vector<IVertex *>();
+		auto vertices = VertexStream<VertexModel>();
 		auto indices = std::vector<uint32_t>();
+		vertices.Reserve((slices + 1) * (stacks + 1));
 
 		for (uint32_t i = 0; i < slices + 1; i++)
 		{
@@ -23,17 +24,15 @@ namespace acid
 				float jDivStacks = static_cast<float>(j) / static_cast<float>(stacks);
 				float radius = radiusBase * (1.0f - jDivStacks) + radiusTop * jDivStacks;
 
-				VertexModel *vertex = new VertexModel();
-				vertex->m_position.m_x = xDir * radius;
-				vertex->m_position.m_y = jDivStacks * height - (height / 2.0f);
-				vertex->m_position.m_z = zDir * radius;
-				vertex->m_uv.m_x = 1.0f - iDivSlices;
-				vertex->m_uv.m_y = 1.0f - jDivStacks;
-				vertex->m_normal.m_x = xDir;
-				vertex->m_normal.m_y = 0.0f;
-				vertex->m_normal.m_z = zDir;
-
-				vertices.emplace_back(vertex);
+				VertexModel &vertex = vertices.Add();
+				vertex.m_position.m_x = xDir * radius;
+				vertex.m_position.m_y = jDivStacks * height - (height / 2.0f);
+				vertex.m_position.m_z = zDir * radius;
+				vertex.m_uv.m_x = 1.0f - iDivSlices;
+				vertex.m_uv.m_y = 1.0f - jDivStacks;
+				vertex.m_normal.m_x = xDir;
+				vertex.m_normal.m_y = 0.0f;
+				vertex.m_normal.m_z = zDir;
 			}
 		}
 
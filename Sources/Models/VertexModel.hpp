@@ -1,15 +1,13 @@
 #pragma once
 
-#include <vector>
 #include "Maths/Vector2.hpp"
 #include "Maths/Vector3.hpp"
 #include "Renderer/Pipelines/PipelineCreate.hpp"
-#include "IVertex.hpp"
+#include "VertexStream.hpp"
 
 namespace acid
 {
-	class ACID_EXPORT VertexModel :
-		public IVertex
+	class ACID_EXPORT VertexModel
 	{
 	public:
 		Vector3 m_position;
@@ -19,13 +17,9 @@ namespace acid
 
 		VertexModel(const Vector3 &position = Vector3::ZERO, const Vector2 &uv = Vector2::ZERO, const Vector3 &normal = Vector3::ZERO, const Vector3 &tangent = Vector3::ZERO);
 
-		VertexModel(const VertexModel &source);
+		Vector3 GetPosition() const { return m_position; };
 
-		~VertexModel();
-
-		Vector3 GetPosition() const override { return m_position; };
-
-		void SetPosition(const Vector3 &position) override { m_position = position; };
+		void SetPosition(const Vector3 &position) { m_position = position; };
 
 		Vector2 GetUv() const { return m_uv; };
 
@@ -39,10 +33,6 @@ namespace acid
 
 		void SetTangent(const Vector3 &tangent) { m_tangent = tangent; };
 
-		size_t GetSize() const override { return sizeof(VertexModel); }
-
-		void *GetData(std::vector<IVertex *> &vertices) override;
-
-		static VertexInput GetVertexInput();
+		static VertexInput GetVertexInput(const uint32_t &binding = 0);
 	};
 }
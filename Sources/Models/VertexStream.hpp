@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include "Maths/Colour.hpp"
+#include "Maths/Vector2.hpp"
+#include "Maths/Vector3.hpp"
+#include "Maths/Vector4.hpp"
+#include "Renderer/Pipelines/PipelineCreate.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Maps the type of a vertex member to the format the vertex shader reads it as.
+	/// </summary>
+	template<typename T>
+	struct VertexFormat
+	{
+	};
+
+	template<>
+	struct VertexFormat<float>
+	{
+		static constexpr VkFormat value = VK_FORMAT_R32_SFLOAT;
+	};
+
+	template<>
+	struct VertexFormat<int32_t>
+	{
+		static constexpr VkFormat value = VK_FORMAT_R32_SINT;
+	};
+
+	template<>
+	struct VertexFormat<uint32_t>
+	{
+		static constexpr VkFormat value = VK_FORMAT_R32_UINT;
+	};
+
+	template<>
+	struct VertexFormat<Vector2>
+	{
+		static constexpr VkFormat value = VK_FORMAT_R32G32_SFLOAT;
+	};
+
+	template<>
+	struct VertexFormat<Vector3>
+	{
+		static constexpr VkFormat value = VK_FORMAT_R32G32B32_SFLOAT;
+	};
+
+	template<>
+	struct VertexFormat<Vector4>
+	{
+		static constexpr VkFormat value = VK_FORMAT_R32G32B32A32_SFLOAT;
+	};
+
+	template<>
+	struct VertexFormat<Colour>
+	{
+		static constexpr VkFormat value = VK_FORMAT_R32G32B32A32_SFLOAT;
+	};
+
+	/// <summary>
+	/// Describes where a member of a vertex struct is read from.
+	/// </summary>
+	struct VertexElement
+	{
+		uint32_t location;
+		VkFormat format;
+		uint32_t offset;
+
+		/// <summary>
+		/// Creates an element with the format of a member type, used as <c>Create&lt;decltype(T::m_member)&gt;(location, offsetof(T, m_member))</c>.
+		/// </summary>
+		/// <param name="location"> The shader input location. </param>
+		/// <param name="offset"> The offset of the member in the vertex. </param>
+		/// <returns> The vertex element. </returns>
+		template<typename M>
+		static constexpr VertexElement Create(const uint32_t &location, const size_t &offset)
+		{
+			return {location, VertexFormat<M>::value, static_cast<uint32_t>(offset)};
+		}
+	};
+
+	/// <summary>
+	/// A contiguous array of plain vertex structs that is uploaded as is, interleaving every member of the vertex into one binding.
+	/// </summary>
+	/// <typeparam name="T"> The vertex type, it can not have virtual functions. </typeparam>
+	template<typename T>
+	class VertexStream
+	{
+		static_assert(std::is_standard_layout<T>::value && !std::is_polymorphic<T>::value, "Vertices must be plain structs so they can be copied directly into a vertex buffer");
+	private:
+		std::vector<T> m_vertices;
+	public:
+		/// <summary>
+		/// Creates a new empty vertex stream.
+		/// </summary>
+		VertexStream() :
+			m_vertices(std::vector<T>())
+		{
+		}
+
+		/// <summary>
+		/// Creates a new vertex stream from a list of vertices.
+		/// </summary>
+		/// <param name="vertices"> The vertices. </param>
+		VertexStream(std::initializer_list<T> vertices) :
+			m_vertices(vertices)
+		{
+		}
+
+		void Reserve(const size_t &count) { m_vertices.reserve(count); }
+
+		void Clear() { m_vertices.clear(); }
+
+		/// <summary>
+		/// Replaces the vertices of this stream with a copy of an array of vertices.
+		/// </summary>
+		/// <param name="vertices"> The vertices to copy. </param>
+		/// <param name="count"> The number of vertices. </param>
+		void Assign(const T *vertices, const size_t &count) { m_vertices.assign(vertices, vertices + count); }
+
+		/// <summary>
+		/// Constructs a vertex in place at the end of the stream.
+		/// </summary>
+		/// <param name="args"> The vertex constructor arguments. </param>
+		/// <returns> The new vertex. </returns>
+		template<typename... Args>
+		T &Add(Args &&... args)
+		{
+			m_vertices.emplace_back(std::forward<Args>(args)...);
+			return m_vertices.back();
+		}
+
+		size_t GetCount() const { return m_vertices.size(); }
+
+		bool IsEmpty() const { return m_vertices.empty(); }
+
+		const T *GetData() const { return m_vertices.data(); }
+
+		T &operator[](const size_t &index) { return m_vertices[index]; }
+
+		const T &operator[](const size_t &index) const { return m_vertices[index]; }
+
+		typename std::vector<T>::iterator begin() { return m_vertices.begin(); }
+
+		typename std::vector<T>::iterator end() { return m_vertices.end(); }
+
+		typename std::vector<T>::const_iterator begin() const { return m_vertices.begin(); }
+
+		typename std::vector<T>::const_iterator end() const { return m_vertices.end(); }
+
+		/// <summary>
+		/// Gets the size of a single vertex in this stream.
+		/// </summary>
+		/// <returns> The vertex stride. </returns>
+		static constexpr uint32_t GetStride() { return static_cast<uint32_t>(sizeof(T)); }
+
+		/// <summary>
+		/// Creates the vertex input for this vertex type, with every attribute read from a single binding.
+		/// </summary>
+		/// <param name="binding"> The binding the stream is bound to. </param>
+		/// <param name="elements"> The members of the vertex that are read as attributes. </param>
+		/// <returns> The vertex input. </returns>
+		static VertexInput GetVertexInput(const uint32_t &binding, std::initializer_list<VertexElement> elements)
+		{
+			std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
+			bindingDescriptions[0].binding = binding;
+			bindingDescriptions[0].stride = GetStride();
+			bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+			std::vector<VkVertexInputAttributeDescription> attributeDescriptions = std::vector<VkVertexInputAttributeDescription>();
+
+			for (auto &element : elements)
+			{
+				VkVertexInputAttributeDescription attributeDescription = {};
+				attributeDescription.binding = binding;
+				attributeDescription.location = element.location;
+				attributeDescription.format = element.format;
+				attributeDescription.offset = element.offset;
+				attributeDescriptions.emplace_back(attributeDescription);
+			}
+
+			return VertexInput(bindingDescriptions, attributeDescriptions);
+		}
+	};
+}
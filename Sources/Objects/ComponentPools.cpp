@@ -0,0 +1,211 @@
+#include "ComponentPools.hpp"
+
+#include <algorithm>
+#include "IComponent.hpp"
+
+namespace acid
+{
+	const std::size_t ComponentPools::SIZE_ALIGNMENT = alignof(std::max_align_t);
+	const uint32_t ComponentPools::BLOCK_COMPONENTS = 64;
+
+	std::map<std::type_index, uint32_t> ComponentPools::TYPE_IDS = std::map<std::type_index, uint32_t>();
+	std::vector<ComponentPools::TypeMatch> ComponentPools::TYPE_MATCHES = std::vector<ComponentPools::TypeMatch>();
+	bool ComponentPools::TYPE_MATCHES_ADDED = false;
+	std::mutex ComponentPools::TYPE_MUTEX = {};
+
+	std::vector<std::vector<IComponent *>> ComponentPools::POOLS = std::vector<std::vector<IComponent *>>();
+	std::vector<std::vector<int8_t>> ComponentPools::POOL_MATCHES = std::vector<std::vector<int8_t>>();
+	std::vector<IComponent *> ComponentPools::UNSTARTED = std::vector<IComponent *>();
+
+	std::map<std::size_t, ComponentPools::SizePool> ComponentPools::SIZE_POOLS = std::map<std::size_t, ComponentPools::SizePool>();
+	std::mutex ComponentPools::SIZE_MUTEX = {};
+
+	uint32_t ComponentPools::GetTypeId(const std::type_index &type, const TypeMatch &typeMatch)
+	{
+		std::lock_guard<std::mutex> lock(TYPE_MUTEX);
+		uint32_t typeId = TYPE_IDS.emplace(type, static_cast<uint32_t>(TYPE_IDS.size())).first->second;
+
+		if (typeId >= TYPE_MATCHES.size())
+		{
+			TYPE_MATCHES.resize(typeId + 1, nullptr);
+		}
+
+		if (typeMatch != nullptr && TYPE_MATCHES[typeId] == nullptr)
+		{
+			TYPE_MATCHES[typeId] = typeMatch;
+			TYPE_MATCHES_ADDED = true;
+
+			if (typeId >= POOL_MATCHES.size())
+			{
+				POOL_MATCHES.resize(typeId + 1);
+			}
+
+			// Every component in a pool has the same type, so one check decides for the whole pool. Empty pools are decided by their first component.
+			auto &matches = POOL_MATCHES[typeId];
+			matches.assign(POOLS.size(), -1);
+
+			for (uint32_t pool = 0; pool < POOLS.size(); pool++)
+			{
+				if (!POOLS[pool].empty())
+				{
+					matches[pool] = typeMatch(POOLS[pool][0]);
+				}
+			}
+		}
+
+		return typeId;
+	}
+
+	std::vector<ComponentPools::TypeMatch> ComponentPools::GetTypeMatches()
+	{
+		std::lock_guard<std::mutex> lock(TYPE_MUTEX);
+		return TYPE_MATCHES;
+	}
+
+	bool ComponentPools::TakeTypeMatchesAdded()
+	{
+		std::lock_guard<std::mutex> lock(TYPE_MUTEX);
+		bool added = TYPE_MATCHES_ADDED;
+		TYPE_MATCHES_ADDED = false;
+		return added;
+	}
+
+	std::vector<bool> ComponentPools::GetPoolMatches(const uint32_t &typeId)
+	{
+		std::lock_guard<std::mutex> lock(TYPE_MUTEX);
+
+		if (typeId >= POOL_MATCHES.size())
+		{
+			return std::vector<bool>();
+		}
+
+		auto &matches = POOL_MATCHES[typeId];
+		auto poolMatches = std::vector<bool>(matches.size());
+
+		for (uint32_t pool = 0; pool < matches.size(); pool++)
+		{
+			poolMatches[pool] = matches[pool] == 1;
+		}
+
+		return poolMatches;
+	}
+
+	void ComponentPools::Add(IComponent *component)
+	{
+		uint32_t typeId = GetTypeId(std::type_index(typeid(*component)));
+		std::lock_guard<std::mutex> lock(TYPE_MUTEX);
+
+		if (typeId >= POOLS.size())
+		{
+			POOLS.resize(typeId + 1);
+		}
+
+		component->m_typeId = typeId;
+		component->m_poolIndex = static_cast<uint32_t>(POOLS[typeId].size());
+		POOLS[typeId].emplace_back(component);
+
+		// The first component of a pool decides the pool for the type checks added before it.
+		if (POOLS[typeId].size() == 1)
+		{
+			for (uint32_t matchId = 0; matchId < POOL_MATCHES.size(); matchId++)
+			{
+				if (TYPE_MATCHES[matchId] == nullptr)
+				{
+					continue;
+				}
+
+				auto &matches = POOL_MATCHES[matchId];
+
+				if (typeId >= matches.size())
+				{
+					matches.resize(typeId + 1, -1);
+				}
+
+				if (matches[typeId] == -1)
+				{
+					matches[typeId] = TYPE_MATCHES[matchId](component);
+				}
+			}
+		}
+
+		if (!component->IsStarted())
+		{
+			UNSTARTED.emplace_back(component);
+		}
+	}
+
+	void ComponentPools::Remove(IComponent *component)
+	{
+		if (component->m_typeId >= POOLS.size())
+		{
+			return;
+		}
+
+		auto &pool = POOLS[component->m_typeId];
+		uint32_t index = component->m_poolIndex;
+
+		if (index >= pool.size() || pool[index] != component)
+		{
+			return;
+		}
+
+		pool[index] = pool.back();
+		pool[index]->m_poolIndex = index;
+		pool.pop_back();
+
+		component->m_typeId = IComponent::NO_POOL;
+		component->m_poolIndex = IComponent::NO_POOL;
+
+		if (!component->IsStarted())
+		{
+			UNSTARTED.erase(std::remove(UNSTARTED.begin(), UNSTARTED.end(), component), UNSTARTED.end());
+		}
+	}
+
+	std::vector<IComponent *> ComponentPools::TakeUnstarted()
+	{
+		auto unstarted = std::vector<IComponent *>();
+		unstarted.swap(UNSTARTED);
+		return unstarted;
+	}
+
+	void ComponentPools::AddUnstarted(IComponent *component)
+	{
+		UNSTARTED.emplace_back(component);
+	}
+
+	void *ComponentPools::Allocate(const std::size_t &size)
+	{
+		std::size_t slotSize = (std::max(size, static_cast<std::size_t>(1)) + SIZE_ALIGNMENT - 1) & ~(SIZE_ALIGNMENT - 1);
+		std::lock_guard<std::mutex> lock(SIZE_MUTEX);
+		auto &sizePool = SIZE_POOLS[slotSize];
+
+		if (sizePool.free.empty())
+		{
+			// Blocks are never released, so a component never moves and the slots of a size stay close together.
+			char *block = static_cast<char *>(::operator new(slotSize * BLOCK_COMPONENTS));
+			sizePool.blocks.emplace_back(block);
+
+			for (uint32_t i = BLOCK_COMPONENTS; i > 0; i--)
+			{
+				sizePool.free.emplace_back(block + (slotSize * (i - 1)));
+			}
+		}
+
+		void *pointer = sizePool.free.back();
+		sizePool.free.pop_back();
+		return pointer;
+	}
+
+	void ComponentPools::Deallocate(void *pointer, const std::size_t &size)
+	{
+		if (pointer == nullptr)
+		{
+			return;
+		}
+
+		std::size_t slotSize = (std::max(size, static_cast<std::size_t>(1)) + SIZE_ALIGNMENT - 1) & ~(SIZE_ALIGNMENT - 1);
+		std::lock_guard<std::mutex> lock(SIZE_MUTEX);
+		SIZE_POOLS[slotSize].free.emplace_back(pointer);
+	}
+}
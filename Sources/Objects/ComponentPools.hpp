@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <typeindex>
+#include <vector>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	class IComponent;
+
+	/// <summary>
+	/// Every component attached to a game object is kept in a pool of its exact type, so all components of a type can be iterated without casting.
+	/// Component memory is allocated from blocks shared by every component type of the same size class, so components are close to others of a similar size and never move.
+	/// Components are attached and detached on the thread updating the scene.
+	/// </summary>
+	class ACID_EXPORT ComponentPools
+	{
+	public:
+		using TypeMatch = bool(*)(IComponent *);
+	private:
+		struct SizePool
+		{
+			std::vector<char *> blocks;
+			std::vector<void *> free;
+		};
+
+		static const std::size_t SIZE_ALIGNMENT;
+		static const uint32_t BLOCK_COMPONENTS;
+
+		static std::map<std::type_index, uint32_t> TYPE_IDS;
+		static std::vector<TypeMatch> TYPE_MATCHES;
+		static bool TYPE_MATCHES_ADDED;
+		static std::mutex TYPE_MUTEX;
+
+		static std::vector<std::vector<IComponent *>> POOLS;
+		static std::vector<std::vector<int8_t>> POOL_MATCHES;
+		static std::vector<IComponent *> UNSTARTED;
+
+		static std::map<std::size_t, SizePool> SIZE_POOLS;
+		static std::mutex SIZE_MUTEX;
+	public:
+		/// <summary>
+		/// Gets the id of a component type, ids are assigned in the order types are first used.
+		/// </summary>
+		/// <param name="type"> The component type. </param>
+		/// <param name="typeMatch"> Optionally checks if a component is the type, or derived from it. </param>
+		/// <returns> The type id. </returns>
+		static uint32_t GetTypeId(const std::type_index &type, const TypeMatch &typeMatch = nullptr);
+
+		/// <summary>
+		/// Gets the id of a component type, the id is only looked up the first time it is used.
+		/// </summary>
+		/// <param name="T"> The component type. </param>
+		/// <returns> The type id. </returns>
+		template<typename T>
+		static uint32_t GetTypeId()
+		{
+			static const uint32_t typeId = GetTypeId(std::type_index(typeid(T)), [](IComponent *component)
+			{
+				return dynamic_cast<T *>(component) != nullptr;
+			});
+			return typeId;
+		}
+
+		/// <summary>
+		/// Gets the type checks of every type id, a type only has a check once it has been looked up by <see cref="GetTypeId{T}"/>.
+		/// </summary>
+		/// <returns> The type checks, indexed by type id. </returns>
+		static std::vector<TypeMatch> GetTypeMatches();
+
+		/// <summary>
+		/// Takes if type checks have been added since this was last called, the type indices of existing game objects do not have them yet.
+		/// </summary>
+		/// <returns> If type checks were added. </returns>
+		static bool TakeTypeMatchesAdded();
+
+		/// <summary>
+		/// Adds a component to the pool of its type, and queues it to be started.
+		/// </summary>
+		/// <param name="component"> The attached component. </param>
+		static void Add(IComponent *component);
+
+		/// <summary>
+		/// Removes a component from the pool of its type, the last component in the pool takes its place.
+		/// </summary>
+		/// <param name="component"> The detached component. </param>
+		static void Remove(IComponent *component);
+
+		static uint32_t GetPoolCount() { return static_cast<uint32_t>(POOLS.size()); }
+
+		/// <summary>
+		/// Gets the components in a pool, every component in a pool has the same type.
+		/// </summary>
+		/// <param name="pool"> The pool, the type id of the components. </param>
+		/// <returns> The components. </returns>
+		static const std::vector<IComponent *> &GetPool(const uint32_t &pool) { return POOLS[pool]; }
+
+		/// <summary>
+		/// Gets which pools hold components of a type, or derived from it. Pools are matched when the type check is added, and when a pool gets its first component.
+		/// </summary>
+		/// <param name="typeId"> The type id, with a type check. </param>
+		/// <returns> If each pool holds the type, indexed by pool. </returns>
+		static std::vector<bool> GetPoolMatches(const uint32_t &typeId);
+
+		/// <summary>
+		/// Calls a function with every attached component of a type, or derived from it.
+		/// </summary>
+		/// <param name="function"> The function called with each component. </param>
+		/// <param name="T"> The component type. </param>
+		template<typename T, typename F>
+		static void ForEach(const F &function)
+		{
+			// The matches are copied, they may be read from jobs while a job adds the check of another type.
+			auto poolMatches = GetPoolMatches(GetTypeId<T>());
+
+			for (uint32_t pool = 0; pool < poolMatches.size(); pool++)
+			{
+				if (!poolMatches[pool])
+				{
+					continue;
+				}
+
+				for (uint32_t i = 0; i < POOLS[pool].size(); i++)
+				{
+					function(static_cast<T *>(POOLS[pool][i]));
+				}
+			}
+		}
+
+		/// <summary>
+		/// Takes the components that have been attached but not started, in the order they were attached.
+		/// </summary>
+		/// <returns> The unstarted components. </returns>
+		static std::vector<IComponent *> TakeUnstarted();
+
+		/// <summary>
+		/// Queues a component to be started again, when its game object could not be started yet.
+		/// </summary>
+		/// <param name="component"> The unstarted component. </param>
+		static void AddUnstarted(IComponent *component);
+
+		/// <summary>
+		/// Allocates memory for a component from the blocks of its size.
+		/// </summary>
+		/// <param name="size"> The component size. </param>
+		/// <returns> The component memory. </returns>
+		static void *Allocate(const std::size_t &size);
+
+		/// <summary>
+		/// Returns memory for a component to the blocks of its size.
+		/// </summary>
+		/// <param name="pointer"> The component memory. </param>
+		/// <param name="size"> The component size. </param>
+		static void Deallocate(void *pointer, const std::size_t &size);
+	};
+}
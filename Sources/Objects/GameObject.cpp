@@ -6,10 +6,15 @@
 
 namespace acid
 {
+	const int32_t GameObject::TYPE_UNKNOWN = -2;
+	const int32_t GameObject::TYPE_MISSING = -1;
+
 	GameObject::GameObject(const Transform &transform, ISpatialStructure *structure) :
 		m_name(""),
 		m_transform(Transform(transform)),
+		m_renderTransform({}),
 		m_components(std::vector<IComponent *>()),
+		m_typeIndices(std::vector<int32_t>()),
 		m_structure(structure),
 		m_parent(nullptr),
 		m_removed(false)
@@ -57,6 +62,7 @@ namespace acid
 
 		for (auto &component : m_components)
 		{
+			ComponentPools::Remove(component);
 			delete component;
 		}
 	}
@@ -68,6 +74,8 @@ namespace acid
 			return;
 		}
 
+		bool started = false;
+
 		for (auto it = m_components.begin(); it != m_components.end(); ++it)
 		{
 			if ((*it) == nullptr || (*it)->GetGameObject() == nullptr)
@@ -79,6 +87,7 @@ namespace acid
 			{
 				(*it)->Start();
 				(*it)->SetStarted(true);
+				started = true;
 			}
 
 			if ((*it)->IsEnabled())
@@ -86,6 +95,12 @@ namespace acid
 				(*it)->Update();
 			}
 		}
+
+		// Components usually create their shapes and models when started, so the bounds are recalculated.
+		if (started && m_structure != nullptr)
+		{
+			m_structure->Refresh(this);
+		}
 	}
 
 	IComponent *GameObject::AddComponent(IComponent *component)
@@ -97,6 +112,14 @@ namespace acid
 
 		component->SetGameObject(this);
 		m_components.emplace_back(component);
+		UpdateTypeIndices();
+		ComponentPools::Add(component);
+
+		if (m_structure != nullptr)
+		{
+			m_structure->Refresh(this);
+		}
+
 		return component;
 	}
 
@@ -106,10 +129,18 @@ namespace acid
 		{
 			if (*it != nullptr && *it == component)
 			{
-				(*it)->SetGameObject(nullptr);
+				component->SetGameObject(nullptr);
+				ComponentPools::Remove(component);
 
 				m_components.erase(it);
-				delete *it;
+				UpdateTypeIndices();
+				delete component;
+
+				if (m_structure != nullptr)
+				{
+					m_structure->Refresh(this);
+				}
+
 				return true;
 			}
 		}
@@ -125,15 +156,24 @@ namespace acid
 			{
 				auto componentName = Scenes::Get()->FindComponentName(*it);
 
-				if (componentName.has_value() && name == componentName.value())
+				if (!componentName.has_value() || name != componentName.value())
 				{
 					continue;
 				}
 
-				(*it)->SetGameObject(nullptr);
+				IComponent *component = *it;
+				component->SetGameObject(nullptr);
+				ComponentPools::Remove(component);
 
 				m_components.erase(it);
-				delete *it;
+				UpdateTypeIndices();
+				delete component;
+
+				if (m_structure != nullptr)
+				{
+					m_structure->Refresh(this);
+				}
+
 				return true;
 			}
 		}
@@ -163,4 +203,21 @@ namespace acid
 
 		m_removed = true;
 	}
+
+	void GameObject::UpdateTypeIndices()
+	{
+		auto typeMatches = ComponentPools::GetTypeMatches();
+		m_typeIndices.assign(typeMatches.size(), TYPE_UNKNOWN);
+
+		for (uint32_t typeId = 0; typeId < typeMatches.size(); typeId++)
+		{
+			if (typeMatches[typeId] == nullptr)
+			{
+				continue;
+			}
+
+			auto it = std::find_if(m_components.begin(), m_components.end(), typeMatches[typeId]);
+			m_typeIndices[typeId] = it != m_components.end() ? static_cast<int32_t>(it - m_components.begin()) : TYPE_MISSING;
+		}
+	}
 }
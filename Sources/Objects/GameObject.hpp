@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <vector>
 #include "Engine/Exports.hpp"
 #include "Maths/Transform.hpp"
@@ -18,7 +20,12 @@ namespace acid
 	private:
 		std::string m_name;
 		Transform m_transform;
+		std::optional<Transform> m_renderTransform;
+		static const int32_t TYPE_UNKNOWN;
+		static const int32_t TYPE_MISSING;
+
 		std::vector<IComponent *> m_components;
+		std::vector<int32_t> m_typeIndices;
 		ISpatialStructure *m_structure;
 		GameObject *m_parent;
 		bool m_removed;
@@ -38,18 +45,29 @@ namespace acid
 		std::vector<IComponent *> GetComponents() const { return m_components; }
 
 		/// <summary>
-		/// Gets a component by type.
+		/// Gets a component by type, the search starts at the first component of the type found when the type indices were last updated.
+		/// This only reads the game object, so it can be called from jobs while no components are added or removed.
 		/// </summary>
 		/// <param name="T"> The component type to find. </param>
+		/// <param name="allowDisabled"> If a disabled component can be returned, otherwise a disabled component is only returned when no component of the type is enabled. </param>
 		/// <returns> The found component. </returns>
 		template<typename T>
 		T *GetComponent(const bool &allowDisabled = false)
 		{
+			uint32_t typeId = ComponentPools::GetTypeId<T>();
+			int32_t first = typeId < m_typeIndices.size() ? m_typeIndices[typeId] : TYPE_UNKNOWN;
+
+			if (first == TYPE_MISSING)
+			{
+				return nullptr;
+			}
+
+			// Types first looked up since the type indices were last updated are searched from the start.
 			T *alternative = nullptr;
 
-			for (auto &component : m_components)
+			for (auto i = static_cast<uint32_t>(std::max(first, 0)); i < m_components.size(); i++)
 			{
-				auto casted = dynamic_cast<T *>(component);
+				auto casted = dynamic_cast<T *>(m_components[i]);
 
 				if (casted != nullptr)
 				{
@@ -109,19 +127,14 @@ namespace acid
 		template<typename T>
 		bool RemoveComponent()
 		{
-			for (auto &component : m_components)
-			{
-				auto casted = dynamic_cast<T *>(component);
+			T *component = GetComponent<T>(true);
 
-				if (casted != nullptr)
-				{
-					RemoveComponent(component);
-					delete component;
-					return true;
-				}
+			if (component == nullptr)
+			{
+				return false;
 			}
 
-			return false;
+			return RemoveComponent(component);
 		}
 
 		std::string GetName() const { return m_name; }
@@ -132,6 +145,14 @@ namespace acid
 
 		void SetTransform(const Transform &transform) { m_transform = transform; }
 
+		/// <summary>
+		/// Gets the transform this game object is drawn with, a rigidbody draws its body between the last two physics steps while the transform keeps the last step.
+		/// </summary>
+		/// <returns> The render transform if one is set, otherwise the transform. </returns>
+		const Transform &GetRenderTransform() const { return m_renderTransform ? *m_renderTransform : m_transform; }
+
+		void SetRenderTransform(const std::optional<Transform> &renderTransform) { m_renderTransform = renderTransform; }
+
 		ISpatialStructure *GetStructure() const { return m_structure; }
 
 		void SetStructure(ISpatialStructure *structure);
@@ -143,5 +164,10 @@ namespace acid
 		void SetParent(GameObject *parent) { m_parent = parent; }
 
 		void StructureRemove();
+
+		/// <summary>
+		/// Finds the first component of every type with a type check, called when the components change and when type checks are added.
+		/// </summary>
+		void UpdateTypeIndices();
 	};
 }
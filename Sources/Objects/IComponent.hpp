@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <string>
 #include "Engine/Exports.hpp"
 #include "Files/LoadedValue.hpp"
+#include "ComponentPools.hpp"
 
 namespace acid
 {
@@ -13,14 +15,22 @@ namespace acid
 	class ACID_EXPORT IComponent
 	{
 	private:
+		friend class ComponentPools;
+
+		static const uint32_t NO_POOL = UINT32_MAX;
+
 		GameObject *m_gameObject;
 		bool m_started;
 		bool m_enabled;
+		uint32_t m_typeId;
+		uint32_t m_poolIndex;
 	public:
 		IComponent() :
 			m_gameObject(nullptr),
 			m_started(false),
-			m_enabled(true)
+			m_enabled(true),
+			m_typeId(NO_POOL),
+			m_poolIndex(NO_POOL)
 		{
 		}
 
@@ -28,6 +38,10 @@ namespace acid
 		{
 		}
 
+		static void *operator new(std::size_t size) { return ComponentPools::Allocate(size); }
+
+		static void operator delete(void *pointer, std::size_t size) { ComponentPools::Deallocate(pointer, size); }
+
 		virtual void Start() = 0;
 
 		virtual void Update() = 0;
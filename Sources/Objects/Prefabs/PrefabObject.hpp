@@ -38,6 +38,15 @@ namespace acid
 			return result;
 		}
 
+		static ResourceFuture<PrefabObject> ResourceAsync(const std::string &filename)
+		{
+			std::string realFilename = Files::SearchFile(filename);
+			return Resources::Get()->LoadAsync<PrefabObject>(realFilename, [realFilename]()
+			{
+				return std::make_shared<PrefabObject>(realFilename);
+			});
+		}
+
 		/// <summary>
 		/// Creates a new entity prefab.
 		/// </summary>
@@ -1,13 +1,12 @@
 ﻿#pragma once
 
-#include "Maths/Vector2.hpp"
 #include "Maths/Vector3.hpp"
 #include "ParticleType.hpp"
 
 namespace acid
 {
 	/// <summary>
-	/// A instance of a particle type.
+	/// The spawn state of a particle, once added to <see cref="Particles"/> it is simulated inside the <see cref="ParticlePool"/> of its type.
 	/// </summary>
 	class ACID_EXPORT Particle
 	{
@@ -15,22 +14,12 @@ namespace acid
 		std::shared_ptr<ParticleType> m_particleType;
 
 		Vector3 m_position;
-
 		Vector3 m_velocity;
-		Vector3 m_change;
-
-		Vector2 m_textureOffset1;
-		Vector2 m_textureOffset2;
 
 		float m_lifeLength;
 		float m_rotation;
 		float m_scale;
 		float m_gravityEffect;
-
-		float m_elapsedTime;
-		float m_transparency;
-		float m_textureBlendFactor;
-		float m_distanceToCamera;
 	public:
 		/// <summary>
 		/// Creates a new particle object.
@@ -49,25 +38,12 @@ namespace acid
 		/// </summary>
 		~Particle();
 
-		/// <summary>
-		/// Updates the particle.
-		/// </summary>
-		void Update();
-
-		bool IsAlive() const { return m_transparency < 1.0f; }
-
 		std::shared_ptr<ParticleType> GetParticleType() const { return m_particleType; }
 
 		Vector3 GetPosition() const { return m_position; }
 
 		Vector3 GetVelocity() const { return m_velocity; }
 
-		Vector3 GetChange() const { return m_change; }
-
-		Vector2 GetTextureOffset1() const { return m_textureOffset1; }
-
-		Vector2 GetTextureOffset2() const { return m_textureOffset2; }
-
 		float GetLifeLength() const { return m_lifeLength; }
 
 		float GetRotation() const { return m_rotation; }
@@ -75,18 +51,5 @@ namespace acid
 		float GetScale() const { return m_scale; }
 
 		float GetGravityEffect() const { return m_gravityEffect; }
-
-		float GetElapsedTime() const { return m_elapsedTime; }
-
-		float GetTransparency() const { return m_transparency; }
-
-		float GetTextureBlendFactor() const { return m_textureBlendFactor; }
-
-		float DistanceToCamera() const { return m_distanceToCamera; }
-
-		bool operator<(const Particle &other) const;
-
-	private:
-		Vector2 CalculateTextureOffset(const int &index) const;
 	};
 }
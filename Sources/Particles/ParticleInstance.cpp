@@ -0,0 +1,57 @@
+#include "ParticleInstance.hpp"
+
+#include "Models/VertexStream.hpp"
+
+namespace acid
+{
+	const uint32_t ParticleInstance::BINDING = 1;
+	const uint32_t ParticleInstance::LOCATION = 4;
+
+	ParticleInstance::ParticleInstance() :
+		m_position(Vector3()),
+		m_scale(1.0f),
+		m_textureOffsets(Vector4()),
+		m_rotation(0.0f),
+		m_blendFactor(0.0f),
+		m_transparency(0.0f)
+	{
+	}
+
+	ParticleInstance::~ParticleInstance()
+	{
+	}
+
+	VertexInput ParticleInstance::GetVertexInput(const VertexInput &vertexInput, const uint32_t &stride)
+	{
+		auto bindingDescriptions = vertexInput.GetBindingDescriptions();
+		auto attributeDescriptions = vertexInput.GetAttributeDescriptions();
+
+		// The instance input description.
+		VkVertexInputBindingDescription bindingDescription = {};
+		bindingDescription.binding = BINDING;
+		bindingDescription.stride = stride;
+		bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+		bindingDescriptions.emplace_back(bindingDescription);
+
+		std::vector<VertexElement> elements = {
+			VertexElement::Create<decltype(m_position)>(LOCATION, offsetof(ParticleInstance, m_position)),
+			VertexElement::Create<decltype(m_scale)>(LOCATION + 1, offsetof(ParticleInstance, m_scale)),
+			VertexElement::Create<decltype(m_textureOffsets)>(LOCATION + 2, offsetof(ParticleInstance, m_textureOffsets)),
+			VertexElement::Create<decltype(m_rotation)>(LOCATION + 3, offsetof(ParticleInstance, m_rotation)),
+			VertexElement::Create<decltype(m_blendFactor)>(LOCATION + 4, offsetof(ParticleInstance, m_blendFactor)),
+			VertexElement::Create<decltype(m_transparency)>(LOCATION + 5, offsetof(ParticleInstance, m_transparency))
+		};
+
+		for (auto &element : elements)
+		{
+			VkVertexInputAttributeDescription attributeDescription = {};
+			attributeDescription.binding = BINDING;
+			attributeDescription.location = element.location;
+			attributeDescription.format = element.format;
+			attributeDescription.offset = element.offset;
+			attributeDescriptions.emplace_back(attributeDescription);
+		}
+
+		return VertexInput(bindingDescriptions, attributeDescriptions);
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Maths/Vector3.hpp"
+#include "Maths/Vector4.hpp"
+#include "Renderer/Pipelines/PipelineCreate.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Class that represents the per instance attributes of a particle, the quad is turned to face the camera in the vertex shader.
+	/// </summary>
+	class ACID_EXPORT ParticleInstance
+	{
+	public:
+		static const uint32_t BINDING;
+		static const uint32_t LOCATION;
+
+		Vector3 m_position;
+		float m_scale;
+		Vector4 m_textureOffsets;
+		float m_rotation;
+		float m_blendFactor;
+		float m_transparency;
+
+		ParticleInstance();
+
+		~ParticleInstance();
+
+		/// <summary>
+		/// Appends the instance binding and attributes to a models vertex input.
+		/// </summary>
+		/// <param name="vertexInput"> The vertex input of the particle model. </param>
+		/// <param name="stride"> The size of each instance, larger when the attributes start a bigger struct such as a GPU particle. </param>
+		/// <returns> The combined vertex input. </returns>
+		static VertexInput GetVertexInput(const VertexInput &vertexInput, const uint32_t &stride = sizeof(ParticleInstance));
+	};
+}
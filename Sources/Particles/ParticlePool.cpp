@@ -0,0 +1,328 @@
+#include "ParticlePool.hpp"
+
+#include <cmath>
+#include "Helpers/RadixSort.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ACID_PARTICLES_SSE
+#endif
+
+namespace acid
+{
+#if defined(__AVX__)
+	/// <summary>
+	/// The float lanes the particle kernel is written against, eight wide with AVX.
+	/// </summary>
+	struct ParticleLanes
+	{
+		using Type = __m256;
+		static const uint32_t WIDTH = 8;
+
+		static Type Load(const float *source) { return _mm256_loadu_ps(source); }
+
+		static void Store(float *destination, const Type &value) { _mm256_storeu_ps(destination, value); }
+
+		static Type Set(const float &value) { return _mm256_set1_ps(value); }
+
+		static Type Add(const Type &a, const Type &b) { return _mm256_add_ps(a, b); }
+
+		static Type Sub(const Type &a, const Type &b) { return _mm256_sub_ps(a, b); }
+
+		static Type Mul(const Type &a, const Type &b) { return _mm256_mul_ps(a, b); }
+
+		static Type Greater(const Type &a, const Type &b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+
+		static Type And(const Type &a, const Type &b) { return _mm256_and_ps(a, b); }
+	};
+#elif defined(ACID_PARTICLES_SSE)
+	/// <summary>
+	/// The float lanes the particle kernel is written against, four wide with SSE2.
+	/// </summary>
+	struct ParticleLanes
+	{
+		using Type = __m128;
+		static const uint32_t WIDTH = 4;
+
+		static Type Load(const float *source) { return _mm_loadu_ps(source); }
+
+		static void Store(float *destination, const Type &value) { _mm_storeu_ps(destination, value); }
+
+		static Type Set(const float &value) { return _mm_set1_ps(value); }
+
+		static Type Add(const Type &a, const Type &b) { return _mm_add_ps(a, b); }
+
+		static Type Sub(const Type &a, const Type &b) { return _mm_sub_ps(a, b); }
+
+		static Type Mul(const Type &a, const Type &b) { return _mm_mul_ps(a, b); }
+
+		static Type Greater(const Type &a, const Type &b) { return _mm_cmpgt_ps(a, b); }
+
+		static Type And(const Type &a, const Type &b) { return _mm_and_ps(a, b); }
+	};
+#endif
+
+	const uint32_t ParticlePool::DEPTH_BITS = 16;
+
+	static const float GRAVITY = -10.0f;
+
+	ParticlePool::ParticlePool(const std::shared_ptr<ParticleType> &particleType) :
+		m_particleType(particleType),
+		m_positionX(std::vector<float>()),
+		m_positionY(std::vector<float>()),
+		m_positionZ(std::vector<float>()),
+		m_velocityX(std::vector<float>()),
+		m_velocityY(std::vector<float>()),
+		m_velocityZ(std::vector<float>()),
+		m_lifeLength(std::vector<float>()),
+		m_rotation(std::vector<float>()),
+		m_scale(std::vector<float>()),
+		m_gravityEffect(std::vector<float>()),
+		m_elapsedTime(std::vector<float>()),
+		m_transparency(std::vector<float>()),
+		m_textureBlendFactor(std::vector<float>()),
+		m_distanceToCamera(std::vector<float>()),
+		m_textureOffsets(std::vector<Vector4>()),
+		m_depthKeys(std::vector<DepthKey>()),
+		m_depthSwap(std::vector<DepthKey>()),
+		m_drawOrder(std::vector<uint32_t>())
+	{
+	}
+
+	ParticlePool::~ParticlePool()
+	{
+	}
+
+	void ParticlePool::Add(const Particle &particle)
+	{
+		Vector3 position = particle.GetPosition();
+		Vector3 velocity = particle.GetVelocity();
+
+		m_positionX.emplace_back(position.m_x);
+		m_positionY.emplace_back(position.m_y);
+		m_positionZ.emplace_back(position.m_z);
+		m_velocityX.emplace_back(velocity.m_x);
+		m_velocityY.emplace_back(velocity.m_y);
+		m_velocityZ.emplace_back(velocity.m_z);
+		m_lifeLength.emplace_back(particle.GetLifeLength());
+		m_rotation.emplace_back(particle.GetRotation());
+		m_scale.emplace_back(particle.GetScale());
+		m_gravityEffect.emplace_back(particle.GetGravityEffect());
+		m_elapsedTime.emplace_back(0.0f);
+		m_transparency.emplace_back(0.0f);
+		m_textureBlendFactor.emplace_back(0.0f);
+		m_distanceToCamera.emplace_back(0.0f);
+		m_textureOffsets.emplace_back(Vector4(0.0f, 0.0f, 0.0f, 0.0f));
+	}
+
+	void ParticlePool::Update(const float &delta, const Vector3 &cameraPosition)
+	{
+		Integrate(delta, cameraPosition);
+		RemoveDead();
+		UpdateTextureStages();
+	}
+
+	const std::vector<uint32_t> &ParticlePool::SortBackToFront()
+	{
+		uint32_t count = GetCount();
+		uint32_t depthMask = (1u << DEPTH_BITS) - 1;
+		m_depthKeys.resize(count);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			// The key is inverted so the furthest particle comes first.
+			m_depthKeys[i] = DepthKey{depthMask - RadixSort::QuantizeFloat(m_distanceToCamera[i], DEPTH_BITS), i};
+		}
+
+		RadixSort::Sort(m_depthKeys, m_depthSwap, DEPTH_BITS);
+
+		m_drawOrder.resize(count);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			m_drawOrder[i] = m_depthKeys[i].index;
+		}
+
+		return m_drawOrder;
+	}
+
+	void ParticlePool::WriteInstances(const std::vector<uint32_t> &order, ParticleInstance *instances) const
+	{
+		// Components are copied one at a time, the vector constructors are not inlined into this loop.
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			uint32_t index = order[i];
+			auto &instance = instances[i];
+			instance.m_position.m_x = m_positionX[index];
+			instance.m_position.m_y = m_positionY[index];
+			instance.m_position.m_z = m_positionZ[index];
+			instance.m_scale = m_scale[index];
+			instance.m_textureOffsets.m_x = m_textureOffsets[index].m_x;
+			instance.m_textureOffsets.m_y = m_textureOffsets[index].m_y;
+			instance.m_textureOffsets.m_z = m_textureOffsets[index].m_z;
+			instance.m_textureOffsets.m_w = m_textureOffsets[index].m_w;
+			instance.m_rotation = m_rotation[index];
+			instance.m_blendFactor = m_textureBlendFactor[index];
+			instance.m_transparency = m_transparency[index];
+		}
+	}
+
+	void ParticlePool::Clear()
+	{
+		m_positionX.clear();
+		m_positionY.clear();
+		m_positionZ.clear();
+		m_velocityX.clear();
+		m_velocityY.clear();
+		m_velocityZ.clear();
+		m_lifeLength.clear();
+		m_rotation.clear();
+		m_scale.clear();
+		m_gravityEffect.clear();
+		m_elapsedTime.clear();
+		m_transparency.clear();
+		m_textureBlendFactor.clear();
+		m_distanceToCamera.clear();
+		m_textureOffsets.clear();
+	}
+
+	void ParticlePool::Integrate(const float &delta, const Vector3 &cameraPosition)
+	{
+		uint32_t count = GetCount();
+		uint32_t i = 0;
+
+#if defined(__AVX__) || defined(ACID_PARTICLES_SSE)
+		using Lanes = ParticleLanes;
+		const Lanes::Type deltas = Lanes::Set(delta);
+		const Lanes::Type gravity = Lanes::Set(GRAVITY * delta);
+		const Lanes::Type cameraX = Lanes::Set(cameraPosition.m_x);
+		const Lanes::Type cameraY = Lanes::Set(cameraPosition.m_y);
+		const Lanes::Type cameraZ = Lanes::Set(cameraPosition.m_z);
+
+		for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+		{
+			Lanes::Type velocityY = Lanes::Add(Lanes::Load(&m_velocityY[i]), Lanes::Mul(gravity, Lanes::Load(&m_gravityEffect[i])));
+			Lanes::Store(&m_velocityY[i], velocityY);
+
+			Lanes::Type positionX = Lanes::Add(Lanes::Load(&m_positionX[i]), Lanes::Mul(Lanes::Load(&m_velocityX[i]), deltas));
+			Lanes::Type positionY = Lanes::Add(Lanes::Load(&m_positionY[i]), Lanes::Mul(velocityY, deltas));
+			Lanes::Type positionZ = Lanes::Add(Lanes::Load(&m_positionZ[i]), Lanes::Mul(Lanes::Load(&m_velocityZ[i]), deltas));
+			Lanes::Store(&m_positionX[i], positionX);
+			Lanes::Store(&m_positionY[i], positionY);
+			Lanes::Store(&m_positionZ[i], positionZ);
+
+			// Particles past their life length fade out, the comparison mask selects which lanes get the delta.
+			Lanes::Type elapsedTime = Lanes::Add(Lanes::Load(&m_elapsedTime[i]), deltas);
+			Lanes::Type fading = Lanes::Greater(elapsedTime, Lanes::Load(&m_lifeLength[i]));
+			Lanes::Store(&m_elapsedTime[i], elapsedTime);
+			Lanes::Store(&m_transparency[i], Lanes::Add(Lanes::Load(&m_transparency[i]), Lanes::And(fading, deltas)));
+
+			Lanes::Type toCameraX = Lanes::Sub(cameraX, positionX);
+			Lanes::Type toCameraY = Lanes::Sub(cameraY, positionY);
+			Lanes::Type toCameraZ = Lanes::Sub(cameraZ, positionZ);
+			Lanes::Store(&m_distanceToCamera[i], Lanes::Add(Lanes::Add(Lanes::Mul(toCameraX, toCameraX), Lanes::Mul(toCameraY, toCameraY)), Lanes::Mul(toCameraZ, toCameraZ)));
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			m_velocityY[i] += GRAVITY * delta * m_gravityEffect[i];
+
+			m_positionX[i] += m_velocityX[i] * delta;
+			m_positionY[i] += m_velocityY[i] * delta;
+			m_positionZ[i] += m_velocityZ[i] * delta;
+
+			m_elapsedTime[i] += delta;
+
+			if (m_elapsedTime[i] > m_lifeLength[i])
+			{
+				m_transparency[i] += delta;
+			}
+
+			float toCameraX = cameraPosition.m_x - m_positionX[i];
+			float toCameraY = cameraPosition.m_y - m_positionY[i];
+			float toCameraZ = cameraPosition.m_z - m_positionZ[i];
+			m_distanceToCamera[i] = (toCameraX * toCameraX) + (toCameraY * toCameraY) + (toCameraZ * toCameraZ);
+		}
+	}
+
+	void ParticlePool::RemoveDead()
+	{
+		uint32_t i = 0;
+
+		while (i < GetCount())
+		{
+			if (m_transparency[i] >= 1.0f)
+			{
+				// The moved particle is checked again at the same index.
+				Remove(i);
+				continue;
+			}
+
+			i++;
+		}
+	}
+
+	void ParticlePool::UpdateTextureStages()
+	{
+		if (m_particleType->GetTexture() == nullptr)
+		{
+			return;
+		}
+
+		uint32_t numberOfRows = m_particleType->GetNumberOfRows();
+		uint32_t stageCount = numberOfRows * numberOfRows;
+		float rowSize = 1.0f / static_cast<float>(numberOfRows);
+
+		for (uint32_t i = 0; i < GetCount(); i++)
+		{
+			float lifeFactor = m_elapsedTime[i] / m_lifeLength[i];
+			float atlasProgression = lifeFactor * static_cast<float>(stageCount);
+			uint32_t index1 = static_cast<uint32_t>(std::floor(atlasProgression));
+			uint32_t index2 = index1 < stageCount - 1 ? index1 + 1 : index1;
+
+			m_textureBlendFactor[i] = std::fmod(atlasProgression, 1.0f);
+			m_textureOffsets[i] = Vector4(static_cast<float>(index1 % numberOfRows) * rowSize, static_cast<float>(index1 / numberOfRows) * rowSize,
+				static_cast<float>(index2 % numberOfRows) * rowSize, static_cast<float>(index2 / numberOfRows) * rowSize);
+		}
+	}
+
+	void ParticlePool::Remove(const uint32_t &index)
+	{
+		uint32_t last = GetCount() - 1;
+
+		m_positionX[index] = m_positionX[last];
+		m_positionY[index] = m_positionY[last];
+		m_positionZ[index] = m_positionZ[last];
+		m_velocityX[index] = m_velocityX[last];
+		m_velocityY[index] = m_velocityY[last];
+		m_velocityZ[index] = m_velocityZ[last];
+		m_lifeLength[index] = m_lifeLength[last];
+		m_rotation[index] = m_rotation[last];
+		m_scale[index] = m_scale[last];
+		m_gravityEffect[index] = m_gravityEffect[last];
+		m_elapsedTime[index] = m_elapsedTime[last];
+		m_transparency[index] = m_transparency[last];
+		m_textureBlendFactor[index] = m_textureBlendFactor[last];
+		m_distanceToCamera[index] = m_distanceToCamera[last];
+		m_textureOffsets[index] = m_textureOffsets[last];
+
+		m_positionX.pop_back();
+		m_positionY.pop_back();
+		m_positionZ.pop_back();
+		m_velocityX.pop_back();
+		m_velocityY.pop_back();
+		m_velocityZ.pop_back();
+		m_lifeLength.pop_back();
+		m_rotation.pop_back();
+		m_scale.pop_back();
+		m_gravityEffect.pop_back();
+		m_elapsedTime.pop_back();
+		m_transparency.pop_back();
+		m_textureBlendFactor.pop_back();
+		m_distanceToCamera.pop_back();
+		m_textureOffsets.pop_back();
+	}
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Maths/Vector3.hpp"
+#include "Maths/Vector4.hpp"
+#include "Particle.hpp"
+#include "ParticleInstance.hpp"
+#include "ParticleType.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// The live particles of a single type, stored as a structure of arrays so the update runs over contiguous floats.
+	/// Dead particles are removed by moving the last particle into their place, so particle order is not kept.
+	/// </summary>
+	class ACID_EXPORT ParticlePool
+	{
+	private:
+		struct DepthKey
+		{
+			uint32_t key;
+			uint32_t index;
+		};
+
+		std::shared_ptr<ParticleType> m_particleType;
+
+		std::vector<float> m_positionX;
+		std::vector<float> m_positionY;
+		std::vector<float> m_positionZ;
+		std::vector<float> m_velocityX;
+		std::vector<float> m_velocityY;
+		std::vector<float> m_velocityZ;
+
+		std::vector<float> m_lifeLength;
+		std::vector<float> m_rotation;
+		std::vector<float> m_scale;
+		std::vector<float> m_gravityEffect;
+
+		std::vector<float> m_elapsedTime;
+		std::vector<float> m_transparency;
+		std::vector<float> m_textureBlendFactor;
+		std::vector<float> m_distanceToCamera;
+		std::vector<Vector4> m_textureOffsets;
+
+		std::vector<DepthKey> m_depthKeys;
+		std::vector<DepthKey> m_depthSwap;
+		std::vector<uint32_t> m_drawOrder;
+	public:
+		static const uint32_t DEPTH_BITS;
+
+		/// <summary>
+		/// Creates a new particle pool.
+		/// </summary>
+		/// <param name="particleType"> The type of the particles in this pool. </param>
+		explicit ParticlePool(const std::shared_ptr<ParticleType> &particleType);
+
+		~ParticlePool();
+
+		/// <summary>
+		/// Adds a particle to the end of the pool.
+		/// </summary>
+		/// <param name="particle"> The spawn state of the particle. </param>
+		void Add(const Particle &particle);
+
+		/// <summary>
+		/// Integrates and fades every particle, removes the dead ones, then updates the texture atlas stages of those left.
+		/// </summary>
+		/// <param name="delta"> The time since the last update. </param>
+		/// <param name="cameraPosition"> The position used to find the distance of each particle to the camera. </param>
+		void Update(const float &delta, const Vector3 &cameraPosition);
+
+		/// <summary>
+		/// Orders the particles from the furthest to the nearest, with a radix sort over their quantized distance to the camera.
+		/// </summary>
+		/// <returns> The particle indices in the order they should be drawn, valid until the pool changes. </returns>
+		const std::vector<uint32_t> &SortBackToFront();
+
+		/// <summary>
+		/// Writes the instance attributes of particles in a given order.
+		/// </summary>
+		/// <param name="order"> The particle indices to write, such as the order from <see cref="SortBackToFront"/>. </param>
+		/// <param name="instances"> The instances to write to, with room for every index in the order. </param>
+		void WriteInstances(const std::vector<uint32_t> &order, ParticleInstance *instances) const;
+
+		/// <summary>
+		/// Removes every particle from this pool.
+		/// </summary>
+		void Clear();
+
+		std::shared_ptr<ParticleType> GetParticleType() const { return m_particleType; }
+
+		uint32_t GetCount() const { return static_cast<uint32_t>(m_positionX.size()); }
+
+		bool IsEmpty() const { return m_positionX.empty(); }
+
+		Vector3 GetPosition(const uint32_t &index) const { return Vector3(m_positionX[index], m_positionY[index], m_positionZ[index]); }
+
+		Vector3 GetVelocity(const uint32_t &index) const { return Vector3(m_velocityX[index], m_velocityY[index], m_velocityZ[index]); }
+
+		float GetLifeLength(const uint32_t &index) const { return m_lifeLength[index]; }
+
+		float GetRotation(const uint32_t &index) const { return m_rotation[index]; }
+
+		float GetScale(const uint32_t &index) const { return m_scale[index]; }
+
+		float GetElapsedTime(const uint32_t &index) const { return m_elapsedTime[index]; }
+
+		float GetTransparency(const uint32_t &index) const { return m_transparency[index]; }
+
+		float GetTextureBlendFactor(const uint32_t &index) const { return m_textureBlendFactor[index]; }
+
+		float GetDistanceToCamera(const uint32_t &index) const { return m_distanceToCamera[index]; }
+
+		/// <summary>
+		/// Gets the atlas offsets of the two texture stages a particle blends between.
+		/// </summary>
+		/// <param name="index"> The particle index. </param>
+		/// <returns> The first stage offset in x and y, the second stage offset in z and w. </returns>
+		Vector4 GetTextureOffsets(const uint32_t &index) const { return m_textureOffsets[index]; }
+	private:
+		void Integrate(const float &delta, const Vector3 &cameraPosition);
+
+		void RemoveDead();
+
+		void UpdateTextureStages();
+
+		void Remove(const uint32_t &index);
+	};
+}
@@ -0,0 +1,183 @@
+#include "ParticlePoolGpu.hpp"
+
+#include <algorithm>
+#include "Renderer/Renderer.hpp"
+#include "Scenes/Scenes.hpp"
+#include "ParticleInstance.hpp"
+
+namespace acid
+{
+	const uint32_t ParticlePoolGpu::CAPACITY = 65536;
+	const uint32_t ParticlePoolGpu::WORKGROUP_SIZE = 256;
+	const uint32_t ParticlePoolGpu::PARTICLE_STRIDE = 80;
+
+	static void CmdMemoryBarrier(const CommandBuffer &commandBuffer, const VkPipelineStageFlags &srcStageMask, const VkAccessFlags &srcAccessMask,
+		const VkPipelineStageFlags &dstStageMask, const VkAccessFlags &dstAccessMask)
+	{
+		VkMemoryBarrier memoryBarrier = {};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.srcAccessMask = srcAccessMask;
+		memoryBarrier.dstAccessMask = dstAccessMask;
+		vkCmdPipelineBarrier(commandBuffer.GetCommandBuffer(), srcStageMask, dstStageMask, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+	}
+
+	ParticlePoolGpu::ParticlePoolGpu(const std::shared_ptr<ParticleType> &particleType) :
+		m_particleType(particleType),
+		m_particleBuffers(std::vector<std::unique_ptr<StorageBuffer>>()),
+		m_argumentBuffers(std::vector<std::unique_ptr<StorageBuffer>>()),
+		m_requestBuffers(std::vector<std::unique_ptr<StorageBuffer>>(Renderer::MAX_FRAMES_IN_FLIGHT)),
+		m_current(0),
+		m_spawnRequests(std::vector<ParticleSpawnRequest>()),
+		m_spawnCount(0),
+		m_active(false),
+		m_cleared(true),
+		m_uniformSimulate(UniformHandler()),
+		m_uniformSpawn(UniformHandler()),
+		m_descriptorSimulate(DescriptorsHandler()),
+		m_descriptorSpawn(DescriptorsHandler())
+	{
+		// The particles are simulated from one buffer into the other, each with the draw arguments that count its particles.
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			m_particleBuffers.emplace_back(std::make_unique<StorageBuffer>(static_cast<VkDeviceSize>(CAPACITY * PARTICLE_STRIDE), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT));
+			m_argumentBuffers.emplace_back(std::make_unique<StorageBuffer>(static_cast<VkDeviceSize>(sizeof(VkDrawIndexedIndirectCommand)),
+				VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT));
+		}
+	}
+
+	ParticlePoolGpu::~ParticlePoolGpu()
+	{
+	}
+
+	void ParticlePoolGpu::AddSpawnRequest(const ParticleSpawnRequest &request)
+	{
+		if (m_spawnCount >= CAPACITY || request.m_count == 0)
+		{
+			return;
+		}
+
+		ParticleSpawnRequest spawnRequest = request;
+		spawnRequest.m_count = std::min(request.m_count, CAPACITY - m_spawnCount);
+		spawnRequest.m_first = m_spawnCount;
+		m_spawnRequests.emplace_back(spawnRequest);
+		m_spawnCount += spawnRequest.m_count;
+	}
+
+	void ParticlePoolGpu::Clear()
+	{
+		m_spawnRequests.clear();
+		m_spawnCount = 0;
+		m_active = false;
+		m_cleared = true;
+	}
+
+	void ParticlePoolGpu::CmdDispatch(const CommandBuffer &commandBuffer, const Compute &simulate, const Compute &spawn, const uint32_t &indexCount)
+	{
+		if (!m_active && m_spawnRequests.empty())
+		{
+			return;
+		}
+
+		uint32_t source = m_current;
+		uint32_t destination = 1 - m_current;
+		float delta = Scenes::Get()->IsGamePaused() ? 0.0f : Engine::Get()->GetDelta();
+		float atlasRows = static_cast<float>(m_particleType->GetNumberOfRows());
+
+		// Updates descriptors, the sets are created by the first update so nothing is dispatched until the frame after.
+		m_uniformSimulate.Push("delta", delta);
+		m_uniformSimulate.Push("atlasRows", atlasRows);
+
+		m_descriptorSimulate.Push("UboSimulate", m_uniformSimulate);
+		m_descriptorSimulate.Push("SourceParticles", *m_particleBuffers[source]);
+		m_descriptorSimulate.Push("SourceArguments", *m_argumentBuffers[source]);
+		m_descriptorSimulate.Push("DestinationParticles", *m_particleBuffers[destination]);
+		m_descriptorSimulate.Push("DestinationArguments", *m_argumentBuffers[destination]);
+
+		if (!m_descriptorSimulate.Update(simulate))
+		{
+			return;
+		}
+
+		bool spawning = false;
+
+		if (!m_spawnRequests.empty())
+		{
+			UploadSpawnRequests();
+
+			m_uniformSpawn.Push("requestCount", static_cast<uint32_t>(m_spawnRequests.size()));
+			m_uniformSpawn.Push("spawnCount", m_spawnCount);
+			m_uniformSpawn.Push("atlasRows", atlasRows);
+
+			m_descriptorSpawn.Push("UboSpawn", m_uniformSpawn);
+			m_descriptorSpawn.Push("SpawnRequests", *m_requestBuffers[Renderer::Get()->GetCurrentFrame()]);
+			m_descriptorSpawn.Push("DestinationParticles", *m_particleBuffers[destination]);
+			m_descriptorSpawn.Push("DestinationArguments", *m_argumentBuffers[destination]);
+			spawning = m_descriptorSpawn.Update(spawn);
+		}
+
+		// The destination was last read by the draw two frames ago, and the source was written by the previous frame.
+		CmdMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+		// The destination instance count is the counter particles are appended with.
+		VkDrawIndexedIndirectCommand arguments = {};
+		arguments.indexCount = indexCount;
+		arguments.instanceCount = 0;
+		arguments.firstIndex = 0;
+		arguments.vertexOffset = 0;
+		arguments.firstInstance = 0;
+		vkCmdUpdateBuffer(commandBuffer.GetCommandBuffer(), m_argumentBuffers[destination]->GetBuffer(), 0, sizeof(VkDrawIndexedIndirectCommand), &arguments);
+
+		// A cleared or new pool has no particles to simulate.
+		if (m_cleared)
+		{
+			vkCmdUpdateBuffer(commandBuffer.GetCommandBuffer(), m_argumentBuffers[source]->GetBuffer(), 0, sizeof(VkDrawIndexedIndirectCommand), &arguments);
+			m_cleared = false;
+		}
+
+		CmdMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+		// Integrates and ages every live particle, the survivors are compacted into the destination.
+		simulate.BindPipeline(commandBuffer);
+		m_descriptorSimulate.BindDescriptor(commandBuffer);
+		simulate.CmdRender(commandBuffer);
+
+		if (spawning)
+		{
+			// Spawns are appended after the survivors, the counter written by the simulate pass must be visible first.
+			CmdMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+			spawn.BindPipeline(commandBuffer);
+			m_descriptorSpawn.BindDescriptor(commandBuffer);
+			spawn.CmdRender(commandBuffer, m_spawnCount, 1);
+
+			m_spawnRequests.clear();
+			m_spawnCount = 0;
+			m_active = true;
+		}
+
+		CmdMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+			VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+
+		m_current = destination;
+	}
+
+	void ParticlePoolGpu::CmdDraw(const CommandBuffer &commandBuffer) const
+	{
+		VkBuffer instanceBuffers[] = {m_particleBuffers[m_current]->GetBuffer()};
+		VkDeviceSize offsets[] = {0};
+		vkCmdBindVertexBuffers(commandBuffer.GetCommandBuffer(), ParticleInstance::BINDING, 1, instanceBuffers, offsets);
+		vkCmdDrawIndexedIndirect(commandBuffer.GetCommandBuffer(), m_argumentBuffers[m_current]->GetBuffer(), 0, 1, sizeof(VkDrawIndexedIndirectCommand));
+	}
+
+	void ParticlePoolGpu::UploadSpawnRequests()
+	{
+		auto size = static_cast<VkDeviceSize>(m_spawnRequests.size() * sizeof(ParticleSpawnRequest));
+		auto &requestBuffer = m_requestBuffers[Renderer::Get()->GetCurrentFrame()];
+		Buffer::Reserve(requestBuffer, size, 16 * sizeof(ParticleSpawnRequest), 0, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		requestBuffer->Update(m_spawnRequests.data(), size);
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Renderer/Buffers/StorageBuffer.hpp"
+#include "Renderer/Handlers/DescriptorsHandler.hpp"
+#include "Renderer/Handlers/UniformHandler.hpp"
+#include "Renderer/Pipelines/Compute.hpp"
+#include "ParticleSpawnRequest.hpp"
+#include "ParticleType.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// The particles of a single type that live entirely on the GPU, in a fixed capacity storage buffer.
+	/// Each frame a compute pass integrates, ages and compacts the particles into the other of two buffers, then a second pass appends the requested spawns.
+	/// The number of particles written becomes the instance count of a indirect draw, so the CPU never reads it back.
+	/// </summary>
+	class ACID_EXPORT ParticlePoolGpu
+	{
+	private:
+		std::shared_ptr<ParticleType> m_particleType;
+
+		std::vector<std::unique_ptr<StorageBuffer>> m_particleBuffers;
+		std::vector<std::unique_ptr<StorageBuffer>> m_argumentBuffers;
+		std::vector<std::unique_ptr<StorageBuffer>> m_requestBuffers;
+		uint32_t m_current;
+
+		std::vector<ParticleSpawnRequest> m_spawnRequests;
+		uint32_t m_spawnCount;
+		bool m_active;
+		bool m_cleared;
+
+		UniformHandler m_uniformSimulate;
+		UniformHandler m_uniformSpawn;
+		DescriptorsHandler m_descriptorSimulate;
+		DescriptorsHandler m_descriptorSpawn;
+	public:
+		static const uint32_t CAPACITY;
+		static const uint32_t WORKGROUP_SIZE;
+		static const uint32_t PARTICLE_STRIDE;
+
+		/// <summary>
+		/// Creates a new GPU particle pool.
+		/// </summary>
+		/// <param name="particleType"> The type of the particles in this pool. </param>
+		explicit ParticlePoolGpu(const std::shared_ptr<ParticleType> &particleType);
+
+		~ParticlePoolGpu();
+
+		/// <summary>
+		/// Queues a burst of particles to be spawned by the next dispatch, bursts past the pools capacity are cut short.
+		/// </summary>
+		/// <param name="request"> The spawn request. </param>
+		void AddSpawnRequest(const ParticleSpawnRequest &request);
+
+		/// <summary>
+		/// Removes every particle from this pool with the next dispatch.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Records the simulate and spawn passes, this must be recorded outside of a render pass.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="simulate"> The compute pipeline of 'Shaders/Particles/Simulate.comp'. </param>
+		/// <param name="spawn"> The compute pipeline of 'Shaders/Particles/Spawn.comp'. </param>
+		/// <param name="indexCount"> The index count of the particle model, written into the draw arguments. </param>
+		void CmdDispatch(const CommandBuffer &commandBuffer, const Compute &simulate, const Compute &spawn, const uint32_t &indexCount);
+
+		/// <summary>
+		/// Binds the particles written by the last dispatch as instances and draws them with the arguments written on the GPU.
+		/// The particle model must be bound, and the instances use the <see cref="ParticleInstance"/> attributes with a stride of <see cref="PARTICLE_STRIDE"/>.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		void CmdDraw(const CommandBuffer &commandBuffer) const;
+
+		std::shared_ptr<ParticleType> GetParticleType() const { return m_particleType; }
+
+		/// <summary>
+		/// Gets if this pool has spawned particles, the number still alive is only known on the GPU.
+		/// </summary>
+		/// <returns> If the pool may have live particles. </returns>
+		bool IsActive() const { return m_active; }
+	private:
+		void UploadSpawnRequests();
+	};
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include "Maths/Vector3.hpp"
+#include "Maths/Vector4.hpp"
+#include "Spawns/ISpawnParticle.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Class that represents a burst of particles spawned on the GPU, laid out to match the SpawnRequest struct in 'Shaders/Particles/Spawn.comp'.
+	/// </summary>
+	class ACID_EXPORT ParticleSpawnRequest
+	{
+	public:
+		Vector3 m_origin;
+		uint32_t m_shape;
+		Vector3 m_previousOrigin;
+		uint32_t m_count;
+		Vector4 m_shapeParameters;
+
+		Vector3 m_direction;
+		float m_directionDeviation;
+
+		float m_averageSpeed;
+		float m_speedError;
+		float m_gravityEffect;
+		uint32_t m_randomRotation;
+
+		float m_lifeLength;
+		float m_lifeError;
+		float m_scale;
+		float m_scaleError;
+
+		uint32_t m_first;
+		uint32_t m_seed;
+		uint32_t m_padding[2];
+
+		ParticleSpawnRequest() :
+			m_origin(Vector3()),
+			m_shape(SPAWN_SHAPE_POINT),
+			m_previousOrigin(Vector3()),
+			m_count(0),
+			m_shapeParameters(Vector4()),
+			m_direction(Vector3()),
+			m_directionDeviation(0.0f),
+			m_averageSpeed(0.0f),
+			m_speedError(0.0f),
+			m_gravityEffect(0.0f),
+			m_randomRotation(0),
+			m_lifeLength(0.0f),
+			m_lifeError(0.0f),
+			m_scale(0.0f),
+			m_scaleError(0.0f),
+			m_first(0),
+			m_seed(0),
+			m_padding{0, 0}
+		{
+		}
+
+		~ParticleSpawnRequest()
+		{
+		}
+	};
+}
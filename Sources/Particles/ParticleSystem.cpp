@@ -10,6 +10,7 @@ namespace acid
 		m_types(types),
 		m_spawn(spawn),
 		m_pps(pps),
+		m_ppsDriver(nullptr),
 		m_averageSpeed(averageSpeed),
 		m_gravityEffect(gravityEffect),
 		m_randomRotation(false),
@@ -20,8 +21,10 @@ namespace acid
 		m_speedError(0.0f),
 		m_lifeError(0.0f),
 		m_scaleError(0.0f),
-		m_timePassed(0.0f),
-		m_paused(false)
+		m_emitAccumulator(0.0f),
+		m_burstCount(0),
+		m_paused(false),
+		m_gpu(false)
 	{
 	}
 
@@ -31,23 +34,40 @@ namespace acid
 
 	void ParticleSystem::Start()
 	{
+		m_lastPosition = GetGameObject()->GetTransform().GetPosition() + m_systemOffset;
 	}
 
 	void ParticleSystem::Update()
 	{
-		if (m_paused || m_types.empty())
+		Vector3 position = GetGameObject()->GetTransform().GetPosition() + m_systemOffset;
+
+		if (m_paused || m_types.empty() || m_spawn == nullptr)
 		{
+			m_lastPosition = position;
 			return;
 		}
 
-		m_timePassed += Engine::Get()->GetDelta();
+		float delta = Engine::Get()->GetDelta();
+		float pps = m_ppsDriver != nullptr ? m_ppsDriver->Update(delta) : m_pps;
+
+		// Particles owed are accumulated with their fraction kept, so any rate is emitted exactly no matter the frame rate.
+		m_emitAccumulator += std::max(pps, 0.0f) * delta;
+		auto count = static_cast<uint32_t>(m_emitAccumulator);
+		m_emitAccumulator -= static_cast<float>(count);
+
+		if (count > 0)
+		{
+			Emit(count, m_lastPosition, position);
+		}
 
-		if (m_timePassed > 1.0f / m_pps)
+		// Bursts are emitted all at once from where the system is now.
+		if (m_burstCount > 0)
 		{
-			auto created = EmitParticle();
-			Particles::Get()->AddParticle(created);
-			m_timePassed = 0.0f;
+			Emit(m_burstCount, position, position);
+			m_burstCount = 0;
 		}
+
+		m_lastPosition = position;
 	}
 
 	void ParticleSystem::Load(LoadedValue *value)
@@ -68,18 +88,31 @@ namespace acid
 		m_systemOffset.Write(destination->GetChild("Offset", true));
 	}
 
-	Particle *ParticleSystem::EmitParticle()
+	void ParticleSystem::Emit(const uint32_t &count, const Vector3 &from, const Vector3 &to)
 	{
-		if (m_spawn == nullptr)
+		if (m_gpu)
+		{
+			EmitSpawnRequest(count, from, to);
+			return;
+		}
+
+		std::vector<Particle> created = std::vector<Particle>();
+		created.reserve(count);
+		Vector3 motion = to - from;
+
+		for (uint32_t i = 0; i < count; i++)
 		{
-			return nullptr;
+			// Particles are spread along the motion of the system since the last update, so fast systems leave a trail and not clumps.
+			float progress = static_cast<float>(i + 1) / static_cast<float>(count);
+			created.emplace_back(EmitParticle(from + (motion * progress)));
 		}
 
+		Particles::Get()->AddParticles(created);
+	}
+
+	Particle ParticleSystem::EmitParticle(const Vector3 &origin)
+	{
 		Vector3 velocity = Vector3();
-		float delta = Engine::Get()->GetDelta();
-		velocity = GetGameObject()->GetTransform().GetPosition() - m_lastPosition;
-		m_lastPosition = GetGameObject()->GetTransform().GetPosition();
-		velocity /= delta;
 
 		if (m_direction != 0.0f)
 		{
@@ -96,10 +129,33 @@ namespace acid
 		auto emitType = m_types.at(static_cast<uint32_t>(std::floor(Maths::Random(0, static_cast<int>(m_types.size())))));
 		float scale = GenerateValue(emitType->GetScale(), emitType->GetScale() * Maths::Random(1.0f - m_scaleError, 1.0f + m_scaleError));
 		float lifeLength = GenerateValue(emitType->GetLifeLength(), emitType->GetLifeLength() * Maths::Random(1.0f - m_lifeError, 1.0f + m_lifeError));
-		Vector3 spawnPos = Vector3();
-		spawnPos = GetGameObject()->GetTransform().GetPosition() + m_systemOffset;
-		spawnPos = spawnPos + m_spawn->GetBaseSpawnPosition();
-		return new Particle(emitType, spawnPos, velocity, lifeLength, GenerateRotation(), scale, m_gravityEffect);
+		Vector3 spawnPos = origin + m_spawn->GetBaseSpawnPosition();
+		return Particle(emitType, spawnPos, velocity, lifeLength, GenerateRotation(), scale, m_gravityEffect);
+	}
+
+	void ParticleSystem::EmitSpawnRequest(const uint32_t &count, const Vector3 &from, const Vector3 &to)
+	{
+		// Each burst picks one of the types, the values are varied per particle on the GPU.
+		auto emitType = m_types.at(static_cast<uint32_t>(std::floor(Maths::Random(0, static_cast<int>(m_types.size())))));
+
+		ParticleSpawnRequest request = ParticleSpawnRequest();
+		request.m_origin = to;
+		request.m_previousOrigin = from;
+		request.m_shape = m_spawn->GetShape();
+		request.m_shapeParameters = m_spawn->GetShapeParameters();
+		request.m_direction = m_direction;
+		request.m_directionDeviation = m_directionDeviation;
+		request.m_averageSpeed = m_averageSpeed;
+		request.m_speedError = m_speedError;
+		request.m_gravityEffect = m_gravityEffect;
+		request.m_randomRotation = m_randomRotation ? 1 : 0;
+		request.m_lifeLength = emitType->GetLifeLength();
+		request.m_lifeError = m_lifeError;
+		request.m_scale = emitType->GetScale();
+		request.m_scaleError = m_scaleError;
+		request.m_count = count;
+		request.m_seed = static_cast<uint32_t>(Maths::Random(0.0f, 16777216.0f));
+		Particles::Get()->AddSpawnRequest(emitType, request);
 	}
 
 	float ParticleSystem::GenerateValue(const float &average, const float &errorMargin) const
@@ -151,6 +207,11 @@ namespace acid
 		return false;
 	}
 
+	void ParticleSystem::Burst(const uint32_t &count)
+	{
+		m_burstCount += count;
+	}
+
 	void ParticleSystem::SetDirection(const Vector3 &direction, const float &deviation)
 	{
 		m_direction = direction;
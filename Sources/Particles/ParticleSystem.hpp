@@ -2,6 +2,7 @@
 
 #include <vector>
 #include "Maths/Vector3.hpp"
+#include "Maths/Visual/IDriver.hpp"
 #include "Objects/GameObject.hpp"
 #include "Objects/IComponent.hpp"
 #include "Spawns/ISpawnParticle.hpp"
@@ -21,6 +22,7 @@ namespace acid
 		std::shared_ptr<ISpawnParticle> m_spawn;
 
 		float m_pps;
+		std::shared_ptr<IDriver> m_ppsDriver;
 		float m_averageSpeed;
 		float m_gravityEffect;
 		bool m_randomRotation;
@@ -34,8 +36,10 @@ namespace acid
 		float m_lifeError;
 		float m_scaleError;
 
-		float m_timePassed;
+		float m_emitAccumulator;
+		uint32_t m_burstCount;
 		bool m_paused;
+		bool m_gpu;
 	public:
 		/// <summary>
 		/// Creates a new particle system.
@@ -61,8 +65,24 @@ namespace acid
 
 		void Write(LoadedValue *destination) override;
 
+		/// <summary>
+		/// Emits a number of particles at once during the next update, on top of the particles emitted by the rate.
+		/// </summary>
+		/// <param name="count"> The number of particles to emit. </param>
+		void Burst(const uint32_t &count);
+
 	private:
-		Particle *EmitParticle();
+		/// <summary>
+		/// Emits particles spread evenly along a motion of the system.
+		/// </summary>
+		/// <param name="count"> The number of particles to emit. </param>
+		/// <param name="from"> The position of the system at the start of the motion. </param>
+		/// <param name="to"> The position of the system at the end of the motion, where the last particle is emitted. </param>
+		void Emit(const uint32_t &count, const Vector3 &from, const Vector3 &to);
+
+		Particle EmitParticle(const Vector3 &origin);
+
+		void EmitSpawnRequest(const uint32_t &count, const Vector3 &from, const Vector3 &to);
 
 		float GenerateValue(const float &average, const float &errorMargin) const;
 
@@ -83,6 +103,14 @@ namespace acid
 
 		void SetPps(const float &pps) { m_pps = pps; }
 
+		std::shared_ptr<IDriver> GetPpsDriver() const { return m_ppsDriver; }
+
+		/// <summary>
+		/// Sets a driver that gives the particles per second over time, used in place of the constant rate.
+		/// </summary>
+		/// <param name="ppsDriver"> The rate driver, or nullptr to use the constant rate. </param>
+		void SetPpsDriver(std::shared_ptr<IDriver> ppsDriver) { m_ppsDriver = ppsDriver; }
+
 		float GetAverageSpeed() const { return m_averageSpeed; }
 
 		void SetAverageSpeed(const float &averageSpeed) { m_averageSpeed = averageSpeed; }
@@ -118,5 +146,13 @@ namespace acid
 		bool GetPaused() const { return m_paused; }
 
 		void SetPaused(const bool &paused) { m_paused = paused; }
+
+		bool IsGpu() const { return m_gpu; }
+
+		/// <summary>
+		/// Sets if this system spawns its particles on the GPU, where they are spawned, simulated and drawn without the CPU touching each particle.
+		/// </summary>
+		/// <param name="gpu"> If particles are spawned on the GPU. </param>
+		void SetGpu(const bool &gpu) { m_gpu = gpu; }
 	};
 }
@@ -1,14 +1,18 @@
 #include "Particles.hpp"
 
+#include <vector>
+#include "Threads/ThreadPool.hpp"
 #include "Scenes/Scenes.hpp"
 
 namespace acid
 {
 	const float Particles::MAX_ELAPSED_TIME = 5.0f;
+	const uint32_t Particles::PARALLEL_THRESHOLD = 4096;
 
 	Particles::Particles() :
 		IModule(),
-		m_particles(std::map<std::shared_ptr<ParticleType>, std::vector<Particle *>>())
+		m_pools(std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticlePool>>()),
+		m_gpuPools(std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticlePoolGpu>>())
 	{
 	}
 
@@ -23,44 +27,104 @@ namespace acid
 			return;
 		}
 
-		for (auto it = m_particles.begin(); it != m_particles.end(); ++it)
+		float delta = Engine::Get()->GetDelta();
+		auto camera = Scenes::Get()->GetCamera();
+		Vector3 cameraPosition = camera != nullptr ? camera->GetPosition() : Vector3();
+
+		std::vector<ParticlePool *> pools = std::vector<ParticlePool *>();
+		uint32_t particleCount = 0;
+
+		for (auto &pool : m_pools)
 		{
-			for (auto it1 = (*it).second.begin(); it1 != (*it).second.end();)
-			{
-				(*it1)->Update();
+			pools.emplace_back(pool.second.get());
+			particleCount += pool.second->GetCount();
+		}
 
-				if (!(*it1)->IsAlive())
+		// Pools share no data, so large systems are updated a pool per job.
+		if (pools.size() > 1 && particleCount >= PARALLEL_THRESHOLD)
+		{
+			auto handle = ThreadPool::Get()->ParallelFor(0, static_cast<uint32_t>(pools.size()), [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
 				{
-					delete *it1;
-					it1 = (*it).second.erase(it1);
-					continue;
+					pools[i]->Update(delta, cameraPosition);
 				}
-
-				++it1;
+			}, 1);
+			ThreadPool::Get()->Wait(handle);
+		}
+		else
+		{
+			for (auto &pool : pools)
+			{
+				pool->Update(delta, cameraPosition);
 			}
 		}
 	}
 
-	void Particles::AddParticle(Particle *created)
+	void Particles::AddParticle(const Particle &created)
 	{
-		if (created == nullptr)
+		GetPool(created.GetParticleType())->Add(created);
+	}
+
+	void Particles::AddParticles(const std::vector<Particle> &created)
+	{
+		ParticlePool *pool = nullptr;
+
+		for (auto &particle : created)
 		{
-			return;
+			if (pool == nullptr || pool->GetParticleType() != particle.GetParticleType())
+			{
+				pool = GetPool(particle.GetParticleType());
+			}
+
+			pool->Add(particle);
 		}
+	}
 
-		auto it = m_particles.find(created->GetParticleType());
+	void Particles::AddSpawnRequest(const std::shared_ptr<ParticleType> &particleType, const ParticleSpawnRequest &request)
+	{
+		auto it = m_gpuPools.find(particleType);
 
-		if (it == m_particles.end())
+		if (it == m_gpuPools.end())
 		{
-			m_particles.emplace(created->GetParticleType(), std::vector<Particle *>());
-			it = m_particles.find(created->GetParticleType());
+			it = m_gpuPools.emplace(particleType, std::make_unique<ParticlePoolGpu>(particleType)).first;
 		}
 
-		(*it).second.emplace_back(created);
+		(*it).second->AddSpawnRequest(request);
 	}
 
 	void Particles::Clear()
 	{
-		m_particles.clear();
+		m_pools.clear();
+
+		// GPU pools are kept, their buffers may be in use by frames in flight.
+		for (auto &pool : m_gpuPools)
+		{
+			pool.second->Clear();
+		}
+	}
+
+	uint32_t Particles::GetParticleCount() const
+	{
+		uint32_t particleCount = 0;
+
+		for (auto &pool : m_pools)
+		{
+			particleCount += pool.second->GetCount();
+		}
+
+		return particleCount;
+	}
+
+	ParticlePool *Particles::GetPool(const std::shared_ptr<ParticleType> &particleType)
+	{
+		auto it = m_pools.find(particleType);
+
+		if (it == m_pools.end())
+		{
+			it = m_pools.emplace(particleType, std::make_unique<ParticlePool>(particleType)).first;
+		}
+
+		return (*it).second.get();
 	}
 }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <vector>
 #include "Engine/Engine.hpp"
 #include "Particle.hpp"
+#include "ParticlePool.hpp"
+#include "ParticlePoolGpu.hpp"
 
 namespace acid
 {
@@ -15,8 +18,10 @@ namespace acid
 	{
 	private:
 		static const float MAX_ELAPSED_TIME;
+		static const uint32_t PARALLEL_THRESHOLD;
 
-		std::map<std::shared_ptr<ParticleType>, std::vector<Particle *>> m_particles;
+		std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticlePool>> m_pools;
+		std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticlePoolGpu>> m_gpuPools;
 	public:
 		/// <summary>
 		/// Gets this engine instance.
@@ -39,7 +44,24 @@ namespace acid
 
 		void Update() override;
 
-		void AddParticle(Particle *created);
+		/// <summary>
+		/// Adds a particle to the pool of its type.
+		/// </summary>
+		/// <param name="created"> The spawn state of the particle. </param>
+		void AddParticle(const Particle &created);
+
+		/// <summary>
+		/// Adds many particles to the pools of their types, consecutive particles of the same type share one pool lookup.
+		/// </summary>
+		/// <param name="created"> The spawn states of the particles. </param>
+		void AddParticles(const std::vector<Particle> &created);
+
+		/// <summary>
+		/// Adds a burst of particles to be spawned on the GPU, into the GPU pool of its type.
+		/// </summary>
+		/// <param name="particleType"> The type of the particles to spawn. </param>
+		/// <param name="request"> The spawn request. </param>
+		void AddSpawnRequest(const std::shared_ptr<ParticleType> &particleType, const ParticleSpawnRequest &request);
 
 		/// <summary>
 		/// Clears all particles from the scene.
@@ -47,9 +69,23 @@ namespace acid
 		void Clear();
 
 		/// <summary>
-		/// Gets a list of all particles.
+		/// Gets the particle pools, one for each particle type.
 		/// </summary>
-		/// <returns> All particles. </returns>
-		std::map<std::shared_ptr<ParticleType>, std::vector<Particle *>> GetParticles() const { return m_particles; }
+		/// <returns> The particle pools. </returns>
+		const std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticlePool>> &GetPools() const { return m_pools; }
+
+		/// <summary>
+		/// Gets the GPU particle pools, one for each particle type spawned on the GPU.
+		/// </summary>
+		/// <returns> The GPU particle pools. </returns>
+		const std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticlePoolGpu>> &GetGpuPools() const { return m_gpuPools; }
+
+		/// <summary>
+		/// Gets the number of live particles across every pool, particles on the GPU are not counted.
+		/// </summary>
+		/// <returns> The particle count. </returns>
+		uint32_t GetParticleCount() const;
+	private:
+		ParticlePool *GetPool(const std::shared_ptr<ParticleType> &particleType);
 	};
 }
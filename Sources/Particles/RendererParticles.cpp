@@ -1,15 +1,26 @@
 #include "RendererParticles.hpp"
 
-#include "Maths/Maths.hpp"
+#include "Models/Shapes/ModelRectangle.hpp"
 #include "Models/VertexModel.hpp"
+#include "Renderer/Renderer.hpp"
 
 namespace acid
 {
 	RendererParticles::RendererParticles(const GraphicsStage &graphicsStage) :
 		IRenderer(graphicsStage),
-		m_uniformScene(UniformHandler()),
+		m_uniformScene(UniformHandler(true)),
 		m_pipeline(Pipeline(graphicsStage, PipelineCreate({"Shaders/Particles/Particle.vert", "Shaders/Particles/Particle.frag"},
-			VertexModel::GetVertexInput(), PIPELINE_MODE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, {})))
+			ParticleInstance::GetVertexInput(VertexModel::GetVertexInput()), PIPELINE_MODE_MRT_BLENDED, VK_POLYGON_MODE_FILL, VK_CULL_MODE_NONE, {}))),
+		m_pipelineGpu(Pipeline(graphicsStage, PipelineCreate({"Shaders/Particles/Particle.vert", "Shaders/Particles/Particle.frag"},
+			ParticleInstance::GetVertexInput(VertexModel::GetVertexInput(), ParticlePoolGpu::PARTICLE_STRIDE), PIPELINE_MODE_MRT_BLENDED, VK_POLYGON_MODE_FILL, VK_CULL_MODE_NONE, {}))),
+		m_computeSimulate(Compute(ComputeCreate("Shaders/Particles/Simulate.comp", ParticlePoolGpu::CAPACITY, 1, ParticlePoolGpu::WORKGROUP_SIZE, {}))),
+		m_computeSpawn(Compute(ComputeCreate("Shaders/Particles/Spawn.comp", ParticlePoolGpu::CAPACITY, 1, ParticlePoolGpu::WORKGROUP_SIZE, {}))),
+		m_model(ModelRectangle::Resource(-0.5f, 0.5f)),
+		m_instanceBuffers(std::vector<std::unique_ptr<InstanceBuffer>>(Renderer::MAX_FRAMES_IN_FLIGHT)),
+		m_batches(std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticleBatch>>()),
+		m_gpuBatches(std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticleBatch>>()),
+		m_instances(std::vector<ParticleInstance>()),
+		m_instanceCount(0)
 	{
 	}
 
@@ -19,49 +30,159 @@ namespace acid
 
 	void RendererParticles::Render(const CommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera)
 	{
-		/*auto logicalDevice = Display::Get()->GetLogicalDevice();
-		auto descriptorSet = m_pipeline->GetDescriptorSet();
+		auto &pools = Particles::Get()->GetPools();
 
-		UbosParticles::UboScene uboScene = {};
-		uboScene.projection = camera.GetProjectionMatrix();
-		uboScene.view = camera.GetViewMatrix();
-		m_uniformScene->Update(&uboScene);
+		// Batches of particle types that no longer have a pool are released.
+		for (auto it = m_batches.begin(); it != m_batches.end();)
+		{
+			if (pools.find((*it).first) == pools.end())
+			{
+				it = m_batches.erase(it);
+				continue;
+			}
+
+			++it;
+		}
+
+		m_uniformScene.Push("projection", camera.GetProjectionMatrix());
+		m_uniformScene.Push("view", camera.GetViewMatrix());
+
+		m_instanceCount = 0;
+
+		for (auto &[particleType, pool] : pools)
+		{
+			// Particles without a texture have nothing to sample.
+			if (pool->IsEmpty() || particleType->GetTexture() == nullptr)
+			{
+				continue;
+			}
+
+			auto &batch = m_batches[particleType];
+
+			if (batch == nullptr)
+			{
+				batch = std::make_unique<ParticleBatch>();
+			}
 
-		m_pipeline->BindPipeline(commandBuffer);*/
+			batch->offset = static_cast<VkDeviceSize>(m_instanceCount * sizeof(ParticleInstance));
+			batch->count = pool->GetCount();
 
-		/*for (auto iter = Particles::Get()->GetParticles()->begin(); iter != Particles::Get()->GetParticles()->end(); ++iter)
+			// Instances are only constructed when the array grows, every frame after overwrites them in place.
+			if (m_instances.size() < m_instanceCount + batch->count)
+			{
+				m_instances.resize(m_instanceCount + batch->count);
+			}
+
+			// Particles are blended, so each type is written from the furthest to the nearest particle.
+			pool->WriteInstances(pool->SortBackToFront(), &m_instances[m_instanceCount]);
+			m_instanceCount += batch->count;
+		}
+
+		if (m_instanceCount != 0)
 		{
-			std::vector<UbosParticles::UboObject> objects = {};
+			UploadInstances();
 
-			for (auto &particle : *(*iter).second)
+			auto &instanceBuffer = m_instanceBuffers[Renderer::Get()->GetCurrentFrame()];
+
+			m_pipeline.BindPipeline(commandBuffer);
+			m_model->CmdBind(commandBuffer);
+
+			for (auto &[particleType, pool] : pools)
 			{
-				UbosParticles::UboObject object = {};
-				object.transform = ModelMatrix(particle, camera.GetViewMatrix());
-				object.textureOffsets.m_x = particle->GetTextureOffset1()->m_x;
-				object.textureOffsets.m_y = particle->GetTextureOffset1()->m_y;
-				object.textureOffsets.m_z = particle->GetTextureOffset2()->m_x;
-				object.textureOffsets.m_w = particle->GetTextureOffset2()->m_y;
-				object.blendFactor = particle->GetTextureBlendFactor();
-				object.transparency = particle->GetTransparency();
-				objects.emplace_back(object);
+				auto it = m_batches.find(particleType);
+
+				if (pool->IsEmpty() || it == m_batches.end() || particleType->GetTexture() == nullptr)
+				{
+					continue;
+				}
+
+				auto &batch = *(*it).second;
+
+				if (!CmdBindBatch(commandBuffer, m_pipeline, *particleType, batch))
+				{
+					continue;
+				}
+
+				// Draws every particle of the type.
+				instanceBuffer->CmdBind(commandBuffer, ParticleInstance::BINDING, batch.offset);
+				m_model->CmdDraw(commandBuffer, batch.count);
 			}
-		}*/
+		}
+
+		RenderGpu(commandBuffer);
 	}
 
-	Matrix4 RendererParticles::ModelMatrix(Particle *particle, const Matrix4 &viewMatrix)
+	void RendererParticles::Dispatch(const CommandBuffer &commandBuffer)
 	{
-		Matrix4 modelMatrix = modelMatrix.Translate(particle->GetPosition());
-		modelMatrix[0][0] = viewMatrix[0][0];
-		modelMatrix[0][1] = viewMatrix[1][0];
-		modelMatrix[0][2] = viewMatrix[2][0];
-		modelMatrix[1][0] = viewMatrix[0][1];
-		modelMatrix[1][1] = viewMatrix[1][1];
-		modelMatrix[1][2] = viewMatrix[2][1];
-		modelMatrix[2][0] = viewMatrix[0][2];
-		modelMatrix[2][1] = viewMatrix[1][2];
-		modelMatrix[2][2] = viewMatrix[2][2];
-		modelMatrix = modelMatrix.Rotate(Maths::Radians(particle->GetRotation()), Vector3::FRONT);
-		modelMatrix = modelMatrix.Scale(Vector3(particle->GetScale(), particle->GetScale(), particle->GetScale()));
-		return Matrix4();
+		uint32_t indexCount = m_model->GetIndexBuffer()->GetIndexCount();
+
+		for (auto &[particleType, pool] : Particles::Get()->GetGpuPools())
+		{
+			pool->CmdDispatch(commandBuffer, m_computeSimulate, m_computeSpawn, indexCount);
+		}
+	}
+
+	void RendererParticles::UploadInstances()
+	{
+		auto size = static_cast<VkDeviceSize>(m_instanceCount * sizeof(ParticleInstance));
+		auto &instanceBuffer = m_instanceBuffers[Renderer::Get()->GetCurrentFrame()];
+		Buffer::Reserve(instanceBuffer, size, 1024 * sizeof(ParticleInstance));
+		instanceBuffer->Update(m_instances.data(), size);
+	}
+
+	void RendererParticles::RenderGpu(const CommandBuffer &commandBuffer)
+	{
+		bool bound = false;
+
+		for (auto &[particleType, pool] : Particles::Get()->GetGpuPools())
+		{
+			if (!pool->IsActive() || particleType->GetTexture() == nullptr)
+			{
+				continue;
+			}
+
+			if (!bound)
+			{
+				m_pipelineGpu.BindPipeline(commandBuffer);
+				m_model->CmdBind(commandBuffer);
+				bound = true;
+			}
+
+			auto &batch = m_gpuBatches[particleType];
+
+			if (batch == nullptr)
+			{
+				batch = std::make_unique<ParticleBatch>();
+			}
+
+			if (!CmdBindBatch(commandBuffer, m_pipelineGpu, *particleType, *batch))
+			{
+				continue;
+			}
+
+			// The instance count was written by the compute passes.
+			pool->CmdDraw(commandBuffer);
+		}
+	}
+
+	bool RendererParticles::CmdBindBatch(const CommandBuffer &commandBuffer, const Pipeline &pipeline, const ParticleType &particleType, ParticleBatch &batch)
+	{
+		// Updates uniforms.
+		batch.uniformObject.Push("colourOffset", particleType.GetColourOffset());
+		batch.uniformObject.Push("atlasRows", static_cast<float>(particleType.GetNumberOfRows()));
+
+		// Updates descriptors.
+		batch.descriptorSet.Push("UboScene", m_uniformScene);
+		batch.descriptorSet.Push("UboObject", batch.uniformObject);
+		batch.descriptorSet.Push("samplerColour", particleType.GetTexture());
+		bool updateSuccess = batch.descriptorSet.Update(pipeline);
+
+		if (!updateSuccess)
+		{
+			return false;
+		}
+
+		batch.descriptorSet.BindDescriptor(commandBuffer);
+		return true;
 	}
 }
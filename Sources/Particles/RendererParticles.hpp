@@ -1,21 +1,47 @@
 #pragma once
 
+#include <map>
+#include <memory>
 #include <vector>
 #include "Models/Model.hpp"
-#include "Renderer/Buffers/UniformBuffer.hpp"
+#include "Renderer/Buffers/InstanceBuffer.hpp"
 #include "Renderer/IRenderer.hpp"
+#include "Renderer/Handlers/DescriptorsHandler.hpp"
 #include "Renderer/Handlers/UniformHandler.hpp"
+#include "Renderer/Pipelines/Compute.hpp"
 #include "Renderer/Pipelines/Pipeline.hpp"
+#include "ParticleInstance.hpp"
 #include "Particles.hpp"
 
 namespace acid
 {
+	/// <summary>
+	/// Renders every particle pool with one instanced draw per particle type, particles are sorted back to front since they are blended.
+	/// GPU particle pools are simulated by compute passes before the frame renders, and drawn unsorted with indirect draws.
+	/// </summary>
 	class ACID_EXPORT RendererParticles :
 		public IRenderer
 	{
 	private:
+		struct ParticleBatch
+		{
+			UniformHandler uniformObject;
+			DescriptorsHandler descriptorSet;
+			VkDeviceSize offset;
+			uint32_t count;
+		};
+
 		UniformHandler m_uniformScene;
 		Pipeline m_pipeline;
+		Pipeline m_pipelineGpu;
+		Compute m_computeSimulate;
+		Compute m_computeSpawn;
+		std::shared_ptr<Model> m_model;
+		std::vector<std::unique_ptr<InstanceBuffer>> m_instanceBuffers;
+		std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticleBatch>> m_batches;
+		std::map<std::shared_ptr<ParticleType>, std::unique_ptr<ParticleBatch>> m_gpuBatches;
+		std::vector<ParticleInstance> m_instances;
+		uint32_t m_instanceCount;
 	public:
 		RendererParticles(const GraphicsStage &graphicsStage);
 
@@ -23,7 +49,12 @@ namespace acid
 
 		void Render(const CommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera) override;
 
+		void Dispatch(const CommandBuffer &commandBuffer) override;
 	private:
-		Matrix4 ModelMatrix(Particle *particle, const Matrix4 &viewMatrix);
+		void UploadInstances();
+
+		void RenderGpu(const CommandBuffer &commandBuffer);
+
+		bool CmdBindBatch(const CommandBuffer &commandBuffer, const Pipeline &pipeline, const ParticleType &particleType, ParticleBatch &batch);
 	};
 }
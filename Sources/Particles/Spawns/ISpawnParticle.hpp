@@ -1,9 +1,21 @@
 #pragma once
 
 #include "Maths/Vector3.hpp"
+#include "Maths/Vector4.hpp"
 
 namespace acid
 {
+	/// <summary>
+	/// The spawn shapes the GPU particle spawn shader can evaluate.
+	/// </summary>
+	enum SpawnShape
+	{
+		SPAWN_SHAPE_POINT = 0,
+		SPAWN_SHAPE_LINE = 1,
+		SPAWN_SHAPE_CIRCLE = 2,
+		SPAWN_SHAPE_SPHERE = 3
+	};
+
 	/// <summary>
 	/// A interface that defines a particle spawn type.
 	/// </summary>
@@ -29,5 +41,17 @@ namespace acid
 		/// </summary>
 		/// <returns> The base spawn position. </returns>
 		virtual Vector3 GetBaseSpawnPosition() = 0;
+
+		/// <summary>
+		/// Gets the shape of this spawn, used when the spawn position is generated on the GPU.
+		/// </summary>
+		/// <returns> The spawn shape. </returns>
+		virtual SpawnShape GetShape() const = 0;
+
+		/// <summary>
+		/// Gets the parameters of this spawns shape, read by the GPU spawn shader.
+		/// </summary>
+		/// <returns> The point, axis or heading of the shape in xyz, the length or radius in w. </returns>
+		virtual Vector4 GetShapeParameters() const = 0;
 	};
 }
@@ -19,4 +19,9 @@ namespace acid
 		m_spawnPosition = Vector3::RandomPointOnCircle(m_heading, m_radius);
 		return m_spawnPosition;
 	}
+
+	Vector4 SpawnCircle::GetShapeParameters() const
+	{
+		return Vector4(m_heading.m_x, m_heading.m_y, m_heading.m_z, m_radius);
+	}
 }
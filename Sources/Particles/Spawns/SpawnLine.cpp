@@ -23,4 +23,9 @@ namespace acid
 		m_spawnPosition *= Maths::Random(-0.5f, 0.5f);
 		return m_spawnPosition;
 	}
+
+	Vector4 SpawnLine::GetShapeParameters() const
+	{
+		return Vector4(m_axis.m_x, m_axis.m_y, m_axis.m_z, m_length);
+	}
 }
@@ -18,6 +18,10 @@ namespace acid
 
 		Vector3 GetBaseSpawnPosition() override;
 
+		SpawnShape GetShape() const override { return SPAWN_SHAPE_LINE; }
+
+		Vector4 GetShapeParameters() const override;
+
 		float GetLength() const { return m_length; }
 
 		void SetLength(const float &length) { m_length = length; }
@@ -16,4 +16,9 @@ namespace acid
 	{
 		return m_point;
 	}
+
+	Vector4 SpawnPoint::GetShapeParameters() const
+	{
+		return Vector4(m_point.m_x, m_point.m_y, m_point.m_z, 0.0f);
+	}
 }
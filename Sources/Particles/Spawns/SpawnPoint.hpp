@@ -16,6 +16,10 @@ namespace acid
 
 		Vector3 GetBaseSpawnPosition() override;
 
+		SpawnShape GetShape() const override { return SPAWN_SHAPE_POINT; }
+
+		Vector4 GetShapeParameters() const override;
+
 		Vector3 GetPoint() const { return m_point; }
 
 		void SetPoint(const Vector3 &point) { m_point = point; }
@@ -37,4 +37,9 @@ namespace acid
 		m_spawnPosition *= distance;
 		return m_spawnPosition;
 	}
+
+	Vector4 SpawnSphere::GetShapeParameters() const
+	{
+		return Vector4(0.0f, 0.0f, 0.0f, m_radius);
+	}
 }
@@ -17,6 +17,10 @@ namespace acid
 
 		Vector3 GetBaseSpawnPosition() override;
 
+		SpawnShape GetShape() const override { return SPAWN_SHAPE_SPHERE; }
+
+		Vector4 GetShapeParameters() const override;
+
 		float GetRadius() const { return m_radius; }
 
 		void SetRadius(const float &radius) { m_radius = radius; }
@@ -0,0 +1,127 @@
+#include "Aabb.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include "Maths/Vector4.hpp"
+
+namespace acid
+{
+	Aabb::Aabb() :
+		m_min(Vector3::POSITIVE_INFINITY),
+		m_max(Vector3::NEGATIVE_INFINITY)
+	{
+	}
+
+	Aabb::Aabb(const Vector3 &min, const Vector3 &max) :
+		m_min(min),
+		m_max(max)
+	{
+	}
+
+	Aabb Aabb::FromSphere(const Vector3 &centre, const float &radius)
+	{
+		return Aabb(Vector3(centre.m_x - radius, centre.m_y - radius, centre.m_z - radius), Vector3(centre.m_x + radius, centre.m_y + radius, centre.m_z + radius));
+	}
+
+	Aabb Aabb::Transform(const Matrix4 &matrix) const
+	{
+		if (!IsValid())
+		{
+			return *this;
+		}
+
+		std::array<Vector3, 8> corners = {
+			Vector3(m_min.m_x, m_min.m_y, m_min.m_z),
+			Vector3(m_max.m_x, m_min.m_y, m_min.m_z),
+			Vector3(m_min.m_x, m_max.m_y, m_min.m_z),
+			Vector3(m_max.m_x, m_max.m_y, m_min.m_z),
+			Vector3(m_min.m_x, m_min.m_y, m_max.m_z),
+			Vector3(m_max.m_x, m_min.m_y, m_max.m_z),
+			Vector3(m_min.m_x, m_max.m_y, m_max.m_z),
+			Vector3(m_max.m_x, m_max.m_y, m_max.m_z)
+		};
+
+		Aabb result = Aabb();
+
+		for (auto &corner : corners)
+		{
+			Vector3 transformed = Vector3(matrix.Transform(Vector4(corner, 1.0f)));
+			result.m_min = Vector3::MinVector(result.m_min, transformed);
+			result.m_max = Vector3::MaxVector(result.m_max, transformed);
+		}
+
+		return result;
+	}
+
+	Aabb Aabb::Merge(const Aabb &other) const
+	{
+		return Aabb(Vector3::MinVector(m_min, other.m_min), Vector3::MaxVector(m_max, other.m_max));
+	}
+
+	Aabb Aabb::Expand(const float &margin) const
+	{
+		return Aabb(Vector3(m_min.m_x - margin, m_min.m_y - margin, m_min.m_z - margin), Vector3(m_max.m_x + margin, m_max.m_y + margin, m_max.m_z + margin));
+	}
+
+	float Aabb::SurfaceArea() const
+	{
+		float x = m_max.m_x - m_min.m_x;
+		float y = m_max.m_y - m_min.m_y;
+		float z = m_max.m_z - m_min.m_z;
+		return 2.0f * ((x * y) + (y * z) + (z * x));
+	}
+
+	bool Aabb::IsValid() const
+	{
+		return m_min.m_x <= m_max.m_x && m_min.m_y <= m_max.m_y && m_min.m_z <= m_max.m_z;
+	}
+
+	bool Aabb::Contains(const Aabb &other) const
+	{
+		return m_min.m_x <= other.m_min.m_x && m_min.m_y <= other.m_min.m_y && m_min.m_z <= other.m_min.m_z &&
+			m_max.m_x >= other.m_max.m_x && m_max.m_y >= other.m_max.m_y && m_max.m_z >= other.m_max.m_z;
+	}
+
+	bool Aabb::Intersects(const Aabb &other) const
+	{
+		return m_min.m_x <= other.m_max.m_x && m_max.m_x >= other.m_min.m_x &&
+			m_min.m_y <= other.m_max.m_y && m_max.m_y >= other.m_min.m_y &&
+			m_min.m_z <= other.m_max.m_z && m_max.m_z >= other.m_min.m_z;
+	}
+
+	bool Aabb::IntersectsSphere(const Vector3 &centre, const float &radius) const
+	{
+		// Squared distance from the sphere centre to the closest point on the box.
+		float x = std::max(m_min.m_x - centre.m_x, std::max(0.0f, centre.m_x - m_max.m_x));
+		float y = std::max(m_min.m_y - centre.m_y, std::max(0.0f, centre.m_y - m_max.m_y));
+		float z = std::max(m_min.m_z - centre.m_z, std::max(0.0f, centre.m_z - m_max.m_z));
+		return (x * x) + (y * y) + (z * z) <= radius * radius;
+	}
+
+	bool Aabb::InFrustum(const Frustum &frustum) const
+	{
+		return frustum.CubeInFrustum(m_min, m_max);
+	}
+
+	std::optional<float> Aabb::IntersectsRay(const Vector3 &origin, const Vector3 &inverseDirection, const float &maxDistance) const
+	{
+		// Slab test.
+		float tx1 = (m_min.m_x - origin.m_x) * inverseDirection.m_x;
+		float tx2 = (m_max.m_x - origin.m_x) * inverseDirection.m_x;
+		float ty1 = (m_min.m_y - origin.m_y) * inverseDirection.m_y;
+		float ty2 = (m_max.m_y - origin.m_y) * inverseDirection.m_y;
+		float tz1 = (m_min.m_z - origin.m_z) * inverseDirection.m_z;
+		float tz2 = (m_max.m_z - origin.m_z) * inverseDirection.m_z;
+
+		float tmin = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+		float tmax = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+
+		if (tmax < 0.0f || tmin > tmax || tmin > maxDistance)
+		{
+			return std::nullopt;
+		}
+
+		return std::max(tmin, 0.0f);
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <optional>
+#include "Maths/Matrix4.hpp"
+#include "Maths/Vector3.hpp"
+#include "Frustum.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A axis aligned bounding box in world space.
+	/// </summary>
+	class ACID_EXPORT Aabb
+	{
+	public:
+		Vector3 m_min;
+		Vector3 m_max;
+
+		/// <summary>
+		/// Creates a new empty bounding box, merging any box into it results in that box.
+		/// </summary>
+		Aabb();
+
+		/// <summary>
+		/// Creates a new bounding box.
+		/// </summary>
+		/// <param name="min"> The minimum extents. </param>
+		/// <param name="max"> The maximum extents. </param>
+		Aabb(const Vector3 &min, const Vector3 &max);
+
+		/// <summary>
+		/// Creates a bounding box around a sphere.
+		/// </summary>
+		/// <param name="centre"> The sphere centre. </param>
+		/// <param name="radius"> The sphere radius. </param>
+		/// <returns> The bounding box. </returns>
+		static Aabb FromSphere(const Vector3 &centre, const float &radius);
+
+		/// <summary>
+		/// Transforms the corners of this box and builds a new box around them.
+		/// </summary>
+		/// <param name="matrix"> The transformation matrix. </param>
+		/// <returns> The transformed bounding box. </returns>
+		Aabb Transform(const Matrix4 &matrix) const;
+
+		/// <summary>
+		/// Gets the smallest box containing this box and another.
+		/// </summary>
+		/// <param name="other"> The other box. </param>
+		/// <returns> The merged box. </returns>
+		Aabb Merge(const Aabb &other) const;
+
+		/// <summary>
+		/// Grows this box by a margin on every side.
+		/// </summary>
+		/// <param name="margin"> The margin to grow by. </param>
+		/// <returns> The grown box. </returns>
+		Aabb Expand(const float &margin) const;
+
+		/// <summary>
+		/// Gets the surface area of this box, used as the cost when building bounding volume hierarchies.
+		/// </summary>
+		/// <returns> The surface area. </returns>
+		float SurfaceArea() const;
+
+		bool IsValid() const;
+
+		bool Contains(const Aabb &other) const;
+
+		bool Intersects(const Aabb &other) const;
+
+		bool IntersectsSphere(const Vector3 &centre, const float &radius) const;
+
+		bool InFrustum(const Frustum &frustum) const;
+
+		/// <summary>
+		/// Intersects a ray with this box.
+		/// </summary>
+		/// <param name="origin"> The ray origin. </param>
+		/// <param name="inverseDirection"> One divided by each component of the ray direction. </param>
+		/// <param name="maxDistance"> The maximum distance along the ray. </param>
+		/// <returns> The distance along the ray the box is entered at, or no value if it is missed. </returns>
+		std::optional<float> IntersectsRay(const Vector3 &origin, const Vector3 &inverseDirection, const float &maxDistance) const;
+	};
+}
@@ -12,13 +12,13 @@ namespace acid
 	{
 	}
 
-	bool Collider::InFrustum(const Frustum &frustum)
+	std::optional<Aabb> Collider::GetBounds()
 	{
 		btCollisionShape *shape = GetCollisionShape();
 
 		if (shape == nullptr)
 		{
-			return true;
+			return std::nullopt;
 		}
 
 		Vector3 position = GetGameObject()->GetTransform().GetPosition();
@@ -33,7 +33,19 @@ namespace acid
 		btVector3 max = btVector3();
 		shape->getAabb(worldTransform, min, max);
 
-		return frustum.CubeInFrustum(Convert(min), Convert(max));
+		return Aabb(Convert(min), Convert(max));
+	}
+
+	bool Collider::InFrustum(const Frustum &frustum)
+	{
+		auto bounds = GetBounds();
+
+		if (!bounds)
+		{
+			return true;
+		}
+
+		return bounds->InFrustum(frustum);
 	}
 
 	btVector3 Collider::Convert(const Vector3 &vector)
@@ -5,6 +5,7 @@
 #include "Maths/Quaternion.hpp"
 #include "Maths/Vector3.hpp"
 #include "Objects/IComponent.hpp"
+#include "Aabb.hpp"
 #include "Frustum.hpp"
 #include "Ray.hpp"
 
@@ -51,6 +52,12 @@ namespace acid
 		/// <returns> If the shape is partially in the view frustum. </returns>
 		bool InFrustum(const Frustum &frustum);
 
+		/// <summary>
+		/// Gets the world space bounds of the collision shape.
+		/// </summary>
+		/// <returns> The bounds, or no value if there is no collision shape. </returns>
+		std::optional<Aabb> GetBounds();
+
 		static btVector3 Convert(const Vector3 &vector);
 
 		static Vector3 Convert(const btVector3 &vector);
@@ -2,23 +2,16 @@
 
 #include <array>
 #include <cmath>
-#include "Helpers/SquareArray.hpp"
 
 namespace acid
 {
 	Frustum::Frustum() :
-		m_frustumArray(SquareArray::FloatArray(6, 4))
+		m_frustumArray(std::array<std::array<float, 4>, 6>())
 	{
 	}
 
 	Frustum::~Frustum()
 	{
-		for (int i = 0; i < 6; i++)
-		{
-			delete[] m_frustumArray[i];
-		}
-
-		delete[] m_frustumArray;
 	}
 
 	void Frustum::Update(const Matrix4 &view, const Matrix4 &projection)
@@ -0,0 +1,44 @@
+#include "MotionState.hpp"
+
+namespace acid
+{
+	MotionState::MotionState(const btTransform &transform) :
+		btMotionState(),
+		m_previousTransform(transform),
+		m_currentTransform(transform)
+	{
+	}
+
+	MotionState::~MotionState()
+	{
+	}
+
+	void MotionState::getWorldTransform(btTransform &worldTransform) const
+	{
+		worldTransform = m_currentTransform;
+	}
+
+	void MotionState::setWorldTransform(const btTransform &worldTransform)
+	{
+		m_currentTransform = worldTransform;
+	}
+
+	void MotionState::StorePrevious()
+	{
+		m_previousTransform = m_currentTransform;
+	}
+
+	void MotionState::SetTransform(const btTransform &transform)
+	{
+		m_previousTransform = transform;
+		m_currentTransform = transform;
+	}
+
+	btTransform MotionState::Interpolate(const float &progression) const
+	{
+		btTransform result = btTransform();
+		result.setOrigin(m_previousTransform.getOrigin().lerp(m_currentTransform.getOrigin(), progression));
+		result.setRotation(m_previousTransform.getRotation().slerp(m_currentTransform.getRotation(), progression));
+		return result;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <LinearMath/btMotionState.h>
+#include <LinearMath/btTransform.h>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A motion state that keeps the transform of a body before and after the last physics step,
+	/// so the body can be drawn between steps when rendering faster than the physics runs.
+	/// </summary>
+	class ACID_EXPORT MotionState :
+		public btMotionState
+	{
+	private:
+		btTransform m_previousTransform;
+		btTransform m_currentTransform;
+	public:
+		/// <summary>
+		/// Creates a new motion state.
+		/// </summary>
+		/// <param name="transform"> The starting transform of the body. </param>
+		MotionState(const btTransform &transform);
+
+		~MotionState();
+
+		void getWorldTransform(btTransform &worldTransform) const override;
+
+		void setWorldTransform(const btTransform &worldTransform) override;
+
+		/// <summary>
+		/// Stores the current transform as the previous transform, called before each physics step.
+		/// A body that sleeps through the step keeps the same previous and current transforms.
+		/// </summary>
+		void StorePrevious();
+
+		/// <summary>
+		/// Sets the previous and current transforms, so a body that is moved is not drawn sliding from where it was.
+		/// </summary>
+		/// <param name="transform"> The new transform of the body. </param>
+		void SetTransform(const btTransform &transform);
+
+		/// <summary>
+		/// Gets the transform between the previous and current physics step.
+		/// </summary>
+		/// <param name="progression"> How far between the previous and current step, from 0 to 1. </param>
+		/// <returns> The interpolated transform. </returns>
+		btTransform Interpolate(const float &progression) const;
+
+		const btTransform &GetPreviousTransform() const { return m_previousTransform; }
+
+		const btTransform &GetCurrentTransform() const { return m_currentTransform; }
+	};
+}
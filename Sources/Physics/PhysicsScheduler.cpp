@@ -0,0 +1,99 @@
+#include "PhysicsScheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "Threads/ThreadPool.hpp"
+
+namespace acid
+{
+	PhysicsScheduler::PhysicsScheduler(ThreadPool *threadPool) :
+		btITaskScheduler("ThreadPool"),
+		m_threadPool(threadPool),
+		m_numThreads(static_cast<int>(threadPool->GetThreadCount()))
+	{
+	}
+
+	PhysicsScheduler::~PhysicsScheduler()
+	{
+	}
+
+	int PhysicsScheduler::getMaxNumThreads() const
+	{
+		return static_cast<int>(m_threadPool->GetThreadCount());
+	}
+
+	int PhysicsScheduler::getNumThreads() const
+	{
+		return static_cast<int>(m_threadPool->GetThreadCount());
+	}
+
+	void PhysicsScheduler::setNumThreads(int numThreads)
+	{
+		m_numThreads = std::clamp(numThreads, 1, getMaxNumThreads());
+	}
+
+	void PhysicsScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body)
+	{
+		RunChunks(iBegin, iEnd, grainSize, [&](const int &worker, const int &begin, const int &end)
+		{
+			body.forLoop(begin, end);
+		});
+	}
+
+	btScalar PhysicsScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody &body)
+	{
+		std::vector<btScalar> sums = std::vector<btScalar>(m_numThreads, 0.0f);
+
+		RunChunks(iBegin, iEnd, grainSize, [&](const int &worker, const int &begin, const int &end)
+		{
+			sums[worker] += body.sumLoop(begin, end);
+		});
+
+		btScalar sum = 0.0f;
+
+		for (auto &workerSum : sums)
+		{
+			sum += workerSum;
+		}
+
+		return sum;
+	}
+
+	template<typename F>
+	void PhysicsScheduler::RunChunks(const int &iBegin, const int &iEnd, const int &grainSize, const F &function)
+	{
+		if (iEnd <= iBegin)
+		{
+			return;
+		}
+
+		int grain = std::max(grainSize, 1);
+		int chunks = (iEnd - iBegin + grain - 1) / grain;
+		int workers = std::min(m_numThreads, chunks);
+
+		if (workers <= 1)
+		{
+			function(0, iBegin, iEnd);
+			return;
+		}
+
+		// One job per active thread takes chunks until none are left, so no more than the active threads run at once and uneven chunks still balance.
+		std::atomic<int> nextChunk = 0;
+
+		auto handle = m_threadPool->ParallelFor(0, static_cast<uint32_t>(workers), [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t worker = begin; worker < end; worker++)
+			{
+				int chunk;
+
+				while ((chunk = nextChunk++) < chunks)
+				{
+					int chunkBegin = iBegin + (chunk * grain);
+					function(static_cast<int>(worker), chunkBegin, std::min(chunkBegin + grain, iEnd));
+				}
+			}
+		}, 1);
+		m_threadPool->Wait(handle);
+	}
+}
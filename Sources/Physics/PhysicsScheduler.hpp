@@ -0,0 +1,55 @@
+#pragma once
+
+#include <LinearMath/btThreads.h>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	class ThreadPool;
+
+	/// <summary>
+	/// A Bullet task scheduler that runs the parallel loops of a multithreaded physics world as jobs on a thread pool.
+	/// Bullet gives every thread that runs physics work an index, so the world must be stepped on the thread that created the pool,
+	/// then only threads of the pool are ever indexed.
+	/// </summary>
+	class ACID_EXPORT PhysicsScheduler :
+		public btITaskScheduler
+	{
+	private:
+		ThreadPool *m_threadPool;
+		int m_numThreads;
+	public:
+		/// <summary>
+		/// Creates a new physics scheduler.
+		/// </summary>
+		/// <param name="threadPool"> The thread pool the physics work is run on. </param>
+		PhysicsScheduler(ThreadPool *threadPool);
+
+		~PhysicsScheduler();
+
+		int getMaxNumThreads() const override;
+
+		/// <summary>
+		/// Gets the thread count Bullet sizes its per thread data by, this is always the thread pool size as any thread in the pool may run a task.
+		/// </summary>
+		/// <returns> The thread count. </returns>
+		int getNumThreads() const override;
+
+		/// <summary>
+		/// Sets how many threads run a parallel loop at once, one runs every loop on the calling thread.
+		/// </summary>
+		/// <param name="numThreads"> The thread count, clamped to the thread pool size. </param>
+		void setNumThreads(int numThreads) override;
+
+		void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body) override;
+
+		btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody &body) override;
+
+		int GetActiveThreads() const { return m_numThreads; }
+
+		ThreadPool *GetThreadPool() const { return m_threadPool; }
+	private:
+		template<typename F>
+		void RunChunks(const int &iBegin, const int &iEnd, const int &grainSize, const F &function);
+	};
+}
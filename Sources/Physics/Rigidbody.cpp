@@ -24,6 +24,12 @@ namespace acid
 	{
 		btRigidBody *body = btRigidBody::upcast(m_body);
 
+		// The game object is drawn at its transform again once the body no longer moves it.
+		if (body && body->getUserPointer() != nullptr)
+		{
+			static_cast<GameObject *>(body->getUserPointer())->SetRenderTransform({});
+		}
+
 		if (body && body->getMotionState())
 		{
 			delete body->getMotionState();
@@ -103,29 +109,9 @@ namespace acid
 			++it;
 		}
 
+		// Logic and the spatial structure see the body at the last physics step, only drawing is interpolated.
 		auto &transform = GetGameObject()->GetTransform();
-		btTransform worldTransform;
-		m_body->getMotionState()->getWorldTransform(worldTransform);
-
-		if (m_linearFactor != Vector3::ZERO)
-		{
-			btVector3 position = worldTransform.getOrigin();
-			transform.SetPosition(Collider::Convert(position));
-		}
-
-		if (m_angularFactor != Vector3::ZERO)
-		{
-			btQuaternion rotation = worldTransform.getRotation();
-		//	transform.SetRotation(Collider::Convert(rotation));
-			float yaw, pitch, roll;
-			rotation.getEulerZYX(yaw, pitch, roll);
-			transform.SetRotation(Vector3(pitch * RAD_TO_DEG, yaw * RAD_TO_DEG, roll * RAD_TO_DEG));
-		}
-
-		//m_worldTransform->setIdentity();
-		//m_worldTransform->setOrigin(Collider::Convert(transform.GetPosition()));
-		//m_worldTransform->setRotation(Collider::Convert(transform.GetRotation()));
-
+		WriteTransform(static_cast<MotionState *>(m_body->getMotionState())->GetCurrentTransform(), transform);
 		m_shape->setLocalScaling(Collider::Convert(transform.GetScaling()));
 		//m_body->getMotionState()->setWorldTransform(*m_worldTransform);
 		m_linearVelocity = Collider::Convert(m_body->getLinearVelocity());
@@ -149,6 +135,57 @@ namespace acid
 		m_angularFactor.Write(destination->GetChild("Angular Factor", true));
 	}
 
+	void Rigidbody::InterpolateTransform(const float &progression)
+	{
+		if (m_body == nullptr)
+		{
+			return;
+		}
+
+		Transform renderTransform = GetGameObject()->GetTransform();
+		WriteTransform(static_cast<MotionState *>(m_body->getMotionState())->Interpolate(progression), renderTransform);
+		GetGameObject()->SetRenderTransform(renderTransform);
+	}
+
+	void Rigidbody::SetTransform(const Transform &transform)
+	{
+		GetGameObject()->SetTransform(transform);
+		GetGameObject()->SetRenderTransform({});
+
+		// Bodies not created yet start from the game object transform.
+		if (m_body == nullptr)
+		{
+			return;
+		}
+
+		Quaternion rotation = transform.GetRotation();
+		m_worldTransform->setIdentity();
+		m_worldTransform->setOrigin(Collider::Convert(transform.GetPosition()));
+		m_worldTransform->setRotation(Collider::Convert(rotation));
+
+		m_body->setWorldTransform(*m_worldTransform);
+		m_body->setInterpolationWorldTransform(*m_worldTransform);
+		static_cast<MotionState *>(m_body->getMotionState())->SetTransform(*m_worldTransform);
+		m_body->activate(true);
+	}
+
+	void Rigidbody::WriteTransform(const btTransform &worldTransform, Transform &transform) const
+	{
+		if (m_linearFactor != Vector3::ZERO)
+		{
+			btVector3 position = worldTransform.getOrigin();
+			transform.SetPosition(Collider::Convert(position));
+		}
+
+		if (m_angularFactor != Vector3::ZERO)
+		{
+			btQuaternion rotation = worldTransform.getRotation();
+			float yaw, pitch, roll;
+			rotation.getEulerZYX(yaw, pitch, roll);
+			transform.SetRotation(Vector3(pitch * RAD_TO_DEG, yaw * RAD_TO_DEG, roll * RAD_TO_DEG));
+		}
+	}
+
 	void Rigidbody::SetGravity(const Vector3 &gravity)
 	{
 		m_body->setGravity(Collider::Convert(gravity));
@@ -227,9 +264,9 @@ namespace acid
 			shape->calculateLocalInertia(mass, localInertia);
 		}
 
-		// Using motionstate is recommended, it provides interpolation capabilities, and only synchronizes 'active' objects.
-		btDefaultMotionState *myMotionState = new btDefaultMotionState(startTransform);
-		btRigidBody::btRigidBodyConstructionInfo cInfo(mass, myMotionState, shape, localInertia);
+		// The motion state keeps the last two steps so the body can be interpolated, and only synchronizes 'active' objects.
+		auto motionState = new MotionState(startTransform);
+		btRigidBody::btRigidBodyConstructionInfo cInfo(mass, motionState, shape, localInertia);
 		btRigidBody *body = new btRigidBody(cInfo);
 		//	body->setContactProcessingThreshold(m_defaultContactProcessingThreshold);
 		//	body->setUserIndex(-1);
@@ -3,11 +3,11 @@
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
 #include <BulletDynamics/Dynamics/btRigidBody.h>
-#include <LinearMath/btDefaultMotionState.h>
 #include "Maths/Vector3.hpp"
 #include "Objects/GameObject.hpp"
 #include "Objects/IComponent.hpp"
 #include "Force.hpp"
+#include "MotionState.hpp"
 
 namespace acid
 {
@@ -42,6 +42,18 @@ namespace acid
 
 		void Write(LoadedValue *destination) override;
 
+		/// <summary>
+		/// Sets the render transform of the game object to the body between the last two physics steps, the game object transform keeps the last step.
+		/// </summary>
+		/// <param name="progression"> How far between the previous and current step, from 0 to 1. </param>
+		void InterpolateTransform(const float &progression);
+
+		/// <summary>
+		/// Moves the body and its game object, the body is drawn at the new transform instead of sliding there from the last step.
+		/// </summary>
+		/// <param name="transform"> The new transform. </param>
+		void SetTransform(const Transform &transform);
+
 		void SetGravity(const Vector3 &gravity);
 
 		std::shared_ptr<Force> AddForce(const std::shared_ptr<Force> &force);
@@ -75,6 +87,8 @@ namespace acid
 
 		void SetAngularVelocity(const Vector3 &angularVelocity);
 	private:
+		void WriteTransform(const btTransform &worldTransform, Transform &transform) const;
+
 		static btRigidBody *CreateRigidBody(float mass, const btTransform &startTransform, btCollisionShape *shape);
 	};
 }
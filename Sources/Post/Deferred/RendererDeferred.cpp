@@ -44,18 +44,11 @@ namespace acid
 		// Updates uniforms.
 		std::vector<DeferredLight> sceneLights = {};
 
-		auto lights = Scenes::Get()->GetStructure()->QueryComponents<Light>();
+		// Lights are culled by their radius, lights with a negative radius are unbounded and always included.
+		auto lights = Scenes::Get()->GetStructure()->QueryComponents<Light>(camera.GetViewFrustum());
 
 		for (auto &light : lights)
 		{
-			//	auto position = *light->GetPosition();
-			//	float radius = light->GetRadius();
-
-			//	if (radius >= 0.0f && !camera.GetViewFrustum()->SphereInFrustum(position, radius))
-			//	{
-			//		continue;
-			//	}
-
 			if (light->GetColour().LengthSquared() == 0.0f)
 			{
 				continue;
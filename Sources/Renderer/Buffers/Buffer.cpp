@@ -5,10 +5,10 @@
 
 namespace acid
 {
-	Buffer::Buffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage, const VkMemoryPropertyFlags &properties) :
+	Buffer::Buffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage, const VkMemoryPropertyFlags &properties, const MemoryUsage &memoryUsage) :
 		m_size(size),
 		m_buffer(VK_NULL_HANDLE),
-		m_bufferMemory(VK_NULL_HANDLE)
+		m_bufferMemory(MemoryAllocation())
 	{
 		if (m_size == 0)
 		{
@@ -36,54 +36,43 @@ namespace acid
 		VkMemoryRequirements memoryRequirements;
 		vkGetBufferMemoryRequirements(logicalDevice, m_buffer, &memoryRequirements);
 
-		VkMemoryAllocateInfo memoryAllocateInfo = {};
-		memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		memoryAllocateInfo.allocationSize = memoryRequirements.size;
-		memoryAllocateInfo.memoryTypeIndex = FindMemoryType(memoryRequirements.memoryTypeBits, properties);
+		m_bufferMemory = MemoryAllocator::Get()->Allocate(memoryRequirements, properties, MEMORY_RESOURCE_BUFFER, memoryUsage, this);
 
-		Display::CheckVk(vkAllocateMemory(logicalDevice, &memoryAllocateInfo, nullptr, &m_bufferMemory));
-
-		vkBindBufferMemory(logicalDevice, m_buffer, m_bufferMemory, 0);
+		Display::CheckVk(vkBindBufferMemory(logicalDevice, m_buffer, m_bufferMemory.GetMemory(), m_bufferMemory.GetOffset()));
 	}
 
 	Buffer::~Buffer()
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
-
-		vkDestroyBuffer(logicalDevice, m_buffer, nullptr);
-		vkFreeMemory(logicalDevice, m_bufferMemory, nullptr);
+		// A frame in flight may still read the buffer, such as a model replaced while its last frame renders.
+		Renderer::DeferDestroy([buffer = m_buffer, bufferMemory = m_bufferMemory]() mutable
+		{
+			vkDestroyBuffer(Display::Get()->GetLogicalDevice(), buffer, nullptr);
+			MemoryAllocator::Get()->Free(bufferMemory);
+		});
 	}
 
 	uint32_t Buffer::FindMemoryType(const uint32_t &typeFilter, const VkMemoryPropertyFlags &properties)
 	{
-		auto physicalDevice = Display::Get()->GetPhysicalDevice();
-
-		VkPhysicalDeviceMemoryProperties physicalDeviceMemoryProperties;
-		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &physicalDeviceMemoryProperties);
-
-		for (uint32_t i = 0; i < physicalDeviceMemoryProperties.memoryTypeCount; i++)
-		{
-			// If typefilter has a bit set to 1 and it contains the properties we indicated.
-			if ((typeFilter & (1 << i)) &&
-				(physicalDeviceMemoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
-			{
-				return i;
-			}
-		}
-
-		throw std::runtime_error("Failed to find a valid memory type for buffer!");
-		return 0;
+		return MemoryAllocator::Get()->FindMemoryType(typeFilter, properties);
 	}
 
 	void Buffer::CopyBuffer(const VkBuffer srcBuffer, const VkBuffer dstBuffer, const VkDeviceSize &size)
 	{
 		CommandBuffer commandBuffer = CommandBuffer();
 
-		VkBufferCopy copyRegion = {};
-		copyRegion.size = size;
-		vkCmdCopyBuffer(commandBuffer.GetCommandBuffer(), srcBuffer, dstBuffer, 1, &copyRegion);
+		CopyBuffer(commandBuffer, srcBuffer, dstBuffer, size);
 
 		commandBuffer.End();
 		commandBuffer.Submit();
 	}
+
+	void Buffer::CopyBuffer(const CommandBuffer &commandBuffer, const VkBuffer srcBuffer, const VkBuffer dstBuffer, const VkDeviceSize &size,
+		const VkDeviceSize &srcOffset, const VkDeviceSize &dstOffset)
+	{
+		VkBufferCopy copyRegion = {};
+		copyRegion.srcOffset = srcOffset;
+		copyRegion.dstOffset = dstOffset;
+		copyRegion.size = size;
+		vkCmdCopyBuffer(commandBuffer.GetCommandBuffer(), srcBuffer, dstBuffer, 1, &copyRegion);
+	}
 }
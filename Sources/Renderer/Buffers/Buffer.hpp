@@ -1,7 +1,9 @@
 ﻿#pragma once
 
+#include <memory>
 #include <vulkan/vulkan.h>
 #include "Renderer/Descriptors/DescriptorSet.hpp"
+#include "Renderer/Memory/MemoryAllocator.hpp"
 
 namespace acid
 {
@@ -10,9 +12,16 @@ namespace acid
 	protected:
 		VkDeviceSize m_size;
 		VkBuffer m_buffer;
-		VkDeviceMemory m_bufferMemory;
+		MemoryAllocation m_bufferMemory;
 	public:
-		Buffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage, const VkMemoryPropertyFlags &properties);
+		/// <summary>
+		/// Creates a new buffer, its memory is sub-allocated from the memory allocator.
+		/// </summary>
+		/// <param name="size"> The size of the buffer. </param>
+		/// <param name="usage"> The buffer usage flags. </param>
+		/// <param name="properties"> The required memory properties. </param>
+		/// <param name="memoryUsage"> How long the buffer is expected to live, staging buffers should be transient. </param>
+		Buffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage, const VkMemoryPropertyFlags &properties, const MemoryUsage &memoryUsage = MEMORY_USAGE_STATIC);
 
 		virtual ~Buffer();
 
@@ -20,10 +29,59 @@ namespace acid
 
 		VkBuffer GetBuffer() const { return m_buffer; }
 
-		VkDeviceMemory GetBufferMemory() const { return m_bufferMemory; }
+		VkDeviceMemory GetBufferMemory() const { return m_bufferMemory.GetMemory(); }
+
+		/// <summary>
+		/// Gets a pointer to the buffers memory, host visible memory stays mapped for the lifetime of the buffer.
+		/// </summary>
+		/// <returns> The mapped pointer, or nullptr if the buffer is not host visible. </returns>
+		void *GetMapped() const { return m_bufferMemory.GetMapped(); }
+
+		/// <summary>
+		/// Replaces a buffer that is smaller than a size, the capacity grows by powers of two from a minimum so the buffer is rarely recreated.
+		/// Used for buffers rewritten every frame, one per frame in flight, the replaced buffer is destroyed once its frame has finished.
+		/// </summary>
+		/// <param name="buffer"> The buffer, created if it is null. </param>
+		/// <param name="size"> The size the buffer must hold. </param>
+		/// <param name="minimum"> The smallest capacity, greater than zero. </param>
+		/// <param name="args"> The buffer constructor arguments after the size. </param>
+		/// <param name="T"> The buffer type. </param>
+		/// <returns> If the buffer was replaced. </returns>
+		template<typename T, typename... Args>
+		static bool Reserve(std::unique_ptr<T> &buffer, const VkDeviceSize &size, const VkDeviceSize &minimum, Args &&... args)
+		{
+			if (buffer != nullptr && buffer->GetSize() >= size)
+			{
+				return false;
+			}
+
+			VkDeviceSize capacity = minimum;
+
+			while (capacity < size)
+			{
+				capacity *= 2;
+			}
+
+			// The new buffer is created before the old is released, so descriptor handlers always see a different buffer.
+			auto grown = std::make_unique<T>(capacity, std::forward<Args>(args)...);
+			buffer = std::move(grown);
+			return true;
+		}
 
 		static uint32_t FindMemoryType(const uint32_t &typeFilter, const VkMemoryPropertyFlags &properties);
 
 		static void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkDeviceSize &size);
+
+		/// <summary>
+		/// Records a copy between two buffers.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="srcBuffer"> The buffer to copy from. </param>
+		/// <param name="dstBuffer"> The buffer to copy into. </param>
+		/// <param name="size"> The number of bytes to copy. </param>
+		/// <param name="srcOffset"> The offset to copy from in the source buffer. </param>
+		/// <param name="dstOffset"> The offset to copy into in the destination buffer. </param>
+		static void CopyBuffer(const CommandBuffer &commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer, const VkDeviceSize &size,
+			const VkDeviceSize &srcOffset = 0, const VkDeviceSize &dstOffset = 0);
 	};
 }
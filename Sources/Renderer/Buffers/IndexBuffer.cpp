@@ -1,21 +1,20 @@
 ﻿#include "IndexBuffer.hpp"
 
 #include "Display/Display.hpp"
+#include "Renderer/Memory/Uploader.hpp"
 
 namespace acid
 {
-	IndexBuffer::IndexBuffer(const VkIndexType &indexType, const uint64_t &elementSize, const size_t &indexCount, void *newData) :
-		Buffer(elementSize * indexCount, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT),
+	IndexBuffer::IndexBuffer(const VkIndexType &indexType, const uint64_t &elementSize, const size_t &indexCount, const void *newData) :
+		Buffer(elementSize * indexCount, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
 		m_indexType(indexType),
 		m_indexCount(static_cast<uint32_t>(indexCount))
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
-
-		// Copies the index data to the buffer.
-		void *data;
-		vkMapMemory(logicalDevice, m_bufferMemory, 0, m_size, 0, &data);
-		memcpy(data, newData, static_cast<size_t>(m_size));
-		vkUnmapMemory(logicalDevice, m_bufferMemory);
+		// Copies the index data into device local memory.
+		if (m_size != 0)
+		{
+			Uploader::Get()->UploadBuffer(*this, newData, m_size);
+		}
 	}
 
 	IndexBuffer::~IndexBuffer()
@@ -0,0 +1,33 @@
+#include "InstanceBuffer.hpp"
+
+#include "Display/Display.hpp"
+
+namespace acid
+{
+	InstanceBuffer::InstanceBuffer(const VkDeviceSize &size) :
+		Buffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+	{
+	}
+
+	InstanceBuffer::~InstanceBuffer()
+	{
+	}
+
+	void InstanceBuffer::Update(const void *newData, const VkDeviceSize &size)
+	{
+		if (size == 0)
+		{
+			return;
+		}
+
+		// Copies the data to the buffer.
+		memcpy(m_bufferMemory.GetMapped(), newData, static_cast<size_t>(size));
+	}
+
+	void InstanceBuffer::CmdBind(const CommandBuffer &commandBuffer, const uint32_t &binding, const VkDeviceSize &offset) const
+	{
+		VkBuffer instanceBuffers[] = {m_buffer};
+		VkDeviceSize offsets[] = {offset};
+		vkCmdBindVertexBuffers(commandBuffer.GetCommandBuffer(), binding, 1, instanceBuffers, offsets);
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Buffer.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Class that represents a host visible vertex buffer holding per instance attributes.
+	/// </summary>
+	class ACID_EXPORT InstanceBuffer :
+		public Buffer
+	{
+	public:
+		InstanceBuffer(const VkDeviceSize &size);
+
+		~InstanceBuffer();
+
+		/// <summary>
+		/// Copies data into the start of the buffer.
+		/// </summary>
+		/// <param name="newData"> The data to copy. </param>
+		/// <param name="size"> The number of bytes to copy, must not be larger than the buffer. </param>
+		void Update(const void *newData, const VkDeviceSize &size);
+
+		/// <summary>
+		/// Binds a range of this buffer as a vertex input binding.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="binding"> The vertex input binding. </param>
+		/// <param name="offset"> The byte offset of the first instance. </param>
+		void CmdBind(const CommandBuffer &commandBuffer, const uint32_t &binding, const VkDeviceSize &offset) const;
+	};
+}
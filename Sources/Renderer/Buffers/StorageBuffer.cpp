@@ -0,0 +1,61 @@
+#include "StorageBuffer.hpp"
+
+#include <cstring>
+
+namespace acid
+{
+	StorageBuffer::StorageBuffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage, const VkMemoryPropertyFlags &properties) :
+		Buffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | usage, properties),
+		IDescriptor(),
+		m_bufferInfo({})
+	{
+		m_bufferInfo.buffer = m_buffer;
+		m_bufferInfo.offset = 0;
+		m_bufferInfo.range = m_size;
+	}
+
+	StorageBuffer::~StorageBuffer()
+	{
+	}
+
+	void StorageBuffer::Update(const void *newData, const VkDeviceSize &size)
+	{
+		if (size == 0 || GetMapped() == nullptr)
+		{
+			return;
+		}
+
+		// Copies the data to the buffer.
+		memcpy(GetMapped(), newData, static_cast<size_t>(size));
+	}
+
+	DescriptorType StorageBuffer::CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage)
+	{
+		VkDescriptorSetLayoutBinding descriptorSetLayoutBinding = {};
+		descriptorSetLayoutBinding.binding = binding;
+		descriptorSetLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorSetLayoutBinding.descriptorCount = 1;
+		descriptorSetLayoutBinding.pImmutableSamplers = nullptr;
+		descriptorSetLayoutBinding.stageFlags = stage;
+
+		VkDescriptorPoolSize descriptorPoolSize = {};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorPoolSize.descriptorCount = 1;
+
+		return DescriptorType(binding, stage, descriptorSetLayoutBinding, descriptorPoolSize);
+	}
+
+	VkWriteDescriptorSet StorageBuffer::GetWriteDescriptor(const uint32_t &binding, const DescriptorSet &descriptorSet) const
+	{
+		VkWriteDescriptorSet descriptorWrite = {};
+		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrite.dstSet = descriptorSet.GetDescriptorSet();
+		descriptorWrite.dstBinding = binding;
+		descriptorWrite.dstArrayElement = 0;
+		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorWrite.descriptorCount = 1;
+		descriptorWrite.pBufferInfo = &m_bufferInfo;
+
+		return descriptorWrite;
+	}
+}
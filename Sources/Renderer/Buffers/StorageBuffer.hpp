@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Renderer/Descriptors/IDescriptor.hpp"
+#include "Renderer/Pipelines/ShaderProgram.hpp"
+#include "Buffer.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Class that represents a shader storage buffer, bound whole as a storage block that shaders can read and write.
+	/// </summary>
+	class ACID_EXPORT StorageBuffer :
+		public Buffer,
+		public IDescriptor
+	{
+	private:
+		VkDescriptorBufferInfo m_bufferInfo;
+	public:
+		/// <summary>
+		/// Creates a new storage buffer.
+		/// </summary>
+		/// <param name="size"> The size of the buffer. </param>
+		/// <param name="usage"> Usage flags added to the storage usage, such as vertex or indirect buffer usage. </param>
+		/// <param name="properties"> The required memory properties. </param>
+		StorageBuffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage = 0, const VkMemoryPropertyFlags &properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		~StorageBuffer();
+
+		/// <summary>
+		/// Copies data into the start of a host visible buffer.
+		/// </summary>
+		/// <param name="newData"> The data to copy. </param>
+		/// <param name="size"> The number of bytes to copy, must not be larger than the buffer. </param>
+		void Update(const void *newData, const VkDeviceSize &size);
+
+		static DescriptorType CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage);
+
+		VkWriteDescriptorSet GetWriteDescriptor(const uint32_t &binding, const DescriptorSet &descriptorSet) const override;
+	};
+}
@@ -1,15 +1,19 @@
 ﻿#include "UniformBuffer.hpp"
 
-#include "Display/Display.hpp"
+#include <stdexcept>
+#include "Renderer/Renderer.hpp"
 
 namespace acid
 {
 	UniformBuffer::UniformBuffer(const VkDeviceSize &size) :
-		Buffer(size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT),
 		IDescriptor(),
+		m_size(size),
+		m_offset(0),
+		m_frameId(0),
 		m_bufferInfo({})
 	{
-		m_bufferInfo.buffer = m_buffer;
+		// The descriptor always points at the start of the ring, the slice is selected by the dynamic offset.
+		m_bufferInfo.buffer = Renderer::Get()->GetUniformRing()->GetBuffer();
 		m_bufferInfo.offset = 0;
 		m_bufferInfo.range = m_size;
 	}
@@ -18,28 +22,37 @@ namespace acid
 	{
 	}
 
-	void UniformBuffer::Update(void *newData)
+	void UniformBuffer::Update(const void *newData)
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		auto uniformRing = Renderer::Get()->GetUniformRing();
 
-		// Copies the data to the buffer.
-		void *data;
-		vkMapMemory(logicalDevice, m_bufferMemory, 0, m_size, 0, &data);
-		memcpy(data, newData, static_cast<size_t>(m_size));
-		vkUnmapMemory(logicalDevice, m_bufferMemory);
+		if (!uniformRing->Write(newData, m_size, m_offset))
+		{
+			// The ring is sized for every uniform block written in the frames in flight, running out means UniformRing::SIZE is too small.
+			// The previous slice may already be overwritten by this frame, so drawing with it is never correct.
+			fprintf(stderr, "Uniform ring is full, %i bytes could not be written\n", static_cast<int32_t>(m_size));
+			throw std::runtime_error("Uniform ring is full, increase UniformRing::SIZE!");
+		}
+
+		m_frameId = uniformRing->GetFrameId();
+	}
+
+	bool UniformBuffer::IsCurrent() const
+	{
+		return m_frameId == Renderer::Get()->GetUniformRing()->GetFrameId();
 	}
 
 	DescriptorType UniformBuffer::CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage)
 	{
 		VkDescriptorSetLayoutBinding descriptorSetLayoutBinding = {};
 		descriptorSetLayoutBinding.binding = binding;
-		descriptorSetLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorSetLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 		descriptorSetLayoutBinding.descriptorCount = 1;
 		descriptorSetLayoutBinding.pImmutableSamplers = nullptr;
 		descriptorSetLayoutBinding.stageFlags = stage;
 
 		VkDescriptorPoolSize descriptorPoolSize = {};
-		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 		descriptorPoolSize.descriptorCount = 1;
 
 		return DescriptorType(binding, stage, descriptorSetLayoutBinding, descriptorPoolSize);
@@ -52,7 +65,7 @@ namespace acid
 		descriptorWrite.dstSet = descriptorSet.GetDescriptorSet();
 		descriptorWrite.dstBinding = binding;
 		descriptorWrite.dstArrayElement = 0;
-		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 		descriptorWrite.descriptorCount = 1;
 		descriptorWrite.pBufferInfo = &m_bufferInfo;
 
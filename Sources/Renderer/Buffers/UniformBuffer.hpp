@@ -3,22 +3,40 @@
 #include <vulkan/vulkan.h>
 #include "Renderer/Descriptors/IDescriptor.hpp"
 #include "Renderer/Pipelines/ShaderProgram.hpp"
-#include "Buffer.hpp"
 
 namespace acid
 {
+	/// <summary>
+	/// Class that represents the uniform block of a handler, the data lives in a slice of the <see cref="UniformRing"/> and is bound with a dynamic offset.
+	/// </summary>
 	class ACID_EXPORT UniformBuffer :
-		public Buffer,
 		public IDescriptor
 	{
 	private:
+		VkDeviceSize m_size;
+		VkDeviceSize m_offset;
+		uint64_t m_frameId;
 		VkDescriptorBufferInfo m_bufferInfo;
 	public:
 		UniformBuffer(const VkDeviceSize &size);
 
 		~UniformBuffer();
 
-		void Update(void *newData);
+		/// <summary>
+		/// Copies the data into a new slice of the uniform ring, draws recorded before this keep reading the previous slice.
+		/// </summary>
+		/// <param name="newData"> The data to copy, the size of this buffer. </param>
+		void Update(const void *newData);
+
+		/// <summary>
+		/// Gets if the data was written during the frame being recorded, slices from older frames may have been overwritten.
+		/// </summary>
+		/// <returns> If the slice is current. </returns>
+		bool IsCurrent() const;
+
+		VkDeviceSize GetSize() const { return m_size; }
+
+		uint32_t GetDynamicOffset() const { return static_cast<uint32_t>(m_offset); }
 
 		static DescriptorType CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage);
 
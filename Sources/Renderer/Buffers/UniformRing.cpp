@@ -0,0 +1,45 @@
+#include "UniformRing.hpp"
+
+#include "Display/Display.hpp"
+#include "Renderer/Renderer.hpp"
+
+namespace acid
+{
+	const VkDeviceSize UniformRing::SIZE = 8 * 1024 * 1024;
+
+	UniformRing::UniformRing() :
+		Buffer(SIZE, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+		m_ring(SIZE, Renderer::MAX_FRAMES_IN_FLIGHT),
+		m_alignment(Display::Get()->GetPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment),
+		m_frameId(0),
+		m_mutex()
+	{
+	}
+
+	UniformRing::~UniformRing()
+	{
+	}
+
+	void UniformRing::BeginFrame(const uint32_t &frame)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_ring.BeginFrame(frame);
+		m_frameId++;
+	}
+
+	bool UniformRing::Write(const void *data, const VkDeviceSize &size, VkDeviceSize &offset)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (!m_ring.Allocate(size, m_alignment, offset))
+			{
+				return false;
+			}
+		}
+
+		// Slices never overlap, so the copy does not need to hold the lock.
+		memcpy(static_cast<char *>(m_bufferMemory.GetMapped()) + offset, data, static_cast<size_t>(size));
+		return true;
+	}
+}
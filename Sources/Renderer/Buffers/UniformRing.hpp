@@ -0,0 +1,52 @@
+#pragma once
+
+#include <mutex>
+#include "Renderer/Memory/RingAllocator.hpp"
+#include "Buffer.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Class that represents a persistently mapped uniform buffer shared by every uniform handler. Uniform data is written into
+	/// slices that live for a single frame, and is read by shaders through dynamic offsets into this one buffer.
+	/// </summary>
+	class ACID_EXPORT UniformRing :
+		public Buffer
+	{
+	private:
+		RingAllocator m_ring;
+		VkDeviceSize m_alignment;
+		uint64_t m_frameId;
+		std::mutex m_mutex;
+	public:
+		/// <summary>
+		/// The size of the ring, shared between all frames in flight.
+		/// </summary>
+		static const VkDeviceSize SIZE;
+
+		UniformRing();
+
+		~UniformRing();
+
+		/// <summary>
+		/// Begins a frame, releasing the slices written the last time this frame slot was recorded.
+		/// </summary>
+		/// <param name="frame"> The frame slot, the GPU must have finished with it. </param>
+		void BeginFrame(const uint32_t &frame);
+
+		/// <summary>
+		/// Copies data into a new slice for the frame being recorded, this can be called from any thread.
+		/// </summary>
+		/// <param name="data"> The data to copy. </param>
+		/// <param name="size"> The size of the data. </param>
+		/// <param name="offset"> The offset of the slice, used as the dynamic offset when binding. </param>
+		/// <returns> If the data was written, false if the frames in flight fill the ring. </returns>
+		bool Write(const void *data, const VkDeviceSize &size, VkDeviceSize &offset);
+
+		/// <summary>
+		/// Gets a id that changes every frame, slices written with a older id may have been overwritten.
+		/// </summary>
+		/// <returns> The current frame id. </returns>
+		uint64_t GetFrameId() const { return m_frameId; }
+	};
+}
@@ -5,18 +5,18 @@
 
 namespace acid
 {
-	CommandBuffer::CommandBuffer(const bool &begin, const VkQueueFlagBits &queueType, const VkCommandBufferLevel &bufferLevel) :
+	CommandBuffer::CommandBuffer(const bool &begin, const VkQueueFlagBits &queueType, const VkCommandBufferLevel &bufferLevel, const VkCommandPool &commandPool) :
+		m_commandPool(commandPool != VK_NULL_HANDLE ? commandPool : Renderer::Get()->GetCommandPool()),
 		m_queueType(queueType),
 		m_bufferLevel(bufferLevel),
 		m_commandBuffer(VK_NULL_HANDLE),
 		m_running(false)
 	{
 		auto logicalDevice = Display::Get()->GetLogicalDevice();
-		auto commandPool = Renderer::Get()->GetCommandPool();
 
 		VkCommandBufferAllocateInfo commandBufferAllocateInfo = {};
 		commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-		commandBufferAllocateInfo.commandPool = commandPool;
+		commandBufferAllocateInfo.commandPool = m_commandPool;
 		commandBufferAllocateInfo.level = bufferLevel;
 		commandBufferAllocateInfo.commandBufferCount = 1;
 
@@ -31,9 +31,8 @@ namespace acid
 	CommandBuffer::~CommandBuffer()
 	{
 		auto logicalDevice = Display::Get()->GetLogicalDevice();
-		auto commandPool = Renderer::Get()->GetCommandPool();
 
-		vkFreeCommandBuffers(logicalDevice, commandPool, 1, &m_commandBuffer);
+		vkFreeCommandBuffers(logicalDevice, m_commandPool, 1, &m_commandBuffer);
 	}
 
 	void CommandBuffer::Begin(const VkCommandBufferUsageFlags &usage)
@@ -46,6 +45,23 @@ namespace acid
 		m_running = true;
 	}
 
+	void CommandBuffer::BeginSecondary(const VkRenderPass &renderPass, const uint32_t &subpass, const VkFramebuffer &framebuffer)
+	{
+		VkCommandBufferInheritanceInfo inheritanceInfo = {};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.renderPass = renderPass;
+		inheritanceInfo.subpass = subpass;
+		inheritanceInfo.framebuffer = framebuffer;
+
+		VkCommandBufferBeginInfo beginInfo = {};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		Display::CheckVk(vkBeginCommandBuffer(m_commandBuffer, &beginInfo));
+		m_running = true;
+	}
+
 	void CommandBuffer::End()
 	{
 		Display::CheckVk(vkEndCommandBuffer(m_commandBuffer));
@@ -89,6 +105,33 @@ namespace acid
 		}
 	}
 
+	void CommandBuffer::Submit(const VkSemaphore &waitSemaphore, const VkSemaphore &signalSemaphore, const VkFence &fence)
+	{
+		auto queueSelected = GetQueue();
+
+		VkSubmitInfo submitInfo = {};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &m_commandBuffer;
+
+		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+		if (waitSemaphore != VK_NULL_HANDLE)
+		{
+			submitInfo.waitSemaphoreCount = 1;
+			submitInfo.pWaitSemaphores = &waitSemaphore;
+			submitInfo.pWaitDstStageMask = &waitStage;
+		}
+
+		if (signalSemaphore != VK_NULL_HANDLE)
+		{
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &signalSemaphore;
+		}
+
+		Display::CheckVk(vkQueueSubmit(queueSelected, 1, &submitInfo, fence));
+	}
+
 	VkQueue CommandBuffer::GetQueue() const
 	{
 		switch (m_queueType)
@@ -8,21 +8,27 @@ namespace acid
 	class ACID_EXPORT CommandBuffer
 	{
 	private:
+		VkCommandPool m_commandPool;
 		VkQueueFlagBits m_queueType;
 		VkCommandBufferLevel m_bufferLevel;
 		VkCommandBuffer m_commandBuffer;
 		bool m_running;
 	public:
-		CommandBuffer(const bool &begin = true, const VkQueueFlagBits &queueType = VK_QUEUE_GRAPHICS_BIT, const VkCommandBufferLevel &bufferLevel = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+		CommandBuffer(const bool &begin = true, const VkQueueFlagBits &queueType = VK_QUEUE_GRAPHICS_BIT, const VkCommandBufferLevel &bufferLevel = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+			const VkCommandPool &commandPool = VK_NULL_HANDLE);
 
 		~CommandBuffer();
 
 		void Begin(const VkCommandBufferUsageFlags &usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 
+		void BeginSecondary(const VkRenderPass &renderPass, const uint32_t &subpass, const VkFramebuffer &framebuffer);
+
 		void End();
 
 		void Submit(const bool &waitFence = true, const VkSemaphore &semaphore = VK_NULL_HANDLE);
 
+		void Submit(const VkSemaphore &waitSemaphore, const VkSemaphore &signalSemaphore, const VkFence &fence);
+
 		bool IsRunning() const { return m_running; }
 
 		VkCommandBuffer GetCommandBuffer() const { return m_commandBuffer; }
@@ -0,0 +1,51 @@
+#include "CommandPool.hpp"
+
+#include "Display/Display.hpp"
+
+namespace acid
+{
+	CommandPool::CommandPool() :
+		m_commandPool(VK_NULL_HANDLE),
+		m_secondaries(std::vector<CommandBuffer *>()),
+		m_secondariesUsed(0)
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+		commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		commandPoolCreateInfo.queueFamilyIndex = Display::Get()->GetGraphicsFamily();
+		commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+		Display::CheckVk(vkCreateCommandPool(logicalDevice, &commandPoolCreateInfo, nullptr, &m_commandPool));
+	}
+
+	CommandPool::~CommandPool()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		for (auto &secondary : m_secondaries)
+		{
+			delete secondary;
+		}
+
+		vkDestroyCommandPool(logicalDevice, m_commandPool, nullptr);
+	}
+
+	void CommandPool::Reset()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		Display::CheckVk(vkResetCommandPool(logicalDevice, m_commandPool, 0));
+		m_secondariesUsed = 0;
+	}
+
+	CommandBuffer *CommandPool::GetSecondary()
+	{
+		if (m_secondariesUsed == m_secondaries.size())
+		{
+			m_secondaries.emplace_back(new CommandBuffer(false, VK_QUEUE_GRAPHICS_BIT, VK_COMMAND_BUFFER_LEVEL_SECONDARY, m_commandPool));
+		}
+
+		return m_secondaries[m_secondariesUsed++];
+	}
+}
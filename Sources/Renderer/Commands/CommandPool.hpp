@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.h>
+#include "CommandBuffer.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A command pool owned by a single thread for a single frame in flight, secondary command buffers are recycled after every reset.
+	/// </summary>
+	class ACID_EXPORT CommandPool
+	{
+	private:
+		VkCommandPool m_commandPool;
+		std::vector<CommandBuffer *> m_secondaries;
+		uint32_t m_secondariesUsed;
+	public:
+		CommandPool();
+
+		~CommandPool();
+
+		/// <summary>
+		/// Resets the pool and every command buffer allocated from it, the frame using this pool must have finished on the GPU.
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// Gets a unused secondary command buffer from this pool, allocating a new one if all are in use.
+		/// </summary>
+		/// <returns> The secondary command buffer. </returns>
+		CommandBuffer *GetSecondary();
+
+		VkCommandPool GetCommandPool() const { return m_commandPool; }
+	};
+}
@@ -1,6 +1,7 @@
 #include "DescriptorSet.hpp"
 
 #include "Display/Display.hpp"
+#include "Renderer/Renderer.hpp"
 #include "IDescriptor.hpp"
 
 namespace acid
@@ -28,10 +29,12 @@ namespace acid
 
 	DescriptorSet::~DescriptorSet()
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
-
-		VkDescriptorSet descriptors[1] = {m_descriptorSet};
-		vkFreeDescriptorSets(logicalDevice, m_descriptorPool, 1, descriptors);
+		// Handlers recreate their sets when the pipeline changes, while the old sets may still be bound by a frame in flight.
+		Renderer::DeferDestroy([descriptorPool = m_descriptorPool, descriptorSet = m_descriptorSet]()
+		{
+			VkDescriptorSet descriptors[1] = {descriptorSet};
+			vkFreeDescriptorSets(Display::Get()->GetLogicalDevice(), descriptorPool, 1, descriptors);
+		});
 	}
 
 	void DescriptorSet::Update(const std::vector<IDescriptor *> &descriptors)
@@ -51,9 +54,10 @@ namespace acid
 		vkUpdateDescriptorSets(logicalDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
 	}
 
-	void DescriptorSet::BindDescriptor(const CommandBuffer &commandBuffer)
+	void DescriptorSet::BindDescriptor(const CommandBuffer &commandBuffer, const std::vector<uint32_t> &dynamicOffsets)
 	{
 		VkDescriptorSet descriptors[1] = {m_descriptorSet};
-		vkCmdBindDescriptorSets(commandBuffer.GetCommandBuffer(), m_pipelineBindPoint, m_pipelineLayout, 0, 1, descriptors, 0, nullptr);
+		vkCmdBindDescriptorSets(commandBuffer.GetCommandBuffer(), m_pipelineBindPoint, m_pipelineLayout, 0, 1, descriptors,
+			static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 	}
 }
@@ -27,7 +27,12 @@ namespace acid
 
 		void Update(const std::vector<IDescriptor *> &descriptors);
 
-		void BindDescriptor(const CommandBuffer &commandBuffer);
+		/// <summary>
+		/// Binds this descriptor set.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="dynamicOffsets"> The offsets of the dynamic uniform buffers, in binding order. </param>
+		void BindDescriptor(const CommandBuffer &commandBuffer, const std::vector<uint32_t> &dynamicOffsets = {});
 
 		VkDescriptorSet GetDescriptorSet() const { return m_descriptorSet; }
 	};
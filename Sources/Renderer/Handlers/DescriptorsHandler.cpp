@@ -1,26 +1,33 @@
 #include "DescriptorsHandler.hpp"
 
+#include <algorithm>
+#include "Renderer/Renderer.hpp"
+
 namespace acid
 {
 	DescriptorsHandler::DescriptorsHandler() :
 		m_shaderProgram(nullptr),
-		m_descriptorSet(nullptr),
-		m_descriptors(std::vector<IDescriptor *>()),
-		m_changed(false)
+		m_descriptorSets(std::vector<DescriptorSet *>()),
+		m_descriptors(std::vector<std::vector<IDescriptor *>>()),
+		m_changed(std::vector<bool>()),
+		m_dynamicOffsets(std::vector<uint32_t>())
 	{
 	}
 
 	DescriptorsHandler::DescriptorsHandler(const IPipeline &pipeline) :
 		m_shaderProgram(pipeline.GetShaderProgram()),
-		m_descriptorSet(new DescriptorSet(pipeline)),
-		m_descriptors(std::vector<IDescriptor *>(m_shaderProgram->GetLastDescriptorBinding() + 1)),
-		m_changed(true)
+		m_descriptorSets(std::vector<DescriptorSet *>()),
+		m_descriptors(std::vector<std::vector<IDescriptor *>>()),
+		m_changed(std::vector<bool>()),
+		m_dynamicOffsets(std::vector<uint32_t>())
 	{
+		CreateDescriptorSets(pipeline);
+		std::fill(m_changed.begin(), m_changed.end(), true);
 	}
 
 	DescriptorsHandler::~DescriptorsHandler()
 	{
-		delete m_descriptorSet;
+		DestroyDescriptorSets();
 	}
 
 	void DescriptorsHandler::Push(const std::string &descriptorName, IDescriptor *descriptor)
@@ -44,10 +51,17 @@ namespace acid
 			return;
 		}
 
-		if (m_descriptors.at(location) != descriptor)
+		if (m_descriptors.empty())
+		{
+			return;
+		}
+
+		uint32_t frame = Renderer::Get()->GetCurrentFrame();
+
+		if (m_descriptors[frame].at(location) != descriptor)
 		{
-			m_descriptors.at(location) = descriptor;
-			m_changed = true;
+			m_descriptors[frame].at(location) = descriptor;
+			m_changed[frame] = true;
 		}
 	}
 
@@ -58,30 +72,79 @@ namespace acid
 			return;
 		}
 
-		uniformHandler->Update(m_shaderProgram->GetUniformBlock(descriptorName));
+		auto uniformBlock = m_shaderProgram->GetUniformBlock(descriptorName);
+		uniformHandler->Update(uniformBlock);
 		Push(descriptorName, uniformHandler->GetUniformBuffer());
+
+		// The descriptor points at the uniform ring, the slice written this frame is selected when binding.
+		auto &uniformBlocks = m_shaderProgram->GetUniformBlocks();
+		auto index = static_cast<size_t>(std::find(uniformBlocks.begin(), uniformBlocks.end(), uniformBlock) - uniformBlocks.begin());
+
+		if (uniformHandler->GetUniformBuffer() != nullptr && index < m_dynamicOffsets.size())
+		{
+			m_dynamicOffsets[index] = uniformHandler->GetUniformBuffer()->GetDynamicOffset();
+		}
 	}
 
 	bool DescriptorsHandler::Update(const IPipeline &pipeline)
 	{
 		if (m_shaderProgram != pipeline.GetShaderProgram())
 		{
-			m_descriptors.clear();
-			delete m_descriptorSet;
+			DestroyDescriptorSets();
 
 			m_shaderProgram = pipeline.GetShaderProgram();
-			m_descriptors.resize(m_shaderProgram->GetLastDescriptorBinding() + 1);
-			m_descriptorSet = new DescriptorSet(pipeline);
-			m_changed = false;
+			CreateDescriptorSets(pipeline);
 			return false;
 		}
 
-		if (m_changed)
+		uint32_t frame = Renderer::Get()->GetCurrentFrame();
+
+		if (m_changed[frame])
 		{
-			m_descriptorSet->Update(m_descriptors);
-			m_changed = false;
+			m_descriptorSets[frame]->Update(m_descriptors[frame]);
+			m_changed[frame] = false;
 		}
 
 		return true;
 	}
+
+	void DescriptorsHandler::BindDescriptor(const CommandBuffer &commandBuffer)
+	{
+		m_descriptorSets[Renderer::Get()->GetCurrentFrame()]->BindDescriptor(commandBuffer, m_dynamicOffsets);
+	}
+
+	DescriptorSet *DescriptorsHandler::GetDescriptorSet() const
+	{
+		if (m_descriptorSets.empty())
+		{
+			return nullptr;
+		}
+
+		return m_descriptorSets[Renderer::Get()->GetCurrentFrame()];
+	}
+
+	void DescriptorsHandler::CreateDescriptorSets(const IPipeline &pipeline)
+	{
+		for (uint32_t i = 0; i < Renderer::MAX_FRAMES_IN_FLIGHT; i++)
+		{
+			m_descriptorSets.emplace_back(new DescriptorSet(pipeline));
+			m_descriptors.emplace_back(std::vector<IDescriptor *>(m_shaderProgram->GetLastDescriptorBinding() + 1));
+		}
+
+		m_changed = std::vector<bool>(Renderer::MAX_FRAMES_IN_FLIGHT, false);
+		m_dynamicOffsets = std::vector<uint32_t>(m_shaderProgram->GetUniformBlocks().size(), 0);
+	}
+
+	void DescriptorsHandler::DestroyDescriptorSets()
+	{
+		for (auto &descriptorSet : m_descriptorSets)
+		{
+			delete descriptorSet;
+		}
+
+		m_descriptorSets.clear();
+		m_descriptors.clear();
+		m_changed.clear();
+		m_dynamicOffsets.clear();
+	}
 }
@@ -8,15 +8,16 @@
 namespace acid
 {
 	/// <summary>
-	/// Class that handles a descriptor set.
+	/// Class that handles a descriptor set, with one set per frame in flight so sets used by a pending frame are never rewritten.
 	/// </summary>
 	class ACID_EXPORT DescriptorsHandler
 	{
 	private:
 		std::shared_ptr<ShaderProgram> m_shaderProgram;
-		DescriptorSet *m_descriptorSet;
-		std::vector<IDescriptor *> m_descriptors;
-		bool m_changed;
+		std::vector<DescriptorSet *> m_descriptorSets;
+		std::vector<std::vector<IDescriptor *>> m_descriptors;
+		std::vector<bool> m_changed;
+		std::vector<uint32_t> m_dynamicOffsets;
 	public:
 		DescriptorsHandler();
 
@@ -38,8 +39,12 @@ namespace acid
 
 		bool Update(const IPipeline &pipeline);
 
-		void BindDescriptor(const CommandBuffer &commandBuffer) { m_descriptorSet->BindDescriptor(commandBuffer); }
+		void BindDescriptor(const CommandBuffer &commandBuffer);
 
-		DescriptorSet *GetDescriptorSet() const { return m_descriptorSet; }
+		DescriptorSet *GetDescriptorSet() const;
+	private:
+		void CreateDescriptorSets(const IPipeline &pipeline);
+
+		void DestroyDescriptorSets();
 	};
 }
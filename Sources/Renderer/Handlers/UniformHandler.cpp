@@ -40,7 +40,8 @@ namespace acid
 			return false;
 		}
 
-		if (m_changed)
+		// Slices only live for one frame, and a block changed since its last write gets a new slice so draws recorded before keep their values.
+		if (m_changed || !m_uniformBuffer->IsCurrent())
 		{
 			m_uniformBuffer->Update(m_data);
 			m_changed = false;
@@ -1,12 +1,13 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include "Renderer/Buffers/UniformBuffer.hpp"
 
 namespace acid
 {
 	/// <summary>
-	/// Class that handles a uniform buffer.
+	/// Class that handles a uniform block, the block is written into the uniform ring once per frame or whenever it changes, so a frame being recorded never writes memory the GPU is still reading.
 	/// </summary>
 	class ACID_EXPORT UniformHandler
 	{
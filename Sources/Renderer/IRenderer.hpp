@@ -41,6 +41,14 @@ namespace acid
 		/// <param name="camera"> The camera to be used when rendering. </param>
 		virtual void Render(const CommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera) = 0;
 
+		/// <summary>
+		/// Called before the first render pass of a frame begins, used to record compute work that is read while rendering.
+		/// </summary>
+		/// <param name="commandBuffer"> The primary command buffer of the frame. </param>
+		virtual void Dispatch(const CommandBuffer &commandBuffer)
+		{
+		}
+
 		GraphicsStage GetGraphicsStage() const { return m_graphicsStage; }
 
 		bool IsEnabled() const { return m_enabled; };
@@ -0,0 +1,117 @@
+#include "BuddyAllocator.hpp"
+
+#include <algorithm>
+
+namespace acid
+{
+	BuddyAllocator::BuddyAllocator(const VkDeviceSize &size, const VkDeviceSize &minSize) :
+		m_size(size),
+		m_minSize(minSize),
+		m_levels(1),
+		m_freeLists(std::vector<std::set<VkDeviceSize>>()),
+		m_allocated(std::unordered_map<VkDeviceSize, uint32_t>()),
+		m_used(0)
+	{
+		while (GetLevelSize(m_levels) >= m_minSize)
+		{
+			m_levels++;
+		}
+
+		m_freeLists.resize(m_levels);
+		m_freeLists[0].emplace(0);
+	}
+
+	BuddyAllocator::~BuddyAllocator()
+	{
+	}
+
+	bool BuddyAllocator::Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment, VkDeviceSize &offset)
+	{
+		VkDeviceSize required = std::max(std::max(size, alignment), m_minSize);
+
+		if (required > m_size)
+		{
+			return false;
+		}
+
+		// Finds the smallest level that fits the allocation.
+		uint32_t level = m_levels - 1;
+
+		while (GetLevelSize(level) < required)
+		{
+			level--;
+		}
+
+		// Finds the nearest larger free range and splits it down to the required level.
+		int32_t found = static_cast<int32_t>(level);
+
+		while (found >= 0 && m_freeLists[found].empty())
+		{
+			found--;
+		}
+
+		if (found < 0)
+		{
+			return false;
+		}
+
+		VkDeviceSize rangeOffset = *m_freeLists[found].begin();
+		m_freeLists[found].erase(m_freeLists[found].begin());
+
+		for (auto i = static_cast<uint32_t>(found); i < level; i++)
+		{
+			m_freeLists[i + 1].emplace(rangeOffset + GetLevelSize(i + 1));
+		}
+
+		m_allocated.emplace(rangeOffset, level);
+		m_used += GetLevelSize(level);
+		offset = rangeOffset;
+		return true;
+	}
+
+	void BuddyAllocator::Free(const VkDeviceSize &offset)
+	{
+		auto it = m_allocated.find(offset);
+
+		if (it == m_allocated.end())
+		{
+			return;
+		}
+
+		uint32_t level = it->second;
+		VkDeviceSize rangeOffset = offset;
+		m_allocated.erase(it);
+		m_used -= GetLevelSize(level);
+
+		// Merges with the buddy range for as long as it is free.
+		while (level > 0)
+		{
+			VkDeviceSize buddy = rangeOffset ^ GetLevelSize(level);
+			auto buddyIt = m_freeLists[level].find(buddy);
+
+			if (buddyIt == m_freeLists[level].end())
+			{
+				break;
+			}
+
+			m_freeLists[level].erase(buddyIt);
+			rangeOffset = std::min(rangeOffset, buddy);
+			level--;
+		}
+
+		m_freeLists[level].emplace(rangeOffset);
+	}
+
+	VkDeviceSize BuddyAllocator::GetLargestFree() const
+	{
+		for (uint32_t i = 0; i < m_levels; i++)
+		{
+			if (!m_freeLists[i].empty())
+			{
+				return GetLevelSize(i);
+			}
+		}
+
+		return 0;
+	}
+}
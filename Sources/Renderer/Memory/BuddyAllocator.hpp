@@ -0,0 +1,67 @@
+#pragma once
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A buddy allocator over a power of two range, used to place long lived resources inside a memory block.
+	/// Allocations are rounded up to a power of two, so every offset is aligned to the size of its allocation.
+	/// </summary>
+	class ACID_EXPORT BuddyAllocator
+	{
+	private:
+		VkDeviceSize m_size;
+		VkDeviceSize m_minSize;
+		uint32_t m_levels;
+		std::vector<std::set<VkDeviceSize>> m_freeLists;
+		std::unordered_map<VkDeviceSize, uint32_t> m_allocated;
+		VkDeviceSize m_used;
+	public:
+		/// <summary>
+		/// Creates a new buddy allocator.
+		/// </summary>
+		/// <param name="size"> The size of the range, must be a power of two. </param>
+		/// <param name="minSize"> The smallest allocation size, must be a power of two. </param>
+		BuddyAllocator(const VkDeviceSize &size, const VkDeviceSize &minSize);
+
+		~BuddyAllocator();
+
+		/// <summary>
+		/// Allocates a range.
+		/// </summary>
+		/// <param name="size"> The size to allocate. </param>
+		/// <param name="alignment"> The required alignment of the offset. </param>
+		/// <param name="offset"> The offset of the allocated range. </param>
+		/// <returns> If a range was allocated. </returns>
+		bool Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment, VkDeviceSize &offset);
+
+		/// <summary>
+		/// Frees a range, merging it with its buddy while both are free.
+		/// </summary>
+		/// <param name="offset"> The offset returned by <see cref="Allocate"/>. </param>
+		void Free(const VkDeviceSize &offset);
+
+		VkDeviceSize GetSize() const { return m_size; }
+
+		/// <summary>
+		/// Gets the number of bytes in use, including the rounding of each allocation.
+		/// </summary>
+		/// <returns> The used bytes. </returns>
+		VkDeviceSize GetUsed() const { return m_used; }
+
+		uint32_t GetAllocationCount() const { return static_cast<uint32_t>(m_allocated.size()); }
+
+		/// <summary>
+		/// Gets the size of the largest range that can currently be allocated.
+		/// </summary>
+		/// <returns> The largest free range. </returns>
+		VkDeviceSize GetLargestFree() const;
+	private:
+		VkDeviceSize GetLevelSize(const uint32_t &level) const { return m_size >> level; }
+	};
+}
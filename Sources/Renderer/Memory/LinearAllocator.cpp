@@ -0,0 +1,28 @@
+#include "LinearAllocator.hpp"
+
+namespace acid
+{
+	LinearAllocator::LinearAllocator(const VkDeviceSize &size) :
+		m_size(size),
+		m_offset(0)
+	{
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+	}
+
+	bool LinearAllocator::Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment, VkDeviceSize &offset)
+	{
+		VkDeviceSize aligned = (m_offset + alignment - 1) & ~(alignment - 1);
+
+		if (aligned + size > m_size)
+		{
+			return false;
+		}
+
+		offset = aligned;
+		m_offset = aligned + size;
+		return true;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A bump allocator, ranges are only released all at once with <see cref="Reset"/>. Used for transient data such as staging memory.
+	/// </summary>
+	class ACID_EXPORT LinearAllocator
+	{
+	private:
+		VkDeviceSize m_size;
+		VkDeviceSize m_offset;
+	public:
+		LinearAllocator(const VkDeviceSize &size);
+
+		~LinearAllocator();
+
+		/// <summary>
+		/// Allocates a range after the previous allocation.
+		/// </summary>
+		/// <param name="size"> The size to allocate. </param>
+		/// <param name="alignment"> The required alignment of the offset, must be a power of two. </param>
+		/// <param name="offset"> The offset of the allocated range. </param>
+		/// <returns> If a range was allocated. </returns>
+		bool Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment, VkDeviceSize &offset);
+
+		/// <summary>
+		/// Releases every allocation.
+		/// </summary>
+		void Reset() { m_offset = 0; }
+
+		VkDeviceSize GetSize() const { return m_size; }
+
+		VkDeviceSize GetUsed() const { return m_offset; }
+	};
+}
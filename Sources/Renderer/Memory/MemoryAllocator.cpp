@@ -0,0 +1,390 @@
+#include "MemoryAllocator.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include "Display/Display.hpp"
+#include "BuddyAllocator.hpp"
+#include "LinearAllocator.hpp"
+
+namespace acid
+{
+	const VkDeviceSize MemoryAllocator::BLOCK_SIZE = 64 * 1024 * 1024;
+	const VkDeviceSize MemoryAllocator::TRANSIENT_BLOCK_SIZE = 16 * 1024 * 1024;
+	const VkDeviceSize MemoryAllocator::MIN_ALLOCATION = 256;
+
+	/// <summary>
+	/// A single device memory allocation that is split between resources.
+	/// </summary>
+	class MemoryBlock
+	{
+	public:
+		uint32_t m_pool;
+		uint32_t m_memoryType;
+		VkDeviceMemory m_memory;
+		VkDeviceSize m_size;
+		void *m_mapped;
+		std::unique_ptr<BuddyAllocator> m_buddy;
+		std::unique_ptr<LinearAllocator> m_linear;
+		std::unordered_map<VkDeviceSize, MemoryAllocation> m_allocations;
+		bool m_draining;
+
+		MemoryBlock(const uint32_t &pool, const uint32_t &memoryType, const VkDeviceSize &size, const MemoryUsage &usage) :
+			m_pool(pool),
+			m_memoryType(memoryType),
+			m_memory(VK_NULL_HANDLE),
+			m_size(size),
+			m_mapped(nullptr),
+			m_buddy(usage == MEMORY_USAGE_STATIC ? std::make_unique<BuddyAllocator>(size, MemoryAllocator::MIN_ALLOCATION) : nullptr),
+			m_linear(usage == MEMORY_USAGE_TRANSIENT ? std::make_unique<LinearAllocator>(size) : nullptr),
+			m_allocations(std::unordered_map<VkDeviceSize, MemoryAllocation>()),
+			m_draining(false)
+		{
+		}
+
+		bool Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment, VkDeviceSize &offset)
+		{
+			if (m_draining)
+			{
+				return false;
+			}
+
+			if (m_buddy != nullptr)
+			{
+				return m_buddy->Allocate(size, alignment, offset);
+			}
+
+			return m_linear->Allocate(size, alignment, offset);
+		}
+
+		void Free(const VkDeviceSize &offset)
+		{
+			m_allocations.erase(offset);
+
+			if (m_buddy != nullptr)
+			{
+				m_buddy->Free(offset);
+			}
+			else if (m_allocations.empty())
+			{
+				m_linear->Reset();
+			}
+		}
+
+		VkDeviceSize GetUsed() const { return m_buddy != nullptr ? m_buddy->GetUsed() : m_linear->GetUsed(); }
+	};
+
+	MemoryAllocator::MemoryAllocator() :
+		IModule(),
+		m_memoryProperties(Display::Get()->GetPhysicalDeviceMemoryProperties()),
+		m_pools(std::vector<std::vector<std::unique_ptr<MemoryBlock>>>()),
+		m_dedicatedCounts(std::vector<uint32_t>(VK_MAX_MEMORY_HEAPS, 0)),
+		m_dedicatedBytes(std::vector<VkDeviceSize>(VK_MAX_MEMORY_HEAPS, 0)),
+		m_mutex()
+	{
+		// One pool for every memory type, for buffers, linear and optimal images, with static and transient usage.
+		m_pools.resize(m_memoryProperties.memoryTypeCount * 6);
+	}
+
+	MemoryAllocator::~MemoryAllocator()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		for (auto &pool : m_pools)
+		{
+			for (auto &block : pool)
+			{
+				vkFreeMemory(logicalDevice, block->m_memory, nullptr);
+			}
+		}
+	}
+
+	void MemoryAllocator::Update()
+	{
+	}
+
+	MemoryAllocation MemoryAllocator::Allocate(const VkMemoryRequirements &requirements, const VkMemoryPropertyFlags &properties, const MemoryResource &resource,
+		const MemoryUsage &usage, void *userData)
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		uint32_t memoryType = FindMemoryType(requirements.memoryTypeBits, properties);
+		bool hostVisible = (m_memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+		VkDeviceSize blockSize = GetBlockSize(memoryType, usage);
+
+		MemoryAllocation result = MemoryAllocation();
+		result.m_memoryType = memoryType;
+		result.m_size = requirements.size;
+		result.m_userData = userData;
+
+		// Large resources would waste most of a block, they get their own memory.
+		if (requirements.size > blockSize / 2)
+		{
+			VkMemoryAllocateInfo memoryAllocateInfo = {};
+			memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			memoryAllocateInfo.allocationSize = requirements.size;
+			memoryAllocateInfo.memoryTypeIndex = memoryType;
+
+			Display::CheckVk(vkAllocateMemory(logicalDevice, &memoryAllocateInfo, nullptr, &result.m_memory));
+
+			if (hostVisible)
+			{
+				Display::CheckVk(vkMapMemory(logicalDevice, result.m_memory, 0, VK_WHOLE_SIZE, 0, &result.m_mapped));
+			}
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			uint32_t heap = m_memoryProperties.memoryTypes[memoryType].heapIndex;
+			m_dedicatedCounts[heap]++;
+			m_dedicatedBytes[heap] += requirements.size;
+			return result;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		uint32_t poolIndex = GetPoolIndex(memoryType, resource, usage);
+		auto &pool = m_pools[poolIndex];
+		MemoryBlock *block = nullptr;
+		VkDeviceSize offset = 0;
+
+		for (auto &poolBlock : pool)
+		{
+			if (poolBlock->Allocate(requirements.size, requirements.alignment, offset))
+			{
+				block = poolBlock.get();
+				break;
+			}
+		}
+
+		if (block == nullptr)
+		{
+			auto newBlock = std::make_unique<MemoryBlock>(poolIndex, memoryType, blockSize, usage);
+
+			VkMemoryAllocateInfo memoryAllocateInfo = {};
+			memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			memoryAllocateInfo.allocationSize = blockSize;
+			memoryAllocateInfo.memoryTypeIndex = memoryType;
+
+			Display::CheckVk(vkAllocateMemory(logicalDevice, &memoryAllocateInfo, nullptr, &newBlock->m_memory));
+
+			if (hostVisible)
+			{
+				Display::CheckVk(vkMapMemory(logicalDevice, newBlock->m_memory, 0, VK_WHOLE_SIZE, 0, &newBlock->m_mapped));
+			}
+
+			newBlock->Allocate(requirements.size, requirements.alignment, offset);
+			block = newBlock.get();
+			pool.emplace_back(std::move(newBlock));
+		}
+
+		result.m_memory = block->m_memory;
+		result.m_offset = offset;
+		result.m_mapped = block->m_mapped == nullptr ? nullptr : static_cast<char *>(block->m_mapped) + offset;
+		result.m_block = block;
+		block->m_allocations.emplace(offset, result);
+		return result;
+	}
+
+	void MemoryAllocator::Free(MemoryAllocation &allocation)
+	{
+		if (allocation.m_memory == VK_NULL_HANDLE)
+		{
+			return;
+		}
+
+		if (allocation.m_block == nullptr)
+		{
+			vkFreeMemory(Display::Get()->GetLogicalDevice(), allocation.m_memory, nullptr);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			uint32_t heap = m_memoryProperties.memoryTypes[allocation.m_memoryType].heapIndex;
+			m_dedicatedCounts[heap]--;
+			m_dedicatedBytes[heap] -= allocation.m_size;
+			allocation = MemoryAllocation();
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto block = allocation.m_block;
+		block->Free(allocation.m_offset);
+		allocation = MemoryAllocation();
+
+		if (!block->m_allocations.empty())
+		{
+			return;
+		}
+
+		// One empty block is kept per pool so a resource being recreated does not reallocate it, draining blocks are always released.
+		auto &pool = m_pools[block->m_pool];
+		uint32_t emptyBlocks = 0;
+
+		for (auto &poolBlock : pool)
+		{
+			if (poolBlock->m_allocations.empty())
+			{
+				emptyBlocks++;
+			}
+		}
+
+		if (block->m_draining || emptyBlocks > 1)
+		{
+			ReleaseBlock(block);
+		}
+	}
+
+	uint32_t MemoryAllocator::FindMemoryType(const uint32_t &typeFilter, const VkMemoryPropertyFlags &properties) const
+	{
+		std::vector<VkMemoryPropertyFlags> candidates = {properties};
+
+		if ((properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0 && (properties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0)
+		{
+			candidates.insert(candidates.begin(), properties | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		}
+
+		for (auto &candidate : candidates)
+		{
+			for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++)
+			{
+				// If typefilter has a bit set to 1 and it contains the properties we indicated.
+				if ((typeFilter & (1 << i)) && (m_memoryProperties.memoryTypes[i].propertyFlags & candidate) == candidate)
+				{
+					return i;
+				}
+			}
+		}
+
+		throw std::runtime_error("Failed to find a valid memory type!");
+	}
+
+	uint32_t MemoryAllocator::Defragment(const std::function<bool(const MemoryAllocation &)> &relocate, const uint32_t &maxMoves)
+	{
+		std::vector<MemoryAllocation> candidates;
+		std::vector<MemoryBlock *> draining;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			for (auto &pool : m_pools)
+			{
+				// Only pools with a spare block can be compacted, transient blocks empty on their own.
+				if (pool.size() < 2 || pool.front()->m_buddy == nullptr)
+				{
+					continue;
+				}
+
+				MemoryBlock *sparsest = nullptr;
+
+				for (auto &block : pool)
+				{
+					if (!block->m_allocations.empty() && (sparsest == nullptr || block->GetUsed() < sparsest->GetUsed()))
+					{
+						sparsest = block.get();
+					}
+				}
+
+				// A block more than half full is not worth moving.
+				if (sparsest == nullptr || sparsest->GetUsed() > sparsest->m_size / 2)
+				{
+					continue;
+				}
+
+				sparsest->m_draining = true;
+				draining.emplace_back(sparsest);
+
+				for (auto &allocation : sparsest->m_allocations)
+				{
+					candidates.emplace_back(allocation.second);
+				}
+			}
+		}
+
+		// The relocate callback allocates and frees, so it is called without holding the lock.
+		uint32_t moves = 0;
+
+		for (auto &candidate : candidates)
+		{
+			if (moves >= maxMoves)
+			{
+				break;
+			}
+
+			if (relocate(candidate))
+			{
+				moves++;
+			}
+		}
+
+		// Blocks that could not be emptied take new allocations again.
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (auto &pool : m_pools)
+		{
+			for (auto &block : pool)
+			{
+				if (std::find(draining.begin(), draining.end(), block.get()) != draining.end())
+				{
+					block->m_draining = false;
+				}
+			}
+		}
+
+		return moves;
+	}
+
+	std::vector<MemoryStatistics> MemoryAllocator::GetStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::vector<MemoryStatistics> result(m_memoryProperties.memoryHeapCount, MemoryStatistics{0, 0, 0, 0, 0, 0, 0});
+
+		for (uint32_t i = 0; i < m_memoryProperties.memoryHeapCount; i++)
+		{
+			result[i].heapSize = m_memoryProperties.memoryHeaps[i].size;
+			result[i].dedicatedBytes = m_dedicatedBytes[i];
+			result[i].dedicatedCount = m_dedicatedCounts[i];
+		}
+
+		for (auto &pool : m_pools)
+		{
+			for (auto &block : pool)
+			{
+				auto &statistics = result[m_memoryProperties.memoryTypes[block->m_memoryType].heapIndex];
+				statistics.blockBytes += block->m_size;
+				statistics.usedBytes += block->GetUsed();
+				statistics.blockCount++;
+				statistics.allocationCount += static_cast<uint32_t>(block->m_allocations.size());
+			}
+		}
+
+		return result;
+	}
+
+	uint32_t MemoryAllocator::GetPoolIndex(const uint32_t &memoryType, const MemoryResource &resource, const MemoryUsage &usage) const
+	{
+		return (memoryType * 6) + (static_cast<uint32_t>(resource) * 2) + static_cast<uint32_t>(usage);
+	}
+
+	VkDeviceSize MemoryAllocator::GetBlockSize(const uint32_t &memoryType, const MemoryUsage &usage) const
+	{
+		VkDeviceSize blockSize = usage == MEMORY_USAGE_TRANSIENT ? TRANSIENT_BLOCK_SIZE : BLOCK_SIZE;
+		VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[memoryType].heapIndex].size;
+
+		// Small heaps use smaller blocks, the buddy allocator needs a power of two.
+		while (blockSize > MIN_ALLOCATION && blockSize > heapSize / 8)
+		{
+			blockSize /= 2;
+		}
+
+		return blockSize;
+	}
+
+	void MemoryAllocator::ReleaseBlock(MemoryBlock *block)
+	{
+		auto &pool = m_pools[block->m_pool];
+
+		for (auto it = pool.begin(); it != pool.end(); ++it)
+		{
+			if (it->get() == block)
+			{
+				vkFreeMemory(Display::Get()->GetLogicalDevice(), block->m_memory, nullptr);
+				pool.erase(it);
+				return;
+			}
+		}
+	}
+}
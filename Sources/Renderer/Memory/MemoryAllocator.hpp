@@ -0,0 +1,171 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include "Engine/Engine.hpp"
+
+namespace acid
+{
+	class MemoryBlock;
+
+	enum MemoryUsage
+	{
+		/// Long lived resources, placed in blocks by a buddy allocator.
+		MEMORY_USAGE_STATIC = 0,
+		/// Short lived resources such as staging buffers, placed in blocks by a linear allocator that is reset once the block empties.
+		MEMORY_USAGE_TRANSIENT = 1
+	};
+
+	enum MemoryResource
+	{
+		MEMORY_RESOURCE_BUFFER = 0,
+		MEMORY_RESOURCE_IMAGE_LINEAR = 1,
+		MEMORY_RESOURCE_IMAGE_OPTIMAL = 2
+	};
+
+	/// <summary>
+	/// A range of device memory handed out by the memory allocator.
+	/// </summary>
+	class ACID_EXPORT MemoryAllocation
+	{
+	private:
+		friend class MemoryAllocator;
+
+		VkDeviceMemory m_memory;
+		VkDeviceSize m_offset;
+		VkDeviceSize m_size;
+		void *m_mapped;
+		MemoryBlock *m_block;
+		uint32_t m_memoryType;
+		void *m_userData;
+	public:
+		MemoryAllocation() :
+			m_memory(VK_NULL_HANDLE),
+			m_offset(0),
+			m_size(0),
+			m_mapped(nullptr),
+			m_block(nullptr),
+			m_memoryType(0),
+			m_userData(nullptr)
+		{
+		}
+
+		VkDeviceMemory GetMemory() const { return m_memory; }
+
+		VkDeviceSize GetOffset() const { return m_offset; }
+
+		VkDeviceSize GetSize() const { return m_size; }
+
+		/// <summary>
+		/// Gets a pointer to the start of this allocation, memory in host visible blocks stays mapped for the lifetime of the block.
+		/// </summary>
+		/// <returns> The mapped pointer, or nullptr if the memory is not host visible. </returns>
+		void *GetMapped() const { return m_mapped; }
+
+		uint32_t GetMemoryType() const { return m_memoryType; }
+
+		void *GetUserData() const { return m_userData; }
+
+		bool IsDedicated() const { return m_memory != VK_NULL_HANDLE && m_block == nullptr; }
+	};
+
+	/// <summary>
+	/// The memory usage of a single memory heap.
+	/// </summary>
+	struct MemoryStatistics
+	{
+		VkDeviceSize heapSize;
+		VkDeviceSize blockBytes;
+		VkDeviceSize usedBytes;
+		VkDeviceSize dedicatedBytes;
+		uint32_t blockCount;
+		uint32_t allocationCount;
+		uint32_t dedicatedCount;
+	};
+
+	/// <summary>
+	/// A module that sub-allocates device memory out of large blocks, so resources do not each use a driver allocation.
+	/// Blocks are pooled per memory type, resource kind and usage, allocations larger than half a block get their own dedicated memory.
+	/// The allocator is registered right after the display, so it is deleted after every module that owns memory.
+	/// </summary>
+	class ACID_EXPORT MemoryAllocator :
+		public IModule
+	{
+	private:
+		VkPhysicalDeviceMemoryProperties m_memoryProperties;
+		std::vector<std::vector<std::unique_ptr<MemoryBlock>>> m_pools;
+		std::vector<uint32_t> m_dedicatedCounts;
+		std::vector<VkDeviceSize> m_dedicatedBytes;
+		mutable std::mutex m_mutex;
+	public:
+		static const VkDeviceSize BLOCK_SIZE;
+		static const VkDeviceSize TRANSIENT_BLOCK_SIZE;
+		static const VkDeviceSize MIN_ALLOCATION;
+
+		/// <summary>
+		/// Gets this engine instance.
+		/// </summary>
+		/// <returns> The current module instance. </returns>
+		static MemoryAllocator *Get()
+		{
+			return Engine::Get()->GetModule<MemoryAllocator>();
+		}
+
+		MemoryAllocator();
+
+		~MemoryAllocator();
+
+		void Update() override;
+
+		/// <summary>
+		/// Allocates device memory.
+		/// </summary>
+		/// <param name="requirements"> The memory requirements of the resource. </param>
+		/// <param name="properties"> The required memory properties. </param>
+		/// <param name="resource"> The kind of resource, buffers, linear and optimal images use separate blocks so they never share a page. </param>
+		/// <param name="usage"> How long the resource is expected to live. </param>
+		/// <param name="userData"> A pointer kept with the allocation, usually the owner, given back when defragmenting. </param>
+		/// <returns> The allocation. </returns>
+		MemoryAllocation Allocate(const VkMemoryRequirements &requirements, const VkMemoryPropertyFlags &properties, const MemoryResource &resource,
+			const MemoryUsage &usage = MEMORY_USAGE_STATIC, void *userData = nullptr);
+
+		/// <summary>
+		/// Frees a allocation and resets it, freeing a empty allocation does nothing.
+		/// </summary>
+		/// <param name="allocation"> The allocation to free. </param>
+		void Free(MemoryAllocation &allocation);
+
+		/// <summary>
+		/// Finds a memory type from the cached device memory properties. Host visible requests prefer host coherent memory, so mapped writes never need flushing.
+		/// </summary>
+		/// <param name="typeFilter"> The allowed memory type bits. </param>
+		/// <param name="properties"> The required memory properties. </param>
+		/// <returns> The memory type index. </returns>
+		uint32_t FindMemoryType(const uint32_t &typeFilter, const VkMemoryPropertyFlags &properties) const;
+
+		/// <summary>
+		/// Tries to empty the sparsest static block of each pool, so it can be released. The block stops taking new allocations,
+		/// and every allocation inside it is passed to the relocate callback, which is expected to allocate a replacement, copy into it and free the original.
+		/// Allocations of objects queued for destruction by the renderer are still passed until their frames finish, so the callback must skip owners it no longer knows.
+		/// </summary>
+		/// <param name="relocate"> Moves a allocation, returns if it was moved. </param>
+		/// <param name="maxMoves"> The maximum number of allocations to move. </param>
+		/// <returns> The number of allocations moved. </returns>
+		uint32_t Defragment(const std::function<bool(const MemoryAllocation &)> &relocate, const uint32_t &maxMoves);
+
+		/// <summary>
+		/// Gets the memory usage of each memory heap, the heap size is the budget the blocks must fit in.
+		/// </summary>
+		/// <returns> The statistics indexed by heap. </returns>
+		std::vector<MemoryStatistics> GetStatistics() const;
+	private:
+		uint32_t GetPoolIndex(const uint32_t &memoryType, const MemoryResource &resource, const MemoryUsage &usage) const;
+
+		VkDeviceSize GetBlockSize(const uint32_t &memoryType, const MemoryUsage &usage) const;
+
+		void ReleaseBlock(MemoryBlock *block);
+	};
+}
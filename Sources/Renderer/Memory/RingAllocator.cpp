@@ -0,0 +1,53 @@
+#include "RingAllocator.hpp"
+
+namespace acid
+{
+	RingAllocator::RingAllocator(const VkDeviceSize &size, const uint32_t &frames) :
+		m_size(size),
+		m_head(0),
+		m_used(0),
+		m_frameUsed(std::vector<VkDeviceSize>(frames, 0)),
+		m_frame(0)
+	{
+	}
+
+	RingAllocator::~RingAllocator()
+	{
+	}
+
+	void RingAllocator::BeginFrame(const uint32_t &frame)
+	{
+		m_frame = frame;
+		m_used -= m_frameUsed[frame];
+		m_frameUsed[frame] = 0;
+	}
+
+	bool RingAllocator::Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment, VkDeviceSize &offset)
+	{
+		if (size > m_size)
+		{
+			return false;
+		}
+
+		VkDeviceSize aligned = (m_head + alignment - 1) & ~(alignment - 1);
+
+		// Wraps to the start of the ring, the skipped tail is counted as used by this frame.
+		if (aligned + size > m_size)
+		{
+			aligned = 0;
+		}
+
+		VkDeviceSize consumed = aligned >= m_head ? (aligned - m_head) + size : (m_size - m_head) + size;
+
+		if (m_used + consumed > m_size)
+		{
+			return false;
+		}
+
+		offset = aligned;
+		m_head = aligned + size;
+		m_used += consumed;
+		m_frameUsed[m_frame] += consumed;
+		return true;
+	}
+}
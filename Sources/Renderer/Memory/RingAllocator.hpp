@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.h>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A ring allocator for per frame data. Allocations are made for the current frame, and are released together once that frame slot is begun again.
+	/// Frames must be begun in round robin order, so the oldest frame is always the next one released.
+	/// </summary>
+	class ACID_EXPORT RingAllocator
+	{
+	private:
+		VkDeviceSize m_size;
+		VkDeviceSize m_head;
+		VkDeviceSize m_used;
+		std::vector<VkDeviceSize> m_frameUsed;
+		uint32_t m_frame;
+	public:
+		/// <summary>
+		/// Creates a new ring allocator.
+		/// </summary>
+		/// <param name="size"> The size of the ring. </param>
+		/// <param name="frames"> The number of frames that can be in flight at once. </param>
+		RingAllocator(const VkDeviceSize &size, const uint32_t &frames);
+
+		~RingAllocator();
+
+		/// <summary>
+		/// Begins a frame, releasing every allocation made the last time this frame slot was used.
+		/// </summary>
+		/// <param name="frame"> The frame slot, the GPU must have finished with it. </param>
+		void BeginFrame(const uint32_t &frame);
+
+		/// <summary>
+		/// Allocates a range for the current frame.
+		/// </summary>
+		/// <param name="size"> The size to allocate. </param>
+		/// <param name="alignment"> The required alignment of the offset, must be a power of two. </param>
+		/// <param name="offset"> The offset of the allocated range. </param>
+		/// <returns> If a range was allocated, false if the frames in flight fill the ring. </returns>
+		bool Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment, VkDeviceSize &offset);
+
+		VkDeviceSize GetSize() const { return m_size; }
+
+		VkDeviceSize GetUsed() const { return m_used; }
+	};
+}
@@ -0,0 +1,235 @@
+#include "Uploader.hpp"
+
+#include <cstring>
+#include "Display/Display.hpp"
+
+namespace acid
+{
+	const VkDeviceSize Uploader::STAGING_SIZE = 32 * 1024 * 1024;
+	const uint32_t Uploader::BATCH_COUNT = 3;
+
+	static const VkDeviceSize STAGING_ALIGNMENT = 16;
+
+	/// <summary>
+	/// A command buffer and fence used to submit uploads, with the temporary staging buffers it owns until it completes.
+	/// </summary>
+	class UploadBatch
+	{
+	public:
+		CommandBuffer m_commandBuffer;
+		VkFence m_fence;
+		uint64_t m_id;
+		bool m_recording;
+		std::vector<std::unique_ptr<Buffer>> m_buffers;
+
+		explicit UploadBatch(const VkCommandPool &commandPool) :
+			m_commandBuffer(CommandBuffer(false, VK_QUEUE_GRAPHICS_BIT, VK_COMMAND_BUFFER_LEVEL_PRIMARY, commandPool)),
+			m_fence(VK_NULL_HANDLE),
+			m_id(0),
+			m_recording(false),
+			m_buffers(std::vector<std::unique_ptr<Buffer>>())
+		{
+			auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+			VkFenceCreateInfo fenceCreateInfo = {};
+			fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+			Display::CheckVk(vkCreateFence(logicalDevice, &fenceCreateInfo, nullptr, &m_fence));
+		}
+
+		~UploadBatch()
+		{
+			auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+			vkDestroyFence(logicalDevice, m_fence, nullptr);
+		}
+	};
+
+	Uploader::Uploader() :
+		IModule(),
+		m_commandPool(VK_NULL_HANDLE),
+		m_staging(nullptr),
+		m_ring(STAGING_SIZE, BATCH_COUNT),
+		m_batches(std::vector<std::unique_ptr<UploadBatch>>()),
+		m_current(0),
+		m_recording(1),
+		m_completed(0),
+		m_mutex()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+		commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		commandPoolCreateInfo.queueFamilyIndex = Display::Get()->GetGraphicsFamily();
+		commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+		Display::CheckVk(vkCreateCommandPool(logicalDevice, &commandPoolCreateInfo, nullptr, &m_commandPool));
+
+		m_staging = new Buffer(STAGING_SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		for (uint32_t i = 0; i < BATCH_COUNT; i++)
+		{
+			m_batches.emplace_back(std::make_unique<UploadBatch>(m_commandPool));
+		}
+	}
+
+	Uploader::~Uploader()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		auto graphicsQueue = Display::Get()->GetGraphicsQueue();
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			Submit();
+		}
+
+		Display::CheckVk(vkQueueWaitIdle(graphicsQueue));
+
+		m_batches.clear();
+		delete m_staging;
+
+		vkDestroyCommandPool(logicalDevice, m_commandPool, nullptr);
+	}
+
+	void Uploader::Update()
+	{
+		Flush();
+	}
+
+	uint64_t Uploader::Upload(const void *data, const VkDeviceSize &size, const std::function<void(const CommandBuffer &, const VkBuffer &, const VkDeviceSize &)> &record)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto &batch = *m_batches[m_current];
+
+		if (!batch.m_recording)
+		{
+			batch.m_commandBuffer.Begin();
+			batch.m_recording = true;
+		}
+
+		VkBuffer stagingBuffer = m_staging->GetBuffer();
+		VkDeviceSize stagingOffset = 0;
+
+		if (m_ring.Allocate(size, STAGING_ALIGNMENT, stagingOffset))
+		{
+			memcpy(static_cast<char *>(m_staging->GetMapped()) + stagingOffset, data, static_cast<size_t>(size));
+		}
+		else
+		{
+			// The ring is full or the upload is larger than it, a temporary staging buffer is kept alive until the batch completes.
+			auto buffer = std::make_unique<Buffer>(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MEMORY_USAGE_TRANSIENT);
+			memcpy(buffer->GetMapped(), data, static_cast<size_t>(size));
+			stagingBuffer = buffer->GetBuffer();
+			stagingOffset = 0;
+			batch.m_buffers.emplace_back(std::move(buffer));
+		}
+
+		record(batch.m_commandBuffer, stagingBuffer, stagingOffset);
+		return m_recording;
+	}
+
+	uint64_t Uploader::UploadBuffer(const Buffer &buffer, const void *data, const VkDeviceSize &size, const VkDeviceSize &offset)
+	{
+		return Upload(data, size, [&buffer, size, offset](const CommandBuffer &commandBuffer, const VkBuffer &stagingBuffer, const VkDeviceSize &stagingOffset)
+		{
+			Buffer::CopyBuffer(commandBuffer, stagingBuffer, buffer.GetBuffer(), size, stagingOffset, offset);
+		});
+	}
+
+	uint64_t Uploader::Flush()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Submit();
+		Retire();
+		return m_recording - 1;
+	}
+
+	bool Uploader::IsComplete(const uint64_t &batch)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Retire();
+		return batch <= m_completed;
+	}
+
+	void Uploader::Wait(const uint64_t &batch)
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (batch >= m_recording)
+		{
+			Submit();
+		}
+
+		for (uint64_t i = m_completed + 1; i <= batch && i < m_recording; i++)
+		{
+			auto &waiting = *m_batches[(i - 1) % BATCH_COUNT];
+			Display::CheckVk(vkWaitForFences(logicalDevice, 1, &waiting.m_fence, VK_TRUE, UINT64_MAX));
+		}
+
+		Retire();
+	}
+
+	void Uploader::Submit()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		auto &batch = *m_batches[m_current];
+
+		if (!batch.m_recording)
+		{
+			return;
+		}
+
+		// One barrier makes every copy in the batch visible to the submissions that follow on the queue.
+		VkMemoryBarrier memoryBarrier = {};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+		vkCmdPipelineBarrier(batch.m_commandBuffer.GetCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+			1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		batch.m_commandBuffer.End();
+
+		Display::CheckVk(vkResetFences(logicalDevice, 1, &batch.m_fence));
+		batch.m_commandBuffer.Submit(VK_NULL_HANDLE, VK_NULL_HANDLE, batch.m_fence);
+
+		batch.m_recording = false;
+		batch.m_id = m_recording;
+		m_recording++;
+		m_current = (m_current + 1) % BATCH_COUNT;
+
+		// The next batch is the oldest one in flight, its staging range can only be reused once the GPU is done with it.
+		auto &next = *m_batches[m_current];
+
+		if (next.m_id != 0 && next.m_id > m_completed)
+		{
+			Display::CheckVk(vkWaitForFences(logicalDevice, 1, &next.m_fence, VK_TRUE, UINT64_MAX));
+			m_completed = next.m_id;
+		}
+
+		next.m_buffers.clear();
+		m_ring.BeginFrame(m_current);
+	}
+
+	void Uploader::Retire()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		while (m_completed + 1 < m_recording)
+		{
+			auto &batch = *m_batches[m_completed % BATCH_COUNT];
+
+			if (vkGetFenceStatus(logicalDevice, batch.m_fence) != VK_SUCCESS)
+			{
+				return;
+			}
+
+			batch.m_buffers.clear();
+			m_completed++;
+		}
+	}
+}
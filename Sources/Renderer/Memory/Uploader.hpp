@@ -0,0 +1,114 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include "Engine/Engine.hpp"
+#include "Renderer/Buffers/Buffer.hpp"
+#include "RingAllocator.hpp"
+
+namespace acid
+{
+	class UploadBatch;
+
+	/// <summary>
+	/// A module that uploads data into device local buffers and images. Data is copied into a persistently mapped staging ring,
+	/// copies are recorded into a batch that is submitted once per frame on the graphics queue ahead of the frames own command buffer.
+	/// Every batch is signaled by its own fence, so uploads complete without blocking the thread that requested them.
+	/// <para>
+	/// Buffers and images queue their destruction on the renderer, which waits for the upload batches submitted with a frame before destroying
+	/// the objects freed during it, so a destination freed before its copy is submitted stays valid until the copy completes.
+	/// </para>
+	/// </summary>
+	class ACID_EXPORT Uploader :
+		public IModule
+	{
+	private:
+		VkCommandPool m_commandPool;
+
+		Buffer *m_staging;
+		RingAllocator m_ring;
+
+		std::vector<std::unique_ptr<UploadBatch>> m_batches;
+		uint32_t m_current;
+		uint64_t m_recording;
+		uint64_t m_completed;
+
+		std::mutex m_mutex;
+	public:
+		/// <summary>
+		/// The size of the staging ring, uploads that do not fit use a temporary staging buffer.
+		/// </summary>
+		static const VkDeviceSize STAGING_SIZE;
+
+		/// <summary>
+		/// The number of batches that can be in flight at once.
+		/// </summary>
+		static const uint32_t BATCH_COUNT;
+
+		/// <summary>
+		/// Gets this engine instance.
+		/// </summary>
+		/// <returns> The current module instance. </returns>
+		static Uploader *Get()
+		{
+			return Engine::Get()->GetModule<Uploader>();
+		}
+
+		/// <summary>
+		/// Creates a new uploader module.
+		/// </summary>
+		Uploader();
+
+		/// <summary>
+		/// Deconstructor for the uploader module.
+		/// </summary>
+		~Uploader();
+
+		void Update() override;
+
+		/// <summary>
+		/// Stages data and records commands that copy it to the GPU into the current batch.
+		/// </summary>
+		/// <param name="data"> The data to stage. </param>
+		/// <param name="size"> The size of the data. </param>
+		/// <param name="record"> Records the copies, called with the command buffer, the staging buffer and the offset of the staged data. </param>
+		/// <returns> The batch the upload was recorded into. </returns>
+		uint64_t Upload(const void *data, const VkDeviceSize &size, const std::function<void(const CommandBuffer &, const VkBuffer &, const VkDeviceSize &)> &record);
+
+		/// <summary>
+		/// Uploads data into a device local buffer, the buffer must have been created with transfer destination usage.
+		/// </summary>
+		/// <param name="buffer"> The buffer to upload into. </param>
+		/// <param name="data"> The data to upload. </param>
+		/// <param name="size"> The size of the data. </param>
+		/// <param name="offset"> The offset into the buffer. </param>
+		/// <returns> The batch the upload was recorded into. </returns>
+		uint64_t UploadBuffer(const Buffer &buffer, const void *data, const VkDeviceSize &size, const VkDeviceSize &offset = 0);
+
+		/// <summary>
+		/// Submits the batch being recorded, this is called every frame before the renderer submits.
+		/// </summary>
+		/// <returns> The last submitted batch. </returns>
+		uint64_t Flush();
+
+		/// <summary>
+		/// Gets if a batch has finished executing on the GPU.
+		/// </summary>
+		/// <param name="batch"> The batch to check. </param>
+		/// <returns> If the batch is complete. </returns>
+		bool IsComplete(const uint64_t &batch);
+
+		/// <summary>
+		/// Blocks until a batch has finished executing on the GPU, submitting it if it is still being recorded.
+		/// </summary>
+		/// <param name="batch"> The batch to wait on. </param>
+		void Wait(const uint64_t &batch);
+	private:
+		void Submit();
+
+		void Retire();
+	};
+}
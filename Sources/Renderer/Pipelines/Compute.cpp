@@ -41,6 +41,12 @@ namespace acid
 
 		Display::CheckVk(vkDeviceWaitIdle(logicalDevice));
 
+		// Sets allocated from the descriptor pool may be queued for destruction, they must be freed before the pool is.
+		if (Engine::Get() != nullptr && Renderer::Get() != nullptr)
+		{
+			Renderer::Get()->DestroyQueued();
+		}
+
 		vkDestroyShaderModule(logicalDevice, m_shaderModule, nullptr);
 
 		vkDestroyDescriptorSetLayout(logicalDevice, m_descriptorSetLayout, nullptr);
@@ -51,20 +57,19 @@ namespace acid
 
 	void Compute::CmdRender(const CommandBuffer &commandBuffer) const
 	{
-		uint32_t groupCountX = static_cast<uint32_t>(std::ceil(float(m_computeCreate.GetWidth()) / float(m_computeCreate.GetWorkgroupSize())));
-		uint32_t groupCountY = static_cast<uint32_t>(std::ceil(float(m_computeCreate.GetHeight()) / float(m_computeCreate.GetWorkgroupSize())));
+		CmdRender(commandBuffer, m_computeCreate.GetWidth(), m_computeCreate.GetHeight());
+	}
+
+	void Compute::CmdRender(const CommandBuffer &commandBuffer, const uint32_t &width, const uint32_t &height) const
+	{
+		uint32_t groupCountX = static_cast<uint32_t>(std::ceil(float(width) / float(m_computeCreate.GetWorkgroupSize())));
+		uint32_t groupCountY = static_cast<uint32_t>(std::ceil(float(height) / float(m_computeCreate.GetWorkgroupSize())));
 		vkCmdDispatch(commandBuffer.GetCommandBuffer(), groupCountX, groupCountY, 1);
 	}
 
 	void Compute::CreateShaderProgram()
 	{
-		std::stringstream defineBlock;
-		defineBlock << "\n";
-
-		for (auto &define : m_computeCreate.GetDefines())
-		{
-			defineBlock << "#define " << define.GetName() << " " << define.GetValue() << "\n";
-		}
+		std::string defineBlock = ShaderCache::GetDefineBlock(m_computeCreate.GetDefines());
 
 		if (!FileSystem::FileExists(m_computeCreate.GetShaderStage()))
 		{
@@ -79,8 +84,9 @@ namespace acid
 			return;
 		}
 
-		auto shaderCode = ShaderProgram::InsertDefineBlock(fileLoaded.value(), defineBlock.str());
+		auto shaderCode = ShaderProgram::InsertDefineBlock(fileLoaded.value(), defineBlock);
 		shaderCode = ShaderProgram::ProcessIncludes(shaderCode);
+		ShaderCache::RecordPermutation(m_computeCreate.GetShaderStage(), m_computeCreate.GetDefines());
 
 		VkShaderStageFlagBits stageFlag = ShaderProgram::GetShaderStage(m_computeCreate.GetShaderStage());
 		m_shaderModule = m_shaderProgram->ProcessShader(shaderCode, stageFlag);
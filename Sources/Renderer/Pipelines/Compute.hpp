@@ -37,6 +37,14 @@ namespace acid
 
 		void CmdRender(const CommandBuffer &commandBuffer) const;
 
+		/// <summary>
+		/// Dispatches enough workgroups to cover a size other than the one the pipeline was created with.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="width"> The number of invocations to cover along x. </param>
+		/// <param name="height"> The number of invocations to cover along y. </param>
+		void CmdRender(const CommandBuffer &commandBuffer, const uint32_t &width, const uint32_t &height) const;
+
 		std::shared_ptr<ShaderProgram> GetShaderProgram() const override { return m_shaderProgram; }
 
 		VkDescriptorSetLayout GetDescriptorSetLayout() const override { return m_descriptorSetLayout; }
@@ -56,6 +56,9 @@ namespace acid
 		case PIPELINE_MODE_MRT_NO_DEPTH:
 			CreatePipelineMrtNoDepth();
 			break;
+		case PIPELINE_MODE_MRT_BLENDED:
+			CreatePipelineMrtBlended();
+			break;
 		case PIPELINE_MODE_COMPUTE:
 			CreatePipelineCompute();
 			break;
@@ -77,6 +80,12 @@ namespace acid
 
 		Display::CheckVk(vkDeviceWaitIdle(logicalDevice));
 
+		// Sets allocated from the descriptor pool may be queued for destruction, they must be freed before the pool is.
+		if (Engine::Get() != nullptr && Renderer::Get() != nullptr)
+		{
+			Renderer::Get()->DestroyQueued();
+		}
+
 		for (auto &shaderModule : m_modules)
 		{
 			vkDestroyShaderModule(logicalDevice, shaderModule, nullptr);
@@ -100,13 +109,7 @@ namespace acid
 
 	void Pipeline::CreateShaderProgram()
 	{
-		std::stringstream defineBlock;
-		defineBlock << "\n";
-
-		for (auto &define : m_pipelineCreate.GetDefines())
-		{
-			defineBlock << "#define " << define.GetName() << " " << define.GetValue() << "\n";
-		}
+		std::string defineBlock = ShaderCache::GetDefineBlock(m_pipelineCreate.GetDefines());
 
 		for (auto &shaderStage : m_pipelineCreate.GetShaderStages())
 		{
@@ -123,8 +126,9 @@ namespace acid
 				continue;
 			}
 
-			auto shaderCode = ShaderProgram::InsertDefineBlock(fileLoaded.value(), defineBlock.str());
+			auto shaderCode = ShaderProgram::InsertDefineBlock(fileLoaded.value(), defineBlock);
 			shaderCode = ShaderProgram::ProcessIncludes(shaderCode);
+			ShaderCache::RecordPermutation(shaderStage, m_pipelineCreate.GetDefines());
 
 			VkShaderStageFlagBits stageFlag = ShaderProgram::GetShaderStage(shaderStage);
 			VkShaderModule shaderModule = m_shaderProgram->ProcessShader(shaderCode, stageFlag);
@@ -376,6 +380,35 @@ namespace acid
 		CreatePipelinePolygon();
 	}
 
+	void Pipeline::CreatePipelineMrtBlended()
+	{
+		std::vector<VkPipelineColorBlendAttachmentState> blendAttachmentStates = {};
+
+		for (uint32_t i = 0; i < Renderer::Get()->GetRenderStage(m_graphicsStage.GetRenderpass())->GetImageAttachments(); i++)
+		{
+			// Only the colour attachment is blended, the other attachments are written where a fragment is not discarded.
+			VkPipelineColorBlendAttachmentState blendAttachmentState = {};
+			blendAttachmentState.blendEnable = i == 0 ? VK_TRUE : VK_FALSE;
+			blendAttachmentState.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+			blendAttachmentState.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+			blendAttachmentState.colorBlendOp = VK_BLEND_OP_ADD;
+			blendAttachmentState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+			blendAttachmentState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+			blendAttachmentState.alphaBlendOp = VK_BLEND_OP_ADD;
+			blendAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+				VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+			blendAttachmentStates.emplace_back(blendAttachmentState);
+		}
+
+		m_colourBlendState.attachmentCount = static_cast<uint32_t>(blendAttachmentStates.size());
+		m_colourBlendState.pAttachments = blendAttachmentStates.data();
+
+		// Blended draws are sorted back to front, they test against the depth buffer but do not write to it.
+		m_depthStencilState.depthWriteEnable = VK_FALSE;
+
+		CreatePipelinePolygon();
+	}
+
 	void Pipeline::CreatePipelineCompute()
 	{
 		CreatePipelinePolygon();
@@ -91,6 +91,8 @@ namespace acid
 
 		void CreatePipelineMrtNoDepth();
 
+		void CreatePipelineMrtBlended();
+
 		void CreatePipelineCompute();
 	};
 }
@@ -0,0 +1,179 @@
+#include "PipelineCache.hpp"
+
+#include <cstdio>
+#include "Display/Display.hpp"
+#include "Helpers/CacheFile.hpp"
+#include "Helpers/FileSystem.hpp"
+
+namespace acid
+{
+	const uint32_t PipelineCache::HEADER_MAGIC = 0x48435041; // "APCH"
+	const uint32_t PipelineCache::HEADER_VERSION = 1;
+
+	PipelineCache::PipelineCache(const std::string &directory) :
+		m_filename(""),
+		m_pipelineCache(VK_NULL_HANDLE),
+		m_timerSave({}),
+		m_savedSize(0)
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		auto physicalDeviceProperties = Display::Get()->GetPhysicalDeviceProperties();
+
+		char filename[64];
+		snprintf(filename, sizeof(filename), "/Pipelines_%04x_%04x.bin", physicalDeviceProperties.vendorID, physicalDeviceProperties.deviceID);
+		m_filename = directory + filename;
+
+#if ACID_VERBOSE
+		float debugStart = Engine::Get()->GetTimeMs();
+#endif
+
+		auto data = Load();
+		m_savedSize = data.size();
+
+		VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {};
+		pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		pipelineCacheCreateInfo.initialDataSize = data.size();
+		pipelineCacheCreateInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+		Display::CheckVk(vkCreatePipelineCache(logicalDevice, &pipelineCacheCreateInfo, nullptr, &m_pipelineCache));
+
+#if ACID_VERBOSE
+		float debugEnd = Engine::Get()->GetTimeMs();
+		fprintf(stdout, "Pipeline cache '%s' loaded %zu bytes in %fms\n", m_filename.c_str(), data.size(), debugEnd - debugStart);
+#endif
+	}
+
+	PipelineCache::~PipelineCache()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		Save();
+		vkDestroyPipelineCache(logicalDevice, m_pipelineCache, nullptr);
+	}
+
+	void PipelineCache::Update()
+	{
+		if (m_timerSave && m_timerSave->IsPassedTime())
+		{
+			m_timerSave->ResetStartTime();
+			Save();
+		}
+	}
+
+	bool PipelineCache::Save()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		auto physicalDeviceProperties = Display::Get()->GetPhysicalDeviceProperties();
+
+		size_t dataSize = 0;
+		Display::CheckVk(vkGetPipelineCacheData(logicalDevice, m_pipelineCache, &dataSize, nullptr));
+
+		// Pipeline caches only ever grow, so a unchanged size means there is nothing new to write.
+		if (dataSize == 0 || dataSize == m_savedSize)
+		{
+			return false;
+		}
+
+		std::vector<char> file(sizeof(Header) + dataSize);
+		Display::CheckVk(vkGetPipelineCacheData(logicalDevice, m_pipelineCache, &dataSize, file.data() + sizeof(Header)));
+		file.resize(sizeof(Header) + dataSize);
+
+		// The padding of the header is written too, so it is zeroed to keep the file deterministic.
+		Header header;
+		memset(&header, 0, sizeof(Header));
+		header.magic = HEADER_MAGIC;
+		header.version = HEADER_VERSION;
+		header.vendorID = physicalDeviceProperties.vendorID;
+		header.deviceID = physicalDeviceProperties.deviceID;
+		header.driverVersion = physicalDeviceProperties.driverVersion;
+		memcpy(header.pipelineCacheUUID, physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+		header.dataSize = dataSize;
+		header.dataHash = CacheFile::Hash(file.data() + sizeof(Header), dataSize);
+		memcpy(file.data(), &header, sizeof(Header));
+
+		if (!CacheFile::Write(m_filename, file))
+		{
+			return false;
+		}
+
+		m_savedSize = dataSize;
+
+#if ACID_VERBOSE
+		fprintf(stdout, "Pipeline cache '%s' saved %zu bytes\n", m_filename.c_str(), dataSize);
+#endif
+		return true;
+	}
+
+	void PipelineCache::SetSaveInterval(const float &interval)
+	{
+		if (interval <= 0.0f)
+		{
+			m_timerSave = {};
+			return;
+		}
+
+		m_timerSave = Timer(interval);
+	}
+
+	std::vector<char> PipelineCache::Load() const
+	{
+		if (!FileSystem::FileExists(m_filename))
+		{
+			return {};
+		}
+
+		auto file = FileSystem::ReadBinaryFile<char>(m_filename);
+
+		if (!file || file->size() < sizeof(Header))
+		{
+			fprintf(stderr, "Pipeline cache is truncated, ignoring: '%s'\n", m_filename.c_str());
+			return {};
+		}
+
+		auto physicalDeviceProperties = Display::Get()->GetPhysicalDeviceProperties();
+
+		Header header = {};
+		memcpy(&header, file->data(), sizeof(Header));
+
+		if (header.magic != HEADER_MAGIC || header.version != HEADER_VERSION)
+		{
+			fprintf(stderr, "Pipeline cache has a unknown header, ignoring: '%s'\n", m_filename.c_str());
+			return {};
+		}
+
+		if (header.vendorID != physicalDeviceProperties.vendorID || header.deviceID != physicalDeviceProperties.deviceID ||
+			header.driverVersion != physicalDeviceProperties.driverVersion ||
+			memcmp(header.pipelineCacheUUID, physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+		{
+			fprintf(stderr, "Pipeline cache was created by a different device or driver, ignoring: '%s'\n", m_filename.c_str());
+			return {};
+		}
+
+		if (header.dataSize != file->size() - sizeof(Header) || header.dataHash != CacheFile::Hash(file->data() + sizeof(Header), header.dataSize))
+		{
+			fprintf(stderr, "Pipeline cache is corrupt, ignoring: '%s'\n", m_filename.c_str());
+			return {};
+		}
+
+		std::vector<char> data(file->begin() + sizeof(Header), file->end());
+
+		// The driver also validates its own header, checking it here allows a rejected cache to be reported.
+		VkPipelineCacheHeaderVersion cacheHeaderVersion = {};
+		uint32_t cacheHeaderSize = 0;
+
+		if (data.size() >= 16 + VK_UUID_SIZE)
+		{
+			memcpy(&cacheHeaderSize, data.data(), sizeof(uint32_t));
+			memcpy(&cacheHeaderVersion, data.data() + 4, sizeof(uint32_t));
+		}
+
+		if (cacheHeaderSize < 16 + VK_UUID_SIZE || cacheHeaderVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+			memcmp(data.data() + 16, physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+		{
+			fprintf(stderr, "Pipeline cache data header does not match the device, ignoring: '%s'\n", m_filename.c_str());
+			return {};
+		}
+
+		return data;
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include "Engine/Exports.hpp"
+#include "Maths/Timer.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A Vulkan pipeline cache that is persisted to disk between runs.
+	/// The file is keyed by the vendor and device, and is rejected if the device UUID, driver version, size or checksum do not match.
+	/// </summary>
+	class ACID_EXPORT PipelineCache
+	{
+	private:
+		static const uint32_t HEADER_MAGIC;
+		static const uint32_t HEADER_VERSION;
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			uint32_t driverVersion;
+			uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+			uint64_t dataSize;
+			uint64_t dataHash;
+		};
+
+		std::string m_filename;
+		VkPipelineCache m_pipelineCache;
+		std::optional<Timer> m_timerSave;
+		size_t m_savedSize;
+	public:
+		/// <summary>
+		/// Creates a new pipeline cache, loading the cache file for the current device if it is valid.
+		/// </summary>
+		/// <param name="directory"> The directory the cache file is stored in. </param>
+		PipelineCache(const std::string &directory);
+
+		/// <summary>
+		/// Deconstructor for the pipeline cache, saves the cache to disk.
+		/// </summary>
+		~PipelineCache();
+
+		/// <summary>
+		/// Saves the cache if the periodic save interval has passed.
+		/// </summary>
+		void Update();
+
+		/// <summary>
+		/// Writes the cache to disk if it has grown since the last save.
+		/// </summary>
+		/// <returns> If the cache file was written. </returns>
+		bool Save();
+
+		/// <summary>
+		/// Sets the interval between periodic saves.
+		/// </summary>
+		/// <param name="interval"> The interval in seconds, a value less or equal to zero only saves on shutdown. </param>
+		void SetSaveInterval(const float &interval);
+
+		std::string GetFilename() const { return m_filename; }
+
+		VkPipelineCache GetPipelineCache() const { return m_pipelineCache; }
+	private:
+		std::vector<char> Load() const;
+	};
+}
@@ -13,7 +13,8 @@ namespace acid
 		PIPELINE_MODE_POLYGON_NO_DEPTH = 1,
 		PIPELINE_MODE_MRT = 2,
 		PIPELINE_MODE_MRT_NO_DEPTH = 3,
-		PIPELINE_MODE_COMPUTE = 4
+		PIPELINE_MODE_MRT_BLENDED = 4,
+		PIPELINE_MODE_COMPUTE = 5
 	};
 
 	class ACID_EXPORT GraphicsStage
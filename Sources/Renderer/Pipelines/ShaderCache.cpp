@@ -0,0 +1,338 @@
+#include "ShaderCache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include "Helpers/FileSystem.hpp"
+#include "Helpers/FormatString.hpp"
+
+namespace acid
+{
+	const uint32_t ShaderCache::CACHE_MAGIC = 0x48535341; // "ASSH"
+	const uint32_t ShaderCache::CACHE_VERSION = 2;
+
+	CacheFile ShaderCache::CACHE = CacheFile("Shaders");
+	std::mutex ShaderCache::MUTEX = {};
+	std::vector<std::string> ShaderCache::PERMUTATIONS = std::vector<std::string>();
+	bool ShaderCache::PERMUTATIONS_LOADED = false;
+
+	template<typename T>
+	static void WriteValue(std::vector<char> &data, const T &value)
+	{
+		const char *bytes = reinterpret_cast<const char *>(&value);
+		data.insert(data.end(), bytes, bytes + sizeof(T));
+	}
+
+	static void WriteString(std::vector<char> &data, const std::string &value)
+	{
+		WriteValue(data, static_cast<uint32_t>(value.size()));
+		data.insert(data.end(), value.begin(), value.end());
+	}
+
+	template<typename T>
+	static bool ReadValue(const std::vector<char> &data, size_t &offset, T &value)
+	{
+		if (offset + sizeof(T) > data.size())
+		{
+			return false;
+		}
+
+		memcpy(&value, data.data() + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	}
+
+	static bool ReadString(const std::vector<char> &data, size_t &offset, std::string &value)
+	{
+		uint32_t size = 0;
+
+		if (!ReadValue(data, offset, size) || offset + size > data.size())
+		{
+			return false;
+		}
+
+		value = std::string(data.data() + offset, size);
+		offset += size;
+		return true;
+	}
+
+	std::string ShaderCache::GetDirectory()
+	{
+		return CACHE.GetDirectory();
+	}
+
+	void ShaderCache::SetDirectory(const std::string &directory)
+	{
+		CACHE.SetDirectory(directory);
+
+		std::lock_guard<std::mutex> lock(MUTEX);
+		PERMUTATIONS.clear();
+		PERMUTATIONS_LOADED = false;
+	}
+
+	std::string ShaderCache::GetDefineBlock(const std::vector<PipelineDefine> &defines)
+	{
+		std::stringstream defineBlock;
+		defineBlock << "\n";
+
+		for (auto &define : defines)
+		{
+			defineBlock << "#define " << define.GetName() << " " << define.GetValue() << "\n";
+		}
+
+		return defineBlock.str();
+	}
+
+	bool ShaderCache::Load(const std::string &shaderCode, const VkShaderStageFlags &stageFlag, std::vector<uint32_t> &spirv, ShaderReflection &reflection)
+	{
+		std::string filename = GetFilename(shaderCode, stageFlag);
+
+		if (!FileSystem::FileExists(filename))
+		{
+			return false;
+		}
+
+		auto file = FileSystem::ReadBinaryFile<char>(filename);
+
+		if (!file)
+		{
+			return false;
+		}
+
+		auto &data = *file;
+		size_t offset = 0;
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		uint32_t stage = 0;
+		uint64_t codeSize = 0;
+		uint64_t codeHash = 0;
+
+		if (!ReadValue(data, offset, magic) || !ReadValue(data, offset, version) || !ReadValue(data, offset, stage) ||
+			!ReadValue(data, offset, codeSize) || !ReadValue(data, offset, codeHash))
+		{
+			return false;
+		}
+
+		// The filename is a hash, the full header guards against collisions and stale versions.
+		if (magic != CACHE_MAGIC || version != CACHE_VERSION || stage != static_cast<uint32_t>(stageFlag) ||
+			codeSize != shaderCode.size() || codeHash != CacheFile::Hash(shaderCode.data(), shaderCode.size()))
+		{
+			return false;
+		}
+
+		ShaderReflection result = ShaderReflection();
+		uint32_t count = 0;
+
+		if (!ReadValue(data, offset, count))
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			ShaderReflection::Block block = {};
+
+			if (!ReadString(data, offset, block.name) || !ReadValue(data, offset, block.binding) || !ReadValue(data, offset, block.size) ||
+				!ReadValue(data, offset, block.storage))
+			{
+				return false;
+			}
+
+			result.m_blocks.emplace_back(block);
+		}
+
+		if (!ReadValue(data, offset, count))
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			ShaderReflection::Uniform uniform = {};
+
+			if (!ReadString(data, offset, uniform.name) || !ReadValue(data, offset, uniform.binding) || !ReadValue(data, offset, uniform.offset) ||
+				!ReadValue(data, offset, uniform.size) || !ReadValue(data, offset, uniform.glType))
+			{
+				return false;
+			}
+
+			result.m_uniforms.emplace_back(uniform);
+		}
+
+		if (!ReadValue(data, offset, count))
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			ShaderReflection::Attribute attribute = {};
+
+			if (!ReadString(data, offset, attribute.name) || !ReadValue(data, offset, attribute.location) || !ReadValue(data, offset, attribute.size) ||
+				!ReadValue(data, offset, attribute.glType))
+			{
+				return false;
+			}
+
+			result.m_attributes.emplace_back(attribute);
+		}
+
+		if (!ReadValue(data, offset, count) || offset + (count * sizeof(uint32_t)) != data.size() || count == 0)
+		{
+			return false;
+		}
+
+		std::vector<uint32_t> code(count);
+		memcpy(code.data(), data.data() + offset, count * sizeof(uint32_t));
+
+		// SPIR-V magic number.
+		if (code[0] != 0x07230203)
+		{
+			return false;
+		}
+
+		spirv = code;
+		reflection = result;
+		return true;
+	}
+
+	bool ShaderCache::Save(const std::string &shaderCode, const VkShaderStageFlags &stageFlag, const std::vector<uint32_t> &spirv, const ShaderReflection &reflection)
+	{
+		std::string filename = GetFilename(shaderCode, stageFlag);
+
+		std::vector<char> data = {};
+		WriteValue(data, CACHE_MAGIC);
+		WriteValue(data, CACHE_VERSION);
+		WriteValue(data, static_cast<uint32_t>(stageFlag));
+		WriteValue(data, static_cast<uint64_t>(shaderCode.size()));
+		WriteValue(data, CacheFile::Hash(shaderCode.data(), shaderCode.size()));
+
+		WriteValue(data, static_cast<uint32_t>(reflection.m_blocks.size()));
+
+		for (auto &block : reflection.m_blocks)
+		{
+			WriteString(data, block.name);
+			WriteValue(data, block.binding);
+			WriteValue(data, block.size);
+			WriteValue(data, block.storage);
+		}
+
+		WriteValue(data, static_cast<uint32_t>(reflection.m_uniforms.size()));
+
+		for (auto &uniform : reflection.m_uniforms)
+		{
+			WriteString(data, uniform.name);
+			WriteValue(data, uniform.binding);
+			WriteValue(data, uniform.offset);
+			WriteValue(data, uniform.size);
+			WriteValue(data, uniform.glType);
+		}
+
+		WriteValue(data, static_cast<uint32_t>(reflection.m_attributes.size()));
+
+		for (auto &attribute : reflection.m_attributes)
+		{
+			WriteString(data, attribute.name);
+			WriteValue(data, attribute.location);
+			WriteValue(data, attribute.size);
+			WriteValue(data, attribute.glType);
+		}
+
+		WriteValue(data, static_cast<uint32_t>(spirv.size()));
+		const char *code = reinterpret_cast<const char *>(spirv.data());
+		data.insert(data.end(), code, code + (spirv.size() * sizeof(uint32_t)));
+
+		return CacheFile::Write(filename, data);
+	}
+
+	void ShaderCache::RecordPermutation(const std::string &filename, const std::vector<PipelineDefine> &defines)
+	{
+		std::string line = filename;
+
+		for (auto &define : defines)
+		{
+			line += "\t" + define.GetName() + "=" + define.GetValue();
+		}
+
+		std::string directory = GetDirectory();
+		std::string permutationsFile = GetPermutationsFile();
+		std::lock_guard<std::mutex> lock(MUTEX);
+
+		if (!PERMUTATIONS_LOADED)
+		{
+			auto fileLoaded = FileSystem::FileExists(permutationsFile) ? FileSystem::ReadTextFile(permutationsFile) : std::nullopt;
+
+			if (fileLoaded)
+			{
+				PERMUTATIONS = FormatString::Split(*fileLoaded, "\n");
+			}
+
+			PERMUTATIONS_LOADED = true;
+		}
+
+		if (std::find(PERMUTATIONS.begin(), PERMUTATIONS.end(), line) != PERMUTATIONS.end())
+		{
+			return;
+		}
+
+		PERMUTATIONS.emplace_back(line);
+
+		FileSystem::CreateFolder(directory);
+		FILE *file = fopen(permutationsFile.c_str(), "ab");
+
+		if (file != nullptr)
+		{
+			fprintf(file, "%s\n", line.c_str());
+			fclose(file);
+		}
+	}
+
+	std::vector<std::pair<std::string, std::vector<PipelineDefine>>> ShaderCache::ReadPermutations(const std::string &filename)
+	{
+		std::vector<std::pair<std::string, std::vector<PipelineDefine>>> result = {};
+		auto fileLoaded = FileSystem::ReadTextFile(filename);
+
+		if (!fileLoaded)
+		{
+			return result;
+		}
+
+		for (auto &line : FormatString::Split(*fileLoaded, "\n"))
+		{
+			auto parts = FormatString::Split(FormatString::Trim(line), "\t");
+
+			if (parts.empty() || parts[0].empty())
+			{
+				continue;
+			}
+
+			std::vector<PipelineDefine> defines = {};
+
+			for (size_t i = 1; i < parts.size(); i++)
+			{
+				size_t split = parts[i].find('=');
+
+				if (split != std::string::npos)
+				{
+					defines.emplace_back(PipelineDefine(parts[i].substr(0, split), parts[i].substr(split + 1)));
+				}
+			}
+
+			result.emplace_back(parts[0], defines);
+		}
+
+		return result;
+	}
+
+	std::string ShaderCache::GetPermutationsFile()
+	{
+		return GetDirectory() + "/Permutations.txt";
+	}
+
+	std::string ShaderCache::GetFilename(const std::string &shaderCode, const VkShaderStageFlags &stageFlag)
+	{
+		char extension[16];
+		snprintf(extension, sizeof(extension), "_%02x.spv", static_cast<uint32_t>(stageFlag));
+		return CACHE.GetFilename(shaderCode, extension);
+	}
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include "Helpers/CacheFile.hpp"
+#include "PipelineCreate.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// The reflection of a single compiled shader stage, stored next to the SPIR-V so cached stages never need glslang.
+	/// </summary>
+	class ACID_EXPORT ShaderReflection
+	{
+	public:
+		struct Block
+		{
+			std::string name;
+			int32_t binding;
+			int32_t size;
+			bool storage;
+		};
+
+		struct Uniform
+		{
+			std::string name;
+			int32_t binding;
+			int32_t offset;
+			int32_t size;
+			int32_t glType;
+		};
+
+		struct Attribute
+		{
+			std::string name;
+			int32_t location;
+			int32_t size;
+			int32_t glType;
+		};
+
+		std::vector<Block> m_blocks;
+		std::vector<Uniform> m_uniforms;
+		std::vector<Attribute> m_attributes;
+
+		ShaderReflection() :
+			m_blocks(std::vector<Block>()),
+			m_uniforms(std::vector<Uniform>()),
+			m_attributes(std::vector<Attribute>())
+		{
+		}
+	};
+
+	/// <summary>
+	/// A content addressed cache of compiled SPIR-V and reflection, keyed by the hash of the preprocessed shader source (with defines and includes) and the shader stage.
+	/// </summary>
+	class ACID_EXPORT ShaderCache
+	{
+	private:
+		static const uint32_t CACHE_MAGIC;
+		static const uint32_t CACHE_VERSION;
+
+		static CacheFile CACHE;
+		static std::mutex MUTEX;
+		static std::vector<std::string> PERMUTATIONS;
+		static bool PERMUTATIONS_LOADED;
+	public:
+		/// <summary>
+		/// Gets the directory cached shaders are stored in, defaults to 'Cache/Shaders' in the working directory.
+		/// </summary>
+		/// <returns> The cache directory. </returns>
+		static std::string GetDirectory();
+
+		/// <summary>
+		/// Sets the directory cached shaders are stored in.
+		/// </summary>
+		/// <param name="directory"> The new cache directory. </param>
+		static void SetDirectory(const std::string &directory);
+
+		/// <summary>
+		/// Builds the define block that is inserted into shader sources.
+		/// </summary>
+		/// <param name="defines"> The defines to insert. </param>
+		/// <returns> The define block. </returns>
+		static std::string GetDefineBlock(const std::vector<PipelineDefine> &defines);
+
+		/// <summary>
+		/// Loads a cached shader stage.
+		/// </summary>
+		/// <param name="shaderCode"> The preprocessed shader source. </param>
+		/// <param name="stageFlag"> The shader stage. </param>
+		/// <param name="spirv"> The loaded SPIR-V code. </param>
+		/// <param name="reflection"> The loaded stage reflection. </param>
+		/// <returns> If a valid cache entry was found. </returns>
+		static bool Load(const std::string &shaderCode, const VkShaderStageFlags &stageFlag, std::vector<uint32_t> &spirv, ShaderReflection &reflection);
+
+		/// <summary>
+		/// Saves a compiled shader stage to the cache.
+		/// </summary>
+		/// <param name="shaderCode"> The preprocessed shader source. </param>
+		/// <param name="stageFlag"> The shader stage. </param>
+		/// <param name="spirv"> The compiled SPIR-V code. </param>
+		/// <param name="reflection"> The stage reflection. </param>
+		/// <returns> If the entry was written. </returns>
+		static bool Save(const std::string &shaderCode, const VkShaderStageFlags &stageFlag, const std::vector<uint32_t> &spirv, const ShaderReflection &reflection);
+
+		/// <summary>
+		/// Records a shader permutation into the permutations manifest of the cache directory, used by the offline shader compiler.
+		/// </summary>
+		/// <param name="filename"> The shader stage file. </param>
+		/// <param name="defines"> The defines used by the permutation. </param>
+		static void RecordPermutation(const std::string &filename, const std::vector<PipelineDefine> &defines);
+
+		/// <summary>
+		/// Reads a permutations manifest, each line is a shader stage file followed by tab separated NAME=VALUE defines.
+		/// </summary>
+		/// <param name="filename"> The manifest file. </param>
+		/// <returns> The shader files and defines of each permutation. </returns>
+		static std::vector<std::pair<std::string, std::vector<PipelineDefine>>> ReadPermutations(const std::string &filename);
+
+		/// <summary>
+		/// Gets the filename of the permutations manifest in the cache directory.
+		/// </summary>
+		/// <returns> The manifest filename. </returns>
+		static std::string GetPermutationsFile();
+	private:
+		static std::string GetFilename(const std::string &shaderCode, const VkShaderStageFlags &stageFlag);
+	};
+}
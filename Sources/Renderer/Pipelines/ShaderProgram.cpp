@@ -4,6 +4,7 @@
 #include "Display/Display.hpp"
 #include "Helpers/FileSystem.hpp"
 #include "Helpers/FormatString.hpp"
+#include "Renderer/Buffers/StorageBuffer.hpp"
 #include "Renderer/Buffers/UniformBuffer.hpp"
 #include "Textures/Cubemap.hpp"
 #include "Textures/Texture.hpp"
@@ -14,6 +15,7 @@ namespace acid
 		m_name(name),
 		m_uniforms(std::vector<Uniform *>()),
 		m_uniformBlocks(std::vector<UniformBlock *>()),
+		m_storageBlocks(std::vector<UniformBlock *>()),
 		m_vertexAttributes(std::vector<VertexAttribute *>()),
 		m_descriptors(std::vector<DescriptorType>()),
 		m_attributeDescriptions(std::vector<VkVertexInputAttributeDescription>()),
@@ -33,6 +35,11 @@ namespace acid
 			delete uniformBlock;
 		}
 
+		for (auto &storageBlock : m_storageBlocks)
+		{
+			delete storageBlock;
+		}
+
 		for (auto &vertexAttribute : m_vertexAttributes)
 		{
 			delete vertexAttribute;
@@ -41,23 +48,27 @@ namespace acid
 
 	void ShaderProgram::LoadProgram(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag)
 	{
-		for (int i = program.getNumLiveUniformBlocks() - 1; i >= 0; i--)
+		LoadReflection(Reflect(program), stageFlag);
+	}
+
+	void ShaderProgram::LoadReflection(const ShaderReflection &reflection, const VkShaderStageFlags &stageFlag)
+	{
+		for (auto &block : reflection.m_blocks)
 		{
-			LoadUniformBlock(program, stageFlag, i);
+			LoadUniformBlock(block, stageFlag);
 		}
 
-		for (int i = 0; i < program.getNumLiveUniformVariables(); i++)
+		for (auto &uniform : reflection.m_uniforms)
 		{
-			LoadUniform(program, stageFlag, i);
+			LoadUniform(uniform, stageFlag);
 		}
 
-		for (int i = 0; i < program.getNumLiveAttributes(); i++)
+		for (auto &attribute : reflection.m_attributes)
 		{
-			LoadVertexAttribute(program, stageFlag, i);
+			LoadVertexAttribute(attribute, stageFlag);
 		}
 	}
 
-
 	bool ShaderProgram::ReportedNotFound(const std::string &name, const bool &reportIfFound)
 	{
 
@@ -90,6 +101,13 @@ namespace acid
 				return l->GetBinding() < r->GetBinding();
 			});
 
+		// Sort storage blocks by binding.
+		std::sort(m_storageBlocks.begin(), m_storageBlocks.end(),
+			[](UniformBlock *l, UniformBlock *r)
+			{
+				return l->GetBinding() < r->GetBinding();
+			});
+
 		// Sort uniform block uniforms by offsets.
 		for (auto &uniformBlock : m_uniformBlocks)
 		{
@@ -113,6 +131,11 @@ namespace acid
 			m_descriptors.emplace_back(UniformBuffer::CreateDescriptor(static_cast<uint32_t>(uniformBlock->GetBinding()), uniformBlock->GetStageFlags()));
 		}
 
+		for (auto &storageBlock : m_storageBlocks)
+		{
+			m_descriptors.emplace_back(StorageBuffer::CreateDescriptor(static_cast<uint32_t>(storageBlock->GetBinding()), storageBlock->GetStageFlags()));
+		}
+
 		for (auto &uniform : m_uniforms)
 		{
 			switch (uniform->GetGlType())
@@ -181,6 +204,14 @@ namespace acid
 			}
 		}
 
+		for (auto &storageBlock : m_storageBlocks)
+		{
+			if (storageBlock->GetName() == descriptor)
+			{
+				return storageBlock->GetBinding();
+			}
+		}
+
 		return -1;
 	}
 
@@ -389,9 +420,16 @@ namespace acid
 		return resources;
 	}
 
-	VkShaderModule ShaderProgram::ProcessShader(const std::string &shaderCode, const VkShaderStageFlags &stageFlag)
+	std::vector<uint32_t> ShaderProgram::CompileShader(const std::string &shaderCode, const VkShaderStageFlags &stageFlag)
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		std::vector<uint32_t> spirv = std::vector<uint32_t>();
+		ShaderReflection reflection = ShaderReflection();
+
+		if (ShaderCache::Load(shaderCode, stageFlag, spirv, reflection))
+		{
+			LoadReflection(reflection, stageFlag);
+			return spirv;
+		}
 
 		EShLanguage language = GetEshLanguage(stageFlag);
 
@@ -411,16 +449,14 @@ namespace acid
 		shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
 		shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
 
-	//	if (shader.preprocess(&resources, 100, ENoProfile, false, false, messages, &str, includer))
-	//	{
-	//		fprintf(stderr, "SPRIV shader preprocess failed!\n");
-	//	}
+		bool compiled = true;
 
 		if (!shader.parse(&resources, 100, false, messages))
 		{
 			fprintf(stdout, "%s\n", shader.getInfoLog());
 			fprintf(stdout, "%s\n", shader.getInfoDebugLog());
 			fprintf(stderr, "SPRIV shader compile failed!\n");
+			compiled = false;
 		}
 
 		program.addShader(&shader);
@@ -428,20 +464,35 @@ namespace acid
 		if (!program.link(messages) || !program.mapIO())
 		{
 			fprintf(stderr, "Error while linking shader program.\n");
+			compiled = false;
 		}
 
 		program.buildReflection();
-	//	program.dumpReflection();
-		LoadProgram(program, stageFlag);
+		reflection = Reflect(program);
+		LoadReflection(reflection, stageFlag);
 
 		glslang::SpvOptions spvOptions;
 		spvOptions.generateDebugInfo = true;
 		spvOptions.disableOptimizer = true;
 		spvOptions.optimizeSize = false;
 
-		std::vector<uint32_t> spirv = std::vector<uint32_t>();
 		glslang::GlslangToSpv(*program.getIntermediate(language), spirv, &spvOptions);
 
+		// Failed stages are never cached, so fixing the shader source is picked up on the next run.
+		if (compiled && !spirv.empty())
+		{
+			ShaderCache::Save(shaderCode, stageFlag, spirv, reflection);
+		}
+
+		return spirv;
+	}
+
+	VkShaderModule ShaderProgram::ProcessShader(const std::string &shaderCode, const VkShaderStageFlags &stageFlag)
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		std::vector<uint32_t> spirv = CompileShader(shaderCode, stageFlag);
+
 		VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
 		shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
 		shaderModuleCreateInfo.codeSize = spirv.size() * sizeof(uint32_t);
@@ -478,6 +529,19 @@ namespace acid
 		return nullptr;
 	}
 
+	UniformBlock *ShaderProgram::GetStorageBlock(const std::string &blockName)
+	{
+		for (auto &storageBlock : m_storageBlocks)
+		{
+			if (storageBlock->GetName() == blockName)
+			{
+				return storageBlock;
+			}
+		}
+
+		return nullptr;
+	}
+
 	VertexAttribute *ShaderProgram::GetVertexAttribute(const std::string &attributeName)
 	{
 		for (auto &attribute : m_vertexAttributes)
@@ -530,28 +594,69 @@ namespace acid
 			}
 		}
 
+		if (!m_storageBlocks.empty())
+		{
+			result << "Storage Blocks: \n";
+
+			for (auto &storageBlock : m_storageBlocks)
+			{
+				result << "  - " << storageBlock->ToString() << " \n";
+			}
+		}
+
 		return result.str();
 	}
 
-	void ShaderProgram::LoadUniformBlock(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag, const int &i)
+	ShaderReflection ShaderProgram::Reflect(const glslang::TProgram &program)
 	{
-		for (auto &uniformBlock : m_uniformBlocks)
+		ShaderReflection reflection = ShaderReflection();
+
+		for (int i = program.getNumLiveUniformBlocks() - 1; i >= 0; i--)
+		{
+			// Buffer blocks are reflected with the uniform blocks, the storage qualifier tells them apart.
+			auto blockType = program.getUniformBlockTType(i);
+			bool storage = blockType != nullptr && blockType->getQualifier().storage == glslang::EvqBuffer;
+			reflection.m_blocks.emplace_back(ShaderReflection::Block{program.getUniformBlockName(i), program.getUniformBlockBinding(i), program.getUniformBlockSize(i), storage});
+		}
+
+		for (int i = 0; i < program.getNumLiveUniformVariables(); i++)
 		{
-			if (uniformBlock->GetName() == program.getUniformBlockName(i))
+			int32_t size = program.getUniformBinding(i) == -1 ? static_cast<int32_t>(sizeof(float) * program.getUniformTType(i)->computeNumComponents()) : -1;
+			reflection.m_uniforms.emplace_back(ShaderReflection::Uniform{program.getUniformName(i), program.getUniformBinding(i), program.getUniformBufferOffset(i),
+				size, program.getUniformType(i)});
+		}
+
+		for (int i = 0; i < program.getNumLiveAttributes(); i++)
+		{
+			reflection.m_attributes.emplace_back(ShaderReflection::Attribute{program.getAttributeName(i), static_cast<int32_t>(program.getAttributeTType(i)->getQualifier().layoutLocation),
+				static_cast<int32_t>(sizeof(float) * program.getAttributeTType(i)->getVectorSize()), program.getAttributeType(i)});
+		}
+
+		return reflection;
+	}
+
+	void ShaderProgram::LoadUniformBlock(const ShaderReflection::Block &block, const VkShaderStageFlags &stageFlag)
+	{
+		// Storage blocks are kept apart, the index of a uniform block is the index of its dynamic offset.
+		auto &blocks = block.storage ? m_storageBlocks : m_uniformBlocks;
+
+		for (auto &uniformBlock : blocks)
+		{
+			if (uniformBlock->GetName() == block.name)
 			{
 				uniformBlock->SetStageFlags(uniformBlock->GetStageFlags() | stageFlag);
 				return;
 			}
 		}
 
-		m_uniformBlocks.emplace_back(new UniformBlock(program.getUniformBlockName(i), program.getUniformBlockBinding(i), program.getUniformBlockSize(i), stageFlag));
+		blocks.emplace_back(new UniformBlock(block.name, block.binding, block.size, stageFlag));
 	}
 
-	void ShaderProgram::LoadUniform(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag, const int &i)
+	void ShaderProgram::LoadUniform(const ShaderReflection::Uniform &uniform, const VkShaderStageFlags &stageFlag)
 	{
-		if (program.getUniformBinding(i) == -1)
+		if (uniform.binding == -1)
 		{
-			auto splitName = FormatString::Split(program.getUniformName(i), ".");
+			auto splitName = FormatString::Split(uniform.name, ".");
 
 			if (splitName.size() == 2)
 			{
@@ -559,37 +664,48 @@ namespace acid
 				{
 					if (uniformBlock->GetName() == splitName.at(0))
 					{
-						uniformBlock->AddUniform(new Uniform(splitName.at(1), program.getUniformBinding(i), program.getUniformBufferOffset(i),
-							sizeof(float) * program.getUniformTType(i)->computeNumComponents(), program.getUniformType(i), stageFlag));
+						uniformBlock->AddUniform(new Uniform(splitName.at(1), uniform.binding, uniform.offset, uniform.size, uniform.glType, stageFlag));
+						return;
+					}
+				}
+			}
+
+			// Storage block members may be nested in arrays of structs, they keep the rest of their name.
+			if (splitName.size() >= 2)
+			{
+				for (auto &storageBlock : m_storageBlocks)
+				{
+					if (storageBlock->GetName() == splitName.at(0))
+					{
+						storageBlock->AddUniform(new Uniform(uniform.name.substr(splitName.at(0).size() + 1), uniform.binding, uniform.offset, uniform.size, uniform.glType, stageFlag));
 						return;
 					}
 				}
 			}
 		}
 
-		for (auto &uniform : m_uniforms)
+		for (auto &u : m_uniforms)
 		{
-			if (uniform->GetName() == program.getUniformName(i))
+			if (u->GetName() == uniform.name)
 			{
-				uniform->SetStageFlags(uniform->GetStageFlags() | stageFlag);
+				u->SetStageFlags(u->GetStageFlags() | stageFlag);
 				return;
 			}
 		}
 
-		m_uniforms.emplace_back(new Uniform(program.getUniformName(i), program.getUniformBinding(i), program.getUniformBufferOffset(i), -1, program.getUniformType(i), stageFlag));
+		m_uniforms.emplace_back(new Uniform(uniform.name, uniform.binding, uniform.offset, -1, uniform.glType, stageFlag));
 	}
 
-	void ShaderProgram::LoadVertexAttribute(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag, const int &i)
+	void ShaderProgram::LoadVertexAttribute(const ShaderReflection::Attribute &attribute, const VkShaderStageFlags &stageFlag)
 	{
 		for (auto &vertexAttribute : m_vertexAttributes)
 		{
-			if (vertexAttribute->GetName() == program.getAttributeName(i))
+			if (vertexAttribute->GetName() == attribute.name)
 			{
 				return;
 			}
 		}
 
-		m_vertexAttributes.emplace_back(new VertexAttribute(program.getAttributeName(i), program.getAttributeTType(i)->getQualifier().layoutLocation,
-			sizeof(float) * program.getAttributeTType(i)->getVectorSize(), program.getAttributeType(i)));
+		m_vertexAttributes.emplace_back(new VertexAttribute(attribute.name, attribute.location, attribute.size, attribute.glType));
 	}
 }
@@ -7,6 +7,7 @@
 #include <SPIRV/GlslangToSpv.h>
 #include <vulkan/vulkan.h>
 #include "PipelineCreate.hpp"
+#include "ShaderCache.hpp"
 
 namespace acid
 {
@@ -177,6 +178,7 @@ namespace acid
 		std::string m_name;
 		std::vector<Uniform *> m_uniforms;
 		std::vector<UniformBlock *> m_uniformBlocks;
+		std::vector<UniformBlock *> m_storageBlocks;
 		std::vector<VertexAttribute *> m_vertexAttributes;
 
 		std::vector<DescriptorType> m_descriptors;
@@ -190,6 +192,13 @@ namespace acid
 
 		void LoadProgram(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag);
 
+		/// <summary>
+		/// Loads the uniforms, uniform blocks and vertex attributes of a single shader stage from its reflection.
+		/// </summary>
+		/// <param name="reflection"> The stage reflection. </param>
+		/// <param name="stageFlag"> The shader stage. </param>
+		void LoadReflection(const ShaderReflection &reflection, const VkShaderStageFlags &stageFlag);
+
 		std::string GetName() const { return m_name; }
 
 		bool ReportedNotFound(const std::string &name, const bool &reportIfFound);
@@ -204,6 +213,20 @@ namespace acid
 
 		UniformBlock *GetUniformBlock(const std::string &blockName);
 
+		/// <summary>
+		/// Gets the uniform blocks sorted by binding, this is the order their dynamic offsets are bound in.
+		/// </summary>
+		/// <returns> The uniform blocks. </returns>
+		const std::vector<UniformBlock *> &GetUniformBlocks() const { return m_uniformBlocks; }
+
+		UniformBlock *GetStorageBlock(const std::string &blockName);
+
+		/// <summary>
+		/// Gets the shader storage blocks sorted by binding, these are bound as <see cref="StorageBuffer"/> descriptors without dynamic offsets.
+		/// </summary>
+		/// <returns> The storage blocks. </returns>
+		const std::vector<UniformBlock *> &GetStorageBlocks() const { return m_storageBlocks; }
+
 		VertexAttribute *GetVertexAttribute(const std::string &attributeName);
 
 		std::vector<DescriptorType> GetDescriptors() const { return m_descriptors; }
@@ -218,15 +241,25 @@ namespace acid
 
 		static std::string ProcessIncludes(const std::string &shaderCode);
 
+		/// <summary>
+		/// Compiles a preprocessed shader stage into SPIR-V and loads its reflection, using the shader cache when a entry for the source exists.
+		/// </summary>
+		/// <param name="shaderCode"> The preprocessed shader source. </param>
+		/// <param name="stageFlag"> The shader stage. </param>
+		/// <returns> The SPIR-V code, empty if compiling failed. </returns>
+		std::vector<uint32_t> CompileShader(const std::string &shaderCode, const VkShaderStageFlags &stageFlag);
+
 		VkShaderModule ProcessShader(const std::string &shaderCode, const VkShaderStageFlags &stageFlag);
 
 		std::string ToString() const;
 
 	private:
-		void LoadUniformBlock(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag, const int &i);
+		static ShaderReflection Reflect(const glslang::TProgram &program);
+
+		void LoadUniformBlock(const ShaderReflection::Block &block, const VkShaderStageFlags &stageFlag);
 
-		void LoadUniform(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag, const int &i);
+		void LoadUniform(const ShaderReflection::Uniform &uniform, const VkShaderStageFlags &stageFlag);
 
-		void LoadVertexAttribute(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag, const int &i);
+		void LoadVertexAttribute(const ShaderReflection::Attribute &attribute, const VkShaderStageFlags &stageFlag);
 	};
 }
@@ -0,0 +1,103 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include "Helpers/RadixSort.hpp"
+
+namespace acid
+{
+	const uint32_t RenderQueue::ID_BITS = 12;
+	const uint32_t RenderQueue::DEPTH_BITS = 27;
+
+	RenderQueue::RenderQueue() :
+		m_items(std::vector<Item>()),
+		m_swap(std::vector<Item>()),
+		m_pipelineIds(std::unordered_map<const void *, uint32_t>()),
+		m_modelIds(std::unordered_map<const void *, uint32_t>()),
+		m_descriptorIds(std::unordered_map<const void *, uint32_t>()),
+		m_bound(std::array<const void *, 3>()),
+		m_binds(std::array<uint32_t, 3>()),
+		m_bindsSaved(std::array<uint32_t, 3>())
+	{
+		Clear();
+	}
+
+	RenderQueue::~RenderQueue()
+	{
+	}
+
+	void RenderQueue::Clear()
+	{
+		m_items.clear();
+		m_pipelineIds.clear();
+		m_modelIds.clear();
+		m_descriptorIds.clear();
+		m_bound.fill(nullptr);
+		m_binds.fill(0);
+		m_bindsSaved.fill(0);
+	}
+
+	void RenderQueue::Push(const void *pipeline, const void *model, const void *descriptors, const float &depth, const bool &transparent, const uint32_t &value)
+	{
+		uint64_t key = CreateKey(GetId(m_pipelineIds, pipeline), GetId(m_modelIds, model), GetId(m_descriptorIds, descriptors), depth, transparent);
+		m_items.emplace_back(Item{key, value});
+	}
+
+	void RenderQueue::Sort()
+	{
+		RadixSort::Sort(m_items, m_swap);
+	}
+
+	bool RenderQueue::Bind(const RenderBind &bind, const void *object)
+	{
+		if (m_bound[bind] == object)
+		{
+			m_bindsSaved[bind]++;
+			return false;
+		}
+
+		if (bind == RENDER_BIND_PIPELINE)
+		{
+			m_bound[RENDER_BIND_DESCRIPTOR] = nullptr;
+		}
+
+		m_bound[bind] = object;
+		m_binds[bind]++;
+		return true;
+	}
+
+	uint64_t RenderQueue::CreateKey(const uint32_t &pipelineId, const uint32_t &modelId, const uint32_t &descriptorId, const float &depth, const bool &transparent)
+	{
+		uint64_t idMask = (1u << ID_BITS) - 1;
+		uint64_t depthMask = (1u << DEPTH_BITS) - 1;
+
+		uint64_t quantizedDepth = RadixSort::QuantizeFloat(depth, DEPTH_BITS);
+
+		uint64_t pipeline = pipelineId & idMask;
+		uint64_t model = modelId & idMask;
+		uint64_t descriptor = descriptorId & idMask;
+
+		if (transparent)
+		{
+			// Transparent draws come last, the furthest first, state is only used to break ties.
+			return (1ull << 63) | ((depthMask - quantizedDepth) << (3 * ID_BITS)) | (pipeline << (2 * ID_BITS)) | (model << ID_BITS) | descriptor;
+		}
+
+		// Opaque draws are grouped by state first, model before descriptors since per object descriptors are rarely shared, then front to back.
+		return (pipeline << (DEPTH_BITS + (2 * ID_BITS))) | (model << (DEPTH_BITS + ID_BITS)) | (descriptor << DEPTH_BITS) | quantizedDepth;
+	}
+
+	uint32_t RenderQueue::GetId(std::unordered_map<const void *, uint32_t> &ids, const void *object)
+	{
+		auto it = ids.find(object);
+
+		if (it != ids.end())
+		{
+			return it->second;
+		}
+
+		// Ids past the key bits share the last id, those draws are still correct but not grouped.
+		uint32_t id = std::min(static_cast<uint32_t>(ids.size()), (1u << ID_BITS) - 1);
+		ids.emplace(object, id);
+		return id;
+	}
+}
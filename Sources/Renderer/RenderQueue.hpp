@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	enum RenderBind
+	{
+		RENDER_BIND_PIPELINE = 0,
+		RENDER_BIND_DESCRIPTOR = 1,
+		RENDER_BIND_VERTEX = 2
+	};
+
+	/// <summary>
+	/// A queue of draws ordered by a 64 bit key, used to group draws that share state and to skip binds of state that is already bound.
+	/// Opaque draws are grouped by pipeline, model and descriptors then ordered front to back, transparent draws are ordered back to front.
+	/// </summary>
+	class ACID_EXPORT RenderQueue
+	{
+	private:
+		struct Item
+		{
+			uint64_t key;
+			uint32_t value;
+		};
+
+		std::vector<Item> m_items;
+		std::vector<Item> m_swap;
+
+		std::unordered_map<const void *, uint32_t> m_pipelineIds;
+		std::unordered_map<const void *, uint32_t> m_modelIds;
+		std::unordered_map<const void *, uint32_t> m_descriptorIds;
+
+		std::array<const void *, 3> m_bound;
+		std::array<uint32_t, 3> m_binds;
+		std::array<uint32_t, 3> m_bindsSaved;
+	public:
+		static const uint32_t ID_BITS;
+		static const uint32_t DEPTH_BITS;
+
+		RenderQueue();
+
+		~RenderQueue();
+
+		/// <summary>
+		/// Removes all draws, and resets the bound state and bind counters.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Adds a draw to the queue.
+		/// </summary>
+		/// <param name="pipeline"> The pipeline the draw binds. </param>
+		/// <param name="model"> The model the draw binds. </param>
+		/// <param name="descriptors"> The descriptors the draw binds. </param>
+		/// <param name="depth"> The distance from the camera to the draw. </param>
+		/// <param name="transparent"> If the draw is blended, and must be drawn after opaque draws from back to front. </param>
+		/// <param name="value"> The value returned for this draw once the queue is sorted. </param>
+		void Push(const void *pipeline, const void *model, const void *descriptors, const float &depth, const bool &transparent, const uint32_t &value);
+
+		/// <summary>
+		/// Sorts the draws by their keys.
+		/// </summary>
+		void Sort();
+
+		uint32_t GetSize() const { return static_cast<uint32_t>(m_items.size()); }
+
+		uint64_t GetKey(const uint32_t &index) const { return m_items[index].key; }
+
+		uint32_t GetValue(const uint32_t &index) const { return m_items[index].value; }
+
+		/// <summary>
+		/// Marks a object as bound, a bind of the object that is already bound is counted as saved.
+		/// Binding a new pipeline also forgets the bound descriptors, since they may be disturbed by a incompatible layout.
+		/// </summary>
+		/// <param name="bind"> The type of state being bound. </param>
+		/// <param name="object"> The object being bound. </param>
+		/// <returns> If the object must be bound. </returns>
+		bool Bind(const RenderBind &bind, const void *object);
+
+		uint32_t GetBindCount(const RenderBind &bind) const { return m_binds[bind]; }
+
+		uint32_t GetSavedBindCount(const RenderBind &bind) const { return m_bindsSaved[bind]; }
+
+		/// <summary>
+		/// Creates the sort key for a draw.
+		/// </summary>
+		/// <param name="pipelineId"> The pipeline id, clamped to the id bits. </param>
+		/// <param name="modelId"> The model id, clamped to the id bits. </param>
+		/// <param name="descriptorId"> The descriptors id, clamped to the id bits. </param>
+		/// <param name="depth"> The distance from the camera. </param>
+		/// <param name="transparent"> If the draw is blended. </param>
+		/// <returns> The sort key. </returns>
+		static uint64_t CreateKey(const uint32_t &pipelineId, const uint32_t &modelId, const uint32_t &descriptorId, const float &depth, const bool &transparent);
+	private:
+		static uint32_t GetId(std::unordered_map<const void *, uint32_t> &ids, const void *object);
+	};
+}
@@ -1,26 +1,41 @@
 #include "Renderer.hpp"
 
 #include "Helpers/FileSystem.hpp"
+#include "Memory/Uploader.hpp"
 #include "Scenes/Scenes.hpp"
+#include "Threads/ThreadPool.hpp"
 #include "IRenderer.hpp"
 
 namespace acid
 {
+	const uint32_t Renderer::MAX_FRAMES_IN_FLIGHT = 2;
+
 	Renderer::Renderer() :
 		IModule(),
 		m_managerRender(nullptr),
 		m_renderStages(std::vector<RenderStage *>()),
 		m_swapchain(nullptr),
-		m_fenceSwapchainImage(VK_NULL_HANDLE),
 		m_activeSwapchainImage(UINT32_MAX),
-		m_pipelineCache(VK_NULL_HANDLE),
-		m_semaphore(VK_NULL_HANDLE),
+		m_pipelineCache(nullptr),
+		m_uniformRing(nullptr),
+		m_presentCompletes(std::vector<VkSemaphore>(MAX_FRAMES_IN_FLIGHT)),
+		m_renderCompletes(std::vector<VkSemaphore>(MAX_FRAMES_IN_FLIGHT)),
+		m_flightFences(std::vector<VkFence>(MAX_FRAMES_IN_FLIGHT)),
+		m_currentFrame(0),
 		m_commandPool(VK_NULL_HANDLE),
-		m_commandBuffer(nullptr)
+		m_commandBuffers(std::vector<CommandBuffer *>()),
+		m_secondaryPools(std::vector<CommandPool *>()),
+		m_destroyMutex(),
+		m_pendingDestroys(std::vector<std::function<void()>>()),
+		m_frameDestroys(std::vector<std::vector<std::function<void()>>>(MAX_FRAMES_IN_FLIGHT)),
+		m_frameUploads(std::vector<uint64_t>(MAX_FRAMES_IN_FLIGHT, 0)),
+		m_destroying(false)
 	{
 		CreateFences();
 		CreateCommandPool();
 		CreatePipelineCache();
+
+		m_uniformRing = new UniformRing();
 	}
 
 	Renderer::~Renderer()
@@ -30,6 +45,10 @@ namespace acid
 
 		Display::CheckVk(vkQueueWaitIdle(graphicsQueue));
 
+		// Nothing is in flight anymore, so objects freed from here on are destroyed immediately.
+		DestroyQueued();
+		m_destroying = true;
+
 		delete m_managerRender;
 
 		for (auto &renderStage : m_renderStages)
@@ -38,15 +57,44 @@ namespace acid
 		}
 
 		delete m_swapchain;
-		delete m_commandBuffer;
 
-		vkDestroyPipelineCache(logicalDevice, m_pipelineCache, nullptr);
+		for (auto &commandBuffer : m_commandBuffers)
+		{
+			delete commandBuffer;
+		}
+
+		for (auto &secondaryPool : m_secondaryPools)
+		{
+			delete secondaryPool;
+		}
+
+		delete m_pipelineCache;
+		delete m_uniformRing;
+
+		for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		{
+			vkDestroyFence(logicalDevice, m_flightFences[i], nullptr);
+			vkDestroySemaphore(logicalDevice, m_presentCompletes[i], nullptr);
+			vkDestroySemaphore(logicalDevice, m_renderCompletes[i], nullptr);
+		}
 
-		vkDestroyFence(logicalDevice, m_fenceSwapchainImage, nullptr);
-		vkDestroySemaphore(logicalDevice, m_semaphore, nullptr);
 		vkDestroyCommandPool(logicalDevice, m_commandPool, nullptr);
 	}
 
+	void Renderer::DeferDestroy(const std::function<void()> &destroy)
+	{
+		auto renderer = Engine::Get() != nullptr ? Get() : nullptr;
+
+		if (renderer == nullptr || renderer->m_destroying)
+		{
+			destroy();
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(renderer->m_destroyMutex);
+		renderer->m_pendingDestroys.emplace_back(destroy);
+	}
+
 	void Renderer::Update()
 	{
 		if (Display::Get()->IsIconified())
@@ -54,10 +102,25 @@ namespace acid
 			return;
 		}
 
+		BeginFrame();
+
+		m_pipelineCache->Update();
 		m_managerRender->Update();
 
 		auto camera = Scenes::Get()->GetCamera();
 		auto stages = m_managerRender->GetStages();
+
+		// Dispatches can not be recorded inside a render pass, so compute work is recorded before the first stage starts.
+		for (auto &[key, renderers] : stages)
+		{
+			for (auto &renderer : renderers)
+			{
+				if (renderer->IsEnabled())
+				{
+					renderer->Dispatch(*GetCommandBuffer());
+				}
+			}
+		}
 		Vector4 clipPlane = Vector4(0.0f, 1.0f, 0.0f, +std::numeric_limits<float>::infinity());
 
 		for (uint32_t stage = 0; stage < m_renderStages.size(); stage++)
@@ -80,15 +143,17 @@ namespace acid
 
 				if (renderers != stages.end())
 				{
+					std::vector<IRenderer *> enabled = {};
+
 					for (auto &renderer : (*renderers).second)
 					{
-						if (!renderer->IsEnabled())
+						if (renderer->IsEnabled())
 						{
-							continue;
+							enabled.emplace_back(renderer.get());
 						}
-
-						renderer->Render(*m_commandBuffer, clipPlane, *camera);
 					}
+
+					RecordSubpass(stage, subpass, enabled, clipPlane, *camera);
 				}
 
 				if (subpass != subpassCount - 1)
@@ -147,7 +212,7 @@ namespace acid
 
 		VkImage srcImage = Renderer::Get()->GetSwapchain()->GetImages().at(Renderer::Get()->GetActiveSwapchainImage());
 		VkImage dstImage;
-		VkDeviceMemory dstImageMemory;
+		MemoryAllocation dstImageMemory;
 		bool supportsBlit = Texture::CopyImage(srcImage, dstImage, dstImageMemory, width, height, 1, true);
 
 		// Get layout of the image (including row pitch).
@@ -160,10 +225,8 @@ namespace acid
 		// Creates the screenshot image file.
 		FileSystem::CreateFile(filename);
 
-		// Map image memory so we can start copying from it.
-		char *data;
-		vkMapMemory(logicalDevice, dstImageMemory, 0, VK_WHOLE_SIZE, 0, (void **) &data);
-		data += subResourceLayout.offset;
+		// The image memory is already mapped, so we can start copying from it.
+		char *data = static_cast<char *>(dstImageMemory.GetMapped()) + subResourceLayout.offset;
 
 		// If source is BGR (destination is always RGB) and we can't use blit (which does automatic conversion), we'll have to manually swizzle color components
 		bool colourSwizzle = false;
@@ -181,9 +244,8 @@ namespace acid
 		Texture::WritePixels(filename, data, width, height, 4);
 
 		// Clean up resources.
-		vkUnmapMemory(logicalDevice, dstImageMemory);
-		vkFreeMemory(logicalDevice, dstImageMemory, nullptr);
 		vkDestroyImage(logicalDevice, dstImage, nullptr);
+		MemoryAllocator::Get()->Free(dstImageMemory);
 
 #if ACID_VERBOSE
 		float debugEnd = Engine::Get()->GetTimeMs();
@@ -201,19 +263,50 @@ namespace acid
 	{
 		auto logicalDevice = Display::Get()->GetLogicalDevice();
 
+		VkSemaphoreCreateInfo semaphoreCreateInfo = {};
+		semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		// Fences start signaled so the first wait on each frame returns immediately.
 		VkFenceCreateInfo fenceCreateInfo = {};
 		fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-		vkCreateFence(logicalDevice, &fenceCreateInfo, nullptr, &m_fenceSwapchainImage);
+		fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		{
+			Display::CheckVk(vkCreateSemaphore(logicalDevice, &semaphoreCreateInfo, nullptr, &m_presentCompletes[i]));
+			Display::CheckVk(vkCreateSemaphore(logicalDevice, &semaphoreCreateInfo, nullptr, &m_renderCompletes[i]));
+			Display::CheckVk(vkCreateFence(logicalDevice, &fenceCreateInfo, nullptr, &m_flightFences[i]));
+		}
 	}
 
-	void Renderer::CreateCommandPool()
+	void Renderer::BeginFrame()
 	{
 		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		auto commandBuffer = GetCommandBuffer();
 
-		VkSemaphoreCreateInfo semaphoreCreateInfo = {};
-		semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		// Waits until the GPU is done with the command buffer and uniforms of this frame.
+		Display::CheckVk(vkWaitForFences(logicalDevice, 1, &m_flightFences[m_currentFrame], VK_TRUE, UINT64_MAX));
+		Uploader::Get()->Wait(m_frameUploads[m_currentFrame]);
+		DestroyFrame(m_currentFrame);
+		m_uniformRing->BeginFrame(m_currentFrame);
+
+		for (uint32_t i = 0; i < ThreadPool::Get()->GetThreadCount(); i++)
+		{
+			m_secondaryPools[(m_currentFrame * ThreadPool::Get()->GetThreadCount()) + i]->Reset();
+		}
+
+		// A frame abandoned by a swapchain recreation is discarded before recording again.
+		if (commandBuffer->IsRunning())
+		{
+			commandBuffer->End();
+		}
 
-		Display::CheckVk(vkCreateSemaphore(logicalDevice, &semaphoreCreateInfo, nullptr, &m_semaphore));
+		commandBuffer->Begin();
+	}
+
+	void Renderer::CreateCommandPool()
+	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
 
 		VkCommandPoolCreateInfo commandPoolCreateInfo = {};
 		commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -222,17 +315,22 @@ namespace acid
 
 		Display::CheckVk(vkCreateCommandPool(logicalDevice, &commandPoolCreateInfo, nullptr, &m_commandPool));
 
-		m_commandBuffer = new CommandBuffer(false);
+		for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		{
+			m_commandBuffers.emplace_back(new CommandBuffer(false));
+
+			// Every job thread records secondaries from its own pool, as command pools are externally synchronized.
+			for (uint32_t j = 0; j < ThreadPool::Get()->GetThreadCount(); j++)
+			{
+				m_secondaryPools.emplace_back(new CommandPool());
+			}
+		}
 	}
 
 	void Renderer::CreatePipelineCache()
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
-
-		VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {};
-		pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-
-		Display::CheckVk(vkCreatePipelineCache(logicalDevice, &pipelineCacheCreateInfo, nullptr, &m_pipelineCache));
+		m_pipelineCache = new PipelineCache(FileSystem::GetWorkingDirectory() + "/Cache");
+		m_pipelineCache->SetSaveInterval(60.0f);
 	}
 
 	void Renderer::RecreatePass(const uint32_t &i)
@@ -269,13 +367,11 @@ namespace acid
 		}
 
 		auto logicalDevice = Display::Get()->GetLogicalDevice();
-		auto graphicsQueue = Display::Get()->GetGraphicsQueue();
-
-		Display::CheckVk(vkQueueWaitIdle(graphicsQueue));
+		auto commandBuffer = GetCommandBuffer();
 
 		if (renderStage->HasSwapchain())
 		{
-			const VkResult acquireResult = vkAcquireNextImageKHR(logicalDevice, *m_swapchain->GetSwapchain(), UINT64_MAX, VK_NULL_HANDLE, m_fenceSwapchainImage, &m_activeSwapchainImage);
+			const VkResult acquireResult = vkAcquireNextImageKHR(logicalDevice, *m_swapchain->GetSwapchain(), UINT64_MAX, m_presentCompletes[m_currentFrame], VK_NULL_HANDLE, &m_activeSwapchainImage);
 
 			if (acquireResult == VK_ERROR_OUT_OF_DATE_KHR)
 			{
@@ -287,15 +383,6 @@ namespace acid
 			{
 				throw std::runtime_error("Renderer failed to acquire swapchain image!");
 			}
-
-			Display::CheckVk(vkWaitForFences(logicalDevice, 1, &m_fenceSwapchainImage, VK_TRUE, UINT64_MAX));
-
-			Display::CheckVk(vkResetFences(logicalDevice, 1, &m_fenceSwapchainImage));
-		}
-
-		if (!m_commandBuffer->IsRunning())
-		{
-			m_commandBuffer->Begin(VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
 		}
 
 		VkRect2D renderArea = {};
@@ -312,45 +399,42 @@ namespace acid
 		renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(renderStage->GetClearValues().size());
 		renderPassBeginInfo.pClearValues = renderStage->GetClearValues().data();
 
-		vkCmdBeginRenderPass(m_commandBuffer->GetCommandBuffer(), &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-		VkViewport viewport = {};
-		viewport.x = 0.0f;
-		viewport.y = 0.0f;
-		viewport.width = static_cast<float>(renderStage->GetWidth());
-		viewport.height = static_cast<float>(renderStage->GetHeight());
-		viewport.minDepth = 0.0f;
-		viewport.maxDepth = 1.0f;
-		vkCmdSetViewport(m_commandBuffer->GetCommandBuffer(), 0, 1, &viewport);
-
-		VkRect2D scissor = {};
-		scissor.offset.x = 0;
-		scissor.offset.y = 0;
-		scissor.extent.width = renderStage->GetWidth();
-		scissor.extent.height = renderStage->GetHeight();
-		vkCmdSetScissor(m_commandBuffer->GetCommandBuffer(), 0, 1, &scissor);
-
+		vkCmdBeginRenderPass(commandBuffer->GetCommandBuffer(), &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 		return true;
 	}
 
 	void Renderer::EndRenderpass(const uint32_t &i)
 	{
+		auto logicalDevice = Display::Get()->GetLogicalDevice();
 		auto renderStage = GetRenderStage(i);
 		auto presentQueue = Display::Get()->GetPresentQueue();
+		auto commandBuffer = GetCommandBuffer();
 
-		vkCmdEndRenderPass(m_commandBuffer->GetCommandBuffer());
+		vkCmdEndRenderPass(commandBuffer->GetCommandBuffer());
 
 		if (!renderStage->HasSwapchain())
 		{
 			return;
 		}
 
-		m_commandBuffer->End();
-		m_commandBuffer->Submit(false, m_semaphore);
+		commandBuffer->End();
+
+		// Objects freed before this submit are destroyed after this frames fence, the earlier frames fences have been waited on by then.
+		// They are taken before the uploads are flushed, so every copy recorded into them is in the flushed batch or an earlier one.
+		{
+			std::lock_guard<std::mutex> lock(m_destroyMutex);
+			auto &frameDestroys = m_frameDestroys[m_currentFrame];
+			frameDestroys.insert(frameDestroys.end(), m_pendingDestroys.begin(), m_pendingDestroys.end());
+			m_pendingDestroys.clear();
+		}
 
-	//	Display::CheckVk(vkQueueWaitIdle(graphicsQueue));
+		// Uploads recorded while this frame was built are submitted first, so the frame sees them in queue order.
+		m_frameUploads[m_currentFrame] = Uploader::Get()->Flush();
 
-		std::vector<VkSemaphore> waitSemaphores = {m_semaphore};
+		Display::CheckVk(vkResetFences(logicalDevice, 1, &m_flightFences[m_currentFrame]));
+		commandBuffer->Submit(m_presentCompletes[m_currentFrame], m_renderCompletes[m_currentFrame], m_flightFences[m_currentFrame]);
+
+		std::vector<VkSemaphore> waitSemaphores = {m_renderCompletes[m_currentFrame]};
 
 		VkResult presentResult = VK_RESULT_MAX_ENUM;
 
@@ -364,6 +448,7 @@ namespace acid
 		presentInfo.pResults = &presentResult;
 
 		const VkResult queuePresentResult = vkQueuePresentKHR(presentQueue, &presentInfo);
+		m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 
 		if (queuePresentResult == VK_ERROR_OUT_OF_DATE_KHR || queuePresentResult == VK_SUBOPTIMAL_KHR)
 		{
@@ -372,11 +457,108 @@ namespace acid
 		}
 
 		Display::CheckVk(presentResult);
-		Display::CheckVk(vkQueueWaitIdle(presentQueue));
+	}
+
+	void Renderer::RecordSubpass(const uint32_t &i, const uint32_t &subpass, const std::vector<IRenderer *> &renderers, const Vector4 &clipPlane, const ICamera &camera)
+	{
+		if (renderers.empty())
+		{
+			return;
+		}
+
+		auto renderStage = GetRenderStage(i);
+		auto renderpass = renderStage->GetRenderpass()->GetRenderpass();
+		auto framebuffer = renderStage->GetActiveFramebuffer(m_activeSwapchainImage);
+
+		VkViewport viewport = {};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = static_cast<float>(renderStage->GetWidth());
+		viewport.height = static_cast<float>(renderStage->GetHeight());
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+
+		VkRect2D scissor = {};
+		scissor.offset.x = 0;
+		scissor.offset.y = 0;
+		scissor.extent.width = renderStage->GetWidth();
+		scissor.extent.height = renderStage->GetHeight();
+
+		// Each renderer records into its own secondary command buffer on a job thread.
+		std::vector<VkCommandBuffer> secondaries(renderers.size());
+
+		auto handle = ThreadPool::Get()->ParallelFor(0, static_cast<uint32_t>(renderers.size()), [&](uint32_t begin, uint32_t end)
+		{
+			auto secondaryPool = GetSecondaryPool();
+
+			for (uint32_t j = begin; j < end; j++)
+			{
+				auto secondary = secondaryPool->GetSecondary();
+				secondary->BeginSecondary(renderpass, subpass, framebuffer);
+				vkCmdSetViewport(secondary->GetCommandBuffer(), 0, 1, &viewport);
+				vkCmdSetScissor(secondary->GetCommandBuffer(), 0, 1, &scissor);
+				renderers[j]->Render(*secondary, clipPlane, camera);
+				secondary->End();
+				secondaries[j] = secondary->GetCommandBuffer();
+			}
+		}, 1);
+		ThreadPool::Get()->Wait(handle);
+
+		// Secondaries are executed in renderer order, so draw order is the same as when recording inline.
+		vkCmdExecuteCommands(GetCommandBuffer()->GetCommandBuffer(), static_cast<uint32_t>(secondaries.size()), secondaries.data());
+	}
+
+	CommandPool *Renderer::GetSecondaryPool() const
+	{
+		uint32_t threadCount = ThreadPool::Get()->GetThreadCount();
+		int32_t threadIndex = ThreadPool::Get()->GetThreadIndex();
+
+		if (threadIndex == -1)
+		{
+			throw std::runtime_error("Secondary command pools can only be used from job threads!");
+		}
+
+		return m_secondaryPools[(m_currentFrame * threadCount) + static_cast<uint32_t>(threadIndex)];
+	}
+
+	void Renderer::DestroyQueued()
+	{
+		for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		{
+			DestroyFrame(i);
+		}
+
+		auto pendingDestroys = std::vector<std::function<void()>>();
+
+		{
+			std::lock_guard<std::mutex> lock(m_destroyMutex);
+			pendingDestroys.swap(m_pendingDestroys);
+		}
+
+		for (auto &destroy : pendingDestroys)
+		{
+			destroy();
+		}
+	}
+
+	void Renderer::DestroyFrame(const uint32_t &frame)
+	{
+		auto frameDestroys = std::vector<std::function<void()>>();
+
+		{
+			std::lock_guard<std::mutex> lock(m_destroyMutex);
+			frameDestroys.swap(m_frameDestroys[frame]);
+		}
+
+		// Destroying may free more objects, so the lock is not held while destroying.
+		for (auto &destroy : frameDestroys)
+		{
+			destroy();
+		}
 	}
 
 	void Renderer::NextSubpass()
 	{
-		vkCmdNextSubpass(m_commandBuffer->GetCommandBuffer(), VK_SUBPASS_CONTENTS_INLINE);
+		vkCmdNextSubpass(GetCommandBuffer()->GetCommandBuffer(), VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 	}
 }
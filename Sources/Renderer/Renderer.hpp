@@ -1,8 +1,14 @@
 #pragma once
 
+#include <functional>
+#include <mutex>
 #include <vulkan/vulkan.h>
 #include "Renderer/Commands/CommandBuffer.hpp"
+#include "Renderer/Commands/CommandPool.hpp"
 #include "Engine/Engine.hpp"
+#include "Maths/Vector4.hpp"
+#include "Buffers/UniformRing.hpp"
+#include "Pipelines/PipelineCache.hpp"
 #include "Swapchain/DepthStencil.hpp"
 #include "Swapchain/Swapchain.hpp"
 #include "IManagerRender.hpp"
@@ -10,6 +16,9 @@
 
 namespace acid
 {
+	class ICamera;
+	class IRenderer;
+
 	class ACID_EXPORT Renderer :
 		public IModule
 	{
@@ -19,16 +28,32 @@ namespace acid
 		std::vector<RenderStage *> m_renderStages;
 
 		Swapchain *m_swapchain;
-		VkFence m_fenceSwapchainImage;
 		uint32_t m_activeSwapchainImage;
 
-		VkPipelineCache m_pipelineCache;
+		PipelineCache *m_pipelineCache;
+		UniformRing *m_uniformRing;
+
+		std::vector<VkSemaphore> m_presentCompletes;
+		std::vector<VkSemaphore> m_renderCompletes;
+		std::vector<VkFence> m_flightFences;
+		uint32_t m_currentFrame;
 
-		VkSemaphore m_semaphore;
 		VkCommandPool m_commandPool;
 
-		CommandBuffer *m_commandBuffer;
+		std::vector<CommandBuffer *> m_commandBuffers;
+		std::vector<CommandPool *> m_secondaryPools;
+
+		std::mutex m_destroyMutex;
+		std::vector<std::function<void()>> m_pendingDestroys;
+		std::vector<std::vector<std::function<void()>>> m_frameDestroys;
+		std::vector<uint64_t> m_frameUploads;
+		bool m_destroying;
 	public:
+		/// <summary>
+		/// The number of frames the CPU can record ahead of the GPU.
+		/// </summary>
+		static const uint32_t MAX_FRAMES_IN_FLIGHT;
+
 		/// <summary>
 		/// Gets this engine instance.
 		/// </summary>
@@ -38,6 +63,15 @@ namespace acid
 			return Engine::Get()->GetModule<Renderer>();
 		}
 
+		/// <summary>
+		/// Queues the destruction of Vulkan objects that frames in flight may still be using.
+		/// The objects are destroyed once the next submitted frame, and every frame before it, has finished on the GPU,
+		/// along with every upload batch submitted with that frame, so pending copies into the objects stay valid.
+		/// Without a renderer the objects are destroyed immediately.
+		/// </summary>
+		/// <param name="destroy"> The function that destroys the objects. </param>
+		static void DeferDestroy(const std::function<void()> &destroy);
+
 		/// <summary>
 		/// Creates a new renderer module.
 		/// </summary>
@@ -78,14 +112,43 @@ namespace acid
 
 		VkCommandPool GetCommandPool() const { return m_commandPool; }
 
-		CommandBuffer *GetCommandBuffer() const { return m_commandBuffer; }
+		CommandBuffer *GetCommandBuffer() const { return m_commandBuffers.at(m_currentFrame); }
+
+		/// <summary>
+		/// Gets the index of the frame being recorded, resources written by the CPU every frame should be duplicated per frame in flight.
+		/// </summary>
+		/// <returns> The current frame index, less than <see cref="MAX_FRAMES_IN_FLIGHT"/>. </returns>
+		uint32_t GetCurrentFrame() const { return m_currentFrame; }
+
+		/// <summary>
+		/// Gets the secondary command pool owned by the calling job thread for the current frame.
+		/// </summary>
+		/// <returns> The secondary command pool. </returns>
+		CommandPool *GetSecondaryPool() const;
+
+		/// <summary>
+		/// Destroys every queued object immediately, this must only be called once the device is idle.
+		/// </summary>
+		void DestroyQueued();
 
 		uint32_t GetActiveSwapchainImage() const { return m_activeSwapchainImage; }
 
-		VkPipelineCache GetPipelineCache() const { return m_pipelineCache; }
+		VkPipelineCache GetPipelineCache() const { return m_pipelineCache->GetPipelineCache(); }
+
+		UniformRing *GetUniformRing() const { return m_uniformRing; }
+
+		/// <summary>
+		/// Sets how often the pipeline cache is written to disk while running, it is always written on shutdown.
+		/// </summary>
+		/// <param name="interval"> The interval in seconds, a value less or equal to zero disables periodic saves. </param>
+		void SetPipelineCacheInterval(const float &interval) { m_pipelineCache->SetSaveInterval(interval); }
 	private:
 		void CreateFences();
 
+		void BeginFrame();
+
+		void DestroyFrame(const uint32_t &frame);
+
 		void CreateCommandPool();
 
 		void CreatePipelineCache();
@@ -96,6 +159,8 @@ namespace acid
 
 		void EndRenderpass(const uint32_t &i);
 
+		void RecordSubpass(const uint32_t &i, const uint32_t &subpass, const std::vector<IRenderer *> &renderers, const Vector4 &clipPlane, const ICamera &camera);
+
 		void NextSubpass();
 	};
 }
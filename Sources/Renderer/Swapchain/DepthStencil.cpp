@@ -19,6 +19,7 @@ namespace acid
 		m_width(width),
 		m_height(height),
 		m_image(VK_NULL_HANDLE),
+		m_imageMemory(MemoryAllocation()),
 		m_imageView(VK_NULL_HANDLE),
 		m_sampler(VK_NULL_HANDLE),
 		m_format(VK_FORMAT_UNDEFINED),
@@ -52,7 +53,7 @@ namespace acid
 			throw std::runtime_error("Vulkan runtime error, depth stencil format not selected!");
 		}
 
-		Texture::CreateImage(m_image, m_bufferMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, samples, 1, m_format, VK_IMAGE_TILING_OPTIMAL,
+		Texture::CreateImage(m_image, m_imageMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, samples, 1, m_format, VK_IMAGE_TILING_OPTIMAL,
 			VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 1);
 		Texture::CreateImageSampler(m_sampler, true, false, false, 1);
 		Texture::CreateImageView(m_image, m_imageView, VK_IMAGE_VIEW_TYPE_2D, m_format, VK_IMAGE_ASPECT_DEPTH_BIT, 1, 1);
@@ -69,6 +70,7 @@ namespace acid
 		vkDestroySampler(logicalDevice, m_sampler, nullptr);
 		vkDestroyImageView(logicalDevice, m_imageView, nullptr);
 		vkDestroyImage(logicalDevice, m_image, nullptr);
+		MemoryAllocator::Get()->Free(m_imageMemory);
 	}
 
 	DescriptorType DepthStencil::CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage)
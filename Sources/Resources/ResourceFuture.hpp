@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include "Threads/Job.hpp"
+#include "IResource.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// The shared state of a asynchronous resource load.
+	/// </summary>
+	class ACID_EXPORT ResourceLoad
+	{
+	private:
+		friend class Resources;
+
+		std::string m_filename;
+		std::shared_ptr<IResource> m_resource;
+		std::function<void()> m_upload;
+		JobHandle m_job;
+		std::atomic<bool> m_loaded;
+	public:
+		explicit ResourceLoad(const std::string &filename) :
+			m_filename(filename),
+			m_resource(nullptr),
+			m_upload(nullptr),
+			m_job(JobHandle()),
+			m_loaded(false)
+		{
+		}
+
+		std::string GetFilename() const { return m_filename; }
+
+		/// <summary>
+		/// Gets if the resource has been decoded and uploaded.
+		/// </summary>
+		/// <returns> If the load is complete. </returns>
+		bool IsLoaded() const { return m_loaded.load(std::memory_order_acquire); }
+
+		/// <summary>
+		/// Gets the loaded resource.
+		/// </summary>
+		/// <returns> The resource, or null if the load is not complete or has failed. </returns>
+		std::shared_ptr<IResource> GetResource() const { return IsLoaded() ? m_resource : nullptr; }
+
+		/// <summary>
+		/// Blocks until the load is complete, when called from the main thread pending uploads are processed while waiting.
+		/// </summary>
+		void Wait();
+	};
+
+	/// <summary>
+	/// A future like handle to a resource being loaded on the thread pool.
+	/// </summary>
+	/// <param name="T"> The resource type. </param>
+	template<typename T>
+	class ResourceFuture
+	{
+	private:
+		std::shared_ptr<ResourceLoad> m_load;
+	public:
+		ResourceFuture() :
+			m_load(nullptr)
+		{
+		}
+
+		explicit ResourceFuture(const std::shared_ptr<ResourceLoad> &load) :
+			m_load(load)
+		{
+		}
+
+		/// <summary>
+		/// Gets if the resource has been loaded, a empty future is always loaded.
+		/// </summary>
+		/// <returns> If the resource is loaded. </returns>
+		bool IsLoaded() const { return m_load == nullptr || m_load->IsLoaded(); }
+
+		/// <summary>
+		/// Gets the resource without blocking.
+		/// </summary>
+		/// <returns> The resource, or null while it is still loading. </returns>
+		std::shared_ptr<T> Get() const
+		{
+			if (m_load == nullptr)
+			{
+				return nullptr;
+			}
+
+			return std::dynamic_pointer_cast<T>(m_load->GetResource());
+		}
+
+		/// <summary>
+		/// Blocks until the resource is loaded.
+		/// </summary>
+		/// <returns> The resource, or null if loading failed. </returns>
+		std::shared_ptr<T> Wait() const
+		{
+			if (m_load == nullptr)
+			{
+				return nullptr;
+			}
+
+			m_load->Wait();
+			return Get();
+		}
+	};
+}
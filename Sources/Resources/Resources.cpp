@@ -1,30 +1,53 @@
 #include "Resources.hpp"
 
-#include <algorithm>
-
 namespace acid
 {
 	Resources::Resources() :
-		m_resources(std::vector<std::shared_ptr<IResource>>()),
+		m_resources(std::unordered_map<std::string, std::shared_ptr<IResource>>()),
+		m_loading(std::unordered_map<std::string, std::shared_ptr<ResourceLoad>>()),
+		m_mutex(),
+		m_uploads(std::deque<std::shared_ptr<ResourceLoad>>()),
+		m_uploadMutex(),
+		m_uploadBudget(4.0f),
+		m_mainThread(std::this_thread::get_id()),
 		m_timerPurge(Timer(5.0f))
 	{
 	}
 
 	Resources::~Resources()
 	{
+		std::vector<std::shared_ptr<ResourceLoad>> loading = {};
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			for (auto &[filename, load] : m_loading)
+			{
+				loading.emplace_back(load);
+			}
+		}
+
+		// Decode jobs reference this module, so they must finish before it is destroyed.
+		for (auto &load : loading)
+		{
+			ThreadPool::Get()->Wait(load->m_job);
+		}
 	}
 
 	void Resources::Update()
 	{
+		ProcessUploads(m_uploadBudget);
+
 		if (m_timerPurge.IsPassedTime())
 		{
+			std::lock_guard<std::mutex> lock(m_mutex);
 			m_timerPurge.ResetStartTime();
 
 			for (auto it = m_resources.begin(); it != m_resources.end();)
 			{
-				if ((*it).use_count() <= 1)
+				if ((*it).second.use_count() <= 1)
 				{
-					fprintf(stdout, "Resource '%s' erased\n", (*it)->GetFilename().c_str());
+					fprintf(stdout, "Resource '%s' erased\n", (*it).first.c_str());
 					it = m_resources.erase(it);
 					continue;
 				}
@@ -36,52 +59,174 @@ namespace acid
 
 	std::shared_ptr<IResource> Resources::Get(const std::string &filename)
 	{
-		for (auto &resource : m_resources)
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_resources.find(filename);
+
+		if (it == m_resources.end())
 		{
-			if (resource != nullptr && resource->GetFilename() == filename)
-			{
-				return resource;
-			}
+			return nullptr;
 		}
 
-		return nullptr;
+		return (*it).second;
 	}
 
 	void Resources::Add(std::shared_ptr<IResource> resource)
 	{
-		if (std::find(m_resources.begin(), m_resources.end(), resource) != m_resources.end())
+		if (resource == nullptr)
 		{
 			return;
 		}
 
-		m_resources.emplace_back(resource);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_resources.emplace(resource->GetFilename(), resource);
 	}
 
 	bool Resources::Remove(std::shared_ptr<IResource> resource)
 	{
-		for (auto it = m_resources.begin(); it != m_resources.end(); ++it)
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_resources.find(resource->GetFilename());
+
+		if (it == m_resources.end() || (*it).second != resource)
+		{
+			return false;
+		}
+
+		m_resources.erase(it);
+		return true;
+	}
+
+	bool Resources::Remove(const std::string &filename)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_resources.erase(filename) != 0;
+	}
+
+	void Resources::Wait(ResourceLoad &load)
+	{
+		JobHandle job = JobHandle();
+
+		{
+			// The job is set while the mutex is held, a load can be shared with other threads before its job is returned.
+			std::lock_guard<std::mutex> lock(m_mutex);
+			job = load.m_job;
+		}
+
+		ThreadPool::Get()->Wait(job);
+
+		while (!load.IsLoaded())
+		{
+			// Uploads only run on the main thread, other threads wait for it to reach them.
+			if (std::this_thread::get_id() == m_mainThread)
+			{
+				ProcessUploads();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void Resources::ProcessUploads(const float &budget)
+	{
+		float timeStart = Engine::Get()->GetTimeMs();
+
+		while (true)
 		{
-			if (*it == resource)
+			std::shared_ptr<ResourceLoad> load = nullptr;
+
+			{
+				std::lock_guard<std::mutex> lock(m_uploadMutex);
+
+				if (m_uploads.empty())
+				{
+					return;
+				}
+
+				load = m_uploads.front();
+				m_uploads.pop_front();
+			}
+
+			if (load->m_upload)
 			{
-				m_resources.erase(it);
-				return true;
+				load->m_upload();
+				load->m_upload = nullptr;
+			}
+
+			Complete(load);
+
+			if (budget >= 0.0f && Engine::Get()->GetTimeMs() - timeStart >= budget)
+			{
+				return;
 			}
 		}
+	}
 
-		return false;
+	uint32_t Resources::GetLoadingCount()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return static_cast<uint32_t>(m_loading.size());
 	}
 
-	bool Resources::Remove(const std::string &filename)
+	std::shared_ptr<ResourceLoad> Resources::Load(const std::string &filename, const std::function<void(ResourceLoad &)> &decode)
 	{
-		for (auto it = m_resources.begin(); it != m_resources.end(); ++it)
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto load = std::make_shared<ResourceLoad>(filename);
+
+		auto resource = m_resources.find(filename);
+
+		if (resource != m_resources.end())
 		{
-			if ((*it)->GetFilename() == filename)
+			load->m_resource = (*resource).second;
+			load->m_loaded = true;
+			return load;
+		}
+
+		auto loading = m_loading.find(filename);
+
+		if (loading != m_loading.end())
+		{
+			return (*loading).second;
+		}
+
+		m_loading.emplace(filename, load);
+
+		load->m_job = ThreadPool::Get()->Run([this, load, decode]()
+		{
+			try
+			{
+				decode(*load);
+			}
+			catch (const std::exception &e)
 			{
-				m_resources.erase(it);
-				return true;
+				fprintf(stderr, "Failed to load resource '%s': %s\n", load->m_filename.c_str(), e.what());
+				load->m_resource = nullptr;
+				load->m_upload = nullptr;
 			}
+
+			std::lock_guard<std::mutex> uploadLock(m_uploadMutex);
+			m_uploads.emplace_back(load);
+		});
+		return load;
+	}
+
+	void Resources::Complete(const std::shared_ptr<ResourceLoad> &load)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (load->m_resource != nullptr)
+		{
+			// A synchronous load of the same file may have finished first, keep the registered resource so it is not duplicated.
+			auto it = m_resources.emplace(load->m_filename, load->m_resource).first;
+			load->m_resource = (*it).second;
 		}
 
-		return false;
+		m_loading.erase(load->m_filename);
+		load->m_loaded.store(true, std::memory_order_release);
+	}
+
+	void ResourceLoad::Wait()
+	{
+		Resources::Get()->Wait(*this);
 	}
 }
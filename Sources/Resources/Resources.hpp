@@ -1,21 +1,35 @@
 #pragma once
 
+#include <deque>
 #include <memory>
-#include <vector>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include "Engine/Engine.hpp"
 #include "Maths/Timer.hpp"
+#include "Threads/ThreadPool.hpp"
 #include "IResource.hpp"
+#include "ResourceFuture.hpp"
 
 namespace acid
 {
 	/// <summary>
-	/// A module used for managing resources.
+	/// A module used for managing resources, resources are stored in a hashed registry keyed by filename.
+	/// Resources can be loaded asynchronously, decoding happens on the thread pool and uploads are batched on the main thread.
 	/// </summary>
 	class ACID_EXPORT Resources :
 		public IModule
 	{
 	private:
-		std::vector<std::shared_ptr<IResource>> m_resources;
+		std::unordered_map<std::string, std::shared_ptr<IResource>> m_resources;
+		std::unordered_map<std::string, std::shared_ptr<ResourceLoad>> m_loading;
+		std::mutex m_mutex;
+
+		std::deque<std::shared_ptr<ResourceLoad>> m_uploads;
+		std::mutex m_uploadMutex;
+		float m_uploadBudget;
+
+		std::thread::id m_mainThread;
 		Timer m_timerPurge;
 	public:
 		/// <summary>
@@ -46,5 +60,56 @@ namespace acid
 		bool Remove(std::shared_ptr<IResource> resource);
 
 		bool Remove(const std::string &filename);
+
+		/// <summary>
+		/// Loads a resource asynchronously, if the resource is already loaded or loading the existing load is returned.
+		/// </summary>
+		/// <param name="filename"> The filename the resource is registered as. </param>
+		/// <param name="decode"> Creates the resource on a worker thread, must not submit any GPU work. </param>
+		/// <param name="upload"> Optionally called on the main thread after decoding, used to upload to the GPU. </param>
+		/// <returns> A future to the loading resource. </returns>
+		template<typename T>
+		ResourceFuture<T> LoadAsync(const std::string &filename, const std::function<std::shared_ptr<T>()> &decode, const std::function<void(T &)> &upload = nullptr)
+		{
+			return ResourceFuture<T>(Load(filename, [decode, upload](ResourceLoad &load)
+			{
+				auto resource = decode();
+				load.m_resource = resource;
+
+				if (upload && resource != nullptr)
+				{
+					load.m_upload = [upload, resource]()
+					{
+						upload(*resource);
+					};
+				}
+			}));
+		}
+
+		/// <summary>
+		/// Blocks until a asynchronous load is complete.
+		/// </summary>
+		/// <param name="load"> The load to wait on. </param>
+		void Wait(ResourceLoad &load);
+
+		/// <summary>
+		/// Runs the uploads of decoded resources, this is called from <see cref="#Update()"/> with the upload budget.
+		/// </summary>
+		/// <param name="budget"> The time budget in milliseconds, at least one upload is always processed, negative for no limit. </param>
+		void ProcessUploads(const float &budget = -1.0f);
+
+		/// <summary>
+		/// Gets the number of resources still being loaded.
+		/// </summary>
+		/// <returns> The number of pending loads. </returns>
+		uint32_t GetLoadingCount();
+
+		float GetUploadBudget() const { return m_uploadBudget; }
+
+		void SetUploadBudget(const float &uploadBudget) { m_uploadBudget = uploadBudget; }
+	private:
+		std::shared_ptr<ResourceLoad> Load(const std::string &filename, const std::function<void(ResourceLoad &)> &decode);
+
+		void Complete(const std::shared_ptr<ResourceLoad> &load);
 	};
 }
@@ -0,0 +1,308 @@
+#include "DynamicTree.hpp"
+
+#include <algorithm>
+
+namespace acid
+{
+	const int32_t DynamicTree::NULL_NODE = -1;
+
+	DynamicTree::DynamicTree(const float &margin) :
+		m_nodes(std::vector<Node>()),
+		m_root(NULL_NODE),
+		m_freeList(NULL_NODE),
+		m_leafCount(0),
+		m_margin(margin)
+	{
+	}
+
+	int32_t DynamicTree::Insert(const Aabb &box, GameObject *object)
+	{
+		int32_t leaf = AllocateNode();
+		m_nodes[leaf].box = box.Expand(m_margin);
+		m_nodes[leaf].object = object;
+		m_nodes[leaf].height = 0;
+		InsertLeaf(leaf);
+		m_leafCount++;
+		return leaf;
+	}
+
+	void DynamicTree::Remove(const int32_t &proxy)
+	{
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		m_leafCount--;
+	}
+
+	bool DynamicTree::Move(const int32_t &proxy, const Aabb &box)
+	{
+		if (m_nodes[proxy].box.Contains(box))
+		{
+			return false;
+		}
+
+		RemoveLeaf(proxy);
+		m_nodes[proxy].box = box.Expand(m_margin);
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	void DynamicTree::Clear()
+	{
+		m_nodes.clear();
+		m_root = NULL_NODE;
+		m_freeList = NULL_NODE;
+		m_leafCount = 0;
+	}
+
+	int32_t DynamicTree::AllocateNode()
+	{
+		int32_t index;
+
+		if (m_freeList != NULL_NODE)
+		{
+			index = m_freeList;
+			m_freeList = m_nodes[index].parent;
+		}
+		else
+		{
+			index = static_cast<int32_t>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+
+		Node &node = m_nodes[index];
+		node.box = Aabb();
+		node.object = nullptr;
+		node.parent = NULL_NODE;
+		node.left = NULL_NODE;
+		node.right = NULL_NODE;
+		node.height = 0;
+		return index;
+	}
+
+	void DynamicTree::FreeNode(const int32_t &index)
+	{
+		// Free nodes are linked through their parent index.
+		m_nodes[index].parent = m_freeList;
+		m_nodes[index].object = nullptr;
+		m_nodes[index].height = -1;
+		m_freeList = index;
+	}
+
+	void DynamicTree::InsertLeaf(const int32_t &leaf)
+	{
+		if (m_root == NULL_NODE)
+		{
+			m_root = leaf;
+			m_nodes[m_root].parent = NULL_NODE;
+			return;
+		}
+
+		// Finds the best sibling by descending with the surface area heuristic.
+		Aabb leafBox = m_nodes[leaf].box;
+		int32_t index = m_root;
+
+		while (!m_nodes[index].IsLeaf())
+		{
+			int32_t left = m_nodes[index].left;
+			int32_t right = m_nodes[index].right;
+
+			float area = m_nodes[index].box.SurfaceArea();
+			float combinedArea = m_nodes[index].box.Merge(leafBox).SurfaceArea();
+
+			// Cost of creating a new parent for this node and the leaf.
+			float cost = 2.0f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree.
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto childCost = [&](const int32_t &child)
+			{
+				float merged = m_nodes[child].box.Merge(leafBox).SurfaceArea();
+				return m_nodes[child].IsLeaf() ? merged + inheritanceCost : (merged - m_nodes[child].box.SurfaceArea()) + inheritanceCost;
+			};
+
+			float costLeft = childCost(left);
+			float costRight = childCost(right);
+
+			if (cost < costLeft && cost < costRight)
+			{
+				break;
+			}
+
+			index = costLeft < costRight ? left : right;
+		}
+
+		int32_t sibling = index;
+
+		// Creates a new parent.
+		int32_t oldParent = m_nodes[sibling].parent;
+		int32_t newParent = AllocateNode();
+		m_nodes[newParent].parent = oldParent;
+		m_nodes[newParent].box = leafBox.Merge(m_nodes[sibling].box);
+		m_nodes[newParent].height = m_nodes[sibling].height + 1;
+		m_nodes[newParent].left = sibling;
+		m_nodes[newParent].right = leaf;
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		if (oldParent != NULL_NODE)
+		{
+			if (m_nodes[oldParent].left == sibling)
+			{
+				m_nodes[oldParent].left = newParent;
+			}
+			else
+			{
+				m_nodes[oldParent].right = newParent;
+			}
+		}
+		else
+		{
+			m_root = newParent;
+		}
+
+		// Walks back up the tree fixing heights and boxes.
+		index = m_nodes[leaf].parent;
+
+		while (index != NULL_NODE)
+		{
+			index = Balance(index);
+
+			int32_t left = m_nodes[index].left;
+			int32_t right = m_nodes[index].right;
+
+			m_nodes[index].height = 1 + std::max(m_nodes[left].height, m_nodes[right].height);
+			m_nodes[index].box = m_nodes[left].box.Merge(m_nodes[right].box);
+
+			index = m_nodes[index].parent;
+		}
+	}
+
+	void DynamicTree::RemoveLeaf(const int32_t &leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = NULL_NODE;
+			return;
+		}
+
+		int32_t parent = m_nodes[leaf].parent;
+		int32_t grandParent = m_nodes[parent].parent;
+		int32_t sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+		if (grandParent != NULL_NODE)
+		{
+			// Destroys the parent and connects the sibling to the grand parent.
+			if (m_nodes[grandParent].left == parent)
+			{
+				m_nodes[grandParent].left = sibling;
+			}
+			else
+			{
+				m_nodes[grandParent].right = sibling;
+			}
+
+			m_nodes[sibling].parent = grandParent;
+			FreeNode(parent);
+
+			int32_t index = grandParent;
+
+			while (index != NULL_NODE)
+			{
+				index = Balance(index);
+
+				int32_t left = m_nodes[index].left;
+				int32_t right = m_nodes[index].right;
+
+				m_nodes[index].box = m_nodes[left].box.Merge(m_nodes[right].box);
+				m_nodes[index].height = 1 + std::max(m_nodes[left].height, m_nodes[right].height);
+
+				index = m_nodes[index].parent;
+			}
+		}
+		else
+		{
+			m_root = sibling;
+			m_nodes[sibling].parent = NULL_NODE;
+			FreeNode(parent);
+		}
+	}
+
+	int32_t DynamicTree::Balance(const int32_t &iA)
+	{
+		// Performs a left or right rotation if node A is imbalanced, returns the new root index.
+		Node &a = m_nodes[iA];
+
+		if (a.IsLeaf() || a.height < 2)
+		{
+			return iA;
+		}
+
+		int32_t iB = a.left;
+		int32_t iC = a.right;
+		int32_t balance = m_nodes[iC].height - m_nodes[iB].height;
+
+		auto rotate = [&](const int32_t &iUp, const int32_t &iOther)
+		{
+			// Rotates iUp above iA, iOther stays a child of iA.
+			Node &up = m_nodes[iUp];
+			int32_t iF = up.left;
+			int32_t iG = up.right;
+
+			up.left = iA;
+			up.parent = a.parent;
+			a.parent = iUp;
+
+			if (up.parent != NULL_NODE)
+			{
+				if (m_nodes[up.parent].left == iA)
+				{
+					m_nodes[up.parent].left = iUp;
+				}
+				else
+				{
+					m_nodes[up.parent].right = iUp;
+				}
+			}
+			else
+			{
+				m_root = iUp;
+			}
+
+			// Keeps the taller grand child up, the other moves under A.
+			int32_t iKeep = m_nodes[iF].height > m_nodes[iG].height ? iF : iG;
+			int32_t iMove = iKeep == iF ? iG : iF;
+
+			up.right = iKeep;
+
+			if (a.left == iUp)
+			{
+				a.left = iMove;
+			}
+			else
+			{
+				a.right = iMove;
+			}
+
+			m_nodes[iMove].parent = iA;
+
+			a.box = m_nodes[iOther].box.Merge(m_nodes[iMove].box);
+			a.height = 1 + std::max(m_nodes[iOther].height, m_nodes[iMove].height);
+			up.box = a.box.Merge(m_nodes[iKeep].box);
+			up.height = 1 + std::max(a.height, m_nodes[iKeep].height);
+			return iUp;
+		};
+
+		if (balance > 1)
+		{
+			return rotate(iC, iB);
+		}
+
+		if (balance < -1)
+		{
+			return rotate(iB, iC);
+		}
+
+		return iA;
+	}
+}
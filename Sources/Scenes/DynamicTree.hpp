@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Physics/Aabb.hpp"
+
+namespace acid
+{
+	class GameObject;
+
+	/// <summary>
+	/// A dynamic bounding volume hierarchy of game objects. Leaves store fattened boxes so small movements do not change the tree,
+	/// and the tree is kept balanced with rotations as leaves are inserted and removed.
+	/// </summary>
+	class ACID_EXPORT DynamicTree
+	{
+	public:
+		static const int32_t NULL_NODE;
+	private:
+		struct Node
+		{
+			Aabb box;
+			GameObject *object;
+			int32_t parent;
+			int32_t left;
+			int32_t right;
+			int32_t height;
+
+			bool IsLeaf() const { return left == NULL_NODE; }
+		};
+
+		std::vector<Node> m_nodes;
+		int32_t m_root;
+		int32_t m_freeList;
+		uint32_t m_leafCount;
+		float m_margin;
+	public:
+		/// <summary>
+		/// Creates a new dynamic tree.
+		/// </summary>
+		/// <param name="margin"> How far leaf boxes are fattened, objects moving less than this do not update the tree. </param>
+		explicit DynamicTree(const float &margin = 0.2f);
+
+		/// <summary>
+		/// Inserts a object into the tree.
+		/// </summary>
+		/// <param name="box"> The world bounds of the object. </param>
+		/// <param name="object"> The object. </param>
+		/// <returns> The proxy id of the object, used to move and remove it. </returns>
+		int32_t Insert(const Aabb &box, GameObject *object);
+
+		/// <summary>
+		/// Removes a object from the tree.
+		/// </summary>
+		/// <param name="proxy"> The proxy id of the object. </param>
+		void Remove(const int32_t &proxy);
+
+		/// <summary>
+		/// Updates the bounds of a object, the tree is only changed if the bounds leave the fattened leaf box.
+		/// </summary>
+		/// <param name="proxy"> The proxy id of the object. </param>
+		/// <param name="box"> The new world bounds of the object. </param>
+		/// <returns> If the object was reinserted. </returns>
+		bool Move(const int32_t &proxy, const Aabb &box);
+
+		/// <summary>
+		/// Removes all objects from the tree.
+		/// </summary>
+		void Clear();
+
+		GameObject *GetObject(const int32_t &proxy) const { return m_nodes[proxy].object; }
+
+		Aabb GetFatBox(const int32_t &proxy) const { return m_nodes[proxy].box; }
+
+		uint32_t GetSize() const { return m_leafCount; }
+
+		/// <summary>
+		/// Gets the height of the tree, a balanced tree has a height close to log2 of the object count.
+		/// </summary>
+		/// <returns> The tree height. </returns>
+		int32_t GetHeight() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+
+		/// <summary>
+		/// Walks the tree, descending into every node whose box passes the test and calling the callback for every leaf that passes.
+		/// </summary>
+		/// <param name="test"> A function taking a <see cref="Aabb"/>, returning if the box is in range. </param>
+		/// <param name="callback"> A function taking the <see cref="GameObject"/> of each leaf in range. </param>
+		template<typename Test, typename Callback>
+		void Query(const Test &test, const Callback &callback) const
+		{
+			if (m_root == NULL_NODE)
+			{
+				return;
+			}
+
+			int32_t stack[64];
+			std::vector<int32_t> overflow = {};
+			int32_t count = 0;
+			stack[count++] = m_root;
+
+			while (count > 0 || !overflow.empty())
+			{
+				int32_t index;
+
+				if (!overflow.empty())
+				{
+					index = overflow.back();
+					overflow.pop_back();
+				}
+				else
+				{
+					index = stack[--count];
+				}
+
+				const Node &node = m_nodes[index];
+
+				if (!test(node.box))
+				{
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					callback(node.object);
+					continue;
+				}
+
+				for (const int32_t &child : {node.left, node.right})
+				{
+					if (count < 64)
+					{
+						stack[count++] = child;
+					}
+					else
+					{
+						overflow.emplace_back(child);
+					}
+				}
+			}
+		}
+	private:
+		int32_t AllocateNode();
+
+		void FreeNode(const int32_t &index);
+
+		void InsertLeaf(const int32_t &leaf);
+
+		void RemoveLeaf(const int32_t &leaf);
+
+		int32_t Balance(const int32_t &index);
+	};
+}
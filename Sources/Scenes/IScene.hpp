@@ -23,9 +23,10 @@ namespace acid
 		/// Creates a new scene.
 		/// </summary>
 		/// <param name="camera"> The scenes camera. </param>
-		IScene(ICamera *camera) :
+		/// <param name="multithreadedPhysics"> If the scenes physics runs collision detection and constraint solving on the thread pool. </param>
+		IScene(ICamera *camera, const bool &multithreadedPhysics = false) :
 			m_camera(camera),
-			m_physics(new ScenePhysics()),
+			m_physics(new ScenePhysics(multithreadedPhysics)),
 			m_structure(new SceneStructure()),
 			m_started(false)
 		{
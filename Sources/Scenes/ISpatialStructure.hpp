@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <vector>
+#include "Physics/Aabb.hpp"
 #include "Physics/Frustum.hpp"
 
 namespace acid
@@ -14,6 +15,7 @@ namespace acid
 
 	/// <summary>
 	/// A data structure that stores objects with a notion of space.
+	/// Objects without any bounds are treated as infinite, and are returned by every spatial query.
 	/// </summary>
 	class ACID_EXPORT ISpatialStructure
 	{
@@ -79,13 +81,39 @@ namespace acid
 		virtual std::vector<GameObject *> QueryFrustum(const Frustum &range) = 0;
 
 		/// <summary>
-		/// Returns a set of all objects in a specific range of the spatial structure.
+		/// Returns a set of all objects with bounds intersecting a box.
 		/// </summary>
-		/// <param name="range"> The shape range of space being queried. </param>
-		/// <param name="result"> The list to store the data into.
-		/// </param>
+		/// <param name="range"> The box range of space being queried. </param>
+		/// <returns> The list of all object in range. </returns>
+		virtual std::vector<GameObject *> QueryBounding(const Aabb &range) = 0;
+
+		/// <summary>
+		/// Returns a set of all objects with bounds intersecting a sphere.
+		/// </summary>
+		/// <param name="centre"> The sphere centre. </param>
+		/// <param name="radius"> The sphere radius. </param>
 		/// <returns> The list of all object in range. </returns>
-	//	virtual std::vector<GameObject *> QueryBounding(Collider *range) = 0;
+		virtual std::vector<GameObject *> QuerySphere(const Vector3 &centre, const float &radius) = 0;
+
+		/// <summary>
+		/// Returns a set of all objects with bounds hit by a ray, in no particular order.
+		/// </summary>
+		/// <param name="origin"> The ray origin. </param>
+		/// <param name="direction"> The ray direction. </param>
+		/// <param name="maxDistance"> The maximum distance along the ray. </param>
+		/// <returns> The list of all object hit. </returns>
+		virtual std::vector<GameObject *> QueryRay(const Vector3 &origin, const Vector3 &direction, const float &maxDistance) = 0;
+
+		/// <summary>
+		/// Updates the bounds of objects that have moved since the last update.
+		/// </summary>
+		virtual void Update() = 0;
+
+		/// <summary>
+		/// Recalculates the bounds of a object, called when components that give the object its bounds are changed.
+		/// </summary>
+		/// <param name="object"> The object to refresh. </param>
+		virtual void Refresh(GameObject *object) = 0;
 
 		/// <summary>
 		/// If the structure contains the object.
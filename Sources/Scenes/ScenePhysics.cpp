@@ -1,25 +1,76 @@
 #include "ScenePhysics.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include "Engine/Engine.hpp"
+#include "Objects/ComponentPools.hpp"
 #include "Physics/Collider.hpp"
+#include "Physics/MotionState.hpp"
+#include "Physics/Rigidbody.hpp"
+#include "Threads/ThreadPool.hpp"
 
 namespace acid
 {
-	ScenePhysics::ScenePhysics() :
+	const int ScenePhysics::DISPATCH_GRAIN_SIZE = 40;
+
+	std::unique_ptr<PhysicsScheduler> ScenePhysics::SCHEDULER = nullptr;
+
+	void ScenePhysics::SetScheduler(PhysicsScheduler *scheduler)
+	{
+		// Bullet deactivates the old scheduler before it is deleted.
+		btSetTaskScheduler(scheduler != nullptr ? scheduler : btGetSequentialTaskScheduler());
+		SCHEDULER.reset(scheduler);
+	}
+
+	ScenePhysics::ScenePhysics(const bool &multithreaded) :
+		m_multithreaded(multithreaded),
 		m_collisionConfiguration(new btSoftBodyRigidBodyCollisionConfiguration()),
 		m_broadphase(new btDbvtBroadphase()),
-		m_dispatcher(new btCollisionDispatcher(m_collisionConfiguration)),
-		m_solver(new btSequentialImpulseConstraintSolver()),
-		m_dynamicsWorld(new btSoftRigidDynamicsWorld(m_dispatcher, m_broadphase, m_solver, m_collisionConfiguration))
+		m_dispatcher(nullptr),
+		m_solver(nullptr),
+		m_solverMt(nullptr),
+		m_dynamicsWorld(nullptr),
+		m_fixedTimeStep(1.0f / 60.0f),
+		m_maxSubSteps(4),
+		m_accumulator(0.0f),
+		m_updateTime(0.0f)
 	{
+		if (m_multithreaded)
+		{
+			if (SCHEDULER == nullptr)
+			{
+				SetScheduler(new PhysicsScheduler(ThreadPool::Get()));
+			}
+
+			// The dispatcher sizes its per thread data from the scheduler, so the scheduler is set before the world is made.
+			auto solverPool = new btConstraintSolverPoolMt(SCHEDULER->getMaxNumThreads());
+			m_dispatcher = new btCollisionDispatcherMt(m_collisionConfiguration, DISPATCH_GRAIN_SIZE);
+			m_solver = solverPool;
+			m_solverMt = new btSequentialImpulseConstraintSolverMt();
+			m_dynamicsWorld = new btDiscreteDynamicsWorldMt(m_dispatcher, m_broadphase, solverPool, m_solverMt, m_collisionConfiguration);
+		}
+		else
+		{
+			m_dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
+			m_solver = new btSequentialImpulseConstraintSolver();
+			m_dynamicsWorld = new btSoftRigidDynamicsWorld(m_dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
+		}
+
 		m_dynamicsWorld->setGravity(btVector3(0.0f, -9.81f, 0.0f));
 		m_dynamicsWorld->getSolverInfo().m_solverMode |= SOLVER_RANDMIZE_ORDER;
 		m_dynamicsWorld->getDispatchInfo().m_enableSatConvex = true;
 		m_dynamicsWorld->getSolverInfo().m_splitImpulse = true;
 
-		auto softDynamicsWorld = static_cast<btSoftRigidDynamicsWorld *>(m_dynamicsWorld);
-		softDynamicsWorld->getWorldInfo().air_density = 1.0f;
-		softDynamicsWorld->getWorldInfo().m_sparsesdf.Initialize();
+		if (!m_multithreaded)
+		{
+			auto softDynamicsWorld = static_cast<btSoftRigidDynamicsWorld *>(m_dynamicsWorld);
+			softDynamicsWorld->getWorldInfo().air_density = 1.0f;
+			softDynamicsWorld->getWorldInfo().m_sparsesdf.Initialize();
+		}
 	}
 
 	ScenePhysics::~ScenePhysics()
@@ -38,16 +89,60 @@ namespace acid
 			delete obj;
 		}
 
-		delete m_collisionConfiguration;
-		delete m_dispatcher;
-		delete m_broadphase;
-		delete m_solver;
 		delete m_dynamicsWorld;
+		delete m_solverMt;
+		delete m_solver;
+		delete m_broadphase;
+		delete m_dispatcher;
+		delete m_collisionConfiguration;
 	}
 
 	void ScenePhysics::Update()
 	{
-		m_dynamicsWorld->stepSimulation(Engine::Get()->GetDelta());
+		m_accumulator += Engine::Get()->GetDelta();
+		m_updateTime = Engine::Get()->GetTime();
+		uint32_t subSteps = 0;
+
+		while (m_accumulator >= m_fixedTimeStep && subSteps < m_maxSubSteps)
+		{
+			for (int i = 0; i < m_dynamicsWorld->getNumCollisionObjects(); i++)
+			{
+				btRigidBody *body = btRigidBody::upcast(m_dynamicsWorld->getCollisionObjectArray()[i]);
+				auto motionState = body != nullptr ? dynamic_cast<MotionState *>(body->getMotionState()) : nullptr;
+
+				if (motionState != nullptr)
+				{
+					motionState->StorePrevious();
+				}
+			}
+
+			// No substeps are taken by Bullet, the step is exactly the fixed time step.
+			m_dynamicsWorld->stepSimulation(m_fixedTimeStep, 0);
+			m_accumulator -= m_fixedTimeStep;
+			subSteps++;
+		}
+
+		if (m_accumulator >= m_fixedTimeStep)
+		{
+			m_accumulator = std::fmod(m_accumulator, m_fixedTimeStep);
+		}
+	}
+
+	void ScenePhysics::InterpolateTransforms()
+	{
+		float progression = GetInterpolation();
+
+		ComponentPools::ForEach<Rigidbody>([&](Rigidbody *rigidbody)
+		{
+			rigidbody->InterpolateTransform(progression);
+		});
+	}
+
+	float ScenePhysics::GetInterpolation() const
+	{
+		// Rendering happens between updates, so the time since the last update is counted too.
+		float time = m_accumulator + (Engine::Get()->GetTime() - m_updateTime);
+		return std::clamp(time / m_fixedTimeStep, 0.0f, 1.0f);
 	}
 
 	Vector3 ScenePhysics::GetGravity() const
@@ -62,12 +157,22 @@ namespace acid
 
 	float ScenePhysics::GetAirDensity() const
 	{
+		if (m_multithreaded)
+		{
+			return 0.0f;
+		}
+
 		auto softDynamicsWorld = static_cast<btSoftRigidDynamicsWorld *>(m_dynamicsWorld);
 		return softDynamicsWorld->getWorldInfo().air_density;
 	}
 
 	void ScenePhysics::SetAirDensity(const float &airDensity)
 	{
+		if (m_multithreaded)
+		{
+			return;
+		}
+
 		auto softDynamicsWorld = static_cast<btSoftRigidDynamicsWorld *>(m_dynamicsWorld);
 		softDynamicsWorld->getWorldInfo().air_density = airDensity;
 		softDynamicsWorld->getWorldInfo().m_sparsesdf.Initialize();
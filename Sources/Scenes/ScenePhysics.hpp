@@ -1,38 +1,105 @@
 #pragma once
 
+#include <memory>
 #include <BulletCollision/BroadphaseCollision/btBroadphaseInterface.h>
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
-#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <BulletDynamics/ConstraintSolver/btConstraintSolver.h>
 #include <BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h>
 #include <BulletSoftBody/btSoftRigidDynamicsWorld.h>
 #include "Maths/Vector3.hpp"
+#include "Physics/PhysicsScheduler.hpp"
 
 namespace acid
 {
+	/// <summary>
+	/// The physics world of a scene. The world is stepped at a fixed rate, taking as many steps as the time passed needs up to a budget,
+	/// and bodies are drawn between the last two steps so rendering can run faster than the physics.
+	/// <para>
+	/// A multithreaded world dispatches collision pairs and solves islands as jobs, it does not simulate soft bodies.
+	/// </para>
+	/// </summary>
 	class ACID_EXPORT ScenePhysics
 	{
 	private:
+		static const int DISPATCH_GRAIN_SIZE;
+
+		static std::unique_ptr<PhysicsScheduler> SCHEDULER;
+
+		bool m_multithreaded;
 		btCollisionConfiguration *m_collisionConfiguration;
 		btBroadphaseInterface *m_broadphase;
 		btCollisionDispatcher *m_dispatcher;
-		btSequentialImpulseConstraintSolver *m_solver;
+		btConstraintSolver *m_solver;
+		btConstraintSolver *m_solverMt;
 		btDiscreteDynamicsWorld *m_dynamicsWorld;
+
+		float m_fixedTimeStep;
+		uint32_t m_maxSubSteps;
+		float m_accumulator;
+		float m_updateTime;
 	public:
-		ScenePhysics();
+		/// <summary>
+		/// Gets the scheduler multithreaded worlds run their physics work on.
+		/// </summary>
+		/// <returns> The physics scheduler, null until a multithreaded world is created. </returns>
+		static PhysicsScheduler *GetScheduler() { return SCHEDULER.get(); }
+
+		/// <summary>
+		/// Sets the scheduler multithreaded worlds run their physics work on, this must be called on the thread stepping the physics.
+		/// By default a scheduler on the engines thread pool is made when the first multithreaded world is created,
+		/// the scheduler can not be replaced while a multithreaded world exists.
+		/// </summary>
+		/// <param name="scheduler"> The new physics scheduler, the scheduler is deleted when replaced. </param>
+		static void SetScheduler(PhysicsScheduler *scheduler);
+
+		/// <summary>
+		/// Creates a new physics world.
+		/// </summary>
+		/// <param name="multithreaded"> If the world runs collision detection and constraint solving on the physics scheduler. </param>
+		ScenePhysics(const bool &multithreaded = false);
 
 		~ScenePhysics();
 
+		/// <summary>
+		/// Steps the world by the time passed since the last update, in fixed steps.
+		/// Time that would need more steps than the budget is dropped, so the physics slows down instead of falling further behind.
+		/// </summary>
 		void Update();
 
+		/// <summary>
+		/// Sets the render transforms of every rigidbody to their bodies between the last two physics steps, called by the scenes after each update.
+		/// </summary>
+		void InterpolateTransforms();
+
+		/// <summary>
+		/// Gets how far the current time is between the last two physics steps.
+		/// </summary>
+		/// <returns> The progression from the previous step to the current step, from 0 to 1. </returns>
+		float GetInterpolation() const;
+
+		float GetFixedTimeStep() const { return m_fixedTimeStep; }
+
+		void SetFixedTimeStep(const float &fixedTimeStep) { m_fixedTimeStep = fixedTimeStep; }
+
+		uint32_t GetMaxSubSteps() const { return m_maxSubSteps; }
+
+		void SetMaxSubSteps(const uint32_t &maxSubSteps) { m_maxSubSteps = maxSubSteps; }
+
 		Vector3 GetGravity() const;
 
 		void SetGravity(const Vector3 &gravity);
 
+		/// <summary>
+		/// Gets the density of air acting on soft bodies.
+		/// </summary>
+		/// <returns> The air density, zero in a multithreaded world. </returns>
 		float GetAirDensity() const;
 
 		void SetAirDensity(const float &airDensity);
 
+		bool IsMultithreaded() const { return m_multithreaded; }
+
 		btDiscreteDynamicsWorld *GetDynamicsWorld() { return m_dynamicsWorld; }
 	};
 }
@@ -1,12 +1,17 @@
 ﻿#include "SceneStructure.hpp"
 
+#include "Lights/Light.hpp"
+#include "Meshes/Mesh.hpp"
 #include "Physics/Collider.hpp"
 
 namespace acid
 {
 	SceneStructure::SceneStructure() :
 		ISpatialStructure(),
-		m_objects(std::vector<GameObject *>())
+		m_objects(std::vector<GameObject *>()),
+		m_proxies(std::unordered_map<GameObject *, Proxy>()),
+		m_unbounded(std::vector<GameObject *>()),
+		m_tree(DynamicTree())
 	{
 	}
 
@@ -16,25 +21,53 @@ namespace acid
 
 	void SceneStructure::Add(GameObject *object)
 	{
+		if (m_proxies.find(object) != m_proxies.end())
+		{
+			return;
+		}
+
 		m_objects.emplace_back(object);
+		m_proxies.emplace(object, Proxy{DynamicTree::NULL_NODE, object->GetTransform(), nullptr, nullptr});
+		m_unbounded.emplace_back(object);
+		Refresh(object);
 	}
 
 	bool SceneStructure::Remove(GameObject *object)
 	{
 		auto it = std::find(m_objects.begin(), m_objects.end(), object);
 
-		if (it != m_objects.end())
+		if (it == m_objects.end())
+		{
+			return false;
+		}
+
+		m_objects.erase(it);
+
+		auto proxy = m_proxies.find(object);
+
+		if (proxy != m_proxies.end())
 		{
-			m_objects.erase(it);
-			return true;
+			if ((*proxy).second.node != DynamicTree::NULL_NODE)
+			{
+				m_tree.Remove((*proxy).second.node);
+			}
+			else
+			{
+				m_unbounded.erase(std::remove(m_unbounded.begin(), m_unbounded.end(), object), m_unbounded.end());
+			}
+
+			m_proxies.erase(proxy);
 		}
 
-		return false;
+		return true;
 	}
 
 	void SceneStructure::Clear()
 	{
 		m_objects.clear();
+		m_proxies.clear();
+		m_unbounded.clear();
+		m_tree.Clear();
 	}
 
 	std::vector<GameObject *> SceneStructure::QueryAll()
@@ -51,42 +84,155 @@ namespace acid
 
 	std::vector<GameObject *> SceneStructure::QueryFrustum(const Frustum &range)
 	{
-		auto result = std::vector<GameObject *>();
+		auto result = m_unbounded;
+		m_tree.Query([&range](const Aabb &box)
+		{
+			return box.InFrustum(range);
+		}, [&result](GameObject *object)
+		{
+			result.emplace_back(object);
+		});
+		return result;
+	}
 
-		for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
+	std::vector<GameObject *> SceneStructure::QueryBounding(const Aabb &range)
+	{
+		auto result = m_unbounded;
+		m_tree.Query([&range](const Aabb &box)
 		{
-			auto gameObject = static_cast<GameObject *>(*it);
-			auto collider = gameObject->GetComponent<Collider>();
+			return box.Intersects(range);
+		}, [&result](GameObject *object)
+		{
+			result.emplace_back(object);
+		});
+		return result;
+	}
+
+	std::vector<GameObject *> SceneStructure::QuerySphere(const Vector3 &centre, const float &radius)
+	{
+		auto result = m_unbounded;
+		m_tree.Query([&centre, &radius](const Aabb &box)
+		{
+			return box.IntersectsSphere(centre, radius);
+		}, [&result](GameObject *object)
+		{
+			result.emplace_back(object);
+		});
+		return result;
+	}
 
-			if (collider == nullptr || collider->InFrustum(range))
+	std::vector<GameObject *> SceneStructure::QueryRay(const Vector3 &origin, const Vector3 &direction, const float &maxDistance)
+	{
+		auto result = m_unbounded;
+		Vector3 inverseDirection = Vector3(1.0f / direction.m_x, 1.0f / direction.m_y, 1.0f / direction.m_z);
+		m_tree.Query([&origin, &inverseDirection, &maxDistance](const Aabb &box)
+		{
+			return box.IntersectsRay(origin, inverseDirection, maxDistance).has_value();
+		}, [&result](GameObject *object)
+		{
+			result.emplace_back(object);
+		});
+		return result;
+	}
+
+	void SceneStructure::Update()
+	{
+		for (auto &[object, proxy] : m_proxies)
+		{
+			// Comparing the transform is cheap, bounds are only recalculated for objects that have moved or had their model swapped.
+			bool modelChanged = proxy.mesh != nullptr && proxy.mesh->GetModel().get() != proxy.model;
+
+			if (modelChanged || object->GetTransform() != proxy.transform)
 			{
-				result.emplace_back(*it);
+				Refresh(object);
 			}
 		}
-
-		return result;
 	}
 
-	/*std::vector<GameObject *> SceneStructure::QueryBounding(Collider *range)
+	void SceneStructure::Refresh(GameObject *object)
 	{
-		auto result = std::vector<GameObject *>();
+		auto it = m_proxies.find(object);
 
-		for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
+		if (it == m_proxies.end())
+		{
+			return;
+		}
+
+		Proxy &proxy = (*it).second;
+		proxy.transform = object->GetTransform();
+		proxy.mesh = object->GetComponent<Mesh>(true);
+		proxy.model = proxy.mesh == nullptr ? nullptr : proxy.mesh->GetModel().get();
+
+		Aabb bounds = Aabb();
+		bool infinite = false;
+
+		auto collider = object->GetComponent<Collider>(true);
+
+		if (collider != nullptr)
 		{
-			auto gameObject = static_cast<GameObject *>(*it);
-			auto collider = gameObject->GetComponent<Collider>();
+			auto colliderBounds = collider->GetBounds();
 
-			if (collider == nullptr || range->Intersects(*collider).IsIntersection() || range->Contains(*collider))
+			if (colliderBounds)
 			{
-				result.emplace_back(*it);
+				bounds = bounds.Merge(*colliderBounds);
 			}
 		}
 
-		return result;
-	}*/
+		if (proxy.model != nullptr)
+		{
+			bounds = bounds.Merge(Aabb(proxy.model->GetMinExtents(), proxy.model->GetMaxExtents()).Transform(proxy.transform.GetWorldMatrix()));
+		}
+
+		auto light = object->GetComponent<Light>(true);
+
+		if (light != nullptr)
+		{
+			if (light->GetRadius() >= 0.0f)
+			{
+				bounds = bounds.Merge(Aabb::FromSphere(proxy.transform.GetPosition() + light->GetOffset(), light->GetRadius()));
+			}
+			else
+			{
+				infinite = true;
+			}
+		}
+
+		if (infinite || !bounds.IsValid())
+		{
+			if (proxy.node != DynamicTree::NULL_NODE)
+			{
+				m_tree.Remove(proxy.node);
+				proxy.node = DynamicTree::NULL_NODE;
+				m_unbounded.emplace_back(object);
+			}
+
+			return;
+		}
+
+		if (proxy.node == DynamicTree::NULL_NODE)
+		{
+			m_unbounded.erase(std::remove(m_unbounded.begin(), m_unbounded.end(), object), m_unbounded.end());
+			proxy.node = m_tree.Insert(bounds, object);
+			return;
+		}
+
+		m_tree.Move(proxy.node, bounds);
+	}
+
+	std::optional<Aabb> SceneStructure::GetBounds(GameObject *object) const
+	{
+		auto it = m_proxies.find(object);
+
+		if (it == m_proxies.end() || (*it).second.node == DynamicTree::NULL_NODE)
+		{
+			return std::nullopt;
+		}
+
+		return m_tree.GetFatBox((*it).second.node);
+	}
 
 	bool SceneStructure::Contains(GameObject *object)
 	{
-		return std::find(m_objects.begin(), m_objects.end(), object) != m_objects.end();
+		return m_proxies.find(object) != m_proxies.end();
 	}
 }
@@ -1,22 +1,40 @@
 ﻿#pragma once
 
 #include <algorithm>
+#include <unordered_map>
 #include <vector>
+#include "Objects/ComponentPools.hpp"
 #include "Objects/GameObject.hpp"
 #include "Objects/IComponent.hpp"
 #include "Physics/Rigidbody.hpp"
+#include "DynamicTree.hpp"
 #include "ISpatialStructure.hpp"
 
 namespace acid
 {
+	class Mesh;
+
+	class Model;
+
 	/// <summary>
-	/// A structure of spatial objects for a 3D space.
+	/// A structure of spatial objects for a 3D space, bounded objects are indexed by a dynamic bounding volume hierarchy.
 	/// </summary>
 	class ACID_EXPORT SceneStructure :
 		public ISpatialStructure
 	{
 	private:
+		struct Proxy
+		{
+			int32_t node;
+			Transform transform;
+			Mesh *mesh;
+			Model *model;
+		};
+
 		std::vector<GameObject *> m_objects;
+		std::unordered_map<GameObject *, Proxy> m_proxies;
+		std::vector<GameObject *> m_unbounded;
+		DynamicTree m_tree;
 	public:
 		/// <summary>
 		/// Creates a new basic structure.
@@ -42,10 +60,31 @@ namespace acid
 
 		std::vector<GameObject *> QueryFrustum(const Frustum &range) override;
 
-	//	std::vector<GameObject *> QueryBounding(Collider *range) override;
+		std::vector<GameObject *> QueryBounding(const Aabb &range) override;
+
+		std::vector<GameObject *> QuerySphere(const Vector3 &centre, const float &radius) override;
+
+		std::vector<GameObject *> QueryRay(const Vector3 &origin, const Vector3 &direction, const float &maxDistance) override;
+
+		void Update() override;
+
+		void Refresh(GameObject *object) override;
+
+		/// <summary>
+		/// Gets the cached world bounds of a object.
+		/// </summary>
+		/// <param name="object"> The object. </param>
+		/// <returns> The fattened bounds, or no value if the object is unbounded or not in this structure. </returns>
+		std::optional<Aabb> GetBounds(GameObject *object) const;
 
 		/// <summary>
-		/// Returns a set of all components of a type in the spatial structure.
+		/// Gets the spatial index of bounded objects.
+		/// </summary>
+		/// <returns> The dynamic tree. </returns>
+		const DynamicTree &GetTree() const { return m_tree; }
+
+		/// <summary>
+		/// Returns a set of all components of a type in the spatial structure, walking the pools of the type instead of every object.
 		/// </summary>
 		/// <param name="allowDisabled"> If disabled components will be included in this query. </param>
 		/// <returns> The list specified by of all components that match the type. </returns>
@@ -54,14 +93,36 @@ namespace acid
 		{
 			auto result = std::vector<T *>();
 
-			for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
+			ComponentPools::ForEach<T>([&](T *component)
 			{
-				if ((*it)->IsRemoved())
+				if (ContainsComponent(*component) && (component->IsEnabled() || allowDisabled))
+				{
+					result.emplace_back(component);
+				}
+			});
+
+			return result;
+		}
+
+		/// <summary>
+		/// Returns a set of all components of a type on objects inside a frustum.
+		/// </summary>
+		/// <param name="range"> The frustum range of space being queried. </param>
+		/// <param name="allowDisabled"> If disabled components will be included in this query. </param>
+		/// <returns> The list specified by of all components in range that match the type. </returns>
+		template<typename T>
+		std::vector<T *> QueryComponents(const Frustum &range, const bool &allowDisabled = false)
+		{
+			auto result = std::vector<T *>();
+
+			for (auto &object : QueryFrustum(range))
+			{
+				if (object->IsRemoved())
 				{
 					continue;
 				}
 
-				auto component = (*it)->GetComponent<T>();
+				auto component = object->GetComponent<T>();
 
 				if (component != nullptr && (component->IsEnabled() || allowDisabled))
 				{
@@ -80,24 +141,25 @@ namespace acid
 		template<typename T>
 		T *GetComponent(const bool &allowDisabled = false)
 		{
-			for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
-			{
-				if ((*it)->IsRemoved())
-				{
-					continue;
-				}
-
-				auto component = (*it)->GetComponent<T>();
+			T *result = nullptr;
 
-				if (component != nullptr && (component->IsEnabled() || allowDisabled))
+			ComponentPools::ForEach<T>([&](T *component)
+			{
+				if (result == nullptr && ContainsComponent(*component) && (component->IsEnabled() || allowDisabled))
 				{
-					return component;
+					result = component;
 				}
-			}
+			});
 
-			return nullptr;
+			return result;
 		}
 
 		bool Contains(GameObject *object) override;
+	private:
+		bool ContainsComponent(const IComponent &component) const
+		{
+			GameObject *gameObject = component.GetGameObject();
+			return gameObject != nullptr && !gameObject->IsRemoved() && gameObject->GetStructure() == this;
+		}
 	};
 }
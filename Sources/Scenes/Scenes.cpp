@@ -1,5 +1,7 @@
 #include "Scenes.hpp"
 
+#include <algorithm>
+#include <set>
 #include "Physics/Collider.hpp"
 
 namespace acid
@@ -30,6 +32,10 @@ namespace acid
 		}
 
 		m_scene->GetPhysics()->Update();
+
+		// Bodies are drawn between the last two physics steps, as frames are rendered more often than the physics steps.
+		// This runs before the components update, so every component drawing a body this frame reads the same render transform.
+		m_scene->GetPhysics()->InterpolateTransforms();
 		m_scene->Update();
 
 		if (m_scene->GetStructure() == nullptr)
@@ -37,24 +43,86 @@ namespace acid
 			return;
 		}
 
-		auto gameObjects = m_scene->GetStructure()->GetAll();
+		UpdateComponents(*m_scene->GetStructure());
+		m_scene->GetStructure()->Update();
 
-		for (auto it = gameObjects.begin(); it != gameObjects.end(); ++it)
+		if (m_scene->GetCamera() == nullptr)
 		{
-			if ((*it) == nullptr)
+			return;
+		}
+
+		m_scene->GetCamera()->Update();
+	}
+
+	void Scenes::UpdateComponents(SceneStructure &structure)
+	{
+		auto started = std::vector<GameObject *>();
+
+		// Game objects built before a type was first looked up have no index for it, so every lookup of the type would search all of their components.
+		if (ComponentPools::TakeTypeMatchesAdded())
+		{
+			auto updated = std::set<GameObject *>();
+
+			for (uint32_t pool = 0; pool < ComponentPools::GetPoolCount(); pool++)
 			{
+				for (auto &component : ComponentPools::GetPool(pool))
+				{
+					GameObject *gameObject = component->GetGameObject();
+
+					if (gameObject != nullptr && updated.emplace(gameObject).second)
+					{
+						gameObject->UpdateTypeIndices();
+					}
+				}
+			}
+		}
+
+		// Components are started in the order they were attached, as components often use the components attached before them.
+		for (auto &component : ComponentPools::TakeUnstarted())
+		{
+			GameObject *gameObject = component->GetGameObject();
+
+			if (component->IsStarted() || gameObject == nullptr)
+			{
+				continue;
+			}
+
+			if (gameObject->IsRemoved() || gameObject->GetStructure() != &structure)
+			{
+				ComponentPools::AddUnstarted(component);
 				continue;
 			}
 
-			(*it)->Update();
+			component->Start();
+			component->SetStarted(true);
+			started.emplace_back(gameObject);
 		}
 
-		if (m_scene->GetCamera() == nullptr)
+		// Components are updated a type at a time, so each pass walks one pool. Pools can grow while updating, so they are indexed every time.
+		for (uint32_t pool = 0; pool < ComponentPools::GetPoolCount(); pool++)
 		{
-			return;
+			for (uint32_t i = 0; i < ComponentPools::GetPool(pool).size(); i++)
+			{
+				IComponent *component = ComponentPools::GetPool(pool)[i];
+				GameObject *gameObject = component->GetGameObject();
+
+				if (!component->IsStarted() || !component->IsEnabled() || gameObject == nullptr || gameObject->IsRemoved() || gameObject->GetStructure() != &structure)
+				{
+					continue;
+				}
+
+				component->Update();
+			}
 		}
 
-		m_scene->GetCamera()->Update();
+		// Components usually create their shapes and models when started, so the bounds are recalculated.
+		std::sort(started.begin(), started.end());
+		started.erase(std::unique(started.begin(), started.end()), started.end());
+
+		for (auto &gameObject : started)
+		{
+			structure.Refresh(gameObject);
+		}
 	}
 
 	void Scenes::SetScene(IScene *scene)
@@ -96,5 +96,11 @@ namespace acid
 		/// </summary>
 		/// <returns> If the scene is paused. </returns>
 		bool IsGamePaused() { return m_scene->IsGamePaused(); }
+	private:
+		/// <summary>
+		/// Starts newly attached components, and updates every component of the objects in the structure.
+		/// </summary>
+		/// <param name="structure"> The scene object structure. </param>
+		void UpdateComponents(SceneStructure &structure);
 	};
 }
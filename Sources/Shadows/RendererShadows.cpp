@@ -25,7 +25,11 @@ namespace acid
 
 		m_pipeline.BindPipeline(commandBuffer);
 
-		auto renderList = Scenes::Get()->GetStructure()->QueryComponents<ShadowRender>();
+		// Casters outside of the shadow box are clipped when rendering, so they can be culled.
+		Frustum shadowFrustum = Frustum();
+		shadowFrustum.Update(Shadows::Get()->GetShadowBox().GetLightSpaceTransform(), Shadows::Get()->GetShadowBox().GetProjectionMatrix());
+
+		auto renderList = Scenes::Get()->GetStructure()->QueryComponents<ShadowRender>(shadowFrustum);
 
 		for (auto &shadowRender : renderList)
 		{
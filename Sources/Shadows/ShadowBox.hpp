@@ -108,6 +108,8 @@ namespace acid
 
 		Matrix4 GetProjectionViewMatrix() const { return m_projectionViewMatrix; }
 
+		Matrix4 GetProjectionMatrix() const { return m_projectionMatrix; }
+
 		/// <summary>
 		/// This biased projection-view matrix is used to convert fragments into "shadow map space" when rendering the main render pass.
 		/// </summary>
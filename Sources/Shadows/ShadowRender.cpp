@@ -22,7 +22,7 @@ namespace acid
 	void ShadowRender::Update()
 	{
 		// Updates uniforms.
-		m_uniformObject.Push("transform", GetGameObject()->GetTransform().GetWorldMatrix());
+		m_uniformObject.Push("transform", GetGameObject()->GetRenderTransform().GetWorldMatrix());
 	}
 
 	void ShadowRender::Load(LoadedValue *value)
@@ -44,7 +44,7 @@ namespace acid
 
 	void MaterialSkybox::PushUniforms(UniformHandler &uniformObject)
 	{
-		uniformObject.Push("transform", GetGameObject()->GetTransform().GetWorldMatrix());
+		uniformObject.Push("transform", GetGameObject()->GetRenderTransform().GetWorldMatrix());
 		uniformObject.Push("skyColour", m_skyColour);
 		uniformObject.Push("fogColour", m_fogColour);
 		uniformObject.Push("fogLimits", GetGameObject()->GetTransform().GetScaling().m_y * m_fogLimits);
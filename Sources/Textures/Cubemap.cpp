@@ -2,6 +2,8 @@
 
 #include <cmath>
 #include "Display/Display.hpp"
+#include "Renderer/Memory/Uploader.hpp"
+#include "Renderer/Renderer.hpp"
 
 namespace acid
 {
@@ -22,6 +24,7 @@ namespace acid
 		m_height(0),
 		m_depth(0),
 		m_image(VK_NULL_HANDLE),
+		m_imageMemory(MemoryAllocation()),
 		m_imageView(VK_NULL_HANDLE),
 		m_format(VK_FORMAT_R8G8B8A8_UNORM),
 		m_imageInfo({})
@@ -30,44 +33,37 @@ namespace acid
 		float debugStart = Engine::Get()->GetTimeMs();
 #endif
 
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
-
 		auto pixels = Texture::LoadPixels(filename, fileExt, SIDE_FILE_SUFFIXES, m_size, &m_width, &m_height, &m_depth, &m_components);
 
 		m_mipLevels = mipmap ? Texture::GetMipLevels(m_width, m_height, m_depth) : 1;
 
-		Buffer *bufferStaging = new Buffer(m_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-		void *data;
-		vkMapMemory(logicalDevice, bufferStaging->GetBufferMemory(), 0, m_size, 0, &data);
-		memcpy(data, pixels, m_size);
-		vkUnmapMemory(logicalDevice, bufferStaging->GetBufferMemory());
-
-		Texture::CreateImage(m_image, m_bufferMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, VK_SAMPLE_COUNT_1_BIT, m_mipLevels, m_format, VK_IMAGE_TILING_OPTIMAL,
+		Texture::CreateImage(m_image, m_imageMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, VK_SAMPLE_COUNT_1_BIT, m_mipLevels, m_format, VK_IMAGE_TILING_OPTIMAL,
 			VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 6);
-		Texture::TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels, 6);
-		Texture::CopyBufferToImage(bufferStaging->GetBuffer(), m_image, m_width, m_height, 1, 6);
 
-		if (mipmap)
+		Uploader::Get()->Upload(pixels, m_size, [this, mipmap](const CommandBuffer &commandBuffer, const VkBuffer &stagingBuffer, const VkDeviceSize &stagingOffset)
 		{
-			Texture::CreateMipmaps(m_image, m_width, m_height, 1, m_mipLevels, 6);
-		}
-		else
-		{
-			Texture::TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, 6);
-		}
+			Texture::TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels, 6);
+			Texture::CopyBufferToImage(commandBuffer, stagingBuffer, stagingOffset, m_image, m_width, m_height, 1, 6);
+
+			if (mipmap)
+			{
+				Texture::CreateMipmaps(commandBuffer, m_image, m_width, m_height, 1, m_mipLevels, 6);
+			}
+			else
+			{
+				Texture::TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, 6);
+			}
+
+			Buffer::CopyBuffer(commandBuffer, stagingBuffer, m_buffer, m_size, stagingOffset);
+		});
 
 		Texture::CreateImageSampler(m_sampler, m_repeatEdges, m_anisotropic, m_nearest, m_mipLevels);
 		Texture::CreateImageView(m_image, m_imageView,VK_IMAGE_VIEW_TYPE_CUBE, m_format, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels,  6);
 
-		Buffer::CopyBuffer(bufferStaging->GetBuffer(), m_buffer, m_size);
-
 		m_imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 		m_imageInfo.imageView = m_imageView;
 		m_imageInfo.sampler = m_sampler;
 
-		delete bufferStaging;
 		Texture::DeletePixels(pixels);
 
 #if ACID_VERBOSE
@@ -91,6 +87,7 @@ namespace acid
 		m_height(0),
 		m_depth(0),
 		m_image(VK_NULL_HANDLE),
+		m_imageMemory(MemoryAllocation()),
 		m_imageView(VK_NULL_HANDLE),
 		m_format(VK_FORMAT_R8G8B8A8_UNORM),
 		m_imageInfo({})
@@ -99,11 +96,6 @@ namespace acid
 		float debugStart = Engine::Get()->GetTimeMs();
 #endif
 
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
-
-		Buffer *bufferStaging = new Buffer(m_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
 		if (pixels == nullptr)
 		{
 			pixels = new float[width * height * 6]();
@@ -114,27 +106,25 @@ namespace acid
 			}
 		}
 
-		void *data;
-		vkMapMemory(logicalDevice, bufferStaging->GetBufferMemory(), 0, m_size, 0, &data);
-		memcpy(data, pixels, m_size);
-		vkUnmapMemory(logicalDevice, bufferStaging->GetBufferMemory());
-
-		Texture::CreateImage(m_image, m_bufferMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, VK_SAMPLE_COUNT_1_BIT, m_mipLevels, m_format, VK_IMAGE_TILING_OPTIMAL,
+		Texture::CreateImage(m_image, m_imageMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, VK_SAMPLE_COUNT_1_BIT, m_mipLevels, m_format, VK_IMAGE_TILING_OPTIMAL,
 			VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 6);
-		Texture::TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels, 6);
-		Texture::CopyBufferToImage(bufferStaging->GetBuffer(), m_image, m_width, m_height, 1, 6);
-	//	Texture::CreateMipmaps(m_image, m_width, m_height, m_depth, m_mipLevels, 6);
-		Texture::TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, 6);
+
+		Uploader::Get()->Upload(pixels, m_size, [this](const CommandBuffer &commandBuffer, const VkBuffer &stagingBuffer, const VkDeviceSize &stagingOffset)
+		{
+			Texture::TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels, 6);
+			Texture::CopyBufferToImage(commandBuffer, stagingBuffer, stagingOffset, m_image, m_width, m_height, 1, 6);
+		//	Texture::CreateMipmaps(commandBuffer, m_image, m_width, m_height, m_depth, m_mipLevels, 6);
+			Texture::TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, 6);
+			Buffer::CopyBuffer(commandBuffer, stagingBuffer, m_buffer, m_size, stagingOffset);
+		});
+
 		Texture::CreateImageSampler(m_sampler, m_repeatEdges, m_anisotropic, m_nearest, m_mipLevels);
 		Texture::CreateImageView(m_image, m_imageView, VK_IMAGE_VIEW_TYPE_CUBE, m_format, m_mipLevels, VK_IMAGE_ASPECT_COLOR_BIT, 6);
 
-		Buffer::CopyBuffer(bufferStaging->GetBuffer(), m_buffer, m_size);
-
 		m_imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 		m_imageInfo.imageView = m_imageView;
 		m_imageInfo.sampler = m_sampler;
 
-		delete bufferStaging;
 		delete[] pixels;
 
 #if ACID_VERBOSE
@@ -145,11 +135,15 @@ namespace acid
 
 	Cubemap::~Cubemap()
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		Renderer::DeferDestroy([sampler = m_sampler, imageView = m_imageView, image = m_image, imageMemory = m_imageMemory]() mutable
+		{
+			auto logicalDevice = Display::Get()->GetLogicalDevice();
 
-		vkDestroySampler(logicalDevice, m_sampler, nullptr);
-		vkDestroyImageView(logicalDevice, m_imageView, nullptr);
-		vkDestroyImage(logicalDevice, m_image, nullptr);
+			vkDestroySampler(logicalDevice, sampler, nullptr);
+			vkDestroyImageView(logicalDevice, imageView, nullptr);
+			vkDestroyImage(logicalDevice, image, nullptr);
+			MemoryAllocator::Get()->Free(imageMemory);
+		});
 	}
 
 	DescriptorType Cubemap::CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage)
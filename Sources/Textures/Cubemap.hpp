@@ -28,6 +28,7 @@ namespace acid
 		uint32_t m_width, m_height, m_depth;
 
 		VkImage m_image;
+		MemoryAllocation m_imageMemory;
 		VkImageView m_imageView;
 		VkSampler m_sampler;
 		VkFormat m_format;
@@ -3,6 +3,8 @@
 #include <cmath>
 #include "Display/Display.hpp"
 #include "Helpers/FileSystem.hpp"
+#include "Renderer/Memory/Uploader.hpp"
+#include "Renderer/Renderer.hpp"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -13,7 +15,7 @@ namespace acid
 	static const std::string FALLBACK_PATH = "Undefined.png";
 	static const float ANISOTROPY = 16.0f;
 
-	Texture::Texture(const std::string &filename, const bool &repeatEdges, const bool &mipmap, const bool &anisotropic, const bool &nearest) :
+	Texture::Texture(const std::string &filename, const bool &repeatEdges, const bool &mipmap, const bool &anisotropic, const bool &nearest, const bool &upload) :
 		IResource(),
 		Buffer(LoadSize(filename), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
 		IDescriptor(),
@@ -26,8 +28,11 @@ namespace acid
 		m_components(0),
 		m_width(0),
 		m_height(0),
+		m_loadPixels(nullptr),
 		m_image(VK_NULL_HANDLE),
+		m_imageMemory(MemoryAllocation()),
 		m_imageView(VK_NULL_HANDLE),
+		m_sampler(VK_NULL_HANDLE),
 		m_format(VK_FORMAT_R8G8B8A8_UNORM),
 		m_imageInfo({})
 	{
@@ -35,56 +40,26 @@ namespace acid
 		float debugStart = Engine::Get()->GetTimeMs();
 #endif
 
+		std::string loadFilename = filename;
+
 		if (!FileSystem::FileExists(filename))
 		{
 			fprintf(stderr, "File does not exist: '%s'\n", filename.c_str());
-			m_filename = Files::SearchFile(FALLBACK_PATH);
+			loadFilename = Files::SearchFile(FALLBACK_PATH);
 		}
 
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
-
-		auto pixels = LoadPixels(m_filename, &m_width, &m_height, &m_components);
-
+		m_loadPixels = LoadPixels(loadFilename, &m_width, &m_height, &m_components);
 		m_mipLevels = mipmap ? GetMipLevels(m_width, m_height, 1) : 1;
 
-		Buffer bufferStaging = Buffer(m_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-		void *data;
-		vkMapMemory(logicalDevice, bufferStaging.GetBufferMemory(), 0, m_size, 0, &data);
-		memcpy(data, pixels, m_size);
-		vkUnmapMemory(logicalDevice, bufferStaging.GetBufferMemory());
-
-		CreateImage(m_image, m_bufferMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, m_samples, m_mipLevels, m_format, VK_IMAGE_TILING_OPTIMAL,
-			VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 1);
-		TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels, 1);
-		CopyBufferToImage(bufferStaging.GetBuffer(), m_image, m_width, m_height, 1, 1);
-
-		if (mipmap)
-		{
-			CreateMipmaps(m_image, m_width, m_height, 1, m_mipLevels, 1);
-		}
-		else
-		{
-			TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, 1);
-		}
-
-		CreateImageSampler(m_sampler, m_repeatEdges, m_anisotropic, m_nearest, m_mipLevels);
-		CreateImageView(m_image, m_imageView, VK_IMAGE_VIEW_TYPE_2D, m_format, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 1);
-
-		Buffer::CopyBuffer(bufferStaging.GetBuffer(), m_buffer, m_size);
-
-		m_imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		m_imageInfo.imageView = m_imageView;
-		m_imageInfo.sampler = m_sampler;
-
-		DeletePixels(pixels);
-		m_filename = filename;
-
 #if ACID_VERBOSE
 		float debugEnd = Engine::Get()->GetTimeMs();
-		fprintf(stdout, "Texture '%s' loaded in %fms\n", m_filename.c_str(), debugEnd - debugStart);
+		fprintf(stdout, "Texture '%s' decoded in %fms\n", m_filename.c_str(), debugEnd - debugStart);
 #endif
+
+		if (upload)
+		{
+			Upload();
+		}
 	}
 
 	Texture::Texture(const uint32_t &width, const uint32_t &height, const VkFormat &format, const VkImageLayout &imageLayout, const VkImageUsageFlags &usage, const VkSampleCountFlagBits &samples, float *pixels) :
@@ -99,17 +74,14 @@ namespace acid
 		m_components(4),
 		m_width(width),
 		m_height(height),
+		m_loadPixels(nullptr),
 		m_image(VK_NULL_HANDLE),
+		m_imageMemory(MemoryAllocation()),
 		m_imageView(VK_NULL_HANDLE),
 		m_sampler(VK_NULL_HANDLE),
 		m_format(format),
 		m_imageInfo({})
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
-
-		Buffer *bufferStaging = new Buffer(m_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
 		if (pixels == nullptr)
 		{
 			pixels = new float[width * height]();
@@ -120,37 +92,92 @@ namespace acid
 			}
 		}
 
-		void *data;
-		vkMapMemory(logicalDevice, bufferStaging->GetBufferMemory(), 0, m_size, 0, &data);
-		memcpy(data, pixels, m_size);
-		vkUnmapMemory(logicalDevice, bufferStaging->GetBufferMemory());
-
-		CreateImage(m_image, m_bufferMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, samples, m_mipLevels, m_format, VK_IMAGE_TILING_OPTIMAL,
+		CreateImage(m_image, m_imageMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, samples, m_mipLevels, m_format, VK_IMAGE_TILING_OPTIMAL,
 			usage | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 1);
-		TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels, 1);
-		CopyBufferToImage(bufferStaging->GetBuffer(), m_image, m_width, m_height, 1, 1);
-	//	Texture::CreateMipmaps(m_image, m_width, m_height, 1, m_mipLevels, 1);
-		TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, 1);
+
+		Uploader::Get()->Upload(pixels, m_size, [this](const CommandBuffer &commandBuffer, const VkBuffer &stagingBuffer, const VkDeviceSize &stagingOffset)
+		{
+			TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels, 1);
+			CopyBufferToImage(commandBuffer, stagingBuffer, stagingOffset, m_image, m_width, m_height, 1, 1);
+		//	Texture::CreateMipmaps(commandBuffer, m_image, m_width, m_height, 1, m_mipLevels, 1);
+			TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, 1);
+			Buffer::CopyBuffer(commandBuffer, stagingBuffer, m_buffer, m_size, stagingOffset);
+		});
+
 		CreateImageSampler(m_sampler, m_repeatEdges, m_anisotropic, m_nearest, m_mipLevels);
 		CreateImageView(m_image, m_imageView, VK_IMAGE_VIEW_TYPE_2D, m_format, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 1);
 
-		Buffer::CopyBuffer(bufferStaging->GetBuffer(), GetBuffer(), m_size);
-
 		m_imageInfo.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 		m_imageInfo.imageView = m_imageView;
 		m_imageInfo.sampler = m_sampler;
 
-		delete bufferStaging;
 		delete[] pixels;
 	}
 
 	Texture::~Texture()
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
+		Renderer::DeferDestroy([sampler = m_sampler, imageView = m_imageView, image = m_image, imageMemory = m_imageMemory]() mutable
+		{
+			auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+			vkDestroySampler(logicalDevice, sampler, nullptr);
+			vkDestroyImageView(logicalDevice, imageView, nullptr);
+			vkDestroyImage(logicalDevice, image, nullptr);
+			MemoryAllocator::Get()->Free(imageMemory);
+		});
 
-		vkDestroySampler(logicalDevice, m_sampler, nullptr);
-		vkDestroyImageView(logicalDevice, m_imageView, nullptr);
-		vkDestroyImage(logicalDevice, m_image, nullptr);
+		if (m_loadPixels != nullptr)
+		{
+			DeletePixels(m_loadPixels);
+		}
+	}
+
+	void Texture::Upload()
+	{
+		if (m_loadPixels == nullptr)
+		{
+			return;
+		}
+
+#if ACID_VERBOSE
+		float debugStart = Engine::Get()->GetTimeMs();
+#endif
+
+		CreateImage(m_image, m_imageMemory, m_width, m_height, 1, VK_IMAGE_TYPE_2D, m_samples, m_mipLevels, m_format, VK_IMAGE_TILING_OPTIMAL,
+			VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 1);
+
+		// The copies are batched with the other uploads of this frame, the pixels are staged so they can be freed right away.
+		Uploader::Get()->Upload(m_loadPixels, m_size, [this](const CommandBuffer &commandBuffer, const VkBuffer &stagingBuffer, const VkDeviceSize &stagingOffset)
+		{
+			TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels, 1);
+			CopyBufferToImage(commandBuffer, stagingBuffer, stagingOffset, m_image, m_width, m_height, 1, 1);
+
+			if (m_mipLevels > 1)
+			{
+				CreateMipmaps(commandBuffer, m_image, m_width, m_height, 1, m_mipLevels, 1);
+			}
+			else
+			{
+				TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, 1);
+			}
+
+			Buffer::CopyBuffer(commandBuffer, stagingBuffer, m_buffer, m_size, stagingOffset);
+		});
+
+		CreateImageSampler(m_sampler, m_repeatEdges, m_anisotropic, m_nearest, m_mipLevels);
+		CreateImageView(m_image, m_imageView, VK_IMAGE_VIEW_TYPE_2D, m_format, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 1);
+
+		m_imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		m_imageInfo.imageView = m_imageView;
+		m_imageInfo.sampler = m_sampler;
+
+		DeletePixels(m_loadPixels);
+		m_loadPixels = nullptr;
+
+#if ACID_VERBOSE
+		float debugEnd = Engine::Get()->GetTimeMs();
+		fprintf(stdout, "Texture '%s' uploaded in %fms\n", m_filename.c_str(), debugEnd - debugStart);
+#endif
 	}
 
 	DescriptorType Texture::CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage)
@@ -188,7 +215,7 @@ namespace acid
 		auto logicalDevice = Display::Get()->GetLogicalDevice();
 
 		VkImage dstImage;
-		VkDeviceMemory dstImageMemory;
+		MemoryAllocation dstImageMemory;
 		CopyImage(m_image, dstImage, dstImageMemory, m_width, m_height, 1, false);
 
 		VkImageSubresource imageSubresource = {};
@@ -201,30 +228,17 @@ namespace acid
 
 		uint8_t *result = new uint8_t[subresourceLayout.size];
 
-		void *data;
-		vkMapMemory(logicalDevice, dstImageMemory, subresourceLayout.offset, subresourceLayout.size, 0, &data);
-		memcpy(result, data, static_cast<size_t>(subresourceLayout.size));
-		vkUnmapMemory(logicalDevice, dstImageMemory);
+		memcpy(result, static_cast<char *>(dstImageMemory.GetMapped()) + subresourceLayout.offset, static_cast<size_t>(subresourceLayout.size));
 
-		vkFreeMemory(logicalDevice, dstImageMemory, nullptr);
 		vkDestroyImage(logicalDevice, dstImage, nullptr);
+		MemoryAllocator::Get()->Free(dstImageMemory);
 
 		return result;
 	}
 
 	void Texture::SetPixels(uint8_t *pixels)
 	{
-		auto logicalDevice = Display::Get()->GetLogicalDevice();
-
-		Buffer *bufferStaging = new Buffer(m_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-		void *data;
-		vkMapMemory(logicalDevice, bufferStaging->GetBufferMemory(), 0, m_size, 0, &data);
-		memcpy(data, pixels, m_size);
-		vkUnmapMemory(logicalDevice, bufferStaging->GetBufferMemory());
-
-		Buffer::CopyBuffer(bufferStaging->GetBuffer(), GetBuffer(), m_size);
+		Uploader::Get()->UploadBuffer(*this, pixels, m_size);
 	}
 
 	int32_t Texture::LoadSize(const std::string &filepath)
@@ -328,7 +342,7 @@ namespace acid
 		return static_cast<uint32_t>(std::floor(std::log2(std::max(width, std::max(height, depth)))) + 1);
 	}
 
-	void Texture::CreateImage(VkImage &image, VkDeviceMemory &imageMemory, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const VkImageType &type, const VkSampleCountFlagBits &samples, const uint32_t &mipLevels, const VkFormat &format, const VkImageTiling &tiling, const VkImageUsageFlags &usage, const VkMemoryPropertyFlags &properties, const uint32_t &arrayLayers)
+	void Texture::CreateImage(VkImage &image, MemoryAllocation &imageMemory, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const VkImageType &type, const VkSampleCountFlagBits &samples, const uint32_t &mipLevels, const VkFormat &format, const VkImageTiling &tiling, const VkImageUsageFlags &usage, const VkMemoryPropertyFlags &properties, const uint32_t &arrayLayers)
 	{
 		auto logicalDevice = Display::Get()->GetLogicalDevice();
 
@@ -353,14 +367,12 @@ namespace acid
 		VkMemoryRequirements memoryRequirements;
 		vkGetImageMemoryRequirements(logicalDevice, image, &memoryRequirements);
 
-		VkMemoryAllocateInfo memoryAllocateInfo = {};
-		memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		memoryAllocateInfo.allocationSize = memoryRequirements.size;
-		memoryAllocateInfo.memoryTypeIndex = Buffer::FindMemoryType(memoryRequirements.memoryTypeBits, properties);;
+		// Linear images are only used to read back pixels, so they are transient. They never share blocks with optimal images.
+		auto memoryResource = tiling == VK_IMAGE_TILING_LINEAR ? MEMORY_RESOURCE_IMAGE_LINEAR : MEMORY_RESOURCE_IMAGE_OPTIMAL;
+		auto memoryUsage = tiling == VK_IMAGE_TILING_LINEAR ? MEMORY_USAGE_TRANSIENT : MEMORY_USAGE_STATIC;
+		imageMemory = MemoryAllocator::Get()->Allocate(memoryRequirements, properties, memoryResource, memoryUsage);
 
-		Display::CheckVk(vkAllocateMemory(logicalDevice, &memoryAllocateInfo, nullptr, &imageMemory));
-
-		Display::CheckVk(vkBindImageMemory(logicalDevice, image, imageMemory, 0));
+		Display::CheckVk(vkBindImageMemory(logicalDevice, image, imageMemory.GetMemory(), imageMemory.GetOffset()));
 	}
 
 	bool Texture::HasStencilComponent(const VkFormat &format)
@@ -368,10 +380,8 @@ namespace acid
 		return format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT;
 	}
 
-	void Texture::TransitionImageLayout(const VkImage &image, const VkFormat &format, const VkImageLayout &srcImageLayout, const VkImageLayout &dstImageLayout, const uint32_t &mipLevels, const uint32_t &layerCount)
+	void Texture::TransitionImageLayout(const CommandBuffer &commandBuffer, const VkImage &image, const VkFormat &format, const VkImageLayout &srcImageLayout, const VkImageLayout &dstImageLayout, const uint32_t &mipLevels, const uint32_t &layerCount)
 	{
-		CommandBuffer commandBuffer = CommandBuffer();
-
 		VkImageMemoryBarrier imageMemoryBarrier = {};
 		imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 		imageMemoryBarrier.oldLayout = srcImageLayout;
@@ -440,17 +450,12 @@ namespace acid
 		}
 
 		vkCmdPipelineBarrier(commandBuffer.GetCommandBuffer(), srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-
-		commandBuffer.End();
-		commandBuffer.Submit();
 	}
 
-	void Texture::CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const uint32_t &layerCount)
+	void Texture::CopyBufferToImage(const CommandBuffer &commandBuffer, const VkBuffer &buffer, const VkDeviceSize &bufferOffset, const VkImage &image, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const uint32_t &layerCount)
 	{
-		CommandBuffer commandBuffer = CommandBuffer();
-
 		VkBufferImageCopy region = {};
-		region.bufferOffset = 0;
+		region.bufferOffset = bufferOffset;
 		region.bufferRowLength = 0;
 		region.bufferImageHeight = 0;
 		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -461,15 +466,10 @@ namespace acid
 		region.imageExtent = {width, height, depth};
 
 		vkCmdCopyBufferToImage(commandBuffer.GetCommandBuffer(), buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-		commandBuffer.End();
-		commandBuffer.Submit();
 	}
 
-	void Texture::CreateMipmaps(const VkImage &image, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const uint32_t &mipLevels, const uint32_t &layerCount)
+	void Texture::CreateMipmaps(const CommandBuffer &commandBuffer, const VkImage &image, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const uint32_t &mipLevels, const uint32_t &layerCount)
 	{
-		CommandBuffer commandBuffer = CommandBuffer();
-
 		VkImageMemoryBarrier barrier = {};
 		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 		barrier.image = image;
@@ -556,9 +556,6 @@ namespace acid
 			0, nullptr,
 			0, nullptr,
 			1, &barrier);
-
-		commandBuffer.End();
-		commandBuffer.Submit();
 	}
 
 	void Texture::CreateImageSampler(VkSampler &sampler, const bool &repeatEdges, const bool &anisotropic, const bool &nearest, const uint32_t &mipLevels)
@@ -609,7 +606,7 @@ namespace acid
 		Display::CheckVk(vkCreateImageView(logicalDevice, &imageViewCreateInfo, nullptr, &imageView));
 	}
 
-	bool Texture::CopyImage(const VkImage &srcImage, VkImage &dstImage, VkDeviceMemory &dstImageMemory, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const bool &srcSwapchain)
+	bool Texture::CopyImage(const VkImage &srcImage, VkImage &dstImage, MemoryAllocation &dstImageMemory, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const bool &srcSwapchain)
 	{
 		// TODO: Reduce amount of Vulkan warnings.
 		auto physicalDevice = Display::Get()->GetPhysicalDevice();
@@ -29,8 +29,10 @@ namespace acid
 
 		uint32_t m_components;
 		uint32_t m_width, m_height;
+		uint8_t *m_loadPixels;
 
 		VkImage m_image;
+		MemoryAllocation m_imageMemory;
 		VkImageView m_imageView;
 		VkSampler m_sampler;
 		VkFormat m_format;
@@ -52,6 +54,18 @@ namespace acid
 			return result;
 		}
 
+		static ResourceFuture<Texture> ResourceAsync(const std::string &filename)
+		{
+			std::string realFilename = Files::SearchFile(filename);
+			return Resources::Get()->LoadAsync<Texture>(realFilename, [realFilename]()
+			{
+				return std::make_shared<Texture>(realFilename, true, true, true, false, false);
+			}, [](Texture &texture)
+			{
+				texture.Upload();
+			});
+		}
+
 		/// <summary>
 		/// A new texture object.
 		/// </summary>
@@ -60,7 +74,8 @@ namespace acid
 		/// <param name="mipmap"> If mipmaps will be used on the texture. </param>
 		/// <param name="anisotropic"> If anisotropic will be use on the texture. </param>
 		/// <param name="nearest"> If nearest filtering will be use on the texture. </param>
-		Texture(const std::string &filename, const bool &repeatEdges = true, const bool &mipmap = true, const bool &anisotropic = true, const bool &nearest = false);
+		/// <param name="upload"> If the decoded pixels will be uploaded right away, otherwise <see cref="#Upload()"/> must be called from the main thread. </param>
+		Texture(const std::string &filename, const bool &repeatEdges = true, const bool &mipmap = true, const bool &anisotropic = true, const bool &nearest = false, const bool &upload = true);
 
 		/// <summary>
 		/// A new texture object from a array of pixels.
@@ -80,6 +95,11 @@ namespace acid
 		/// </summary>
 		~Texture();
 
+		/// <summary>
+		/// Uploads the decoded pixels into the image, does nothing if the texture has already been uploaded.
+		/// </summary>
+		void Upload();
+
 		static DescriptorType CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage);
 
 		VkWriteDescriptorSet GetWriteDescriptor(const uint32_t &binding, const DescriptorSet &descriptorSet) const override;
@@ -124,21 +144,21 @@ namespace acid
 
 		static uint32_t GetMipLevels(const uint32_t &width, const uint32_t &height, const uint32_t &depth);
 
-		static void CreateImage(VkImage &image, VkDeviceMemory &imageMemory, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const VkImageType &type, const VkSampleCountFlagBits &samples, const uint32_t &mipLevels, const VkFormat &format, const VkImageTiling &tiling, const VkImageUsageFlags &usage, const VkMemoryPropertyFlags &properties, const uint32_t &arrayLayers);
+		static void CreateImage(VkImage &image, MemoryAllocation &imageMemory, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const VkImageType &type, const VkSampleCountFlagBits &samples, const uint32_t &mipLevels, const VkFormat &format, const VkImageTiling &tiling, const VkImageUsageFlags &usage, const VkMemoryPropertyFlags &properties, const uint32_t &arrayLayers);
 
 		static bool HasStencilComponent(const VkFormat &format);
 
-		static void TransitionImageLayout(const VkImage &image, const VkFormat &format, const VkImageLayout &srcImageLayout, const VkImageLayout &dstImageLayout, const uint32_t &mipLevels, const uint32_t &layerCount);
+		static void TransitionImageLayout(const CommandBuffer &commandBuffer, const VkImage &image, const VkFormat &format, const VkImageLayout &srcImageLayout, const VkImageLayout &dstImageLayout, const uint32_t &mipLevels, const uint32_t &layerCount);
 
-		static void CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const uint32_t &layerCount);
+		static void CopyBufferToImage(const CommandBuffer &commandBuffer, const VkBuffer &buffer, const VkDeviceSize &bufferOffset, const VkImage &image, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const uint32_t &layerCount);
 
-		static void CreateMipmaps(const VkImage &image, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const uint32_t &mipLevels, const uint32_t &layerCount);
+		static void CreateMipmaps(const CommandBuffer &commandBuffer, const VkImage &image, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const uint32_t &mipLevels, const uint32_t &layerCount);
 
 		static void CreateImageSampler(VkSampler &sampler, const bool &repeatEdges, const bool &anisotropic, const bool &nearest, const uint32_t &mipLevels);
 
 		static void CreateImageView(const VkImage &image, VkImageView &imageView, const VkImageViewType &type, const VkFormat &format, const VkImageAspectFlags &imageAspect, const uint32_t &mipLevels, const uint32_t &layerCount);
 
-		static bool CopyImage(const VkImage &srcImage, VkImage &dstImage, VkDeviceMemory &dstImageMemory, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const bool &srcSwapchain);
+		static bool CopyImage(const VkImage &srcImage, VkImage &dstImage, MemoryAllocation &dstImageMemory, const uint32_t &width, const uint32_t &height, const uint32_t &depth, const bool &srcSwapchain);
 
 		static void InsertImageMemoryBarrier(const VkCommandBuffer &cmdbuffer, const VkImage &image, const VkAccessFlags &srcAccessMask,
 											 const VkAccessFlags &dstAccessMask, const VkImageLayout &oldImageLayout, const VkImageLayout &newImageLayout,
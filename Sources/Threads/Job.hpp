@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	class Job;
+
+	/// <summary>
+	/// A counter shared between one or more jobs, it completes once every job it counts has been executed.
+	/// </summary>
+	class ACID_EXPORT JobCounter
+	{
+	private:
+		friend class ThreadPool;
+
+		std::atomic<uint32_t> m_pending;
+		std::atomic<bool> m_complete;
+		std::mutex m_mutex;
+		std::vector<Job *> m_continuations;
+	public:
+		explicit JobCounter(const uint32_t &pending) :
+			m_pending(pending),
+			m_complete(pending == 0),
+			m_mutex(),
+			m_continuations(std::vector<Job *>())
+		{
+		}
+
+		bool IsComplete() const { return m_complete.load(std::memory_order_acquire); }
+	};
+
+	/// <summary>
+	/// A handle that can be waited on, or depended on, for a group of jobs scheduled in the thread pool.
+	/// </summary>
+	class ACID_EXPORT JobHandle
+	{
+	private:
+		friend class ThreadPool;
+
+		std::shared_ptr<JobCounter> m_counter;
+	public:
+		JobHandle() :
+			m_counter(nullptr)
+		{
+		}
+
+		explicit JobHandle(const std::shared_ptr<JobCounter> &counter) :
+			m_counter(counter)
+		{
+		}
+
+		/// <summary>
+		/// Gets if all jobs referenced by this handle have been executed, a empty handle is always complete.
+		/// </summary>
+		/// <returns> If the jobs are complete. </returns>
+		bool IsComplete() const { return m_counter == nullptr || m_counter->IsComplete(); }
+	};
+
+	/// <summary>
+	/// A unit of work executed by the thread pool.
+	/// </summary>
+	class ACID_EXPORT Job
+	{
+	private:
+		friend class ThreadPool;
+
+		std::function<void()> m_function;
+		std::shared_ptr<JobCounter> m_counter;
+		std::atomic<uint32_t> m_dependencies;
+	public:
+		Job(std::function<void()> function, const std::shared_ptr<JobCounter> &counter, const uint32_t &dependencies) :
+			m_function(std::move(function)),
+			m_counter(counter),
+			m_dependencies(dependencies)
+		{
+		}
+	};
+}
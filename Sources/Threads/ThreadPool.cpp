@@ -1,26 +1,310 @@
 #include "ThreadPool.hpp"
 
+#include <algorithm>
+
 namespace acid
 {
 	const uint32_t ThreadPool::HARDWARE_CONCURRENCY = std::thread::hardware_concurrency();
 
-	ThreadPool::ThreadPool(const uint32_t &threadCount)
+	static thread_local const ThreadPool *CURRENT_POOL = nullptr;
+	static thread_local int32_t CURRENT_INDEX = -1;
+
+	ThreadPool::ThreadPool(const uint32_t &threadCount) :
+		m_threads(std::vector<std::thread>()),
+		m_queues(std::vector<std::unique_ptr<WorkStealingDeque<Job *>>>()),
+		m_globalMutex(),
+		m_globalQueue(std::deque<Job *>()),
+		m_queuedJobs(0),
+		m_unfinishedJobs(0),
+		m_sleepMutex(),
+		m_condition(),
+		m_destroying(false)
 	{
-		for (uint32_t i = 0; i < threadCount; i++)
+		uint32_t count = std::max(threadCount, 1u);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			m_queues.emplace_back(std::make_unique<WorkStealingDeque<Job *>>());
+		}
+
+		CURRENT_POOL = this;
+		CURRENT_INDEX = 0;
+
+		for (uint32_t i = 1; i < count; i++)
 		{
-			m_threads.push_back(std::make_unique<Thread>());
+			m_threads.emplace_back(std::thread(&ThreadPool::WorkerLoop, this, i));
 		}
 	}
 
 	ThreadPool::~ThreadPool()
 	{
+		Wait();
+
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_destroying = true;
+		}
+
+		m_condition.notify_all();
+
+		for (auto &thread : m_threads)
+		{
+			thread.join();
+		}
+
+		if (CURRENT_POOL == this)
+		{
+			CURRENT_POOL = nullptr;
+			CURRENT_INDEX = -1;
+		}
+	}
+
+	void ThreadPool::Update()
+	{
+	}
+
+	JobHandle ThreadPool::Run(std::function<void()> function, const std::vector<JobHandle> &dependencies)
+	{
+		auto counter = std::make_shared<JobCounter>(1);
+		auto job = new Job(std::move(function), counter, static_cast<uint32_t>(dependencies.size()) + 1);
+		m_unfinishedJobs++;
+
+		for (auto &dependency : dependencies)
+		{
+			AddDependency(job, dependency);
+		}
+
+		// Releases the guard dependency, the job is scheduled here unless a dependency is still pending.
+		if (--job->m_dependencies == 0)
+		{
+			Schedule(job);
+		}
+
+		return JobHandle(counter);
+	}
+
+	JobHandle ThreadPool::ParallelFor(const uint32_t &begin, const uint32_t &end, const std::function<void(uint32_t, uint32_t)> &function,
+		const uint32_t &grainSize, const std::vector<JobHandle> &dependencies)
+	{
+		if (end <= begin)
+		{
+			return JobHandle();
+		}
+
+		uint32_t count = end - begin;
+		uint32_t grain = grainSize;
+
+		if (grain == 0)
+		{
+			// Several chunks per thread so stealing can balance uneven work.
+			grain = std::max(count / (GetThreadCount() * 4), 1u);
+		}
+
+		uint32_t chunks = (count + grain - 1) / grain;
+		auto counter = std::make_shared<JobCounter>(chunks);
+
+		// Chunks depend on a single empty job that joins all dependencies, instead of every chunk registering with every dependency.
+		auto gate = dependencies.empty() ? JobHandle() : Run([]() {}, dependencies);
+
+		for (uint32_t i = 0; i < chunks; i++)
+		{
+			uint32_t chunkBegin = begin + (i * grain);
+			uint32_t chunkEnd = std::min(chunkBegin + grain, end);
+			auto job = new Job([function, chunkBegin, chunkEnd]()
+			{
+				function(chunkBegin, chunkEnd);
+			}, counter, 2);
+			m_unfinishedJobs++;
+			AddDependency(job, gate);
+
+			if (--job->m_dependencies == 0)
+			{
+				Schedule(job);
+			}
+		}
+
+		return JobHandle(counter);
+	}
+
+	void ThreadPool::Wait(const JobHandle &handle)
+	{
+		int32_t index = GetThreadIndex();
+
+		while (!handle.IsComplete())
+		{
+			Job *job = nullptr;
+
+			if (FindJob(index, job))
+			{
+				Execute(job);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
 	}
 
 	void ThreadPool::Wait()
 	{
-		for (auto &thread : m_threads)
+		int32_t index = GetThreadIndex();
+
+		while (m_unfinishedJobs.load(std::memory_order_acquire) != 0)
 		{
-			thread->Wait();
+			Job *job = nullptr;
+
+			if (FindJob(index, job))
+			{
+				Execute(job);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	int32_t ThreadPool::GetThreadIndex() const
+	{
+		return CURRENT_POOL == this ? CURRENT_INDEX : -1;
+	}
+
+	void ThreadPool::Schedule(Job *job)
+	{
+		int32_t index = GetThreadIndex();
+		m_queuedJobs++;
+
+		if (index == -1 || !m_queues[index]->Push(job))
+		{
+			std::lock_guard<std::mutex> lock(m_globalMutex);
+			m_globalQueue.emplace_back(job);
+		}
+
+		// Taking the lock orders this notify after a worker has checked the job count, so the wake up can not be lost.
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+		}
+
+		m_condition.notify_one();
+	}
+
+	void ThreadPool::AddDependency(Job *job, const JobHandle &dependency)
+	{
+		if (dependency.m_counter != nullptr)
+		{
+			std::lock_guard<std::mutex> lock(dependency.m_counter->m_mutex);
+
+			if (!dependency.m_counter->IsComplete())
+			{
+				dependency.m_counter->m_continuations.emplace_back(job);
+				return;
+			}
+		}
+
+		job->m_dependencies--;
+	}
+
+	void ThreadPool::Execute(Job *job)
+	{
+		job->m_function();
+
+		auto counter = job->m_counter;
+		delete job;
+
+		if (--counter->m_pending == 0)
+		{
+			Release(counter.get());
+		}
+
+		m_unfinishedJobs--;
+	}
+
+	void ThreadPool::Release(JobCounter *counter)
+	{
+		std::vector<Job *> continuations;
+
+		{
+			std::lock_guard<std::mutex> lock(counter->m_mutex);
+			counter->m_complete.store(true, std::memory_order_release);
+			continuations.swap(counter->m_continuations);
+		}
+
+		for (auto &continuation : continuations)
+		{
+			if (--continuation->m_dependencies == 0)
+			{
+				Schedule(continuation);
+			}
+		}
+	}
+
+	bool ThreadPool::FindJob(const int32_t &index, Job *&job)
+	{
+		if (m_queuedJobs.load(std::memory_order_acquire) == 0)
+		{
+			return false;
+		}
+
+		if (index != -1 && m_queues[index]->Pop(job))
+		{
+			m_queuedJobs--;
+			return true;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_globalMutex);
+
+			if (!m_globalQueue.empty())
+			{
+				job = m_globalQueue.front();
+				m_globalQueue.pop_front();
+				m_queuedJobs--;
+				return true;
+			}
+		}
+
+		auto count = static_cast<uint32_t>(m_queues.size());
+		uint32_t start = index == -1 ? 0 : static_cast<uint32_t>(index) + 1;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t victim = (start + i) % count;
+
+			if (static_cast<int32_t>(victim) != index && m_queues[victim]->Steal(job))
+			{
+				m_queuedJobs--;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ThreadPool::WorkerLoop(const uint32_t &index)
+	{
+		CURRENT_POOL = this;
+		CURRENT_INDEX = static_cast<int32_t>(index);
+
+		while (true)
+		{
+			Job *job = nullptr;
+
+			if (FindJob(CURRENT_INDEX, job))
+			{
+				Execute(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_condition.wait(lock, [this]
+			{
+				return m_queuedJobs.load(std::memory_order_acquire) != 0 || m_destroying;
+			});
+
+			if (m_destroying)
+			{
+				break;
+			}
 		}
 	}
 }
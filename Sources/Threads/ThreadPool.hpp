@@ -1,30 +1,112 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <vector>
-#include "Engine/Exports.hpp"
-#include "Thread.hpp"
+#include "Engine/Engine.hpp"
+#include "Job.hpp"
+#include "WorkStealingDeque.hpp"
 
 namespace acid
 {
 	/// <summary>
-	/// A pool of threads.
+	/// A work stealing job system, each worker owns a lock-free deque and idle workers steal from the others.
+	/// Threads waiting on a job handle help execute jobs instead of blocking.
 	/// </summary>
-	class ACID_EXPORT ThreadPool
+	class ACID_EXPORT ThreadPool :
+		public IModule
 	{
 	private:
-		std::vector<std::unique_ptr<Thread>> m_threads;
+		std::vector<std::thread> m_threads;
+		std::vector<std::unique_ptr<WorkStealingDeque<Job *>>> m_queues;
+
+		std::mutex m_globalMutex;
+		std::deque<Job *> m_globalQueue;
+
+		std::atomic<uint32_t> m_queuedJobs;
+		std::atomic<uint32_t> m_unfinishedJobs;
+
+		std::mutex m_sleepMutex;
+		std::condition_variable m_condition;
+		std::atomic<bool> m_destroying;
 	public:
 		static const uint32_t HARDWARE_CONCURRENCY;
 
+		/// <summary>
+		/// Gets this engine instance.
+		/// </summary>
+		/// <returns> The current module instance. </returns>
+		static ThreadPool *Get()
+		{
+			return Engine::Get()->GetModule<ThreadPool>();
+		}
+
+		/// <summary>
+		/// Creates a new thread pool, the creating thread takes part in executing jobs while it waits.
+		/// </summary>
+		/// <param name="threadCount"> The total thread count including the creating thread. </param>
 		ThreadPool(const uint32_t &threadCount = HARDWARE_CONCURRENCY);
 
 		~ThreadPool();
 
+		void Update() override;
+
+		/// <summary>
+		/// Schedules a job to be executed once all of its dependencies have completed.
+		/// </summary>
+		/// <param name="function"> The job function. </param>
+		/// <param name="dependencies"> Handles that must complete before this job can run. </param>
+		/// <returns> A handle to the scheduled job. </returns>
+		JobHandle Run(std::function<void()> function, const std::vector<JobHandle> &dependencies = {});
+
+		/// <summary>
+		/// Splits a range into chunks that are executed as jobs.
+		/// </summary>
+		/// <param name="begin"> The first index in the range. </param>
+		/// <param name="end"> One past the last index in the range. </param>
+		/// <param name="function"> The function called with the start and end of each chunk. </param>
+		/// <param name="grainSize"> The minimum number of indices per job, zero to pick from the thread count. </param>
+		/// <param name="dependencies"> Handles that must complete before any chunk can run. </param>
+		/// <returns> A handle that completes when every chunk is executed. </returns>
+		JobHandle ParallelFor(const uint32_t &begin, const uint32_t &end, const std::function<void(uint32_t, uint32_t)> &function,
+			const uint32_t &grainSize = 0, const std::vector<JobHandle> &dependencies = {});
+
 		/// <summary>
-		/// Waits until all threads are finished.
+		/// Waits until the jobs behind a handle have been executed, executing other jobs in the meantime.
+		/// </summary>
+		/// <param name="handle"> The handle to wait on. </param>
+		void Wait(const JobHandle &handle);
+
+		/// <summary>
+		/// Waits until all scheduled jobs have been executed.
 		/// </summary>
 		void Wait();
 
-		std::vector<std::unique_ptr<Thread>> &GetThreads() { return m_threads; }
+		/// <summary>
+		/// Gets the number of threads executing jobs, including the thread that created the pool.
+		/// </summary>
+		/// <returns> The thread count. </returns>
+		uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_queues.size()); }
+
+		/// <summary>
+		/// Gets the index of the calling thread inside this pool, the creating thread is index 0.
+		/// </summary>
+		/// <returns> The thread index, or -1 if the thread is not owned by this pool. </returns>
+		int32_t GetThreadIndex() const;
+	private:
+		void Schedule(Job *job);
+
+		void AddDependency(Job *job, const JobHandle &dependency);
+
+		void Execute(Job *job);
+
+		void Release(JobCounter *counter);
+
+		bool FindJob(const int32_t &index, Job *&job);
+
+		void WorkerLoop(const uint32_t &index);
 	};
 }
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace acid
+{
+	/// <summary>
+	/// A fixed capacity lock-free Chase-Lev deque. The owning thread pushes and pops from the bottom, while any other thread may steal from the top.
+	/// </summary>
+	/// <param name="T"> The trivially copyable item type, usually a pointer. </param>
+	/// <param name="Capacity"> The maximum number of items, must be a power of two. </param>
+	template<typename T, std::size_t Capacity = 4096>
+	class WorkStealingDeque
+	{
+	private:
+		static_assert((Capacity & (Capacity - 1)) == 0, "WorkStealingDeque capacity must be a power of two!");
+
+		static const int64_t MASK = static_cast<int64_t>(Capacity) - 1;
+
+		alignas(64) std::atomic<int64_t> m_top;
+		alignas(64) std::atomic<int64_t> m_bottom;
+		std::array<std::atomic<T>, Capacity> m_items;
+	public:
+		WorkStealingDeque() :
+			m_top(0),
+			m_bottom(0),
+			m_items()
+		{
+		}
+
+		/// <summary>
+		/// Pushes a item onto the bottom of the deque, only called by the owning thread.
+		/// </summary>
+		/// <param name="item"> The item to push. </param>
+		/// <returns> If the item was pushed, false if the deque is full. </returns>
+		bool Push(const T &item)
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			int64_t top = m_top.load(std::memory_order_acquire);
+
+			if (bottom - top >= static_cast<int64_t>(Capacity))
+			{
+				return false;
+			}
+
+			m_items[bottom & MASK].store(item, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		/// <summary>
+		/// Pops the most recently pushed item from the bottom of the deque, only called by the owning thread.
+		/// </summary>
+		/// <param name="item"> The popped item. </param>
+		/// <returns> If a item was popped. </returns>
+		bool Pop(T &item)
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			item = m_items[bottom & MASK].load(std::memory_order_relaxed);
+
+			if (top != bottom)
+			{
+				return true;
+			}
+
+			// The last item, race against stealing threads.
+			bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return won;
+		}
+
+		/// <summary>
+		/// Steals the oldest item from the top of the deque, can be called from any thread.
+		/// </summary>
+		/// <param name="item"> The stolen item. </param>
+		/// <returns> If a item was stolen. </returns>
+		bool Steal(T &item)
+		{
+			int64_t top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+			{
+				return false;
+			}
+
+			item = m_items[top & MASK].load(std::memory_order_relaxed);
+			return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Gets a approximate count of items in the deque.
+		/// </summary>
+		/// <returns> The approximate size. </returns>
+		std::size_t GetSize() const
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			int64_t top = m_top.load(std::memory_order_relaxed);
+			return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+		}
+	};
+}
@@ -0,0 +1,15 @@
+set(TESTPARTICLES_HEADERS_
+        )
+
+set(TESTPARTICLES_SOURCES_
+        "TestParticles.rc"
+        "Main.cpp"
+        )
+
+source_group("Header Files" FILES ${TESTPARTICLES_HEADERS_})
+source_group("Source Files" FILES ${TESTPARTICLES_SOURCES_})
+
+set(TESTPARTICLES_SOURCES
+        ${TESTPARTICLES_HEADERS_}
+        ${TESTPARTICLES_SOURCES_}
+        )
\ No newline at end of file
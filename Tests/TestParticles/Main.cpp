@@ -0,0 +1,83 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <Maths/Colour.hpp>
+#include <Maths/Maths.hpp>
+#include <Maths/Vector3.hpp>
+#include <Particles/ParticleInstance.hpp>
+#include <Particles/ParticlePool.hpp>
+
+using namespace acid;
+
+static const uint32_t PARTICLE_COUNT = 100000;
+static const uint32_t FRAME_COUNT = 200;
+static const float DELTA = 1.0f / 60.0f;
+
+static float ElapsedMs(const std::chrono::high_resolution_clock::time_point &start)
+{
+	return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static void Spawn(ParticlePool &pool, const std::shared_ptr<ParticleType> &particleType)
+{
+	Vector3 position = Vector3(Maths::Random(-50.0f, 50.0f), Maths::Random(0.0f, 20.0f), Maths::Random(-50.0f, 50.0f));
+	Vector3 velocity = Vector3::RandomUnitVector() * Maths::Random(0.5f, 4.0f);
+	pool.Add(Particle(particleType, position, velocity, Maths::Random(1.0f, 4.0f), Maths::Random(0.0f, 360.0f), Maths::Random(0.5f, 1.5f), 0.2f));
+}
+
+int main(int argc, char **argv)
+{
+	// Particles without a texture skip the atlas stages, every other part of a frame is measured.
+	auto particleType = std::make_shared<ParticleType>(nullptr, 4, Colour::WHITE, 2.0f, 1.0f);
+	ParticlePool pool = ParticlePool(particleType);
+	std::vector<ParticleInstance> instances = std::vector<ParticleInstance>();
+	Vector3 cameraPosition = Vector3(0.0f, 10.0f, -80.0f);
+
+	float updateMs = 0.0f;
+	float sortMs = 0.0f;
+	float writeMs = 0.0f;
+	uint64_t processed = 0;
+
+	for (uint32_t frame = 0; frame < FRAME_COUNT; frame++)
+	{
+		// Particles that died last frame are replaced, so every frame works on the same count.
+		while (pool.GetCount() < PARTICLE_COUNT)
+		{
+			Spawn(pool, particleType);
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		pool.Update(DELTA, cameraPosition);
+		updateMs += ElapsedMs(start);
+
+		start = std::chrono::high_resolution_clock::now();
+		auto &drawOrder = pool.SortBackToFront();
+		sortMs += ElapsedMs(start);
+
+		start = std::chrono::high_resolution_clock::now();
+		instances.resize(pool.GetCount());
+		pool.WriteInstances(drawOrder, instances.data());
+		writeMs += ElapsedMs(start);
+		processed += pool.GetCount();
+	}
+
+	// The draw order is checked so a broken sort can not report a fast time, depth is quantized so near equal particles may swap.
+	auto &drawOrder = pool.SortBackToFront();
+
+	for (uint32_t i = 1; i < pool.GetCount(); i++)
+	{
+		if (pool.GetDistanceToCamera(drawOrder[i - 1]) < pool.GetDistanceToCamera(drawOrder[i]) * 0.99f)
+		{
+			fprintf(stderr, "Particles are not sorted back to front at %i\n", i);
+			return 1;
+		}
+	}
+
+	float totalMs = updateMs + sortMs + writeMs;
+	fprintf(stdout, "Particles: %i, Frames: %i\n", PARTICLE_COUNT, FRAME_COUNT);
+	fprintf(stdout, "  Update: %.3fms per frame, %.0f particles per ms\n", updateMs / FRAME_COUNT, static_cast<float>(processed) / updateMs);
+	fprintf(stdout, "  Sort: %.3fms per frame, %.0f particles per ms\n", sortMs / FRAME_COUNT, static_cast<float>(processed) / sortMs);
+	fprintf(stdout, "  Instances: %.3fms per frame, %.0f particles per ms\n", writeMs / FRAME_COUNT, static_cast<float>(processed) / writeMs);
+	fprintf(stdout, "  Total: %.3fms per frame, %.0f particles per ms\n", totalMs / FRAME_COUNT, static_cast<float>(processed) / totalMs);
+	return 0;
+}
@@ -0,0 +1,15 @@
+set(TESTPHYSICSTHREADS_HEADERS_
+        )
+
+set(TESTPHYSICSTHREADS_SOURCES_
+        "TestPhysicsThreads.rc"
+        "Main.cpp"
+        )
+
+source_group("Header Files" FILES ${TESTPHYSICSTHREADS_HEADERS_})
+source_group("Source Files" FILES ${TESTPHYSICSTHREADS_SOURCES_})
+
+set(TESTPHYSICSTHREADS_SOURCES
+        ${TESTPHYSICSTHREADS_HEADERS_}
+        ${TESTPHYSICSTHREADS_SOURCES_}
+        )
\ No newline at end of file
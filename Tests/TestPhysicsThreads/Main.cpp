@@ -0,0 +1,130 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <Maths/Vector3.hpp>
+#include <Physics/ColliderBox.hpp>
+#include <Physics/ColliderSphere.hpp>
+#include <Physics/MotionState.hpp>
+#include <Physics/PhysicsScheduler.hpp>
+#include <Scenes/ScenePhysics.hpp>
+#include <Threads/ThreadPool.hpp>
+
+using namespace acid;
+
+static const uint32_t STACK_COUNT = 16;
+static const uint32_t STACK_HEIGHT = 10;
+static const uint32_t STEP_COUNT = 300;
+static const uint32_t MAX_THREADS = 8;
+static const uint32_t THREAD_COUNTS[] = { 1, 2, 4, MAX_THREADS };
+static const float DELTA = 1.0f / 60.0f;
+
+static float ElapsedMs(const std::chrono::high_resolution_clock::time_point &start)
+{
+	return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static btRigidBody *AddBody(ScenePhysics &physics, btCollisionShape *shape, const float &mass, const Vector3 &position)
+{
+	btVector3 localInertia = btVector3(0.0f, 0.0f, 0.0f);
+
+	if (mass != 0.0f)
+	{
+		shape->calculateLocalInertia(mass, localInertia);
+	}
+
+	btTransform transform = btTransform();
+	transform.setIdentity();
+	transform.setOrigin(Collider::Convert(position));
+
+	btRigidBody *body = new btRigidBody(btRigidBody::btRigidBodyConstructionInfo(mass, new MotionState(transform), shape, localInertia));
+	physics.GetDynamicsWorld()->addRigidBody(body);
+	return body;
+}
+
+// Steps a world of box stacks with a sphere resting on each stack, and returns the time per step or a negative time if a body fell through the ground.
+static float Simulate(const bool &multithreaded, const ColliderBox &ground, const ColliderBox &box, const ColliderSphere &sphere, uint32_t &bodyCount)
+{
+	ScenePhysics physics = ScenePhysics(multithreaded);
+	std::vector<btRigidBody *> bodies = std::vector<btRigidBody *>();
+
+	AddBody(physics, ground.GetCollisionShape(), 0.0f, Vector3(0.0f, -0.5f, 0.0f));
+
+	for (uint32_t x = 0; x < STACK_COUNT; x++)
+	{
+		for (uint32_t z = 0; z < STACK_COUNT; z++)
+		{
+			Vector3 base = Vector3(3.0f * (x - (STACK_COUNT / 2.0f)), 0.5f, 3.0f * (z - (STACK_COUNT / 2.0f)));
+
+			for (uint32_t y = 0; y < STACK_HEIGHT; y++)
+			{
+				bodies.emplace_back(AddBody(physics, box.GetCollisionShape(), 1.0f, base + Vector3(0.0f, static_cast<float>(y), 0.0f)));
+			}
+
+			bodies.emplace_back(AddBody(physics, sphere.GetCollisionShape(), 1.0f, base + Vector3(0.0f, static_cast<float>(STACK_HEIGHT), 0.0f)));
+		}
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t step = 0; step < STEP_COUNT; step++)
+	{
+		physics.GetDynamicsWorld()->stepSimulation(DELTA, 0);
+	}
+
+	float stepMs = ElapsedMs(start) / STEP_COUNT;
+	bodyCount = static_cast<uint32_t>(bodies.size());
+
+	// Bodies are checked so a broken step can not report a fast time.
+	for (auto &body : bodies)
+	{
+		float height = body->getWorldTransform().getOrigin().y();
+
+		if (!std::isfinite(height) || height < 0.0f)
+		{
+			return -1.0f;
+		}
+	}
+
+	return stepMs;
+}
+
+int main(int argc, char **argv)
+{
+	// The pool is made with the most threads benchmarked, the scheduler limits how many of them run physics work.
+	ThreadPool threadPool = ThreadPool(MAX_THREADS);
+	ScenePhysics::SetScheduler(new PhysicsScheduler(&threadPool));
+
+	ColliderBox ground = ColliderBox(Vector3(200.0f, 1.0f, 200.0f));
+	ColliderBox box = ColliderBox(Vector3(1.0f, 1.0f, 1.0f));
+	ColliderSphere sphere = ColliderSphere(0.5f);
+	uint32_t bodyCount = 0;
+
+	float singleMs = Simulate(false, ground, box, sphere, bodyCount);
+
+	if (singleMs < 0.0f)
+	{
+		fprintf(stderr, "A body fell through the ground in the single threaded world\n");
+		return 1;
+	}
+
+	fprintf(stdout, "Bodies: %i, Steps: %i\n", bodyCount, STEP_COUNT);
+	fprintf(stdout, "  Single threaded world: %.3fms per step\n", singleMs);
+
+	for (auto &threadCount : THREAD_COUNTS)
+	{
+		ScenePhysics::GetScheduler()->setNumThreads(static_cast<int>(threadCount));
+		float stepMs = Simulate(true, ground, box, sphere, bodyCount);
+
+		if (stepMs < 0.0f)
+		{
+			fprintf(stderr, "A body fell through the ground with %i threads\n", threadCount);
+			return 1;
+		}
+
+		fprintf(stdout, "  Multithreaded world, %i threads: %.3fms per step, %.2fx\n", threadCount, stepMs, singleMs / stepMs);
+	}
+
+	ScenePhysics::SetScheduler(nullptr);
+	return 0;
+}
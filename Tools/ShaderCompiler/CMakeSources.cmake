@@ -0,0 +1,15 @@
+set(SHADERCOMPILER_HEADERS_
+        )
+
+set(SHADERCOMPILER_SOURCES_
+        "ShaderCompiler.rc"
+        "Main.cpp"
+        )
+
+source_group("Header Files" FILES ${SHADERCOMPILER_HEADERS_})
+source_group("Source Files" FILES ${SHADERCOMPILER_SOURCES_})
+
+set(SHADERCOMPILER_SOURCES
+        ${SHADERCOMPILER_HEADERS_}
+        ${SHADERCOMPILER_SOURCES_}
+        )
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <SPIRV/GlslangToSpv.h>
+#include <Files/Files.hpp>
+#include <Helpers/FileSystem.hpp>
+#include <Renderer/Pipelines/ShaderCache.hpp>
+#include <Renderer/Pipelines/ShaderProgram.hpp>
+
+using namespace acid;
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: ShaderCompiler <permutations file> [cache directory] [search paths...]\n");
+		return 1;
+	}
+
+	std::string permutationsFile = argv[1];
+
+	if (argc >= 3)
+	{
+		ShaderCache::SetDirectory(argv[2]);
+	}
+
+	for (int i = 3; i < argc; i++)
+	{
+		Files::AddSearchPath(argv[i]);
+	}
+
+	auto permutations = ShaderCache::ReadPermutations(permutationsFile);
+
+	if (permutations.empty())
+	{
+		fprintf(stderr, "No shader permutations found in: '%s'\n", permutationsFile.c_str());
+		return 1;
+	}
+
+	glslang::InitializeProcess();
+
+	uint32_t compiled = 0;
+
+	for (auto &[filename, defines] : permutations)
+	{
+		auto fileLoaded = FileSystem::ReadTextFile(filename);
+
+		if (!fileLoaded)
+		{
+			fprintf(stderr, "File does not exist: '%s'\n", filename.c_str());
+			continue;
+		}
+
+		auto shaderCode = ShaderProgram::InsertDefineBlock(*fileLoaded, ShaderCache::GetDefineBlock(defines));
+		shaderCode = ShaderProgram::ProcessIncludes(shaderCode);
+
+		// Compiling writes the SPIR-V and reflection into the cache directory.
+		ShaderProgram shaderProgram = ShaderProgram(filename);
+		auto spirv = shaderProgram.CompileShader(shaderCode, ShaderProgram::GetShaderStage(filename));
+
+		if (spirv.empty())
+		{
+			fprintf(stderr, "Failed to compile: '%s'\n", filename.c_str());
+			continue;
+		}
+
+		fprintf(stdout, "Compiled: '%s' (%i defines)\n", filename.c_str(), static_cast<int>(defines.size()));
+		compiled++;
+	}
+
+	glslang::FinalizeProcess();
+
+	fprintf(stdout, "Compiled %i of %i shader permutations into: '%s'\n", compiled, static_cast<int>(permutations.size()), ShaderCache::GetDirectory().c_str());
+	return compiled == permutations.size() ? 0 : 1;
+}